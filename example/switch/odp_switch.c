@@ -440,6 +440,17 @@ static inline void broadcast_packet(odp_packet_t pkt, thread_args_t *thr_arg,
 	odp_bool_t first = 1;
 	uint8_t port_out;
 	unsigned buf_len;
+	odp_packet_t ref[MAX_PKTIOS];
+	int num_ref = 0;
+	int num_out = gbl_args->appl.if_count - 1;
+	int i = 0;
+
+	/* Packet is not modified, other interfaces get a reference to it */
+	if (num_out > 1) {
+		num_ref = odp_packet_ref_multi(pkt, 0, ref, num_out - 1);
+		if (num_ref < 0)
+			num_ref = 0;
+	}
 
 	for (port_out = 0; port_out < gbl_args->appl.if_count; port_out++) {
 		if (port_out == port_in)
@@ -447,18 +458,15 @@ static inline void broadcast_packet(odp_packet_t pkt, thread_args_t *thr_arg,
 
 		buf_len = thr_arg->tx_pktio[port_out].buf.len;
 
-		if (first) { /* No need to copy for the first interface */
+		if (first) { /* No need to reference the first interface */
 			thr_arg->tx_pktio[port_out].buf.pkt[buf_len] = pkt;
 			first = 0;
 		} else {
-			odp_packet_t pkt_cp;
-
-			pkt_cp = odp_packet_copy(pkt, gbl_args->pool);
-			if (pkt_cp == ODP_PACKET_INVALID) {
-				printf("Error: packet copy failed\n");
+			if (i == num_ref) {
+				printf("Error: packet reference failed\n");
 				continue;
 			}
-			thr_arg->tx_pktio[port_out].buf.pkt[buf_len] = pkt_cp;
+			thr_arg->tx_pktio[port_out].buf.pkt[buf_len] = ref[i++];
 		}
 		thr_arg->tx_pktio[port_out].buf.len++;
 	}
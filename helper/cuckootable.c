@@ -65,7 +65,10 @@
 #define KEY_ALIGNMENT			16
 
 /** Maximum size of hash table that can be created. */
-#define HASH_ENTRIES_MAX        1048576
+#define HASH_ENTRIES_MAX        (16 * 1024 * 1024)
+
+/** Number of keys looked up together by the bulk lookup pipeline */
+#define LOOKUP_BURST_MAX		32
 
 /** @internal signature struct
  *   Structure storing both primary and secondary hashes
@@ -91,20 +94,20 @@ struct cuckoo_table_key_value {
 /** @internal bucket structure
  *  Put the elements with defferent keys but a same signature
  *  into a bucket, and each bucket has at most HASH_BUCKET_ENTRIES
- *  elements.
+ *  elements. Signatures, key-value slot indexes and version of a bucket
+ *  fit into a single cache line, so that a lookup needs only the bucket
+ *  and the matching key-value slot.
+ *
+ *  Readers do not take locks. Writers make the version odd while they
+ *  modify the bucket, readers retry when the version was odd or changed
+ *  during the read.
  */
 struct cuckoo_table_bucket {
 	struct cuckoo_table_signatures signatures[HASH_BUCKET_ENTRIES];
-	/* Includes dummy key index that always contains index 0 */
-	odp_buffer_t key_buf[HASH_BUCKET_ENTRIES + 1];
-	uint8_t flag[HASH_BUCKET_ENTRIES];
+	uint32_t kv_idx[HASH_BUCKET_ENTRIES];
+	odp_atomic_u32_t version;
 } ODP_ALIGNED_CACHE;
 
-/* More efficient access to a map of single ullong */
-#define ULLONG_FOR_EACH_1(IDX, MAP)	\
-	for (; MAP && (((IDX) = __builtin_ctzll(MAP)), true); \
-		 MAP = (MAP & (MAP - 1)))
-
 /** A hash table structure. */
 typedef struct {
 	/**< for check */
@@ -121,8 +124,18 @@ typedef struct {
 	uint32_t value_len;
 	/**< Bitmask for getting bucket index from hash signature. */
 	uint32_t bucket_bitmask;
-	/**< Queue that stores all free key-value slots*/
-	odp_queue_t free_slots;
+	/**< Size of a key-value slot */
+	uint32_t kv_entry_size;
+	/**< Number of free key-value slots */
+	uint32_t num_free;
+	/**< Stack of free key-value slot indexes */
+	uint32_t *free_slots;
+	/**< Key-value slots */
+	uint8_t *kv_slots;
+	/**< Entries being pushed by make_space_bucket(), per bucket entry */
+	uint8_t *flags;
+	/**< Serializes writers */
+	odp_spinlock_t writer_lock;
 	/** Table with buckets storing all the hash values and key indexes
 	  to the key table*/
 	struct cuckoo_table_bucket *buckets;
@@ -178,18 +191,9 @@ odph_cuckoo_table_create(
 {
 	odph_cuckoo_table_impl *tbl;
 	odp_shm_t shm_tbl;
-
-	odp_pool_t pool;
-	odp_pool_param_t param;
-
-	odp_queue_t queue;
-	odp_queue_param_t qparam;
-
-	char pool_name[ODPH_TABLE_NAME_LEN + 3],
-		 queue_name[ODPH_TABLE_NAME_LEN + 3];
-	unsigned i;
-	uint32_t impl_size, kv_entry_size,
-			 bucket_num, bucket_size;
+	uint32_t i;
+	uint64_t impl_size, kv_entry_size, bucket_num, bucket_size,
+		 kv_size, free_size, flags_size;
 
 	/* Check for valid parameters */
 	if (
@@ -208,16 +212,24 @@ odph_cuckoo_table_create(
 		return NULL;
 	}
 
-	/* Calculate the sizes of different parts of cuckoo hash table */
+	/* Calculate the sizes of different parts of cuckoo hash table.
+	 * Key-value slots are kept pointer aligned. */
 	impl_size = sizeof(odph_cuckoo_table_impl);
 	kv_entry_size = sizeof(struct cuckoo_table_key_value)
 					+ key_size + value_size;
+	kv_entry_size = (kv_entry_size + sizeof(void *) - 1) &
+			~(uint64_t)(sizeof(void *) - 1);
 
 	bucket_num = align32pow2(capacity) / HASH_BUCKET_ENTRIES;
 	bucket_size = bucket_num * sizeof(struct cuckoo_table_bucket);
+	kv_size = (uint64_t)capacity * kv_entry_size;
+	free_size = (uint64_t)capacity * sizeof(uint32_t);
+	flags_size = bucket_num * HASH_BUCKET_ENTRIES;
 
 	shm_tbl = odp_shm_reserve(
-				name, impl_size + bucket_size,
+				name,
+				impl_size + bucket_size + kv_size + free_size +
+				flags_size,
 				ODP_CACHE_LINE_SIZE, ODP_SHM_SW_ONLY);
 
 	if (shm_tbl == ODP_SHM_INVALID) {
@@ -231,44 +243,14 @@ odph_cuckoo_table_create(
 	memset(tbl, 0, impl_size + bucket_size);
 
 	/* header of this mem block is the table impl struct,
-	 * then the bucket pool.
+	 * then the buckets, key-value slots, the free slot stack
+	 * and the push flags.
 	 */
 	tbl->buckets = (void *)((char *)tbl + impl_size);
-
-	/* initialize key-value buffer pool */
-	snprintf(pool_name, sizeof(pool_name), "kv_%s", name);
-	pool = odp_pool_lookup(pool_name);
-
-	if (pool != ODP_POOL_INVALID)
-		odp_pool_destroy(pool);
-
-	odp_pool_param_init(&param);
-	param.type = ODP_POOL_BUFFER;
-	param.buf.size = kv_entry_size;
-	param.buf.align = ODP_CACHE_LINE_SIZE;
-	param.buf.num = capacity;
-
-	pool = odp_pool_create(pool_name, &param);
-
-	if (pool == ODP_POOL_INVALID) {
-		ODPH_DBG("failed to create key-value pool\n");
-		odp_shm_free(shm_tbl);
-		return NULL;
-	}
-
-	/* initialize free_slots queue */
-	odp_queue_param_init(&qparam);
-	qparam.type = ODP_QUEUE_TYPE_PLAIN;
-	qparam.size = capacity;
-
-	snprintf(queue_name, sizeof(queue_name), "fs_%s", name);
-	queue = odp_queue_create(queue_name, &qparam);
-	if (queue == ODP_QUEUE_INVALID) {
-		ODPH_DBG("failed to create free_slots queue\n");
-		odp_pool_destroy(pool);
-		odp_shm_free(shm_tbl);
-		return NULL;
-	}
+	tbl->kv_slots = (uint8_t *)tbl->buckets + bucket_size;
+	tbl->free_slots = (void *)(tbl->kv_slots + kv_size);
+	tbl->flags = (uint8_t *)tbl->free_slots + free_size;
+	memset(tbl->flags, 0, flags_size);
 
 	/* Setup hash context */
 	snprintf(tbl->name, sizeof(tbl->name), "%s", name);
@@ -278,24 +260,15 @@ odph_cuckoo_table_create(
 	tbl->value_len = value_size;
 	tbl->num_buckets = bucket_num;
 	tbl->bucket_bitmask = bucket_num - 1;
-	tbl->free_slots = queue;
-
-	/* generate all free buffers, and put into queue */
-	for (i = 0; i < capacity; i++) {
-		odp_event_t ev = odp_buffer_to_event(
-				odp_buffer_alloc(pool));
-		if (ev == ODP_EVENT_INVALID) {
-			ODPH_DBG("failed to generate free slots\n");
-			odph_cuckoo_table_destroy((odph_table_t)tbl);
-			return NULL;
-		}
+	tbl->kv_entry_size = kv_entry_size;
+	odp_spinlock_init(&tbl->writer_lock);
+	for (i = 0; i < bucket_num; i++)
+		odp_atomic_init_u32(&tbl->buckets[i].version, 0);
 
-		if (odp_queue_enq(queue, ev) < 0) {
-			ODPH_DBG("failed to enqueue free slots\n");
-			odph_cuckoo_table_destroy((odph_table_t)tbl);
-			return NULL;
-		}
-	}
+	/* all key-value slots are free, lowest index on top */
+	for (i = 0; i < capacity; i++)
+		tbl->free_slots[i] = capacity - 1 - i;
+	tbl->num_free = capacity;
 
 	return (odph_table_t)tbl;
 }
@@ -303,13 +276,8 @@ odph_cuckoo_table_create(
 int
 odph_cuckoo_table_destroy(odph_table_t tbl)
 {
-	int ret;
 	odph_cuckoo_table_impl *impl = NULL;
-	char pool_name[ODPH_TABLE_NAME_LEN + 3];
-	odp_event_t ev;
 	odp_shm_t shm;
-	odp_pool_t pool;
-	uint32_t i, j;
 
 	if (tbl == NULL)
 		return -1;
@@ -322,40 +290,6 @@ odph_cuckoo_table_destroy(odph_table_t tbl)
 		return -1;
 	}
 
-	/* free all used buffers*/
-	for (i = 0; i < impl->num_buckets; i++) {
-		for (j = 0; j < HASH_BUCKET_ENTRIES; j++) {
-			if (impl->buckets[i].signatures[j].current
-					!= NULL_SIGNATURE)
-				odp_buffer_free(impl->buckets[i].key_buf[j]);
-		}
-	}
-
-	/* free all free buffers */
-	while ((ev = odp_queue_deq(impl->free_slots))
-			!= ODP_EVENT_INVALID) {
-		odp_buffer_free(odp_buffer_from_event(ev));
-	}
-
-	/* destroy free_slots queue */
-	ret = odp_queue_destroy(impl->free_slots);
-	if (ret < 0)
-		ODPH_DBG("failed to destroy free_slots queue\n");
-
-	/* destroy key-value pool */
-	snprintf(pool_name, sizeof(pool_name), "kv_%s", impl->name);
-	pool = odp_pool_lookup(pool_name);
-	if (pool == ODP_POOL_INVALID) {
-		ODPH_DBG("invalid pool\n");
-		return -1;
-	}
-
-	ret = odp_pool_destroy(pool);
-	if (ret != 0) {
-		ODPH_DBG("failed to destroy key-value buffer pool\n");
-		return -1;
-	}
-
 	/* free impl */
 	shm = odp_shm_lookup(impl->name);
 	if (shm == ODP_SHM_INVALID) {
@@ -363,6 +297,8 @@ odph_cuckoo_table_destroy(odph_table_t tbl)
 		return -1;
 	}
 
+	impl->magicword = 0;
+
 	return odp_shm_free(shm);
 }
 
@@ -384,7 +320,85 @@ hash_secondary(const uint32_t primary_hash)
 	return (primary_hash ^ ((tag + 1) * alt_bits_xor));
 }
 
-/* Search for an entry that can be pushed to its alternative location */
+/* Key-value slot of an index */
+static inline struct cuckoo_table_key_value *
+slot_kv(const odph_cuckoo_table_impl *h, uint32_t idx)
+{
+	return (struct cuckoo_table_key_value *)(void *)
+	       (h->kv_slots + (uint64_t)idx * h->kv_entry_size);
+}
+
+/* Return a key-value slot to the free slot stack */
+static inline void
+cuckoo_table_free_slot(odph_cuckoo_table_impl *h, uint32_t idx)
+{
+	h->free_slots[h->num_free++] = idx;
+}
+
+/* Wait until no writer modifies the bucket and return its version */
+static inline uint32_t
+bucket_read_begin(const struct cuckoo_table_bucket *bkt)
+{
+	odp_atomic_u32_t *version = (odp_atomic_u32_t *)(uintptr_t)
+				    &bkt->version;
+	uint32_t ver;
+
+	while ((ver = odp_atomic_load_acq_u32(version)) & 1)
+		odp_cpu_pause();
+
+	return ver;
+}
+
+/* Check if the bucket was modified after bucket_read_begin() */
+static inline int
+bucket_read_retry(const struct cuckoo_table_bucket *bkt, uint32_t ver)
+{
+	odp_atomic_u32_t *version = (odp_atomic_u32_t *)(uintptr_t)
+				    &bkt->version;
+
+	odp_mb_acquire();
+	return odp_atomic_load_u32(version) != ver;
+}
+
+static inline void
+bucket_write_begin(struct cuckoo_table_bucket *bkt)
+{
+	odp_atomic_inc_u32(&bkt->version);
+	odp_mb_full();
+}
+
+static inline void
+bucket_write_end(struct cuckoo_table_bucket *bkt)
+{
+	odp_atomic_add_rel_u32(&bkt->version, 1);
+}
+
+/* Push flags of the entries of a bucket */
+static inline uint8_t *
+bucket_flags(const odph_cuckoo_table_impl *impl,
+	     const struct cuckoo_table_bucket *bkt)
+{
+	return &impl->flags[(bkt - impl->buckets) * HASH_BUCKET_ENTRIES];
+}
+
+/* Write an entry into a bucket */
+static inline void
+bucket_set_entry(struct cuckoo_table_bucket *bkt, unsigned i,
+		 uint32_t current, uint32_t alt, uint32_t kv_idx)
+{
+	bucket_write_begin(bkt);
+	bkt->signatures[i].current = current;
+	bkt->signatures[i].alt = alt;
+	bkt->kv_idx[i] = kv_idx;
+	bucket_write_end(bkt);
+}
+
+/*
+ * Search for an entry that can be pushed to its alternative location.
+ * An entry is first copied to its alternative bucket and only then
+ * overwritten by the caller, so concurrent readers always find it in
+ * one of its buckets.
+ */
 static inline int
 make_space_bucket(
 	const odph_cuckoo_table_impl *impl,
@@ -394,6 +408,7 @@ make_space_bucket(
 	int ret;
 	uint32_t next_bucket_idx;
 	struct cuckoo_table_bucket *next_bkt[HASH_BUCKET_ENTRIES];
+	uint8_t *flag = bucket_flags(impl, bkt);
 
 	/*
 	 * Push existing item (search for bucket with space in
@@ -414,15 +429,14 @@ make_space_bucket(
 
 	/* Alternative location has spare room (end of recursive function) */
 	if (i != HASH_BUCKET_ENTRIES) {
-		next_bkt[i]->signatures[j].alt = bkt->signatures[i].current;
-		next_bkt[i]->signatures[j].current = bkt->signatures[i].alt;
-		next_bkt[i]->key_buf[j] = bkt->key_buf[i];
+		bucket_set_entry(next_bkt[i], j, bkt->signatures[i].alt,
+				 bkt->signatures[i].current, bkt->kv_idx[i]);
 		return i;
 	}
 
 	/* Pick entry that has not been pushed yet */
 	for (i = 0; i < HASH_BUCKET_ENTRIES; i++)
-		if (bkt->flag[i] == 0)
+		if (flag[i] == 0)
 			break;
 
 	/* All entries have been pushed, so entry cannot be added */
@@ -430,7 +444,7 @@ make_space_bucket(
 		return -ENOSPC;
 
 	/* Set flag to indicate that this entry is going to be pushed */
-	bkt->flag[i] = 1;
+	flag[i] = 1;
 	/* Need room in alternative bucket to insert the pushed entry */
 	ret = make_space_bucket(impl, next_bkt[i]);
 	/*
@@ -439,29 +453,42 @@ make_space_bucket(
 	 * in its alternative location if successful,
 	 * or return error
 	 */
-	bkt->flag[i] = 0;
+	flag[i] = 0;
 	if (ret >= 0) {
-		next_bkt[i]->signatures[ret].alt = bkt->signatures[i].current;
-		next_bkt[i]->signatures[ret].current = bkt->signatures[i].alt;
-		next_bkt[i]->key_buf[ret] = bkt->key_buf[i];
+		bucket_set_entry(next_bkt[i], ret, bkt->signatures[i].alt,
+				 bkt->signatures[i].current, bkt->kv_idx[i]);
 		return i;
 	}
 
 	return ret;
 }
 
+/* Update value of an existing entry */
+static inline void
+cuckoo_table_update_value(
+	const odph_cuckoo_table_impl *h, struct cuckoo_table_bucket *bkt,
+	struct cuckoo_table_key_value *kv, const void *data)
+{
+	if (kv->value == NULL)
+		return;
+
+	bucket_write_begin(bkt);
+	memcpy(kv->value, data, h->value_len);
+	bucket_write_end(bkt);
+}
+
+/* Caller holds the writer lock */
 static inline int32_t
 cuckoo_table_add_key_with_hash(
-	const odph_cuckoo_table_impl *h, const void *key,
+	odph_cuckoo_table_impl *h, const void *key,
 	uint32_t sig, void *data)
 {
 	uint32_t alt_hash;
 	uint32_t prim_bucket_idx, sec_bucket_idx;
+	uint32_t new_idx;
 	unsigned i;
 	struct cuckoo_table_bucket *prim_bkt, *sec_bkt;
 	struct cuckoo_table_key_value *new_kv, *kv;
-
-	odp_buffer_t new_buf;
 	int ret;
 
 	prim_bucket_idx = sig & h->bucket_bitmask;
@@ -473,25 +500,15 @@ cuckoo_table_add_key_with_hash(
 	sec_bkt = &h->buckets[sec_bucket_idx];
 	__builtin_prefetch((const void *)(uintptr_t)sec_bkt, 0, 3);
 
-	/* Get a new slot for storing the new key */
-	new_buf = odp_buffer_from_event(odp_queue_deq(h->free_slots));
-	if (new_buf == ODP_BUFFER_INVALID)
-		return -ENOSPC;
-
 	/* Check if key is already inserted in primary location */
 	for (i = 0; i < HASH_BUCKET_ENTRIES; i++) {
 		if (
 			prim_bkt->signatures[i].current == sig &&
 			prim_bkt->signatures[i].alt == alt_hash)  {
-			kv = (struct cuckoo_table_key_value *)odp_buffer_addr(
-					prim_bkt->key_buf[i]);
+			kv = slot_kv(h, prim_bkt->kv_idx[i]);
 			if (memcmp(key, kv->key, h->key_len) == 0) {
-				odp_queue_enq(
-						h->free_slots,
-						odp_buffer_to_event(new_buf));
-				/* Update data */
-				if (kv->value != NULL)
-					memcpy(kv->value, data, h->value_len);
+				cuckoo_table_update_value(h, prim_bkt, kv,
+							  data);
 
 				/* Return bucket index */
 				return prim_bucket_idx;
@@ -504,15 +521,10 @@ cuckoo_table_add_key_with_hash(
 		if (
 			sec_bkt->signatures[i].alt == sig &&
 			sec_bkt->signatures[i].current == alt_hash)  {
-			kv = (struct cuckoo_table_key_value *)odp_buffer_addr(
-					sec_bkt->key_buf[i]);
+			kv = slot_kv(h, sec_bkt->kv_idx[i]);
 			if (memcmp(key, kv->key, h->key_len) == 0) {
-				odp_queue_enq(
-						h->free_slots,
-						odp_buffer_to_event(new_buf));
-				/* Update data */
-				if (kv->value != NULL)
-					memcpy(kv->value, data, h->value_len);
+				cuckoo_table_update_value(h, sec_bkt, kv,
+							  data);
 
 				/* Return bucket index */
 				return sec_bucket_idx;
@@ -520,8 +532,12 @@ cuckoo_table_add_key_with_hash(
 		}
 	}
 
-	new_kv = (struct cuckoo_table_key_value *)odp_buffer_addr(new_buf);
-	__builtin_prefetch((const void *)(uintptr_t)new_kv, 0, 3);
+	/* Get a new slot for storing the new key */
+	if (h->num_free == 0)
+		return -ENOSPC;
+
+	new_idx = h->free_slots[h->num_free - 1];
+	new_kv = slot_kv(h, new_idx);
 
 	/* Copy key and value.
 	 * key-value mem block : struct cuckoo_table_key_value
@@ -542,9 +558,8 @@ cuckoo_table_add_key_with_hash(
 	for (i = 0; i < HASH_BUCKET_ENTRIES; i++) {
 		/* Check if slot is available */
 		if (odp_likely(prim_bkt->signatures[i].sig == NULL_SIGNATURE)) {
-			prim_bkt->signatures[i].current = sig;
-			prim_bkt->signatures[i].alt = alt_hash;
-			prim_bkt->key_buf[i] = new_buf;
+			bucket_set_entry(prim_bkt, i, sig, alt_hash, new_idx);
+			h->num_free--;
 			return prim_bucket_idx;
 		}
 	}
@@ -555,18 +570,14 @@ cuckoo_table_add_key_with_hash(
 	/*
 	 * After recursive function.
 	 * Insert the new entry in the position of the pushed entry
-	 * if successful or return error and
-	 * store the new slot back in the pool
+	 * if successful or return error. The new slot stays free.
 	 */
 	if (ret >= 0) {
-		prim_bkt->signatures[ret].current = sig;
-		prim_bkt->signatures[ret].alt = alt_hash;
-		prim_bkt->key_buf[ret] = new_buf;
+		bucket_set_entry(prim_bkt, ret, sig, alt_hash, new_idx);
+		h->num_free--;
 		return prim_bucket_idx;
 	}
 
-	/* Error in addition, store new slot back in the free_slots */
-	odp_queue_enq(h->free_slots, odp_buffer_to_event(new_buf));
 	return ret;
 }
 
@@ -574,14 +585,18 @@ int
 odph_cuckoo_table_put_value(odph_table_t tbl, void *key, void *value)
 {
 	odph_cuckoo_table_impl *impl;
+	uint32_t sig;
 	int ret;
 
 	if ((tbl == NULL) || (key == NULL))
 		return -EINVAL;
 
 	impl = (odph_cuckoo_table_impl *)(void *)tbl;
-	ret = cuckoo_table_add_key_with_hash(
-			impl, key, hash(impl, key), value);
+	sig = hash(impl, key);
+
+	odp_spinlock_lock(&impl->writer_lock);
+	ret = cuckoo_table_add_key_with_hash(impl, key, sig, value);
+	odp_spinlock_unlock(&impl->writer_lock);
 
 	if (ret < 0)
 		return -1;
@@ -589,90 +604,276 @@ odph_cuckoo_table_put_value(odph_table_t tbl, void *key, void *value)
 	return 0;
 }
 
-static inline int32_t
-cuckoo_table_lookup_with_hash(
-	const odph_cuckoo_table_impl *h, const void *key,
-	uint32_t sig, void **data_ptr)
+/* Search a bucket for a key. Returns the matching key-value slot. */
+static inline struct cuckoo_table_key_value *
+bucket_search(const odph_cuckoo_table_impl *h,
+	      const struct cuckoo_table_bucket *bkt, const void *key,
+	      uint32_t current, uint32_t alt)
 {
-	uint32_t bucket_idx;
-	uint32_t alt_hash;
-	unsigned i;
-	struct cuckoo_table_bucket *bkt;
 	struct cuckoo_table_key_value *kv;
+	unsigned i;
 
-	bucket_idx = sig & h->bucket_bitmask;
-	bkt = &h->buckets[bucket_idx];
-
-	/* Check if key is in primary location */
 	for (i = 0; i < HASH_BUCKET_ENTRIES; i++) {
 		if (
-			bkt->signatures[i].current == sig &&
-			bkt->signatures[i].sig != NULL_SIGNATURE) {
-			kv = (struct cuckoo_table_key_value *)odp_buffer_addr(
-					bkt->key_buf[i]);
-			if (memcmp(key, kv->key, h->key_len) == 0) {
-				if (data_ptr != NULL)
-					*data_ptr = kv->value;
-				/*
-				 * Return index where key is stored,
-				 * subtracting the first dummy index
-				 */
-				return bucket_idx;
-			}
+			bkt->signatures[i].current == current &&
+			bkt->signatures[i].alt == alt) {
+			kv = slot_kv(h, bkt->kv_idx[i]);
+			if (memcmp(key, kv->key, h->key_len) == 0)
+				return kv;
 		}
 	}
 
+	return NULL;
+}
+
+/* Copy the value of a hit into the buffer. The value is copied only when
+ * the bucket did not change since the hit was found, and the copy is
+ * checked the same way, since values are updated in place. Returns
+ * non-zero when the bucket changed and the lookup must be retried. */
+static inline int
+bucket_hit_read(const odph_cuckoo_table_impl *h,
+		const struct cuckoo_table_bucket *bkt, uint32_t ver,
+		const struct cuckoo_table_key_value *kv, void *buffer)
+{
+	if (bucket_read_retry(bkt, ver))
+		return 1;
+
+	if (buffer == NULL || h->value_len == 0)
+		return 0;
+
+	memcpy(buffer, kv->value, h->value_len);
+
+	return bucket_read_retry(bkt, ver);
+}
+
+/*
+ * Look up a key without locks. A hit is valid when its bucket did not
+ * change during the search. A miss is valid when neither bucket changed,
+ * otherwise the key could have been moved between the buckets while
+ * those were searched.
+ */
+static inline int32_t
+cuckoo_table_lookup_with_hash(
+	const odph_cuckoo_table_impl *h, const void *key,
+	uint32_t sig, void *buffer)
+{
+	uint32_t prim_bucket_idx, sec_bucket_idx;
+	uint32_t alt_hash;
+	uint32_t prim_ver, sec_ver;
+	const struct cuckoo_table_bucket *prim_bkt, *sec_bkt;
+	const struct cuckoo_table_key_value *kv;
+
+	prim_bucket_idx = sig & h->bucket_bitmask;
+	prim_bkt = &h->buckets[prim_bucket_idx];
+
 	/* Calculate secondary hash */
 	alt_hash = hash_secondary(sig);
-	bucket_idx = alt_hash & h->bucket_bitmask;
-	bkt = &h->buckets[bucket_idx];
+	sec_bucket_idx = alt_hash & h->bucket_bitmask;
+	sec_bkt = &h->buckets[sec_bucket_idx];
 
-	/* Check if key is in secondary location */
-	for (i = 0; i < HASH_BUCKET_ENTRIES; i++) {
-		if (
-			bkt->signatures[i].current == alt_hash &&
-			bkt->signatures[i].alt == sig) {
-			kv = (struct cuckoo_table_key_value *)odp_buffer_addr(
-					bkt->key_buf[i]);
-			if (memcmp(key, kv->key, h->key_len) == 0) {
-				if (data_ptr != NULL)
-					*data_ptr = kv->value;
-				/*
-				 * Return index where key is stored,
-				 * subtracting the first dummy index
-				 */
-				return bucket_idx;
-			}
+	while (1) {
+		prim_ver = bucket_read_begin(prim_bkt);
+		sec_ver = bucket_read_begin(sec_bkt);
+
+		/* Check if key is in primary location */
+		kv = bucket_search(h, prim_bkt, key, sig, alt_hash);
+		if (kv != NULL) {
+			if (bucket_hit_read(h, prim_bkt, prim_ver, kv, buffer))
+				continue;
+			return prim_bucket_idx;
 		}
-	}
 
-	return -ENOENT;
+		/* Check if key is in secondary location */
+		kv = bucket_search(h, sec_bkt, key, alt_hash, sig);
+		if (kv != NULL) {
+			if (bucket_hit_read(h, sec_bkt, sec_ver, kv, buffer))
+				continue;
+			return sec_bucket_idx;
+		}
+
+		if (!bucket_read_retry(prim_bkt, prim_ver) &&
+		    !bucket_read_retry(sec_bkt, sec_ver))
+			return -ENOENT;
+	}
 }
 
 int odph_cuckoo_table_get_value(odph_table_t tbl, void *key,
-				void *buffer, uint32_t buffer_size ODP_UNUSED)
+				void *buffer, uint32_t buffer_size)
 {
 	odph_cuckoo_table_impl *impl = (odph_cuckoo_table_impl *)(void *)tbl;
-	void *tmp = NULL;
 	int ret;
 
 	if ((tbl == NULL) || (key == NULL))
 		return -EINVAL;
 
-	ret = cuckoo_table_lookup_with_hash(impl, key, hash(impl, key), &tmp);
+	if (buffer != NULL && buffer_size < impl->value_len)
+		return -EINVAL;
+
+	ret = cuckoo_table_lookup_with_hash(impl, key, hash(impl, key),
+					    buffer);
 
 	if (ret < 0)
 		return -1;
 
-	if (impl->value_len > 0)
-		memcpy(buffer, tmp, impl->value_len);
-
 	return 0;
 }
 
+/* Bitmap of bucket entries with matching signatures */
+static inline uint64_t
+bucket_sig_match(const struct cuckoo_table_bucket *bkt,
+		 uint32_t current, uint32_t alt)
+{
+	uint64_t map = 0;
+	unsigned i;
+
+	for (i = 0; i < HASH_BUCKET_ENTRIES; i++)
+		if (bkt->signatures[i].current == current &&
+		    bkt->signatures[i].alt == alt)
+			map |= 1ULL << i;
+
+	return map;
+}
+
+/* Compare key against bucket entries in the map. Returns the matching
+ * key-value slot. */
+static inline struct cuckoo_table_key_value *
+bucket_map_search(const odph_cuckoo_table_impl *h,
+		  const struct cuckoo_table_bucket *bkt, uint64_t map,
+		  const void *key)
+{
+	struct cuckoo_table_key_value *kv;
+	unsigned idx;
+
+	ULLONG_FOR_EACH_1(idx, map) {
+		kv = slot_kv(h, bkt->kv_idx[idx]);
+		if (memcmp(key, kv->key, h->key_len) == 0)
+			return kv;
+	}
+
+	return NULL;
+}
+
+/*
+ * Look up a burst of keys in three stages, so that cache misses of
+ * different keys overlap:
+ *  1. hash all keys and prefetch both candidate buckets
+ *  2. compare inline signatures and prefetch matching key-value slots
+ *  3. compare keys of the matching slots and copy values of the hits
+ * Only slots with matching signatures are fetched, so a miss usually
+ * costs just the bucket accesses. A value is copied only after its hit
+ * is confirmed. A key whose buckets were modified during the lookup is
+ * looked up again with the single key lookup.
+ */
+static inline int
+cuckoo_table_lookup_burst(
+	const odph_cuckoo_table_impl *h, void *key[],
+	void *buffer[], int hit[], int num)
+{
+	uint32_t sig[LOOKUP_BURST_MAX], alt_hash[LOOKUP_BURST_MAX];
+	uint32_t prim_ver[LOOKUP_BURST_MAX], sec_ver[LOOKUP_BURST_MAX];
+	const struct cuckoo_table_bucket *prim_bkt[LOOKUP_BURST_MAX];
+	const struct cuckoo_table_bucket *sec_bkt[LOOKUP_BURST_MAX];
+	uint64_t prim_map[LOOKUP_BURST_MAX], sec_map[LOOKUP_BURST_MAX];
+	const struct cuckoo_table_key_value *kv;
+	uint64_t map;
+	unsigned idx;
+	int i, found = 0;
+	int retry;
+
+	for (i = 0; i < num; i++) {
+		sig[i] = hash(h, key[i]);
+		alt_hash[i] = hash_secondary(sig[i]);
+		prim_bkt[i] = &h->buckets[sig[i] & h->bucket_bitmask];
+		sec_bkt[i] = &h->buckets[alt_hash[i] & h->bucket_bitmask];
+		__builtin_prefetch(prim_bkt[i], 0, 3);
+		__builtin_prefetch(sec_bkt[i], 0, 3);
+	}
+
+	for (i = 0; i < num; i++) {
+		prim_ver[i] = bucket_read_begin(prim_bkt[i]);
+		sec_ver[i] = bucket_read_begin(sec_bkt[i]);
+
+		prim_map[i] = bucket_sig_match(prim_bkt[i], sig[i],
+					       alt_hash[i]);
+		sec_map[i] = bucket_sig_match(sec_bkt[i], alt_hash[i],
+					      sig[i]);
+
+		map = prim_map[i];
+		ULLONG_FOR_EACH_1(idx, map)
+			__builtin_prefetch(slot_kv(h, prim_bkt[i]->kv_idx[idx]),
+					   0, 3);
+
+		map = sec_map[i];
+		ULLONG_FOR_EACH_1(idx, map)
+			__builtin_prefetch(slot_kv(h, sec_bkt[i]->kv_idx[idx]),
+					   0, 3);
+	}
+
+	for (i = 0; i < num; i++) {
+		void *buf = buffer ? buffer[i] : NULL;
+
+		kv = bucket_map_search(h, prim_bkt[i], prim_map[i], key[i]);
+		if (kv != NULL) {
+			hit[i] = 1;
+			retry = bucket_hit_read(h, prim_bkt[i], prim_ver[i],
+						kv, buf);
+		} else {
+			kv = bucket_map_search(h, sec_bkt[i], sec_map[i],
+					       key[i]);
+			hit[i] = kv != NULL;
+			if (hit[i])
+				retry = bucket_hit_read(h, sec_bkt[i],
+							sec_ver[i], kv, buf);
+			else
+				retry = bucket_read_retry(prim_bkt[i],
+							  prim_ver[i]) ||
+					bucket_read_retry(sec_bkt[i],
+							  sec_ver[i]);
+		}
+
+		if (odp_unlikely(retry))
+			hit[i] = cuckoo_table_lookup_with_hash(h, key[i],
+							       sig[i],
+							       buf) >= 0;
+
+		found += hit[i];
+	}
+
+	return found;
+}
+
+int odph_cuckoo_table_get_value_multi(odph_table_t tbl, void *key[],
+				      void *buffer[],
+				      uint32_t buffer_size,
+				      int hit[], int num)
+{
+	odph_cuckoo_table_impl *impl = (odph_cuckoo_table_impl *)(void *)tbl;
+	int i, burst;
+	int found = 0;
+
+	if ((tbl == NULL) || (key == NULL) || (hit == NULL) || (num < 0))
+		return -EINVAL;
+
+	if (buffer != NULL && buffer_size < impl->value_len)
+		return -EINVAL;
+
+	for (i = 0; i < num; i += burst) {
+		burst = num - i;
+		if (burst > LOOKUP_BURST_MAX)
+			burst = LOOKUP_BURST_MAX;
+
+		found += cuckoo_table_lookup_burst(impl, &key[i],
+						   buffer ? &buffer[i] : NULL,
+						   &hit[i], burst);
+	}
+
+	return found;
+}
+
+/* Caller holds the writer lock */
 static inline int32_t
 cuckoo_table_del_key_with_hash(
-	const odph_cuckoo_table_impl *h,
+	odph_cuckoo_table_impl *h,
 	const void *key, uint32_t sig)
 {
 	uint32_t bucket_idx;
@@ -689,14 +890,12 @@ cuckoo_table_del_key_with_hash(
 		if (
 			bkt->signatures[i].current == sig &&
 			bkt->signatures[i].sig != NULL_SIGNATURE) {
-			kv = (struct cuckoo_table_key_value *)odp_buffer_addr(
-					bkt->key_buf[i]);
+			kv = slot_kv(h, bkt->kv_idx[i]);
 			if (memcmp(key, kv->key, h->key_len) == 0) {
+				bucket_write_begin(bkt);
 				bkt->signatures[i].sig = NULL_SIGNATURE;
-				odp_queue_enq(
-						h->free_slots,
-						odp_buffer_to_event(
-							bkt->key_buf[i]));
+				bucket_write_end(bkt);
+				cuckoo_table_free_slot(h, bkt->kv_idx[i]);
 				return bucket_idx;
 			}
 		}
@@ -712,14 +911,12 @@ cuckoo_table_del_key_with_hash(
 		if (
 			bkt->signatures[i].current == alt_hash &&
 			bkt->signatures[i].sig != NULL_SIGNATURE) {
-			kv = (struct cuckoo_table_key_value *)odp_buffer_addr(
-					bkt->key_buf[i]);
+			kv = slot_kv(h, bkt->kv_idx[i]);
 			if (memcmp(key, kv->key, h->key_len) == 0) {
+				bucket_write_begin(bkt);
 				bkt->signatures[i].sig = NULL_SIGNATURE;
-				odp_queue_enq(
-						h->free_slots,
-						odp_buffer_to_event(
-							bkt->key_buf[i]));
+				bucket_write_end(bkt);
+				cuckoo_table_free_slot(h, bkt->kv_idx[i]);
 				return bucket_idx;
 			}
 		}
@@ -732,12 +929,18 @@ int
 odph_cuckoo_table_remove_value(odph_table_t tbl, void *key)
 {
 	odph_cuckoo_table_impl *impl = (void *)tbl;
+	uint32_t sig;
 	int ret;
 
 	if ((tbl == NULL) || (key == NULL))
 		return -EINVAL;
 
-	ret = cuckoo_table_del_key_with_hash(impl, key, hash(impl, key));
+	sig = hash(impl, key);
+
+	odp_spinlock_lock(&impl->writer_lock);
+	ret = cuckoo_table_del_key_with_hash(impl, key, sig);
+	odp_spinlock_unlock(&impl->writer_lock);
+
 	if (ret < 0)
 		return -1;
 
@@ -60,7 +60,11 @@ extern "C" {
 /**
  * Create a cuckoo table
  *
- * @param name       Name of the cuckoo table to be created
+ * Lookups do not take locks and may run in any number of threads
+ * concurrently with inserts and removals. Inserts and removals are
+ * serialized with a lock.
+ *
+ * @param name      Name of the cuckoo table to be created
  * @param capacity   Number of elements table may store
  * @param key_size   Size of the key for each element
  * @param value_size Size of the value stored for each element
@@ -111,8 +115,9 @@ int odph_cuckoo_table_put_value(odph_table_t table, void *key, void *value);
  *
  * @param table Table from which value is to be retrieved
  * @param key   Address of an odph_table_t to be used as key
- * @param[out] buffer Address of buffer to receive resulting value
- * @param buffer_size Size of supplied buffer
+ * @param[out] buffer Address of buffer to receive resulting value, or NULL
+ * @param buffer_size Size of supplied buffer. Must be at least the value
+ *                    size of the table, when a buffer is supplied.
  *
  * @retval 0   Success
  * @retval 1   Success
@@ -122,6 +127,33 @@ int odph_cuckoo_table_get_value(odph_table_t table,
 				void *key, void *buffer,
 				uint32_t buffer_size);
 
+/**
+ * Retrieve values of multiple keys from a cuckoo table
+ *
+ * Lookups of the keys are pipelined, so that memory accesses of different
+ * keys overlap. This is considerably faster than calling
+ * odph_cuckoo_table_get_value() for each key when the table does not fit
+ * into CPU caches.
+ *
+ * @param table  Table from which values are to be retrieved
+ * @param key    Array of key addresses
+ * @param[out] buffer Array of buffer addresses to receive resulting values.
+ *                    Buffer of a key that is not found is not modified.
+ *                    May be NULL, when only the hit results are needed.
+ * @param buffer_size Size of each supplied buffer. Must be at least the
+ *                    value size of the table, when buffers are supplied.
+ * @param[out] hit    Array of lookup results, 1 when the key was found and
+ *                    0 otherwise
+ * @param num    Number of keys
+ *
+ * @return Number of keys found
+ * @retval < 0 Failure
+ */
+int odph_cuckoo_table_get_value_multi(odph_table_t table,
+				      void *key[], void *buffer[],
+				      uint32_t buffer_size,
+				      int hit[], int num);
+
 /**
  * Remove a value from a cuckoo table
  *
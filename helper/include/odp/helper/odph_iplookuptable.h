@@ -13,6 +13,10 @@
  * this table is IPv4 address (32 bits), and the value can be
  * defined by user. This table uses the 16,8,8 ip lookup (longest
  * prefix matching) algorithm.
+ *
+ * The IPv6 lookup table uses the same algorithm with 16,8,8,...,8
+ * levels. The key of the IPv6 table is an IPv6 address (128 bits)
+ * in network byte order.
  */
 
 #ifndef ODPH_IPLOOKUP_TABLE_H_
@@ -37,6 +41,14 @@ typedef struct {
 	uint8_t cidr; /**< CIDR value for prefix matching */
 } odph_iplookup_prefix_t;
 
+/**
+ * IPv6 Lookup Prefix
+ */
+typedef struct {
+	uint8_t ip[16]; /**< IPv6 address in network byte order */
+	uint8_t cidr;   /**< CIDR value for prefix matching */
+} odph_ip6lookup_prefix_t;
+
 /**
  * Create an IP lookup table
  *
@@ -100,6 +112,26 @@ int odph_iplookup_table_put_value(odph_table_t table, void *key, void *value);
 int odph_iplookup_table_get_value(odph_table_t table, void *key,
 				  void *buffer, uint32_t buffer_size);
 
+/**
+ * Retrieve values of multiple IPv4 addresses from an iplookup table
+ *
+ * Lookups of the addresses proceed level by level, so that the subtree
+ * accesses of different addresses overlap. Value of an address that
+ * matches only the default prefix is ODP_BUFFER_INVALID.
+ *
+ * @param table  Table from which values are to be retrieved
+ * @param key    Array of IPv4 address (uint32_t) addresses
+ * @param[out] buffer Array of buffer addresses to receive resulting values
+ * @param buffer_size Size of each supplied buffer
+ * @param num    Number of addresses
+ *
+ * @return Number of addresses that matched a prefix
+ * @retval < 0 Failure
+ */
+int odph_iplookup_table_get_value_multi(odph_table_t table, void *key[],
+					void *buffer[], uint32_t buffer_size,
+					int num);
+
 /**
  * Remove a value from an iplookup table
  *
@@ -114,6 +146,100 @@ int odph_iplookup_table_remove_value(odph_table_t table, void *key);
 
 extern odph_table_ops_t odph_iplookup_table_ops; /**< @internal */
 
+/**
+ * Create an IPv6 lookup table
+ *
+ * @param name Name of the table to be created
+ * @param ODP_IGNORED_1 Unused
+ * @param ODP_IGNORED_2 Unused
+ * @param value_size Byte size of each entry in the table
+ *
+ * @return Handle of the created IPv6 lookup table
+ * @retval NULL If table create failed
+ */
+odph_table_t odph_ip6lookup_table_create(const char *name,
+					 uint32_t ODP_IGNORED_1,
+					 uint32_t ODP_IGNORED_2,
+					 uint32_t value_size);
+
+/**
+ * Lookup an IPv6 lookup table by name
+ *
+ * @param name Name of the table to be located
+ *
+ * @return Handle of the located IPv6 lookup table
+ * @retval NULL No table matching supplied name found
+ */
+odph_table_t odph_ip6lookup_table_lookup(const char *name);
+
+/**
+ * Destroy an IPv6 lookup table
+ *
+ * @param table Handle of the IPv6 lookup table to be destroyed
+ *
+ * @retval 0 Success
+ * @retval < 0 Failure
+ */
+int odph_ip6lookup_table_destroy(odph_table_t table);
+
+/**
+ * Insert a key/value pair into an IPv6 lookup table
+ *
+ * @param table Table into which value is to be stored
+ * @param key   Address of an odph_ip6lookup_prefix_t to be used as key
+ * @param value Value to be associated with specified key
+ *
+ * @retval >= 0 Success
+ * @retval < 0  Failure
+ */
+int odph_ip6lookup_table_put_value(odph_table_t table, void *key,
+				   void *value);
+
+/**
+ * Retrieve a value from an IPv6 lookup table
+ *
+ * @param table Table from which value is to be retrieved
+ * @param key   Address of an IPv6 address (16 bytes) to be used as key
+ * @param[out] buffer Address of buffer to receive resulting value
+ * @param buffer_size Size of supplied buffer
+ *
+ * @retval 0 Success
+ * @retval < 0 Failure
+ */
+int odph_ip6lookup_table_get_value(odph_table_t table, void *key,
+				   void *buffer, uint32_t buffer_size);
+
+/**
+ * Retrieve values of multiple IPv6 addresses from an IPv6 lookup table
+ *
+ * @param table  Table from which values are to be retrieved
+ * @param key    Array of IPv6 address (16 bytes) addresses
+ * @param[out] buffer Array of buffer addresses to receive resulting values
+ * @param buffer_size Size of each supplied buffer
+ * @param num    Number of addresses
+ *
+ * @return Number of addresses that matched a prefix
+ * @retval < 0 Failure
+ *
+ * @see odph_iplookup_table_get_value_multi()
+ */
+int odph_ip6lookup_table_get_value_multi(odph_table_t table, void *key[],
+					 void *buffer[], uint32_t buffer_size,
+					 int num);
+
+/**
+ * Remove a value from an IPv6 lookup table
+ *
+ * @param table Table from which value is to be removed
+ * @param key   Address of odph_ip6lookup_prefix_t to be used as key
+ *
+ * @retval >= 0 Success
+ * @retval < 0  Failure
+ */
+int odph_ip6lookup_table_remove_value(odph_table_t table, void *key);
+
+extern odph_table_ops_t odph_ip6lookup_table_ops; /**< @internal */
+
 /**
  * @}
  */
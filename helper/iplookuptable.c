@@ -20,16 +20,26 @@
  *   to indicate this block is used by a ip lookup table
  */
 #define ODPH_IP_LOOKUP_TABLE_MAGIC_WORD 0xCFCFFCFC
+/** @magic word of an IPv6 lookup table */
+#define ODPH_IP6_LOOKUP_TABLE_MAGIC_WORD 0xCF6FF6FC
 
 /* The length(bit) of the IPv4 address */
 #define IP_LENGTH 32
+/* The length(bit) of the IPv6 address */
+#define IP6_LENGTH 128
 
 /* The number of L1 entries */
 #define ENTRY_NUM_L1		(1 << 16)
 /* The size of one L2\L3 subtree */
 #define ENTRY_NUM_SUBTREE	(1 << 8)
 
-#define WHICH_CHILD(ip, cidr) ((ip >> (IP_LENGTH - cidr)) & 0x00000001)
+/* Maximum number of addresses looked up at once by burst lookups */
+#define LOOKUP_BURST_MAX 32
+
+/* Bit number cidr (1 = most significant) of an address in network
+ * byte order */
+#define WHICH_CHILD(ip, cidr) \
+	((ip[((cidr) - 1) >> 3] >> (7 - (((cidr) - 1) & 7))) & 0x01)
 
 /** @internal entry struct
  *   Structure store an entry of the ip prefix table.
@@ -47,23 +57,18 @@ typedef struct {
 		odp_buffer_t nexthop;
 		void *ptr;
 	};
-	union {
-		uint8_t u8;
-		struct {
-#if ODP_BYTE_ORDER == ODP_BIG_ENDIAN
-			uint8_t child : 1;
-			uint8_t cidr  : 7;
-#else
-			uint8_t cidr  : 7;
-			uint8_t child : 1;
-#endif
-		};
-	};
+	/* IPv6 prefixes are up to 128 bits long, so cidr needs a full
+	 * byte. The entry is padded to pointer alignment anyway. */
+	uint8_t cidr;
+	uint8_t child;
 } prefix_entry_t;
 
 #define ENTRY_SIZE (sizeof(prefix_entry_t) + sizeof(odp_buffer_t))
 #define ENTRY_BUFF_ARR(x) ((odp_buffer_t *)(void *)((char *)x \
 			+ sizeof(prefix_entry_t) * ENTRY_NUM_SUBTREE))
+/* L1 stores the subtree buffers after all of its entries */
+#define L1_BUFF_ARR(x) ((odp_buffer_t *)(void *)((char *)x \
+			+ sizeof(prefix_entry_t) * ENTRY_NUM_L1))
 
 /** @internal trie node struct
  *  In this IP lookup algorithm, we use a
@@ -300,9 +305,10 @@ trie_destroy(odph_iplookup_table_impl *tbl, trie_node_t *trie)
 static int
 trie_insert_node(
 		odph_iplookup_table_impl *tbl, trie_node_t *root,
-		uint32_t ip, uint8_t cidr, odp_buffer_t nexthop)
+		const uint8_t *ip, uint8_t cidr, odp_buffer_t nexthop)
 {
-	uint8_t level = 0, child;
+	uint32_t level = 0;
+	uint8_t child;
 	odp_buffer_t buf;
 	trie_node_t *node = root, *prev = root;
 
@@ -339,7 +345,7 @@ trie_insert_node(
 static int
 trie_delete_node(
 		odph_iplookup_table_impl *tbl,
-		trie_node_t *root, uint32_t ip, uint8_t cidr)
+		trie_node_t *root, const uint8_t *ip, uint8_t cidr)
 {
 	if (root == NULL)
 		return -1;
@@ -349,7 +355,8 @@ trie_delete_node(
 		return -1;
 
 	trie_node_t *node = root, *prev = NULL;
-	uint8_t level = 1, child = 0;
+	uint32_t level = 1;
+	uint8_t child = 0;
 	odp_buffer_t tmp;
 
 	/* Find the target node. */
@@ -394,7 +401,7 @@ trie_delete_node(
 /* Detect the longest overlapping prefix. */
 static int
 trie_detect_overlap(
-		trie_node_t *trie, uint32_t ip, uint8_t cidr,
+		trie_node_t *trie, const uint8_t *ip, uint8_t cidr,
 		uint8_t leaf_push, uint8_t *over_cidr,
 		odp_buffer_t *over_nexthop)
 {
@@ -418,8 +425,9 @@ trie_detect_overlap(
  ***************   IP prefix lookup table   ****************
  ***********************************************************/
 
-odph_table_t
-odph_iplookup_table_lookup(const char *name)
+/* Find a table of the type indicated by the magic word */
+static odph_table_t
+iplookup_table_lookup(const char *name, uint32_t magicword)
 {
 	odph_iplookup_table_impl *tbl = NULL;
 	odp_shm_t shm;
@@ -433,17 +441,24 @@ odph_iplookup_table_lookup(const char *name)
 
 	if (
 		tbl != NULL &&
-		tbl->magicword == ODPH_IP_LOOKUP_TABLE_MAGIC_WORD &&
+		tbl->magicword == magicword &&
 		strcmp(tbl->name, name) == 0)
 		return (odph_table_t)tbl;
 
 	return NULL;
 }
 
-odph_table_t odph_iplookup_table_create(const char *name,
-					uint32_t p1 ODP_UNUSED,
-					uint32_t p2 ODP_UNUSED,
-					uint32_t value_size)
+odph_table_t
+odph_iplookup_table_lookup(const char *name)
+{
+	return iplookup_table_lookup(name, ODPH_IP_LOOKUP_TABLE_MAGIC_WORD);
+}
+
+/* Create a table of the type indicated by the magic word. Both IPv4 and
+ * IPv6 tables use a 16 bit L1 table followed by 8 bit subtrees. */
+static odph_table_t
+iplookup_table_create(const char *name, uint32_t value_size,
+		      uint32_t magicword)
 {
 	odph_iplookup_table_impl *tbl;
 	odp_shm_t shm_tbl;
@@ -460,7 +475,7 @@ odph_table_t odph_iplookup_table_create(const char *name,
 	}
 
 	/* Guarantee there's no existing */
-	tbl = (void *)odph_iplookup_table_lookup(name);
+	tbl = (void *)iplookup_table_lookup(name, magicword);
 	if (tbl != NULL) {
 		ODPH_DBG("IP prefix table %s already exists\n", name);
 		return NULL;
@@ -493,7 +508,7 @@ odph_table_t odph_iplookup_table_create(const char *name,
 
 	/* Setup table context. */
 	snprintf(tbl->name, sizeof(tbl->name), "%s", name);
-	tbl->magicword = ODPH_IP_LOOKUP_TABLE_MAGIC_WORD;
+	tbl->magicword = magicword;
 	tbl->nexthop_len = value_size;
 
 	/* Initialize cache */
@@ -522,6 +537,15 @@ odph_table_t odph_iplookup_table_create(const char *name,
 	return (odph_table_t)tbl;
 }
 
+odph_table_t odph_iplookup_table_create(const char *name,
+					uint32_t p1 ODP_UNUSED,
+					uint32_t p2 ODP_UNUSED,
+					uint32_t value_size)
+{
+	return iplookup_table_create(name, value_size,
+				     ODPH_IP_LOOKUP_TABLE_MAGIC_WORD);
+}
+
 int
 odph_iplookup_table_destroy(odph_table_t tbl)
 {
@@ -545,7 +569,7 @@ odph_iplookup_table_destroy(odph_table_t tbl)
 	trie_destroy(impl, impl->trie);
 
 	/* free all L2 and L3 entries */
-	buff1 = ENTRY_BUFF_ARR(impl->l1e);
+	buff1 = L1_BUFF_ARR(impl->l1e);
 	for (i = 0; i < ENTRY_NUM_L1; i++) {
 		if ((impl->l1e[i]).child == 0)
 			continue;
@@ -612,6 +636,42 @@ prefix_insert_into_lx(
 	return ret;
 }
 
+/* Get the child subtree of an entry. If the child is not existed,
+ * create a new subtree. Return NULL for error.
+ */
+static prefix_entry_t *
+prefix_get_subtree(
+		odph_iplookup_table_impl *tbl, prefix_entry_t *entry,
+		odp_buffer_t *buff)
+{
+	odp_buffer_t buf, push = entry->nexthop;
+	prefix_entry_t *ne = NULL;
+
+	/* If child subtree is existed, get it. */
+	if (entry->child)
+		return (prefix_entry_t *)entry->ptr;
+
+	buf = cache_get_buffer(tbl, CACHE_TYPE_SUBTREE);
+	if (buf == ODP_BUFFER_INVALID) {
+		ODPH_DBG("failed to get subtree buffer from cache.\n");
+		return NULL;
+	}
+	ne = (prefix_entry_t *)odp_buffer_addr(buf);
+
+	entry->child = 1;
+	entry->ptr = ne;
+	*buff = buf;
+
+	/* If this entry contains a nexthop and a small cidr,
+	 * push it to the next level.
+	 */
+	if (entry->cidr > 0)
+		(void)prefix_insert_into_lx(tbl, ne, entry->cidr,
+					    push, entry->cidr + 8);
+
+	return ne;
+}
+
 static int
 prefix_insert_iter(
 		odph_iplookup_table_impl *tbl, prefix_entry_t *entry,
@@ -622,33 +682,10 @@ prefix_insert_iter(
 	prefix_entry_t *ne = NULL;
 	odp_buffer_t *nbuff = NULL;
 
-	/* If child subtree is existed, get it. */
-	if (entry->child) {
-		ne = (prefix_entry_t *)entry->ptr;
-		nbuff = ENTRY_BUFF_ARR(ne);
-	} else {
-		/* If the child is not existed, create a new subtree. */
-		odp_buffer_t buf, push = entry->nexthop;
-
-		buf = cache_get_buffer(tbl, CACHE_TYPE_SUBTREE);
-		if (buf == ODP_BUFFER_INVALID) {
-			ODPH_DBG("failed to get subtree buffer from cache.\n");
-			return -1;
-		}
-		ne = (prefix_entry_t *)odp_buffer_addr(buf);
-		nbuff = ENTRY_BUFF_ARR(ne);
-
-		entry->child = 1;
-		entry->ptr = ne;
-		*buff = buf;
-
-		/* If this entry contains a nexthop and a small cidr,
-		 * push it to the next level.
-		 */
-		if (entry->cidr > 0)
-			(void)prefix_insert_into_lx(tbl, ne, entry->cidr,
-						    push, entry->cidr + 8);
-	}
+	ne = prefix_get_subtree(tbl, entry, buff);
+	if (ne == NULL)
+		return -1;
+	nbuff = ENTRY_BUFF_ARR(ne);
 
 	ne += (ip >> 24);
 	nbuff += (ip >> 24);
@@ -671,6 +708,7 @@ odph_iplookup_table_put_value(odph_table_t tbl, void *key, void *value)
 	odph_iplookup_prefix_t *prefix = (odph_iplookup_prefix_t *)key;
 	prefix_entry_t *l1e = NULL;
 	odp_buffer_t nexthop;
+	uint32_t be_ip;
 	int ret = 0;
 
 	if ((tbl == NULL) || (key == NULL) || (value == NULL))
@@ -681,11 +719,12 @@ odph_iplookup_table_put_value(odph_table_t tbl, void *key, void *value)
 	if (prefix->cidr == 0)
 		return -1;
 	prefix->ip = prefix->ip & (0xffffffff << (IP_LENGTH - prefix->cidr));
+	be_ip = odp_cpu_to_be_32(prefix->ip);
 
 	/* insert into trie */
 	ret = trie_insert_node(
 				impl, impl->trie,
-				prefix->ip, prefix->cidr, nexthop);
+				(uint8_t *)&be_ip, prefix->cidr, nexthop);
 
 	if (ret < 0) {
 		ODPH_DBG("failed to insert into trie\n");
@@ -694,7 +733,7 @@ odph_iplookup_table_put_value(odph_table_t tbl, void *key, void *value)
 
 	/* get L1 entry */
 	l1e = &impl->l1e[prefix->ip >> 16];
-	odp_buffer_t *buff = ENTRY_BUFF_ARR(impl->l1e) + (prefix->ip >> 16);
+	odp_buffer_t *buff = L1_BUFF_ARR(impl->l1e) + (prefix->ip >> 16);
 
 	if (prefix->cidr <= 16) {
 		ret = prefix_insert_into_lx(
@@ -736,18 +775,75 @@ int odph_iplookup_table_get_value(odph_table_t tbl, void *key,
 		ip <<= 8;
 	}
 
-	/* copy data */
-	if (entry->nexthop == ODP_BUFFER_INVALID) {
-		/* ONLY match the default prefix */
-		printf("only match the default prefix\n");
-		*buff = ODP_BUFFER_INVALID;
-	} else {
-		*buff = entry->nexthop;
-	}
+	/* copy data, ODP_BUFFER_INVALID when only the default prefix
+	 * matches */
+	*buff = entry->nexthop;
 
 	return 0;
 }
 
+/* Look up a burst of IPv4 addresses. All addresses walk down the
+ * tree level by level, so that the L2/L3 subtree accesses of different
+ * addresses overlap. */
+static inline int
+iplookup_burst(const odph_iplookup_table_impl *impl, void *key[],
+	       void *buffer[], int num)
+{
+	const prefix_entry_t *entry[LOOKUP_BURST_MAX];
+	uint32_t ip[LOOKUP_BURST_MAX];
+	int i, more, found = 0;
+
+	for (i = 0; i < num; i++) {
+		ip[i] = *((uint32_t *)key[i]);
+		entry[i] = &impl->l1e[ip[i] >> 16];
+		__builtin_prefetch(entry[i], 0, 3);
+		ip[i] <<= 16;
+	}
+
+	do {
+		more = 0;
+		for (i = 0; i < num; i++) {
+			if (!entry[i]->child)
+				continue;
+
+			entry[i] = (const prefix_entry_t *)entry[i]->ptr +
+				   (ip[i] >> 24);
+			__builtin_prefetch(entry[i], 0, 3);
+			ip[i] <<= 8;
+			more = 1;
+		}
+	} while (more);
+
+	for (i = 0; i < num; i++) {
+		*((odp_buffer_t *)buffer[i]) = entry[i]->nexthop;
+		found += entry[i]->nexthop != ODP_BUFFER_INVALID;
+	}
+
+	return found;
+}
+
+int odph_iplookup_table_get_value_multi(odph_table_t tbl, void *key[],
+					void *buffer[],
+					uint32_t buffer_size ODP_UNUSED,
+					int num)
+{
+	odph_iplookup_table_impl *impl = (void *)tbl;
+	int i, burst, found = 0;
+
+	if ((tbl == NULL) || (key == NULL) || (buffer == NULL) || (num < 0))
+		return -EINVAL;
+
+	for (i = 0; i < num; i += burst) {
+		burst = num - i;
+		if (burst > LOOKUP_BURST_MAX)
+			burst = LOOKUP_BURST_MAX;
+
+		found += iplookup_burst(impl, &key[i], &buffer[i], burst);
+	}
+
+	return found;
+}
+
 static int
 prefix_delete_lx(
 		odph_iplookup_table_impl *tbl, prefix_entry_t *l1e,
@@ -848,9 +944,10 @@ prefix_delete_iter(
 {
 	uint8_t ret = 0, over_cidr;
 	odp_buffer_t over_nexthop;
+	uint32_t be_ip = odp_cpu_to_be_32(ip);
 
 	trie_detect_overlap(
-			tbl->trie, ip, cidr + 8 * depth, level,
+			tbl->trie, (uint8_t *)&be_ip, cidr + 8 * depth, level,
 			&over_cidr, &over_nexthop);
 	if (cidr > 8) {
 		prefix_entry_t *ne =
@@ -890,7 +987,7 @@ odph_iplookup_table_remove_value(odph_table_t tbl, void *key)
 {
 	odph_iplookup_table_impl *impl = (void *)tbl;
 	odph_iplookup_prefix_t *prefix = (odph_iplookup_prefix_t *)key;
-	uint32_t ip;
+	uint32_t ip, be_ip;
 	uint8_t cidr;
 
 	if ((tbl == NULL) || (key == NULL))
@@ -898,17 +995,19 @@ odph_iplookup_table_remove_value(odph_table_t tbl, void *key)
 
 	ip   = prefix->ip;
 	cidr = prefix->cidr;
+	be_ip = odp_cpu_to_be_32(ip);
 
 	if (cidr == 0)
 		return -EINVAL;
 
 	prefix_entry_t *entry = &impl->l1e[ip >> 16];
-	odp_buffer_t *buff = ENTRY_BUFF_ARR(impl->l1e) + (ip >> 16);
+	odp_buffer_t *buff = L1_BUFF_ARR(impl->l1e) + (ip >> 16);
 	uint8_t over_cidr, ret;
 	odp_buffer_t over_nexthop;
 
 	trie_detect_overlap(
-			impl->trie, ip, cidr, 16, &over_cidr, &over_nexthop);
+			impl->trie, (uint8_t *)&be_ip, cidr, 16,
+			&over_cidr, &over_nexthop);
 
 	if (cidr <= 16) {
 		prefix_delete_lx(
@@ -935,7 +1034,7 @@ odph_iplookup_table_remove_value(odph_table_t tbl, void *key)
 		}
 	}
 
-	return trie_delete_node(impl, impl->trie, ip, cidr);
+	return trie_delete_node(impl, impl->trie, (uint8_t *)&be_ip, cidr);
 }
 
 odph_table_ops_t odph_iplookup_table_ops = {
@@ -946,3 +1045,305 @@ odph_table_ops_t odph_iplookup_table_ops = {
 	odph_iplookup_table_get_value,
 	odph_iplookup_table_remove_value
 };
+
+/***********************************************************
+ **************   IPv6 prefix lookup table   ***************
+ ***********************************************************/
+
+/* The number of bytes of the IPv6 address */
+#define IP6_ADDR_LEN (IP6_LENGTH / 8)
+
+/* Index of the L1 entry of an IPv6 address */
+#define IP6_L1_INDEX(ip) (((uint32_t)(ip)[0] << 8) | (ip)[1])
+
+/* Clear the bits of an IPv6 address beyond the prefix length */
+static void
+ip6_prefix_mask(uint8_t *dst, const uint8_t *ip, uint8_t cidr)
+{
+	int i;
+
+	for (i = 0; i < IP6_ADDR_LEN; i++) {
+		if (cidr >= 8)
+			dst[i] = ip[i];
+		else if (cidr > 0)
+			dst[i] = ip[i] & (uint8_t)(0xff << (8 - cidr));
+		else
+			dst[i] = 0;
+
+		cidr = cidr >= 8 ? cidr - 8 : 0;
+	}
+}
+
+/* Check if the prefix is stored in the trie */
+static int
+trie_find_node(trie_node_t *root, const uint8_t *ip, uint8_t cidr)
+{
+	trie_node_t *node = root;
+	uint32_t level;
+
+	for (level = 1; level <= cidr && node != NULL; level++)
+		node = WHICH_CHILD(ip, level) == 0 ? node->left : node->right;
+
+	return node != NULL && node->nexthop != ODP_BUFFER_INVALID;
+}
+
+/* Free all subtrees below the entries (recursively) */
+static void
+subtree_destroy(
+		odph_iplookup_table_impl *tbl, prefix_entry_t *entry,
+		uint32_t num)
+{
+	odp_buffer_t *buff = num == ENTRY_NUM_L1 ? L1_BUFF_ARR(entry) :
+			     ENTRY_BUFF_ARR(entry);
+	uint32_t i;
+
+	for (i = 0; i < num; i++) {
+		if (entry[i].child == 0)
+			continue;
+
+		subtree_destroy(tbl, (prefix_entry_t *)entry[i].ptr,
+				ENTRY_NUM_SUBTREE);
+		odp_queue_enq(tbl->free_slots[CACHE_TYPE_SUBTREE],
+			      odp_buffer_to_event(buff[i]));
+	}
+}
+
+odph_table_t
+odph_ip6lookup_table_lookup(const char *name)
+{
+	return iplookup_table_lookup(name, ODPH_IP6_LOOKUP_TABLE_MAGIC_WORD);
+}
+
+odph_table_t odph_ip6lookup_table_create(const char *name,
+					 uint32_t p1 ODP_UNUSED,
+					 uint32_t p2 ODP_UNUSED,
+					 uint32_t value_size)
+{
+	return iplookup_table_create(name, value_size,
+				     ODPH_IP6_LOOKUP_TABLE_MAGIC_WORD);
+}
+
+int
+odph_ip6lookup_table_destroy(odph_table_t tbl)
+{
+	odph_iplookup_table_impl *impl = (void *)tbl;
+
+	if (tbl == NULL)
+		return -1;
+
+	/* check magic word */
+	if (impl->magicword != ODPH_IP6_LOOKUP_TABLE_MAGIC_WORD) {
+		ODPH_DBG("wrong magicword for IPv6 prefix table\n");
+		return -1;
+	}
+
+	trie_destroy(impl, impl->trie);
+	subtree_destroy(impl, impl->l1e, ENTRY_NUM_L1);
+	cache_destroy(impl);
+
+	odp_shm_free(odp_shm_lookup(impl->name));
+	return 0;
+}
+
+int
+odph_ip6lookup_table_put_value(odph_table_t tbl, void *key, void *value)
+{
+	odph_iplookup_table_impl *impl = (void *)tbl;
+	odph_ip6lookup_prefix_t *prefix = (odph_ip6lookup_prefix_t *)key;
+	uint8_t ip[IP6_ADDR_LEN];
+	prefix_entry_t *entry;
+	odp_buffer_t *buff;
+	odp_buffer_t nexthop;
+	uint32_t level, byte;
+
+	if ((tbl == NULL) || (key == NULL) || (value == NULL))
+		return -1;
+
+	if (prefix->cidr == 0 || prefix->cidr > IP6_LENGTH)
+		return -1;
+
+	nexthop = *((odp_buffer_t *)value);
+	ip6_prefix_mask(ip, prefix->ip, prefix->cidr);
+
+	/* insert into trie */
+	if (trie_insert_node(impl, impl->trie, ip, prefix->cidr,
+			     nexthop) < 0) {
+		ODPH_DBG("failed to insert into trie\n");
+		return -1;
+	}
+
+	/* walk down to the level of the prefix, creating subtrees */
+	entry = &impl->l1e[IP6_L1_INDEX(ip)];
+	buff = L1_BUFF_ARR(impl->l1e) + IP6_L1_INDEX(ip);
+
+	for (level = 16, byte = 2; prefix->cidr > level; level += 8, byte++) {
+		prefix_entry_t *ne = prefix_get_subtree(impl, entry, buff);
+
+		if (ne == NULL)
+			return -1;
+
+		entry = ne + ip[byte];
+		buff = ENTRY_BUFF_ARR(ne) + ip[byte];
+	}
+
+	return prefix_insert_into_lx(impl, entry, prefix->cidr, nexthop,
+				     level);
+}
+
+int odph_ip6lookup_table_get_value(odph_table_t tbl, void *key,
+				   void *buffer,
+				   uint32_t buffer_size ODP_UNUSED)
+{
+	odph_iplookup_table_impl *impl = (void *)tbl;
+	const uint8_t *ip = key;
+	const prefix_entry_t *entry;
+	int byte = 2;
+
+	if ((tbl == NULL) || (key == NULL) || (buffer == NULL))
+		return -EINVAL;
+
+	entry = &impl->l1e[IP6_L1_INDEX(ip)];
+	while (entry->child)
+		entry = (const prefix_entry_t *)entry->ptr + ip[byte++];
+
+	/* ODP_BUFFER_INVALID when only the default prefix matches */
+	*((odp_buffer_t *)buffer) = entry->nexthop;
+
+	return 0;
+}
+
+/* Look up a burst of IPv6 addresses level by level, like
+ * iplookup_burst() */
+static inline int
+ip6lookup_burst(const odph_iplookup_table_impl *impl, void *key[],
+		void *buffer[], int num)
+{
+	const prefix_entry_t *entry[LOOKUP_BURST_MAX];
+	int i, byte, more, found = 0;
+
+	for (i = 0; i < num; i++) {
+		entry[i] = &impl->l1e[IP6_L1_INDEX((uint8_t *)key[i])];
+		__builtin_prefetch(entry[i], 0, 3);
+	}
+
+	byte = 2;
+	do {
+		more = 0;
+		for (i = 0; i < num; i++) {
+			if (!entry[i]->child)
+				continue;
+
+			entry[i] = (const prefix_entry_t *)entry[i]->ptr +
+				   ((uint8_t *)key[i])[byte];
+			__builtin_prefetch(entry[i], 0, 3);
+			more = 1;
+		}
+		byte++;
+	} while (more);
+
+	for (i = 0; i < num; i++) {
+		*((odp_buffer_t *)buffer[i]) = entry[i]->nexthop;
+		found += entry[i]->nexthop != ODP_BUFFER_INVALID;
+	}
+
+	return found;
+}
+
+int odph_ip6lookup_table_get_value_multi(odph_table_t tbl, void *key[],
+					 void *buffer[],
+					 uint32_t buffer_size ODP_UNUSED,
+					 int num)
+{
+	odph_iplookup_table_impl *impl = (void *)tbl;
+	int i, burst, found = 0;
+
+	if ((tbl == NULL) || (key == NULL) || (buffer == NULL) || (num < 0))
+		return -EINVAL;
+
+	for (i = 0; i < num; i += burst) {
+		burst = num - i;
+		if (burst > LOOKUP_BURST_MAX)
+			burst = LOOKUP_BURST_MAX;
+
+		found += ip6lookup_burst(impl, &key[i], &buffer[i], burst);
+	}
+
+	return found;
+}
+
+int
+odph_ip6lookup_table_remove_value(odph_table_t tbl, void *key)
+{
+	odph_iplookup_table_impl *impl = (void *)tbl;
+	odph_ip6lookup_prefix_t *prefix = (odph_ip6lookup_prefix_t *)key;
+	uint8_t ip[IP6_ADDR_LEN];
+	prefix_entry_t *entry[IP6_LENGTH / 8];
+	odp_buffer_t *buff[IP6_LENGTH / 8];
+	uint8_t over_cidr;
+	odp_buffer_t over_nexthop;
+	uint32_t level, byte;
+	int depth = 0;
+
+	if ((tbl == NULL) || (key == NULL))
+		return -EINVAL;
+
+	if (prefix->cidr == 0 || prefix->cidr > IP6_LENGTH)
+		return -EINVAL;
+
+	ip6_prefix_mask(ip, prefix->ip, prefix->cidr);
+
+	if (!trie_find_node(impl->trie, ip, prefix->cidr)) {
+		ODPH_DBG("IPv6 prefix is not existed\n");
+		return -1;
+	}
+
+	/* The longest shorter prefix replaces the removed one */
+	trie_detect_overlap(impl->trie, ip, prefix->cidr, prefix->cidr,
+			    &over_cidr, &over_nexthop);
+
+	/* walk down to the level of the prefix, remember the path */
+	entry[0] = &impl->l1e[IP6_L1_INDEX(ip)];
+	buff[0] = L1_BUFF_ARR(impl->l1e) + IP6_L1_INDEX(ip);
+
+	for (level = 16, byte = 2; prefix->cidr > level; level += 8, byte++) {
+		prefix_entry_t *ne = (prefix_entry_t *)entry[depth]->ptr;
+
+		if (!entry[depth]->child)
+			return -1;
+
+		depth++;
+		entry[depth] = ne + ip[byte];
+		buff[depth] = ENTRY_BUFF_ARR(ne) + ip[byte];
+	}
+
+	prefix_delete_lx(impl, entry[depth], buff[depth], prefix->cidr,
+			 over_cidr, over_nexthop, level);
+
+	/* Recycle subtrees along the path that became uniform */
+	for (depth--, level -= 8; depth >= 0; depth--, level -= 8) {
+		prefix_entry_t *e = entry[depth];
+		prefix_entry_t *ne = (prefix_entry_t *)e->ptr;
+
+		if (!can_recycle(e, level))
+			break;
+
+		e->cidr = ne->cidr;
+		e->nexthop = ne->nexthop;
+		cache_init_buffer(*buff[depth], CACHE_TYPE_SUBTREE,
+				  ENTRY_SIZE * ENTRY_NUM_SUBTREE);
+		odp_queue_enq(impl->free_slots[CACHE_TYPE_SUBTREE],
+			      odp_buffer_to_event(*buff[depth]));
+		e->child = 0;
+	}
+
+	return trie_delete_node(impl, impl->trie, ip, prefix->cidr);
+}
+
+odph_table_ops_t odph_ip6lookup_table_ops = {
+	odph_ip6lookup_table_create,
+	odph_ip6lookup_table_lookup,
+	odph_ip6lookup_table_destroy,
+	odph_ip6lookup_table_put_value,
+	odph_ip6lookup_table_get_value,
+	odph_ip6lookup_table_remove_value
+};
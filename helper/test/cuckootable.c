@@ -41,6 +41,7 @@
 
 #include <stdio.h>
 #include <stdint.h>
+#include <inttypes.h>
 #include <string.h>
 #include <stdlib.h>
 #include <stdarg.h>
@@ -393,7 +394,7 @@ static int test_five_keys(void)
 }
 
 #define BUCKET_ENTRIES 4
-#define HASH_ENTRIES_MAX 1048576
+#define HASH_ENTRIES_MAX (16 * 1024 * 1024)
 /*
  * Do tests for cuchoo tabke creation with bad parameters.
  */
@@ -429,58 +430,153 @@ static int test_creation_with_bad_parameters(void)
 	return 0;
 }
 
-#define PERFORMANCE_CAPACITY 1000000
-
 /*
- * Test the performance of cuckoo hash table.
- *   table capacity : 1,000,000
- *   key size : 4 bytes
- *   value size : 0
- * Insert at most number random keys into the table. If one
- * insertion is failed, the rest insertions will be cancelled.
- * The table utilization of the report will show actual number
- * of items inserted.
- * Then search all inserted items.
+ * Sequence of operations for bulk lookup of 5 keys
+ * key type : struct flow_key
+ * value type: uint32_t
+ *	- put 4 keys
+ *	- get_multi all 5 keys: 4 hits with right values, 1 miss
+ *	- get_multi with too small value buffers: failure
+ *	- get_multi all 5 keys without value buffers: 4 hits, 1 miss
+ *	- remove keys
+ *	- get_multi all 5 keys: miss
  */
-static int test_performance(int number)
+static int test_multi_lookup(void)
 {
 	odph_table_t table;
+	void *key_tbl[5];
+	void *val_tbl[5];
+	uint32_t val[5];
+	int hit[5];
+	uint32_t i;
+	int ret;
 
-	/* generate random keys */
-	uint8_t *key_space = NULL;
-	const void **key_ptr = NULL;
-	unsigned key_len = 4, j;
-	unsigned elem_num = (number > PERFORMANCE_CAPACITY) ?
-						PERFORMANCE_CAPACITY : number;
-	unsigned key_num = key_len * elem_num;
+	table = odph_cuckoo_table_create(
+			"multi_lookup", 10, sizeof(struct flow_key),
+			sizeof(uint32_t));
+	if (table == NULL) {
+		printf("failed to create table\n");
+		return -1;
+	}
 
-	key_space = (uint8_t *)malloc(key_num);
-	if (key_space == NULL)
-		return -ENOENT;
+	for (i = 0; i < 5; i++) {
+		key_tbl[i] = &keys[i];
+		val_tbl[i] = &val[i];
+	}
 
-	key_ptr = (const void **)malloc(sizeof(void *) * elem_num);
-	if (key_ptr == NULL) {
-		free(key_space);
-		return -ENOENT;
+	for (i = 0; i < 4; i++) {
+		uint32_t v = 100 + i;
+
+		if (odph_cuckoo_table_put_value(table, &keys[i], &v) < 0) {
+			printf("failed to add key %d\n", i);
+			odph_cuckoo_table_destroy(table);
+			return -1;
+		}
+	}
+
+	memset(val, 0, sizeof(val));
+	ret = odph_cuckoo_table_get_value_multi(table, key_tbl, val_tbl,
+						sizeof(uint32_t), hit, 5);
+	if (ret != 4) {
+		printf("get_multi found %d keys, expected 4\n", ret);
+		odph_cuckoo_table_destroy(table);
+		return -1;
+	}
+
+	for (i = 0; i < 5; i++) {
+		if ((i < 4 && (!hit[i] || val[i] != 100 + i)) ||
+		    (i == 4 && (hit[i] || val[i] != 0))) {
+			print_key_info("Bad lookup result", &keys[i]);
+			odph_cuckoo_table_destroy(table);
+			return -1;
+		}
+	}
+
+	/* Buffers smaller than the value are rejected */
+	ret = odph_cuckoo_table_get_value_multi(table, key_tbl, val_tbl,
+						sizeof(uint16_t), hit, 5);
+	if (ret >= 0) {
+		printf("get_multi accepted too small buffers\n");
+		odph_cuckoo_table_destroy(table);
+		return -1;
 	}
 
-	for (j = 0; j < key_num; j++) {
-		key_space[j] = rand() % 255;
-		if (j % key_len == 0)
-			key_ptr[j / key_len] = &key_space[j];
+	/* Hit results only */
+	memset(hit, 0, sizeof(hit));
+	ret = odph_cuckoo_table_get_value_multi(table, key_tbl, NULL,
+						sizeof(uint32_t), hit, 5);
+	if (ret != 4 || !hit[0] || !hit[3] || hit[4]) {
+		printf("get_multi without buffers found %d keys\n", ret);
+		odph_cuckoo_table_destroy(table);
+		return -1;
 	}
 
+	for (i = 0; i < 4; i++)
+		odph_cuckoo_table_remove_value(table, &keys[i]);
+
+	ret = odph_cuckoo_table_get_value_multi(table, key_tbl, val_tbl,
+						sizeof(uint32_t), hit, 5);
+	if (ret != 0) {
+		printf("get_multi found %d removed keys\n", ret);
+		odph_cuckoo_table_destroy(table);
+		return -1;
+	}
+
+	odph_cuckoo_table_destroy(table);
+	return 0;
+}
+
+#define PERFORMANCE_CAPACITY 1000000
+
+/* Keys per bulk lookup call */
+#define PERFORMANCE_BURST 32
+
+/*
+ * Test the performance of cuckoo hash table.
+ *   key size : 4 bytes
+ *   value size : 4 bytes
+ * Insert at most number unique keys into the table of the given
+ * capacity. If one insertion is failed, the rest insertions will be
+ * cancelled. The table utilization of the report will show actual
+ * number of items inserted.
+ * Then search all inserted items in random order, one by one and in
+ * bursts.
+ */
+static int test_performance(uint32_t capacity, uint32_t number)
+{
+	odph_table_t table;
+	uint32_t *key_space = NULL;
+	uint32_t *lookup = NULL;
+	void *key_ptr[PERFORMANCE_BURST];
+	void *val_ptr[PERFORMANCE_BURST];
+	uint32_t val[PERFORMANCE_BURST];
+	int hit[PERFORMANCE_BURST];
+	unsigned key_len = sizeof(uint32_t), j, k;
+	unsigned elem_num = (number > capacity) ? capacity : number;
 	unsigned num;
 	int ret = 0;
 	struct timeval start, end;
-	double add_time = 0;
+	double add_time, lkp_time, multi_time;
+
+	key_space = malloc(sizeof(uint32_t) * elem_num);
+	lookup = malloc(sizeof(uint32_t) * elem_num);
+	if (key_space == NULL || lookup == NULL) {
+		free(key_space);
+		free(lookup);
+		return -ENOENT;
+	}
+
+	/* Multiplication by an odd constant is a bijection, so keys are
+	 * unique and non-zero */
+	for (j = 0; j < elem_num; j++)
+		key_space[j] = (j + 1) * 2654435761u;
 
 	fflush(stdout);
 	table = odph_cuckoo_table_create(
-			"performance_test", PERFORMANCE_CAPACITY, key_len, 0);
+			"performance_test", capacity, key_len, sizeof(uint32_t));
 	if (table == NULL) {
 		printf("cuckoo table creation failed\n");
-		free(key_ptr);
+		free(lookup);
 		free(key_space);
 		return -ENOENT;
 	}
@@ -488,8 +584,7 @@ static int test_performance(int number)
 	/* insert (put) */
 	gettimeofday(&start, 0);
 	for (j = 0; j < elem_num; j++) {
-		ret = odph_cuckoo_table_put_value(
-				table, &key_space[j * key_len], NULL);
+		ret = odph_cuckoo_table_put_value(table, &key_space[j], &j);
 		if (ret < 0)
 			break;
 	}
@@ -498,29 +593,247 @@ static int test_performance(int number)
 	add_time = get_time_diff(&start, &end);
 	printf(
 		"add %u/%u (%.2f) items, time = %.9lfs\n",
-		num, PERFORMANCE_CAPACITY,
-		(double)num / PERFORMANCE_CAPACITY, add_time);
+		num, capacity, (double)num / capacity, add_time);
+
+	/* Look up in random order to defeat caches and prefetchers */
+	for (j = 0; j < num; j++)
+		lookup[j] = j;
+	for (j = num - 1; num && j > 0; j--) {
+		uint32_t tmp = lookup[j];
+
+		k = rand() % (j + 1);
+		lookup[j] = lookup[k];
+		lookup[k] = tmp;
+	}
 
 	/* search (get) */
+	ret = 0;
 	gettimeofday(&start, 0);
 	for (j = 0; j < num; j++) {
-		ret = odph_cuckoo_table_get_value(
-				table, &key_space[j * key_len], NULL, 0);
+		if (odph_cuckoo_table_get_value(table,
+						&key_space[lookup[j]],
+						&val[0], sizeof(val[0])) < 0 ||
+		    val[0] != lookup[j])
+			ret = -1;
+	}
+	gettimeofday(&end, 0);
+	lkp_time = get_time_diff(&start, &end);
+	if (ret < 0)
+		printf("lookup error\n");
 
-		if (ret < 0)
-			printf("lookup error\n");
+	/* search (get_multi) */
+	for (k = 0; k < PERFORMANCE_BURST; k++)
+		val_ptr[k] = &val[k];
+
+	gettimeofday(&start, 0);
+	for (j = 0; j < num; j += PERFORMANCE_BURST) {
+		int burst = num - j < PERFORMANCE_BURST ?
+			    num - j : PERFORMANCE_BURST;
+
+		for (k = 0; k < (unsigned)burst; k++)
+			key_ptr[k] = &key_space[lookup[j + k]];
+
+		if (odph_cuckoo_table_get_value_multi(table, key_ptr, val_ptr,
+						      sizeof(val[0]), hit,
+						      burst) != burst)
+			ret = -1;
+
+		for (k = 0; k < (unsigned)burst; k++)
+			if (val[k] != lookup[j + k])
+				ret = -1;
 	}
 	gettimeofday(&end, 0);
-	printf(
-			"lookup %u items, time = %.9lfs\n",
-			num, get_time_diff(&start, &end));
+	multi_time = get_time_diff(&start, &end);
+	if (ret < 0)
+		printf("bulk lookup error\n");
+
+	printf("lookup %u items, time = %.9lfs, %.1f ns/lookup\n",
+	       num, lkp_time, num ? lkp_time * 1e9 / num : 0.0);
+	printf("bulk lookup %u items, time = %.9lfs, %.1f ns/lookup\n",
+	       num, multi_time, num ? multi_time * 1e9 / num : 0.0);
 
 	odph_cuckoo_table_destroy(table);
-	free(key_ptr);
+	free(lookup);
 	free(key_space);
 	return ret;
 }
 
+#define CONCURRENT_CAPACITY 65536
+#define CONCURRENT_STABLE   40000
+#define CONCURRENT_CHURN    16000
+#define CONCURRENT_ROUNDS   20
+#define CONCURRENT_READERS  2
+
+static odp_instance_t test_instance;
+
+/* State shared by the concurrent test threads */
+static struct {
+	odph_table_t table;
+	odp_atomic_u32_t stop;
+	odp_atomic_u64_t lookups;
+	odp_atomic_u64_t errors;
+} concurrent;
+
+static inline uint32_t concurrent_key(uint32_t i)
+{
+	return (i + 1) * 2654435761u;
+}
+
+/*
+ * Reader thread: look up the stable keys with single and bulk lookups.
+ * Every stable key must be found with its own value at any time.
+ */
+static int concurrent_reader(void *arg ODP_UNUSED)
+{
+	uint32_t keys[PERFORMANCE_BURST];
+	uint32_t val[PERFORMANCE_BURST];
+	void *key_ptr[PERFORMANCE_BURST];
+	void *val_ptr[PERFORMANCE_BURST];
+	int hit[PERFORMANCE_BURST];
+	uint64_t lookups = 0, errors = 0;
+	uint32_t i, k;
+
+	for (k = 0; k < PERFORMANCE_BURST; k++) {
+		key_ptr[k] = &keys[k];
+		val_ptr[k] = &val[k];
+	}
+
+	while (!odp_atomic_load_u32(&concurrent.stop)) {
+		for (i = 0; i < CONCURRENT_STABLE; i++) {
+			keys[0] = concurrent_key(i);
+			if (odph_cuckoo_table_get_value(concurrent.table,
+							&keys[0], &val[0],
+							sizeof(uint32_t)) < 0 ||
+			    val[0] != i)
+				errors++;
+		}
+		lookups += CONCURRENT_STABLE;
+
+		for (i = 0; i + PERFORMANCE_BURST <= CONCURRENT_STABLE;
+		     i += PERFORMANCE_BURST) {
+			for (k = 0; k < PERFORMANCE_BURST; k++)
+				keys[k] = concurrent_key(i + k);
+
+			odph_cuckoo_table_get_value_multi(concurrent.table,
+							  key_ptr, val_ptr,
+							  sizeof(uint32_t),
+							  hit,
+							  PERFORMANCE_BURST);
+			for (k = 0; k < PERFORMANCE_BURST; k++)
+				if (!hit[k] || val[k] != i + k)
+					errors++;
+		}
+		lookups += i;
+	}
+
+	odp_atomic_add_u64(&concurrent.lookups, lookups);
+	odp_atomic_add_u64(&concurrent.errors, errors);
+	return 0;
+}
+
+/*
+ * Test lock-free lookups while the control thread inserts and deletes.
+ * Reader threads look up a stable set of keys, while this thread
+ * repeatedly inserts and removes another set of keys. The table is
+ * filled close to its capacity, so that inserts displace stable keys
+ * between their buckets.
+ */
+static int test_concurrent(void)
+{
+	odph_odpthread_t thread_tbl[CONCURRENT_READERS];
+	odph_odpthread_params_t thr_params;
+	odp_cpumask_t cpumask, thd_mask;
+	struct timeval start, end;
+	double churn_time;
+	uint32_t i, round, key, val;
+	uint64_t inserts = 0;
+	int cpu, ret = 0;
+
+	concurrent.table = odph_cuckoo_table_create("concurrent_test",
+						    CONCURRENT_CAPACITY,
+						    sizeof(uint32_t),
+						    sizeof(uint32_t));
+	if (concurrent.table == NULL) {
+		printf("cuckoo table creation failed\n");
+		return -1;
+	}
+
+	for (i = 0; i < CONCURRENT_STABLE; i++) {
+		key = concurrent_key(i);
+		if (odph_cuckoo_table_put_value(concurrent.table, &key,
+						&i) < 0) {
+			printf("stable key insert failed\n");
+			odph_cuckoo_table_destroy(concurrent.table);
+			return -1;
+		}
+	}
+
+	odp_atomic_init_u32(&concurrent.stop, 0);
+	odp_atomic_init_u64(&concurrent.lookups, 0);
+	odp_atomic_init_u64(&concurrent.errors, 0);
+
+	memset(thread_tbl, 0, sizeof(thread_tbl));
+	memset(&thr_params, 0, sizeof(thr_params));
+	thr_params.start    = concurrent_reader;
+	thr_params.arg      = NULL;
+	thr_params.thr_type = ODP_THREAD_WORKER;
+	thr_params.instance = test_instance;
+
+	odp_cpumask_default_worker(&cpumask, CONCURRENT_READERS);
+	cpu = odp_cpumask_first(&cpumask);
+	for (i = 0; i < CONCURRENT_READERS; i++) {
+		odp_cpumask_zero(&thd_mask);
+		odp_cpumask_set(&thd_mask, cpu);
+		odph_odpthreads_create(&thread_tbl[i], &thd_mask, &thr_params);
+
+		cpu = odp_cpumask_next(&cpumask, cpu);
+		if (cpu < 0)
+			cpu = odp_cpumask_first(&cpumask);
+	}
+
+	gettimeofday(&start, 0);
+	for (round = 0; round < CONCURRENT_ROUNDS; round++) {
+		for (i = 0; i < CONCURRENT_CHURN; i++) {
+			key = concurrent_key(CONCURRENT_STABLE + i);
+			val = CONCURRENT_STABLE + i;
+			if (odph_cuckoo_table_put_value(concurrent.table,
+							&key, &val) == 0)
+				inserts++;
+		}
+
+		for (i = 0; i < CONCURRENT_CHURN; i++) {
+			key = concurrent_key(CONCURRENT_STABLE + i);
+			odph_cuckoo_table_remove_value(concurrent.table, &key);
+		}
+	}
+	gettimeofday(&end, 0);
+	churn_time = get_time_diff(&start, &end);
+
+	odp_atomic_store_u32(&concurrent.stop, 1);
+	for (i = 0; i < CONCURRENT_READERS; i++)
+		odph_odpthreads_join(&thread_tbl[i]);
+
+	printf("concurrent: %u readers, %" PRIu64 " lookups, %" PRIu64
+	       " errors, %" PRIu64 " inserts in %.3fs\n", CONCURRENT_READERS,
+	       odp_atomic_load_u64(&concurrent.lookups),
+	       odp_atomic_load_u64(&concurrent.errors), inserts, churn_time);
+
+	if (odp_atomic_load_u64(&concurrent.errors))
+		ret = -1;
+
+	/* Stable keys must still be there */
+	for (i = 0; i < CONCURRENT_STABLE; i++) {
+		key = concurrent_key(i);
+		if (odph_cuckoo_table_get_value(concurrent.table, &key, &val,
+						sizeof(uint32_t)) < 0 ||
+		    val != i)
+			ret = -1;
+	}
+
+	odph_cuckoo_table_destroy(concurrent.table);
+	return ret;
+}
+
 /*
  * Do all unit and performance tests.
  */
@@ -535,15 +848,25 @@ test_cuckoo_hash_table(void)
 		return -1;
 	if (test_five_keys() < 0)
 		return -1;
+	if (test_multi_lookup() < 0)
+		return -1;
 	if (test_creation_with_bad_parameters() < 0)
 		return -1;
-	if (test_performance(950000) < 0)
+	if (test_concurrent() < 0)
+		return -1;
+	if (test_performance(PERFORMANCE_CAPACITY, 950000) < 0)
 		return -1;
 
 	return 0;
 }
 
-int main(int argc ODPH_UNUSED, char *argv[] ODPH_UNUSED)
+/*
+ * Without arguments all unit tests and the default performance test are
+ * run. Otherwise only performance tests are run, one per table capacity
+ * given as an argument, e.g. "cuckootable 1048576 16777216". Tables are
+ * filled to 90% of the capacity.
+ */
+int main(int argc, char *argv[])
 {
 	odp_instance_t instance;
 	int ret = 0;
@@ -554,6 +877,8 @@ int main(int argc ODPH_UNUSED, char *argv[] ODPH_UNUSED)
 		exit(EXIT_FAILURE);
 	}
 
+	test_instance = instance;
+
 	ret = odp_init_local(instance, ODP_THREAD_WORKER);
 	if (ret != 0) {
 		fprintf(stderr, "Error: ODP local init failed.\n");
@@ -561,7 +886,19 @@ int main(int argc ODPH_UNUSED, char *argv[] ODPH_UNUSED)
 	}
 
 	srand(time(0));
-	ret = test_cuckoo_hash_table();
+
+	if (argc > 1) {
+		int i;
+
+		for (i = 1; i < argc && ret == 0; i++) {
+			uint32_t capacity = strtoul(argv[i], NULL, 0);
+
+			ret = test_performance(capacity,
+					       (uint64_t)capacity * 9 / 10);
+		}
+	} else {
+		ret = test_cuckoo_hash_table();
+	}
 
 	if (ret < 0)
 		printf("cuckoo hash table test fail!!\n");
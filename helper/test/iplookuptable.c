@@ -8,6 +8,7 @@
 
 #include <stdio.h>
 #include <stdint.h>
+#include <inttypes.h>
 #include <string.h>
 #include <stdlib.h>
 #include <errno.h>
@@ -140,6 +141,174 @@ static int test_ip_lookup_table(void)
 	return 0;
 }
 
+#define NUM_MULTI_KEYS 6
+
+/*
+ * Burst lookups of IPv4 addresses hitting L1, L2, L3 and default
+ * prefixes must return the same values as single lookups.
+ */
+static int test_ip_lookup_multi(void)
+{
+	const char *prefix_str[] = {
+		"10.1.0.0", "10.1.2.0", "10.1.2.128", "192.168.0.0" };
+	const uint8_t prefix_cidr[] = { 16, 24, 25, 24 };
+	const char *lkp_str[NUM_MULTI_KEYS] = {
+		"10.1.3.1", "10.1.2.1", "10.1.2.200", "192.168.0.7",
+		"192.168.1.7", "11.0.0.1" };
+	const uint64_t expect[NUM_MULTI_KEYS] = { 1, 2, 3, 4, 0, 0 };
+	odph_iplookup_prefix_t prefix;
+	odph_table_t table;
+	uint32_t lkp_ip[NUM_MULTI_KEYS];
+	uint64_t result[NUM_MULTI_KEYS], single, value;
+	void *key[NUM_MULTI_KEYS], *buf[NUM_MULTI_KEYS];
+	int i, ret = 0;
+
+	table = odph_iplookup_table_create(
+			"prefix_multi_test", 0, 0, sizeof(uint32_t));
+	if (table == NULL) {
+		printf("IP prefix lookup table creation failed\n");
+		return -1;
+	}
+
+	for (i = 0; i < 4; i++) {
+		odph_ipv4_addr_parse(&prefix.ip, prefix_str[i]);
+		prefix.cidr = prefix_cidr[i];
+		value = i + 1;
+		if (odph_iplookup_table_put_value(table, &prefix,
+						  &value) < 0) {
+			printf("Failed to add ip prefix\n");
+			odph_iplookup_table_destroy(table);
+			return -1;
+		}
+	}
+
+	for (i = 0; i < NUM_MULTI_KEYS; i++) {
+		odph_ipv4_addr_parse(&lkp_ip[i], lkp_str[i]);
+		key[i] = &lkp_ip[i];
+		buf[i] = &result[i];
+	}
+
+	if (odph_iplookup_table_get_value_multi(table, key, buf, 0,
+						NUM_MULTI_KEYS) != 4)
+		ret = -1;
+
+	for (i = 0; i < NUM_MULTI_KEYS; i++) {
+		single = 0;
+		odph_iplookup_table_get_value(table, &lkp_ip[i], &single, 0);
+		if (result[i] != expect[i] || single != expect[i]) {
+			print_prefix_info("Wrong result for", lkp_ip[i], 32);
+			ret = -1;
+		}
+	}
+
+	odph_iplookup_table_destroy(table);
+	return ret;
+}
+
+/*
+ * IPv6 prefixes on L1, on a subtree and on the last level:
+ *	- put prefixes and get with single and burst lookups
+ *	- remove the middle prefix, addresses fall back to the short one
+ *	- remove the rest, only the default prefix is left
+ */
+static int test_ip6_lookup_table(void)
+{
+	static const uint8_t addr[NUM_MULTI_KEYS][16] = {
+		/* 2001:db8:0:1::5 */
+		{ 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 5 },
+		/* 2001:db8:0:1::6 */
+		{ 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 6 },
+		/* 2001:db8:0:2::1 */
+		{ 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 1 },
+		/* 2001:db9::1 */
+		{ 0x20, 0x01, 0x0d, 0xb9, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1 },
+		/* 2001:8db8::1 */
+		{ 0x20, 0x01, 0x8d, 0xb8, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1 },
+		/* fe80::1 */
+		{ 0xfe, 0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1 }
+	};
+	static const uint8_t prefix_cidr[] = { 128, 64, 32, 16 };
+	static const uint64_t prefix_value[] = { 3, 2, 1, 4 };
+	static const uint64_t expect[3][NUM_MULTI_KEYS] = {
+		{ 3, 2, 1, 4, 4, 0 },	/* all prefixes */
+		{ 3, 1, 1, 4, 4, 0 },	/* /64 removed */
+		{ 0, 0, 0, 0, 0, 0 }	/* all removed */
+	};
+	odph_ip6lookup_prefix_t prefix[4];
+	odph_table_t table;
+	uint64_t result[NUM_MULTI_KEYS], single, value;
+	void *key[NUM_MULTI_KEYS], *buf[NUM_MULTI_KEYS];
+	int i, step, ret = 0;
+
+	table = odph_ip6lookup_table_create(
+			"prefix6_test", 0, 0, sizeof(uint32_t));
+	if (table == NULL) {
+		printf("IPv6 prefix lookup table creation failed\n");
+		return -1;
+	}
+
+	/* 2001:db8:0:1::5/128, 2001:db8:0:1::/64, 2001:db8::/32 and
+	 * 2001::/16 */
+	for (i = 0; i < 4; i++) {
+		memcpy(prefix[i].ip, addr[0], 16);
+		prefix[i].cidr = prefix_cidr[i];
+		value = prefix_value[i];
+		if (odph_ip6lookup_table_put_value(table, &prefix[i],
+						   &value) < 0) {
+			printf("Failed to add IPv6 prefix\n");
+			odph_ip6lookup_table_destroy(table);
+			return -1;
+		}
+	}
+
+	for (i = 0; i < NUM_MULTI_KEYS; i++) {
+		key[i] = (void *)(uintptr_t)addr[i];
+		buf[i] = &result[i];
+	}
+
+	for (step = 0; step < 3 && ret == 0; step++) {
+		if (step == 1 &&
+		    odph_ip6lookup_table_remove_value(table, &prefix[1]) < 0)
+			ret = -1;
+
+		if (step == 2) {
+			for (i = 0; i < 4; i++) {
+				if (i == 1)
+					continue;
+				if (odph_ip6lookup_table_remove_value(
+						table, &prefix[i]) < 0)
+					ret = -1;
+			}
+		}
+
+		odph_ip6lookup_table_get_value_multi(table, key, buf, 0,
+						     NUM_MULTI_KEYS);
+
+		for (i = 0; i < NUM_MULTI_KEYS; i++) {
+			single = odp_buffer_to_u64(ODP_BUFFER_INVALID);
+			odph_ip6lookup_table_get_value(table, key[i],
+						       &single, 0);
+			if (result[i] != expect[step][i] ||
+			    single != expect[step][i]) {
+				printf("Wrong IPv6 result %d at step %d: "
+				       "%" PRIu64 " %" PRIu64 "\n",
+				       i, step, result[i], single);
+				ret = -1;
+			}
+		}
+	}
+
+	/* Removed prefix cannot be removed again */
+	if (ret == 0 &&
+	    odph_ip6lookup_table_remove_value(table, &prefix[1]) >= 0) {
+		printf("Removed IPv6 prefix was found\n");
+		ret = -1;
+	}
+
+	odph_ip6lookup_table_destroy(table);
+	return ret;
+}
+
 int main(int argc ODPH_UNUSED, char *argv[] ODPH_UNUSED)
 {
 	odp_instance_t instance;
@@ -157,10 +326,14 @@ int main(int argc ODPH_UNUSED, char *argv[] ODPH_UNUSED)
 		exit(EXIT_FAILURE);
 	}
 
-	if (test_ip_lookup_table() < 0)
+	if (test_ip_lookup_table() < 0 ||
+	    test_ip_lookup_multi() < 0 ||
+	    test_ip6_lookup_table() < 0) {
 		printf("Test failed\n");
-	else
+		ret = -1;
+	} else {
 		printf("All tests passed\n");
+	}
 
 	if (odp_term_local()) {
 		fprintf(stderr, "Error: ODP local term failed.\n");
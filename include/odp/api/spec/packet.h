@@ -51,6 +51,16 @@ extern "C" {
  * Invalid packet segment
  */
 
+/**
+ * @typedef odp_packet_vector_t
+ * ODP packet vector
+ */
+
+/**
+ * @def ODP_PACKET_VECTOR_INVALID
+ * Invalid packet vector
+ */
+
  /**
   * @typedef odp_packet_color_t
   * Color of packet for shaper/drop processing
@@ -83,6 +93,59 @@ typedef struct odp_packet_data_range {
 
 } odp_packet_data_range_t;
 
+/**
+ * Protocol
+ */
+typedef enum odp_proto_t {
+	/** No protocol defined */
+	ODP_PROTO_NONE = 0,
+
+	/** Ethernet (including VLAN) */
+	ODP_PROTO_ETH,
+
+	/** IP version 4 */
+	ODP_PROTO_IPV4,
+
+	/** IP version 6 */
+	ODP_PROTO_IPV6
+
+} odp_proto_t;
+
+/**
+ * Protocol layer
+ */
+typedef enum odp_proto_layer_t {
+	/** No layers */
+	ODP_PROTO_LAYER_NONE = 0,
+
+	/** Layer L2 protocols (Ethernet, VLAN, etc) */
+	ODP_PROTO_LAYER_L2,
+
+	/** Layer L3 protocols (IPv4, IPv6, ICMP, IPsec, etc) */
+	ODP_PROTO_LAYER_L3,
+
+	/** Layer L4 protocols (UDP, TCP, SCTP) */
+	ODP_PROTO_LAYER_L4,
+
+	/** All layers */
+	ODP_PROTO_LAYER_ALL
+
+} odp_proto_layer_t;
+
+/**
+ * Packet parse parameters
+ */
+typedef struct odp_packet_parse_param_t {
+	/** Protocol header at parse starting point. Valid values for this
+	 *  field are: ODP_PROTO_ETH, ODP_PROTO_IPV4, ODP_PROTO_IPV6. */
+	odp_proto_t proto;
+
+	/** Continue parsing until this layer. Must be the same or higher
+	 *  layer than the layer of 'proto'. */
+	odp_proto_layer_t last_layer;
+
+} odp_packet_parse_param_t;
+
 /*
  *
  * Alloc and free
@@ -923,6 +986,31 @@ odp_packet_t odp_packet_ref_static(odp_packet_t pkt);
  */
 odp_packet_t odp_packet_ref(odp_packet_t pkt, uint32_t offset);
 
+/**
+ * Create multiple references to a packet
+ *
+ * Otherwise like odp_packet_ref(), but creates and outputs multiple
+ * references to the same packet with a single call. All references share the
+ * packet data starting from the same byte offset. This is more efficient than
+ * calling odp_packet_ref() multiple times, e.g., when replicating a packet to
+ * multiple destinations.
+ *
+ * Packet is not modified on failure.
+ *
+ * @param      pkt    Handle of the packet for which references are to be
+ *                    created.
+ * @param      offset Byte offset in the packet at which the shared part is to
+ *                    begin. This must be in the range
+ *                    0 ... odp_packet_len(pkt)-1.
+ * @param[out] ref    Array of reference handles for output
+ * @param      num    Maximum number of references to create
+ *
+ * @return Number of references actually created (1 ... num)
+ * @retval <0 on failure
+ */
+int odp_packet_ref_multi(odp_packet_t pkt, uint32_t offset,
+			 odp_packet_t ref[], int num);
+
 /**
  * Create a reference to a packet with a header packet
  *
@@ -962,13 +1050,13 @@ odp_packet_t odp_packet_ref_pkt(odp_packet_t pkt, uint32_t offset,
  * of a static reference it also shares metadata. Shared parts must be treated
  * as read only.
  *
- * New references are created with odp_packet_ref_static(), odp_packet_ref() and
- * odp_packet_ref_pkt() calls. The intent of multiple references is to avoid
- * packet copies, however some implementations may do a packet copy for some of
- * the calls. If a copy is done, the new reference is actually a new, unique
- * packet and this function returns '0' for it. When a real reference is
- * created (instead of a copy), this function returns '1' for both packets
- * (the original packet and the new reference).
+ * New references are created with odp_packet_ref_static(), odp_packet_ref(),
+ * odp_packet_ref_multi() and odp_packet_ref_pkt() calls. The intent of
+ * multiple references is to avoid packet copies, however some implementations
+ * may do a packet copy for some of the calls. If a copy is done, the new
+ * reference is actually a new, unique packet and this function returns '0' for
+ * it. When a real reference is created (instead of a copy), this function
+ * returns '1' for both packets (the original packet and the new reference).
  *
  * @param pkt Packet handle
  *
@@ -1116,6 +1204,26 @@ int odp_packet_copy_data(odp_packet_t pkt, uint32_t dst_offset,
 int odp_packet_move_data(odp_packet_t pkt, uint32_t dst_offset,
 			 uint32_t src_offset, uint32_t len);
 
+/**
+ * Compare packet data to memory
+ *
+ * Compare 'len' bytes of packet data starting from 'offset' to the data at
+ * the source address, without copying packet data out. Packet data may be
+ * segmented. The compared area (offset ... offset + len) must not exceed
+ * packet data length.
+ *
+ * @param pkt    Packet handle
+ * @param offset Byte offset into the packet
+ * @param src    Source address
+ * @param len    Number of bytes to compare
+ *
+ * @retval 0 Packet data and memory are equal
+ * @retval <0 Packet data is less than memory (as memcmp())
+ * @retval >0 Packet data is greater than memory (as memcmp())
+ */
+int odp_packet_cmp_mem(odp_packet_t pkt, uint32_t offset, const void *src,
+		       uint32_t len);
+
 /*
  *
  * Meta-data
@@ -1358,6 +1466,53 @@ uint32_t odp_packet_l4_offset(odp_packet_t pkt);
  */
 int odp_packet_l4_offset_set(odp_packet_t pkt, uint32_t offset);
 
+/**
+ * Parse packet
+ *
+ * Parse protocol headers in packet data and update layer/protocol specific
+ * metadata (e.g. offsets, errors, protocols, etc). Parsing starts at 'offset',
+ * which is the first header byte of protocol 'param.proto'. Parameter
+ * 'param.last_layer' defines the last layer application requests to check.
+ * Use ODP_PROTO_LAYER_ALL for all layers. A successful operation sets or
+ * resets packet metadata for all layers from the layer of 'param.proto' to
+ * the application defined last layer. Metadata of other layers have
+ * undefined values. When operation fails, metadata of all layers have
+ * undefined values.
+ *
+ * @param pkt     Packet handle
+ * @param offset  Byte offset into the packet
+ * @param param   Parse parameters. Proto and last_layer fields must be set.
+ *
+ * @retval 0 on success
+ * @retval <0 on failure
+ *
+ * @see odp_packet_parse_multi()
+ */
+int odp_packet_parse(odp_packet_t pkt, uint32_t offset,
+		     const odp_packet_parse_param_t *param);
+
+/**
+ * Parse multiple packets
+ *
+ * Otherwise like odp_packet_parse(), but parses multiple packets. Packets may
+ * have unique offsets, but must start with the same protocol. The same
+ * parse parameters are applied to all packets. Packets are parsed in array
+ * order and the operation stops at the first packet which fails. Parsing
+ * multiple packets at once may be faster than parsing them one by one.
+ *
+ * @param pkt     Packet handle array
+ * @param offset  Byte offsets into the packets
+ * @param num     Number of packets and offsets
+ * @param param   Parse parameters. Proto and last_layer fields must be set.
+ *
+ * @return Number of packets parsed successfully (0 ... num)
+ * @retval <0 on failure
+ *
+ * @see odp_packet_parse()
+ */
+int odp_packet_parse_multi(const odp_packet_t pkt[], const uint32_t offset[],
+			   int num, const odp_packet_parse_param_t *param);
+
 /**
  * Packet flow hash value
  *
@@ -1475,6 +1630,126 @@ int8_t odp_packet_shaper_len_adjust(odp_packet_t pkt);
  */
 void odp_packet_shaper_len_adjust_set(odp_packet_t pkt, int8_t adj);
 
+/*
+ *
+ * Packet vectors
+ * ********************************************************
+ *
+ */
+
+/**
+ * Get packet vector handle from event
+ *
+ * Converts an ODP_EVENT_PACKET_VECTOR type event to a packet vector.
+ *
+ * @param ev   Event handle
+ *
+ * @return Packet vector handle
+ *
+ * @see odp_event_type()
+ */
+odp_packet_vector_t odp_packet_vector_from_event(odp_event_t ev);
+
+/**
+ * Convert packet vector handle to event
+ *
+ * @param pktv  Packet vector handle
+ *
+ * @return Event handle
+ */
+odp_event_t odp_packet_vector_to_event(odp_packet_vector_t pktv);
+
+/**
+ * Allocate a packet vector from a packet vector pool
+ *
+ * Allocates an empty packet vector from the specified pool. The pool must
+ * have been created with the ODP_POOL_VECTOR type.
+ *
+ * @param pool  Packet vector pool handle
+ *
+ * @return Handle of allocated packet vector
+ * @retval ODP_PACKET_VECTOR_INVALID  Packet vector could not be allocated
+ */
+odp_packet_vector_t odp_packet_vector_alloc(odp_pool_t pool);
+
+/**
+ * Free packet vector
+ *
+ * Frees the packet vector into the pool it was allocated from. Packets in
+ * the vector are not freed. Use odp_event_free() to free both the vector and
+ * its packets.
+ *
+ * @param pktv  Packet vector handle
+ */
+void odp_packet_vector_free(odp_packet_vector_t pktv);
+
+/**
+ * Packet vector table
+ *
+ * Outputs a pointer to the packet handle table of the vector. The table has
+ * room for pool parameter vector.max_size packets, of which the first
+ * odp_packet_vector_size() entries are valid. Application may modify the
+ * table and update the size with odp_packet_vector_size_set().
+ *
+ * @param      pktv     Packet vector handle
+ * @param[out] pkt_tbl  Pointer to the packet handle table for output
+ *
+ * @return Number of packets in the vector
+ */
+uint32_t odp_packet_vector_tbl(odp_packet_vector_t pktv,
+			       odp_packet_t **pkt_tbl);
+
+/**
+ * Number of packets in a vector
+ *
+ * @param pktv  Packet vector handle
+ *
+ * @return Number of packets in the vector
+ */
+uint32_t odp_packet_vector_size(odp_packet_vector_t pktv);
+
+/**
+ * Set the number of packets in a vector
+ *
+ * The size must not exceed pool parameter vector.max_size.
+ *
+ * @param pktv  Packet vector handle
+ * @param size  Number of packets in the vector
+ */
+void odp_packet_vector_size_set(odp_packet_vector_t pktv, uint32_t size);
+
+/**
+ * Packet vector pool
+ *
+ * @param pktv  Packet vector handle
+ *
+ * @return Handle of the pool the vector was allocated from
+ */
+odp_pool_t odp_packet_vector_pool(odp_packet_vector_t pktv);
+
+/**
+ * Check that packet vector is valid
+ *
+ * @param pktv  Packet vector handle
+ *
+ * @retval 0 Packet vector is not valid
+ * @retval 1 Packet vector is valid
+ */
+int odp_packet_vector_valid(odp_packet_vector_t pktv);
+
+/**
+ * Get printable value for an odp_packet_vector_t
+ *
+ * @param hdl  odp_packet_vector_t handle to be printed
+ * @return     uint64_t value that can be used to print/display this
+ *             handle
+ *
+ * @note This routine is intended to be used for diagnostic purposes
+ * to enable applications to generate a printable value that represents
+ * an odp_packet_vector_t handle.
+ */
+uint64_t odp_packet_vector_to_u64(odp_packet_vector_t hdl);
+
 /*
  *
  * Debugging
@@ -152,6 +152,38 @@ typedef enum odp_pktio_op_mode_t {
 
 } odp_pktio_op_mode_t;
 
+/**
+ * Packet input vector configuration
+ *
+ * Packet input aggregates received packets into packet vector events
+ * (ODP_EVENT_PACKET_VECTOR) when vectors are enabled. A vector carries
+ * packets of a single input burst which are destined to the same event
+ * queue. Packet order is maintained within and between vectors of a queue.
+ * Vectors are formed only in ODP_PKTIN_MODE_QUEUE and ODP_PKTIN_MODE_SCHED
+ * modes.
+ */
+typedef struct odp_pktin_vector_config_t {
+	/** Enable packet vectors
+	  *
+	  * * 0: Packets are delivered as packet events (default)
+	  * * 1: Packets are delivered in packet vector events */
+	odp_bool_t enable;
+
+	/** Packet vector pool
+	  *
+	  * Pool of type ODP_POOL_VECTOR from which vectors are allocated.
+	  * Packets are delivered as packet events when a vector cannot be
+	  * allocated. */
+	odp_pool_t pool;
+
+	/** Maximum number of packets in a vector
+	  *
+	  * The value must be between pktio capability vector.min_size and
+	  * vector.max_size, and not larger than vector.max_size of the pool. */
+	uint32_t max_size;
+
+} odp_pktin_vector_config_t;
+
 /**
  * Packet input queue parameters
  */
@@ -207,6 +239,11 @@ typedef struct odp_pktin_queue_param_t {
 	  * value is ignored. */
 	odp_queue_param_t queue_param;
 
+	/** Packet vector configuration
+	  *
+	  * Packet vectors are disabled by default. */
+	odp_pktin_vector_config_t vector;
+
 } odp_pktin_queue_param_t;
 
 /**
@@ -299,6 +336,16 @@ typedef union odp_pktin_config_opt_t {
 		/** Drop packets with a SCTP error on packet input */
 		uint64_t drop_sctp_err : 1;
 
+		/** Zero-copy packet input
+		  *
+		  * Received packets may be passed to the application in place,
+		  * in memory owned by the sender (e.g. another ODP instance).
+		  * odp_packet_pool() returns the pool of the pktio also for
+		  * those packets. Packet manipulation calls which need more
+		  * memory (e.g. odp_packet_extend_tail()) may copy the packet
+		  * into a new packet from that pool. */
+		uint64_t zero_copy     : 1;
+
 	} bit;
 
 	/** All bits of the bit field structure
@@ -446,6 +493,18 @@ typedef struct odp_pktio_capability_t {
 	 * set to zero. */
 	odp_pktio_set_op_t set_op;
 
+	/** Packet input vector capabilities */
+	struct {
+		/** Packet vectors are supported */
+		odp_bool_t supported;
+
+		/** Minimum value of vector 'max_size' configuration */
+		uint32_t min_size;
+
+		/** Maximum value of vector 'max_size' configuration */
+		uint32_t max_size;
+	} vector;
+
 	/** @deprecated Use enable_loop inside odp_pktin_config_t */
 	odp_bool_t ODP_DEPRECATE(loop_supported);
 } odp_pktio_capability_t;
@@ -41,6 +41,9 @@ extern "C" {
  * Maximum pool name length in chars including null char
  */
 
+/** Maximum number of packet pool subparameter sets */
+#define ODP_POOL_MAX_SUBPARAMS 7
+
 /**
  * Pool capabilities
  */
@@ -127,6 +130,13 @@ typedef struct odp_pool_capability_t {
 		 * The value of zero means that limited only by the available
 		 * memory size for the pool. */
 		uint32_t max_uarea_size;
+
+		/** Maximum number of subparameter sets
+		 *
+		 * Maximum value of 'num_subparam' in packet pool parameters.
+		 * The value of zero means that packet pools support only a
+		 * single buffer size class. */
+		uint8_t max_num_subparam;
 	} pkt;
 
 	/** Timeout pool capabilities  */
@@ -141,6 +151,21 @@ typedef struct odp_pool_capability_t {
 		uint32_t max_num;
 	} tmo;
 
+	/** Packet vector pool capabilities */
+	struct {
+		/** Maximum number of packet vector pools */
+		unsigned max_pools;
+
+		/** Maximum number of packet vectors in a pool
+		 *
+		 * The value of zero means that limited only by the available
+		 * memory size for the pool. */
+		uint32_t max_num;
+
+		/** Maximum number of packets in a vector */
+		uint32_t max_size;
+	} vector;
+
 } odp_pool_capability_t;
 
 /**
@@ -214,6 +239,29 @@ typedef struct odp_pool_param_t {
 			    defined by pool capability pkt.max_uarea_size.
 			    Specify as 0 if no user area is needed. */
 			uint32_t uarea_size;
+
+			/** Number of subparameter sets in 'sub' table. A
+			    packet pool has a buffer size class for 'num' and
+			    'len', and an additional class for each subparameter
+			    set. Packet allocation and packet input select the
+			    smallest class which stores the packet in a single
+			    segment. Only packets longer than the largest class
+			    are segmented. Packets of all classes belong to this
+			    pool. The maximum value is defined by pool capability
+			    pkt.max_num_subparam. Use 0 for a single class. */
+			uint8_t num_subparam;
+
+			/** Subparameter sets of additional buffer size classes.
+			    Lengths must be larger than 'len' and in increasing
+			    order. */
+			struct {
+				/** Number of packets in the class */
+				uint32_t num;
+
+				/** Maximum packet length that the class stores
+				    in a single segment */
+				uint32_t len;
+			} sub[ODP_POOL_MAX_SUBPARAMS];
 		} pkt;
 
 		/** Parameters for timeout pools */
@@ -221,6 +269,19 @@ typedef struct odp_pool_param_t {
 			/** Number of timeouts in the pool */
 			uint32_t num;
 		} tmo;
+
+		/** Parameters for packet vector pools */
+		struct {
+			/** Number of packet vectors in the pool. The maximum
+			    value is defined by pool capability
+			    vector.max_num. */
+			uint32_t num;
+
+			/** Maximum number of packets that a vector may
+			    carry. The maximum value is defined by pool
+			    capability vector.max_size. */
+			uint32_t max_size;
+		} vector;
 	};
 } odp_pool_param_t;
 
@@ -230,6 +291,8 @@ typedef struct odp_pool_param_t {
 #define ODP_POOL_BUFFER       ODP_EVENT_BUFFER
 /** Timeout pool */
 #define ODP_POOL_TIMEOUT      ODP_EVENT_TIMEOUT
+/** Packet vector pool */
+#define ODP_POOL_VECTOR       ODP_EVENT_PACKET_VECTOR
 
 /**
  * Create a pool
@@ -273,6 +336,9 @@ int odp_pool_destroy(odp_pool_t pool);
  */
 odp_pool_t odp_pool_lookup(const char *name);
 
+/** Maximum number of NUMA nodes reported in pool information */
+#define ODP_POOL_NUMA_NODES_MAX 8
+
 /**
  * Pool information struct
  * Used to get information about a pool.
@@ -280,6 +346,23 @@ odp_pool_t odp_pool_lookup(const char *name);
 typedef struct odp_pool_info_t {
 	const char *name;          /**< pool name */
 	odp_pool_param_t params;   /**< pool parameters */
+
+	/** Number of NUMA nodes the pool memory is split between
+	  *
+	  * One when the pool is not NUMA aware. */
+	uint32_t num_node;
+
+	/** Number of buffers on each NUMA node
+	  *
+	  * The first 'num_node' entries are valid. Entries are in the same
+	  * order as in 'node_id'. */
+	uint32_t node_num[ODP_POOL_NUMA_NODES_MAX];
+
+	/** NUMA node id of each 'node_num' entry
+	  *
+	  * Node ids may not be consecutive. The first 'num_node' entries
+	  * are valid. */
+	uint32_t node_id[ODP_POOL_NUMA_NODES_MAX];
 } odp_pool_info_t;
 
 /**
@@ -367,6 +367,38 @@ void odp_schedule_order_lock(unsigned lock_index);
  */
 void odp_schedule_order_unlock(unsigned lock_index);
 
+/**
+ * Read scheduler statistics
+ *
+ * Outputs scheduler statistics summed over all threads. Statistics
+ * collection is an optional, build time feature of the implementation.
+ *
+ * @param[out] stats    Pointer to statistics struct for output
+ *
+ * @retval  0 On success
+ * @retval <0 On failure, e.g. statistics are not supported
+ */
+int odp_schedule_stats(odp_schedule_stats_t *stats);
+
+/**
+ * Read scheduler statistics of a thread
+ *
+ * @param      thr      Thread ID
+ * @param[out] stats    Pointer to statistics struct for output
+ *
+ * @retval  0 On success
+ * @retval <0 On failure, e.g. statistics are not supported
+ */
+int odp_schedule_thr_stats(int thr, odp_schedule_stats_t *stats);
+
+/**
+ * Print scheduler statistics
+ *
+ * Print implementation defined scheduler statistics to the ODP log.
+ * The information is intended to be used for debugging.
+ */
+void odp_schedule_stats_print(void);
+
 /**
  * @}
  */
@@ -147,8 +147,90 @@ typedef	struct odp_schedule_param_t {
 	  *
 	  * Default value is 0. */
 	unsigned lock_count;
+
+	/** Scheduling burst size
+	  *
+	  * Maximum number of events the scheduler dequeues from this queue
+	  * at a time. Smaller bursts improve load balancing, larger bursts
+	  * reduce scheduling overhead. A schedule call outputs at most this
+	  * many events from the queue. The implementation may use a smaller
+	  * burst, e.g. limit the value to its own maximum burst size.
+	  *
+	  * Default value is 0, which selects the implementation default. */
+	uint32_t burst_size;
+
+	/** Maximum number of events per atomic context
+	  *
+	  * An atomic context of this queue holds at most this many events.
+	  * When the value is larger than the burst size, a thread may keep
+	  * the atomic context and continue with another burst from the same
+	  * queue until this many events have been scheduled in the context,
+	  * or the queue is empty. This trades fairness between queues for
+	  * cache locality of a single flow. Continuing the context is a hint:
+	  * the implementation may release it after any burst.
+	  *
+	  * Default value is 0, which selects the implementation default. */
+	uint32_t atomic_max_events;
+
+	/** Sticky atomic context
+	  *
+	  * When true, 'atomic_max_events' is ignored. The value is a hint that
+	  * a thread should keep the atomic context of this queue as long as
+	  * the queue has events. Other queues may be starved while the thread
+	  * serves a busy sticky queue. The context is released when the queue
+	  * is found empty or with odp_schedule_release_atomic(). The
+	  * implementation may release the context also earlier.
+	  *
+	  * Default value is false. */
+	odp_bool_t atomic_sticky;
 } odp_schedule_param_t;
 
+/** Number of buckets in the scheduling latency histogram */
+#define ODP_SCHEDULE_LATENCY_BUCKETS 32
+
+/**
+ * Scheduler statistics
+ *
+ * Counters are cumulative from odp_init_global(). Time values are in
+ * nanoseconds.
+ */
+typedef struct odp_schedule_stats_t {
+	/** Number of schedule calls */
+	uint64_t calls;
+
+	/** Number of events returned by schedule calls */
+	uint64_t events;
+
+	/** Number of scheduling rounds which found no events */
+	uint64_t empty_polls;
+
+	/** Number of packet input polls */
+	uint64_t pktin_polls;
+
+	/** Number of atomic contexts held */
+	uint64_t atomic_holds;
+
+	/** Total time atomic contexts were held */
+	uint64_t atomic_hold_ns;
+
+	/** Number of times a thread waited for its ordered context turn */
+	uint64_t ordered_waits;
+
+	/** Total time waited for ordered context turns */
+	uint64_t ordered_wait_ns;
+
+	/** Number of ordered enqueues which did not fit into the ordered
+	  * stash and had to wait for the context turn */
+	uint64_t stash_overflows;
+
+	/** Histogram of event latency from enqueue to schedule
+	  *
+	  * Bucket 'i' counts events with latency of 2^i ... 2^(i+1) - 1
+	  * nanoseconds. Bucket zero includes also zero latency and the last
+	  * bucket all latencies above its lower limit. */
+	uint64_t latency[ODP_SCHEDULE_LATENCY_BUCKETS];
+} odp_schedule_stats_t;
+
 /**
  * @}
  */
@@ -11,8 +11,13 @@
 extern "C" {
 #endif
 
+#include <odp/api/std_types.h>
+
 #define _ODP_CACHE_LINE_SIZE 64
 
+/** @internal HW time counter can be read inline */
+#define _ODP_CPU_GLOBAL_TIME 1
+
 static inline void odp_cpu_pause(void)
 {
 	/* YIELD hints the CPU to switch to another thread if possible
@@ -23,6 +28,23 @@ static inline void odp_cpu_pause(void)
 	__asm volatile("isb" ::: "memory");
 }
 
+/** @internal Read HW time counter (virtual count) @return Counter value */
+static inline uint64_t _odp_cpu_global_time(void)
+{
+	uint64_t cntvct;
+
+	/*
+	 * To be consistent with other architectures, do not issue a
+	 * serializing instruction, e.g. ISB, before reading this
+	 * sys reg.
+	 */
+
+	/* Memory clobber to minimize optimization around load from sys reg. */
+	__asm__ volatile("mrs %0, cntvct_el0" : "=r"(cntvct) : : "memory");
+
+	return cntvct;
+}
+
 #ifdef __cplusplus
 }
 #endif
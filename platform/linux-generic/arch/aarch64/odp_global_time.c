@@ -10,12 +10,22 @@
 
 #include <time.h>
 
+#include <odp/api/cpu.h>
 #include <odp_debug_internal.h>
 #include <odp_time_internal.h>
 
+static uint64_t read_cntfrq(void)
+{
+	uint64_t cntfrq;
+
+	__asm__ volatile("mrs %0, cntfrq_el0" : "=r"(cntfrq) : : );
+
+	return cntfrq;
+}
+
 int cpu_has_global_time(void)
 {
-	uint64_t hz = cpu_global_time_freq();
+	uint64_t hz = read_cntfrq();
 
 	/*
 	 * The system counter portion of the architected timer must
@@ -33,25 +43,15 @@ int cpu_has_global_time(void)
 
 uint64_t cpu_global_time(void)
 {
-	uint64_t cntvct;
-
-	/*
-	 * To be consistent with other architectures, do not issue a
-	 * serializing instruction, e.g. ISB, before reading this
-	 * sys reg.
-	 */
-
-	/* Memory clobber to minimize optimization around load from sys reg. */
-	__asm__ volatile("mrs %0, cntvct_el0" : "=r"(cntvct) : : "memory");
-
-	return cntvct;
+	return _odp_cpu_global_time();
 }
 
-uint64_t cpu_global_time_freq(void)
+uint64_t cpu_global_time_freq(time_freq_info_t *info)
 {
-	uint64_t cntfrq;
-
-	__asm__ volatile("mrs %0, cntfrq_el0" : "=r"(cntfrq) : : );
+	/* Frequency register is programmed by firmware. Its accuracy is
+	 * defined by the system oscillator, which is not known here. */
+	info->src     = "CNTFRQ_EL0";
+	info->err_ppm = 0;
 
-	return cntfrq;
+	return read_cntfrq();
 }
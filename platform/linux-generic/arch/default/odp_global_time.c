@@ -27,7 +27,7 @@ uint64_t cpu_global_time(void)
 	return 0;
 }
 
-uint64_t cpu_global_time_freq(void)
+uint64_t cpu_global_time_freq(time_freq_info_t *info ODP_UNUSED)
 {
 	return 0;
 }
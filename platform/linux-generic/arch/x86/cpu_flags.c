@@ -324,6 +324,33 @@ static int cpu_get_flag_enabled(enum rte_cpu_flag_t feature)
 	return (regs[feat->reg] >> feat->bit) & 1;
 }
 
+int cpu_cpuid(uint32_t leaf, uint32_t subleaf, uint32_t out[4])
+{
+	cpuid_registers_t regs;
+	uint32_t base = leaf & 0xffff0000;
+
+	if (base == 0x40000000) {
+		/* Hypervisor leaves are valid only when running on one */
+		cpu_get_features(1, 0, regs);
+		if (!((regs[RTE_REG_ECX] >> 31) & 1))
+			return -1;
+	}
+
+	cpu_get_features(base, 0, regs);
+	if (((regs[RTE_REG_EAX] ^ leaf) & 0xffff0000) ||
+	    regs[RTE_REG_EAX] < leaf)
+		return -1;
+
+	cpu_get_features(leaf, subleaf, regs);
+
+	out[0] = regs[RTE_REG_EAX];
+	out[1] = regs[RTE_REG_EBX];
+	out[2] = regs[RTE_REG_ECX];
+	out[3] = regs[RTE_REG_EDX];
+
+	return 0;
+}
+
 static const char *cpu_get_flag_name(enum rte_cpu_flag_t feature)
 {
 	if (feature >= RTE_CPUFLAG_NUMFLAGS)
@@ -11,8 +11,14 @@
 extern "C" {
 #endif
 
+#include <stdint.h>
+
 void cpu_flags_print_all(void);
 
+/* Read CPUID leaf into out[] in EAX, EBX, ECX, EDX order. Returns -1 when
+ * the leaf is not supported. */
+int cpu_cpuid(uint32_t leaf, uint32_t subleaf, uint32_t out[4]);
+
 #ifdef __cplusplus
 }
 #endif
@@ -11,8 +11,13 @@
 extern "C" {
 #endif
 
+#include <odp/api/std_types.h>
+
 #define _ODP_CACHE_LINE_SIZE 64
 
+/** @internal HW time counter can be read inline */
+#define _ODP_CPU_GLOBAL_TIME 1
+
 static inline void odp_cpu_pause(void)
 {
 #ifdef __SSE2__
@@ -22,6 +27,16 @@ static inline void odp_cpu_pause(void)
 #endif
 }
 
+/** @internal Read HW time counter (TSC) @return Counter value */
+static inline uint64_t _odp_cpu_global_time(void)
+{
+	uint32_t lo, hi;
+
+	__asm__ __volatile__ ("rdtsc" : "=a" (lo), "=d" (hi) : : "memory");
+
+	return ((uint64_t)hi << 32) | lo;
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -9,69 +9,212 @@
 #include <odp_posix_extensions.h>
 
 #include <time.h>
+#include <stdlib.h>
 
 #include <odp/api/cpu.h>
 #include <odp/api/hints.h>
 #include <odp_debug_internal.h>
 #include <odp_time_internal.h>
+#include <cpu_flags.h>
 
 uint64_t cpu_global_time(void)
 {
-	return odp_cpu_cycles();
+	return _odp_cpu_global_time();
 }
 
 #define SEC_IN_NS 1000000000ULL
 
-/* Measure TSC frequency. Frequency information registers are defined for x86,
- * but those are often not enumerated. */
-uint64_t cpu_global_time_freq(void)
+/* Number of calibration rounds and length of a round */
+#define CALIB_ROUNDS   9
+#define CALIB_ROUND_NS (SEC_IN_NS / 16)
+
+/* Number of time reads per calibration sample */
+#define CALIB_SAMPLES  4
+
+/* TSC frequency from CPUID leaf 0x15 (TSC / crystal clock ratio). Exact
+ * when the crystal frequency is enumerated. */
+static uint64_t tsc_freq_crystal(void)
+{
+	uint32_t regs[4];
+	uint32_t denom, numer, crystal_hz;
+
+	if (cpu_cpuid(0x15, 0, regs))
+		return 0;
+
+	denom      = regs[0];
+	numer      = regs[1];
+	crystal_hz = regs[2];
+
+	if (denom == 0 || numer == 0 || crystal_hz == 0)
+		return 0;
+
+	return ((uint64_t)crystal_hz * numer) / denom;
+}
+
+/* Nominal base frequency from CPUID leaf 0x16, in 1 MHz resolution. TSC runs
+ * at base frequency, but the actual frequency may differ from the nominal
+ * value by hundreds of ppm. */
+static uint64_t tsc_freq_base(uint32_t *err_ppm)
+{
+	uint32_t regs[4];
+	uint64_t hz;
+
+	if (cpu_cpuid(0x16, 0, regs) || (regs[0] & 0xffff) == 0)
+		return 0;
+
+	hz = (uint64_t)(regs[0] & 0xffff) * 1000000;
+	*err_ppm = (1000000 * 1000000ULL + hz - 1) / hz;
+
+	return hz;
+}
+
+/* TSC frequency from hypervisor timing leaf, in 1 kHz resolution */
+static uint64_t tsc_freq_hypervisor(uint32_t *err_ppm)
+{
+	uint32_t regs[4];
+	uint64_t hz;
+
+	if (cpu_cpuid(0x40000010, 0, regs) || regs[0] == 0)
+		return 0;
+
+	hz = (uint64_t)regs[0] * 1000;
+	*err_ppm = (1000 * 1000000ULL + hz - 1) / hz;
+
+	return hz;
+}
+
+/* Read TSC and system time as close together as possible. Returns TSC value
+ * at the middle of the system time read and the read window in cycles. The
+ * first reads after a sleep are slow, the sample with the shortest window
+ * is used. */
+static int tsc_sample(uint64_t *tsc, uint64_t *ns, uint64_t *window)
 {
-	struct timespec sleep, ts1, ts2;
-	uint64_t t1, t2, ts_nsec, cycles, hz;
+	struct timespec ts;
+	uint64_t t1, t2;
 	int i;
-	uint64_t avg = 0;
-	int rounds = 3;
-	int warm_up = 1;
 
-	for (i = 0; i < rounds; i++) {
-		sleep.tv_sec = 0;
+	*window = UINT64_MAX;
 
-		if (warm_up)
-			sleep.tv_nsec = SEC_IN_NS / 1000;
-		else
-			sleep.tv_nsec = SEC_IN_NS / 4;
+	for (i = 0; i < CALIB_SAMPLES; i++) {
+		t1 = cpu_global_time();
 
-		if (clock_gettime(CLOCK_MONOTONIC_RAW, &ts1)) {
-			ODP_DBG("clock_gettime failed\n");
-			return 0;
+		if (clock_gettime(CLOCK_MONOTONIC_RAW, &ts))
+			return -1;
+
+		t2 = cpu_global_time();
+
+		if (t2 - t1 < *window) {
+			*tsc    = t1 + (t2 - t1) / 2;
+			*ns     = ts.tv_sec * SEC_IN_NS + ts.tv_nsec;
+			*window = t2 - t1;
 		}
+	}
 
-		t1 = cpu_global_time();
+	return 0;
+}
+
+static int cmp_u64(const void *a, const void *b)
+{
+	uint64_t x = *(const uint64_t *)a;
+	uint64_t y = *(const uint64_t *)b;
+
+	return (x > y) - (x < y);
+}
+
+/* Measure TSC frequency against the system clock. Median of several rounds
+ * filters out rounds disturbed by preemption. Error estimate includes both
+ * spread of the rounds and time read uncertainty. */
+static uint64_t tsc_freq_calibrate(uint32_t *err_ppm)
+{
+	struct timespec sleep;
+	uint64_t tsc1, tsc2, ns1, ns2, win1, win2, ns;
+	uint64_t hz[CALIB_ROUNDS];
+	uint64_t median, spread, read_err;
+	uint64_t max_window = 0;
+	int i;
+
+	sleep.tv_sec  = 0;
+	sleep.tv_nsec = SEC_IN_NS / 1000;
+
+	/* Warm up */
+	if (nanosleep(&sleep, NULL) < 0)
+		return 0;
+
+	sleep.tv_nsec = CALIB_ROUND_NS;
+
+	for (i = 0; i < CALIB_ROUNDS; i++) {
+		if (tsc_sample(&tsc1, &ns1, &win1))
+			return 0;
 
 		if (nanosleep(&sleep, NULL) < 0) {
 			ODP_DBG("nanosleep failed\n");
 			return 0;
 		}
 
-		if (clock_gettime(CLOCK_MONOTONIC_RAW, &ts2)) {
-			ODP_DBG("clock_gettime failed\n");
+		if (tsc_sample(&tsc2, &ns2, &win2))
 			return 0;
-		}
 
-		t2 = cpu_global_time();
+		ns = ns2 - ns1;
+		if (ns == 0)
+			return 0;
+
+		hz[i] = ((tsc2 - tsc1) * SEC_IN_NS) / ns;
+
+		if (win1 > max_window)
+			max_window = win1;
+		if (win2 > max_window)
+			max_window = win2;
+	}
+
+	qsort(hz, CALIB_ROUNDS, sizeof(uint64_t), cmp_u64);
+
+	median = hz[CALIB_ROUNDS / 2];
+	if (median == 0)
+		return 0;
 
-		ts_nsec  = (ts2.tv_sec - ts1.tv_sec) * SEC_IN_NS;
-		ts_nsec += ts2.tv_nsec - ts1.tv_nsec;
+	/* Outermost rounds are ignored also in the error estimate */
+	spread   = (hz[CALIB_ROUNDS - 2] - hz[1]) / 2;
+	read_err = (max_window * SEC_IN_NS) / CALIB_ROUND_NS;
 
-		cycles = t2 - t1;
+	*err_ppm = ((spread + read_err) * 1000000) / median;
 
-		hz = (cycles * SEC_IN_NS) / ts_nsec;
+	return median;
+}
+
+/* TSC frequency. Frequency information registers are defined for x86, but
+ * those are often not enumerated. Only the crystal based frequency is exact,
+ * the hypervisor leaf is used as is in 1 kHz resolution. Otherwise the
+ * frequency is measured, and the nominal base frequency is used only when
+ * the measurement fails. */
+uint64_t cpu_global_time_freq(time_freq_info_t *info)
+{
+	uint64_t hz;
+	uint32_t err_ppm = 0;
+
+	hz = tsc_freq_crystal();
+	if (hz) {
+		info->src     = "TSC, CPUID 0x15";
+		info->err_ppm = 0;
+		return hz;
+	}
 
-		if (warm_up)
-			warm_up = 0;
-		else
-			avg += hz;
+	hz = tsc_freq_hypervisor(&err_ppm);
+	if (hz) {
+		info->src     = "TSC, hypervisor CPUID 0x40000010";
+		info->err_ppm = err_ppm;
+		return hz;
 	}
 
-	return avg / (rounds - 1);
+	hz = tsc_freq_calibrate(&err_ppm);
+	if (hz) {
+		info->src     = "TSC, calibrated";
+		info->err_ppm = err_ppm;
+		return hz;
+	}
+
+	hz = tsc_freq_base(&err_ppm);
+	info->src     = "TSC, CPUID 0x16";
+	info->err_ppm = err_ppm;
+
+	return hz;
 }
@@ -22,6 +22,11 @@ extern "C" {
 #include <odp/api/plat/buffer_types.h>
 #include <odp/api/plat/pool_types.h>
 
+#include <odp/api/plat/static_inline.h>
+#if ODP_ABI_COMPAT == 0
+#include <odp/api/plat/buffer_inlines.h>
+#endif
+
 /** @ingroup odp_buffer
  *  @{
  */
@@ -19,6 +19,11 @@ extern "C" {
 
 #include <odp/api/plat/event_types.h>
 
+#include <odp/api/plat/static_inline.h>
+#if ODP_ABI_COMPAT == 0
+#include <odp/api/plat/event_inlines.h>
+#endif
+
 /** @ingroup odp_event
  *  @{
  */
@@ -0,0 +1,56 @@
+/* Copyright (c) 2017, Linaro Limited
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file
+ *
+ * Buffer inline functions
+ */
+
+#ifndef _ODP_PLAT_BUFFER_INLINES_H_
+#define _ODP_PLAT_BUFFER_INLINES_H_
+
+#include <odp/api/plat/event_types.h>
+#include <odp/api/plat/buffer_types.h>
+
+/** @internal Inline function offsets */
+extern const _odp_buffer_inline_offset_t _odp_buffer_inline;
+
+/** @internal Inline function @param ev @return */
+static inline odp_buffer_t _odp_buffer_from_event(odp_event_t ev)
+{
+	return (odp_buffer_t)ev;
+}
+
+/** @internal Inline function @param buf @return */
+static inline odp_event_t _odp_buffer_to_event(odp_buffer_t buf)
+{
+	return (odp_event_t)buf;
+}
+
+/** @internal Inline function @param buf @return */
+static inline void *_odp_buffer_addr(odp_buffer_t buf)
+{
+	return _odp_buf_get(buf, void *, addr);
+}
+
+/* Include inlined versions of API functions */
+#include <odp/api/plat/static_inline.h>
+#if ODP_ABI_COMPAT == 0
+
+/** @ingroup odp_buffer
+ *  @{
+ */
+
+#include <odp/api/plat/buffer_inlines_api.h>
+
+/**
+ * @}
+ */
+
+#endif
+
+#endif
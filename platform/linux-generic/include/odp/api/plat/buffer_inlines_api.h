@@ -0,0 +1,31 @@
+/* Copyright (c) 2017, Linaro Limited
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file
+ *
+ * Buffer inline functions
+ */
+
+#ifndef _ODP_PLAT_BUFFER_INLINES_API_H_
+#define _ODP_PLAT_BUFFER_INLINES_API_H_
+
+_ODP_INLINE odp_buffer_t odp_buffer_from_event(odp_event_t ev)
+{
+	return _odp_buffer_from_event(ev);
+}
+
+_ODP_INLINE odp_event_t odp_buffer_to_event(odp_buffer_t buf)
+{
+	return _odp_buffer_to_event(buf);
+}
+
+_ODP_INLINE void *odp_buffer_addr(odp_buffer_t buf)
+{
+	return _odp_buffer_addr(buf);
+}
+
+#endif
@@ -39,6 +39,21 @@ typedef ODP_HANDLE_T(odp_buffer_t);
 
 #endif
 
+#include <odp/api/std_types.h>
+
+/** @internal Buffer field accessor */
+#define _odp_buf_get(buf, cast, field) \
+	(*(cast *)(uintptr_t)((uint8_t *)buf + _odp_buffer_inline.field))
+
+/** @internal Buffer header field offsets for inline functions */
+typedef struct _odp_buffer_inline_offset_t {
+	/** @internal field offset */
+	uint16_t addr;
+	/** @internal field offset */
+	uint16_t event_type;
+
+} _odp_buffer_inline_offset_t;
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,43 @@
+/* Copyright (c) 2017, Linaro Limited
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file
+ *
+ * Event inline functions
+ */
+
+#ifndef _ODP_PLAT_EVENT_INLINES_H_
+#define _ODP_PLAT_EVENT_INLINES_H_
+
+#include <odp/api/plat/event_types.h>
+#include <odp/api/plat/buffer_inlines.h>
+
+/** @internal Inline function @param ev @return */
+static inline odp_event_type_t _odp_event_type(odp_event_t ev)
+{
+	int8_t type = _odp_buf_get(ev, int8_t, event_type);
+
+	return (odp_event_type_t)type;
+}
+
+/* Include inlined versions of API functions */
+#include <odp/api/plat/static_inline.h>
+#if ODP_ABI_COMPAT == 0
+
+/** @ingroup odp_event
+ *  @{
+ */
+
+#include <odp/api/plat/event_inlines_api.h>
+
+/**
+ * @}
+ */
+
+#endif
+
+#endif
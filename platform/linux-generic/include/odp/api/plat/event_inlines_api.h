@@ -0,0 +1,21 @@
+/* Copyright (c) 2017, Linaro Limited
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file
+ *
+ * Event inline functions
+ */
+
+#ifndef _ODP_PLAT_EVENT_INLINES_API_H_
+#define _ODP_PLAT_EVENT_INLINES_API_H_
+
+_ODP_INLINE odp_event_type_t odp_event_type(odp_event_t event)
+{
+	return _odp_event_type(event);
+}
+
+#endif
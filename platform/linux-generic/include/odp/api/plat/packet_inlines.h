@@ -170,6 +170,24 @@ static inline odp_buffer_t packet_to_buffer(odp_packet_t pkt)
 	return (odp_buffer_t)pkt;
 }
 
+/** @internal Inline function @param ev @return */
+static inline odp_packet_t _odp_packet_from_event(odp_event_t ev)
+{
+	if (odp_unlikely(ev == ODP_EVENT_INVALID))
+		return ODP_PACKET_INVALID;
+
+	return (odp_packet_t)ev;
+}
+
+/** @internal Inline function @param pkt @return */
+static inline odp_event_t _odp_packet_to_event(odp_packet_t pkt)
+{
+	if (odp_unlikely(pkt == ODP_PACKET_INVALID))
+		return ODP_EVENT_INVALID;
+
+	return (odp_event_t)pkt;
+}
+
 /* Include inlined versions of API functions */
 #include <odp/api/plat/static_inline.h>
 #if ODP_ABI_COMPAT == 0
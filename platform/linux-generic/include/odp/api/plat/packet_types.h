@@ -38,6 +38,10 @@ typedef ODP_HANDLE_T(odp_packet_t);
 
 #define ODP_PACKET_OFFSET_INVALID 0xffff
 
+typedef ODP_HANDLE_T(odp_packet_vector_t);
+
+#define ODP_PACKET_VECTOR_INVALID _odp_cast_scalar(odp_packet_vector_t, 0)
+
 typedef uint8_t odp_packet_seg_t;
 
 static inline uint8_t _odp_packet_seg_to_ndx(odp_packet_seg_t seg)
@@ -0,0 +1,64 @@
+/* Copyright (c) 2017, Linaro Limited
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file
+ *
+ * Queue inline functions
+ */
+
+#ifndef _ODP_PLAT_QUEUE_INLINES_H_
+#define _ODP_PLAT_QUEUE_INLINES_H_
+
+#include <odp/api/plat/event_types.h>
+#include <odp/api/plat/queue_types.h>
+
+/** @internal Queue fast path functions of the selected implementation */
+extern const _odp_queue_api_fn_t *_odp_queue_api;
+
+/** @internal Inline function @param queue @param ev @return */
+static inline int _odp_queue_enq(odp_queue_t queue, odp_event_t ev)
+{
+	return _odp_queue_api->enq(queue, ev);
+}
+
+/** @internal Inline function @param queue @param events @param num @return */
+static inline int _odp_queue_enq_multi(odp_queue_t queue,
+				       const odp_event_t events[], int num)
+{
+	return _odp_queue_api->enq_multi(queue, events, num);
+}
+
+/** @internal Inline function @param queue @return */
+static inline odp_event_t _odp_queue_deq(odp_queue_t queue)
+{
+	return _odp_queue_api->deq(queue);
+}
+
+/** @internal Inline function @param queue @param events @param num @return */
+static inline int _odp_queue_deq_multi(odp_queue_t queue, odp_event_t events[],
+				       int num)
+{
+	return _odp_queue_api->deq_multi(queue, events, num);
+}
+
+/* Include inlined versions of API functions */
+#include <odp/api/plat/static_inline.h>
+#if ODP_ABI_COMPAT == 0
+
+/** @ingroup odp_queue
+ *  @{
+ */
+
+#include <odp/api/plat/queue_inlines_api.h>
+
+/**
+ * @}
+ */
+
+#endif
+
+#endif
@@ -0,0 +1,38 @@
+/* Copyright (c) 2017, Linaro Limited
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file
+ *
+ * Queue inline functions
+ */
+
+#ifndef _ODP_PLAT_QUEUE_INLINES_API_H_
+#define _ODP_PLAT_QUEUE_INLINES_API_H_
+
+_ODP_INLINE int odp_queue_enq(odp_queue_t queue, odp_event_t ev)
+{
+	return _odp_queue_enq(queue, ev);
+}
+
+_ODP_INLINE int odp_queue_enq_multi(odp_queue_t queue,
+				    const odp_event_t events[], int num)
+{
+	return _odp_queue_enq_multi(queue, events, num);
+}
+
+_ODP_INLINE odp_event_t odp_queue_deq(odp_queue_t queue)
+{
+	return _odp_queue_deq(queue);
+}
+
+_ODP_INLINE int odp_queue_deq_multi(odp_queue_t queue, odp_event_t events[],
+				    int num)
+{
+	return _odp_queue_deq_multi(queue, events, num);
+}
+
+#endif
@@ -41,6 +41,22 @@ typedef ODP_HANDLE_T(odp_queue_t);
 
 #endif
 
+#include <odp/api/plat/event_types.h>
+
+/** @internal Queue fast path functions for inline API */
+typedef struct _odp_queue_api_fn_t {
+	/** @internal Enqueue an event */
+	int (*enq)(odp_queue_t queue, odp_event_t ev);
+	/** @internal Enqueue multiple events */
+	int (*enq_multi)(odp_queue_t queue, const odp_event_t events[],
+			 int num);
+	/** @internal Dequeue an event */
+	odp_event_t (*deq)(odp_queue_t queue);
+	/** @internal Dequeue multiple events */
+	int (*deq_multi)(odp_queue_t queue, odp_event_t events[], int num);
+
+} _odp_queue_api_fn_t;
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,93 @@
+/* Copyright (c) 2017, Linaro Limited
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file
+ *
+ * Scheduler inline functions
+ */
+
+#ifndef _ODP_PLAT_SCHEDULE_INLINES_H_
+#define _ODP_PLAT_SCHEDULE_INLINES_H_
+
+#include <odp/api/plat/schedule_types.h>
+
+/** @internal Scheduler fast path functions of the selected implementation */
+extern const _odp_schedule_api_fn_t *_odp_sched_api;
+
+/** @internal Inline function @param from @param wait @return */
+static inline odp_event_t _odp_schedule(odp_queue_t *from, uint64_t wait)
+{
+	return _odp_sched_api->schedule(from, wait);
+}
+
+/** @internal Inline function @param from @param wait @param events
+ *  @param num @return */
+static inline int _odp_schedule_multi(odp_queue_t *from, uint64_t wait,
+				      odp_event_t events[], int num)
+{
+	return _odp_sched_api->schedule_multi(from, wait, events, num);
+}
+
+/** @internal Inline function */
+static inline void _odp_schedule_pause(void)
+{
+	_odp_sched_api->schedule_pause();
+}
+
+/** @internal Inline function */
+static inline void _odp_schedule_resume(void)
+{
+	_odp_sched_api->schedule_resume();
+}
+
+/** @internal Inline function */
+static inline void _odp_schedule_release_atomic(void)
+{
+	_odp_sched_api->schedule_release_atomic();
+}
+
+/** @internal Inline function */
+static inline void _odp_schedule_release_ordered(void)
+{
+	_odp_sched_api->schedule_release_ordered();
+}
+
+/** @internal Inline function @param num */
+static inline void _odp_schedule_prefetch(int num)
+{
+	_odp_sched_api->schedule_prefetch(num);
+}
+
+/** @internal Inline function @param lock_index */
+static inline void _odp_schedule_order_lock(unsigned lock_index)
+{
+	_odp_sched_api->schedule_order_lock(lock_index);
+}
+
+/** @internal Inline function @param lock_index */
+static inline void _odp_schedule_order_unlock(unsigned lock_index)
+{
+	_odp_sched_api->schedule_order_unlock(lock_index);
+}
+
+/* Include inlined versions of API functions */
+#include <odp/api/plat/static_inline.h>
+#if ODP_ABI_COMPAT == 0
+
+/** @ingroup odp_scheduler
+ *  @{
+ */
+
+#include <odp/api/plat/schedule_inlines_api.h>
+
+/**
+ * @}
+ */
+
+#endif
+
+#endif
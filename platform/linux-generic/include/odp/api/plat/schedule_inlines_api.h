@@ -0,0 +1,62 @@
+/* Copyright (c) 2017, Linaro Limited
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file
+ *
+ * Scheduler inline functions
+ */
+
+#ifndef _ODP_PLAT_SCHEDULE_INLINES_API_H_
+#define _ODP_PLAT_SCHEDULE_INLINES_API_H_
+
+_ODP_INLINE odp_event_t odp_schedule(odp_queue_t *from, uint64_t wait)
+{
+	return _odp_schedule(from, wait);
+}
+
+_ODP_INLINE int odp_schedule_multi(odp_queue_t *from, uint64_t wait,
+				   odp_event_t events[], int num)
+{
+	return _odp_schedule_multi(from, wait, events, num);
+}
+
+_ODP_INLINE void odp_schedule_pause(void)
+{
+	_odp_schedule_pause();
+}
+
+_ODP_INLINE void odp_schedule_resume(void)
+{
+	_odp_schedule_resume();
+}
+
+_ODP_INLINE void odp_schedule_release_atomic(void)
+{
+	_odp_schedule_release_atomic();
+}
+
+_ODP_INLINE void odp_schedule_release_ordered(void)
+{
+	_odp_schedule_release_ordered();
+}
+
+_ODP_INLINE void odp_schedule_prefetch(int num)
+{
+	_odp_schedule_prefetch(num);
+}
+
+_ODP_INLINE void odp_schedule_order_lock(unsigned lock_index)
+{
+	_odp_schedule_order_lock(lock_index);
+}
+
+_ODP_INLINE void odp_schedule_order_unlock(unsigned lock_index)
+{
+	_odp_schedule_order_unlock(lock_index);
+}
+
+#endif
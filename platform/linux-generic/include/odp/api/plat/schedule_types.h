@@ -18,6 +18,10 @@
 extern "C" {
 #endif
 
+#include <odp/api/std_types.h>
+#include <odp/api/plat/event_types.h>
+#include <odp/api/plat/queue_types.h>
+
 /** @addtogroup odp_scheduler
  *  @{
  */
@@ -55,6 +59,30 @@ typedef int odp_schedule_group_t;
  * @}
  */
 
+/** @internal Scheduler fast path functions for inline API */
+typedef struct _odp_schedule_api_fn_t {
+	/** @internal Schedule an event */
+	odp_event_t (*schedule)(odp_queue_t *from, uint64_t wait);
+	/** @internal Schedule multiple events */
+	int (*schedule_multi)(odp_queue_t *from, uint64_t wait,
+			      odp_event_t events[], int num);
+	/** @internal Pause scheduling */
+	void (*schedule_pause)(void);
+	/** @internal Resume scheduling */
+	void (*schedule_resume)(void);
+	/** @internal Release atomic context */
+	void (*schedule_release_atomic)(void);
+	/** @internal Release ordered context */
+	void (*schedule_release_ordered)(void);
+	/** @internal Prefetch events */
+	void (*schedule_prefetch)(int num);
+	/** @internal Acquire ordered lock */
+	void (*schedule_order_lock)(unsigned lock_index);
+	/** @internal Release ordered lock */
+	void (*schedule_order_unlock)(unsigned lock_index);
+
+} _odp_schedule_api_fn_t;
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,158 @@
+/* Copyright (c) 2017, Linaro Limited
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file
+ *
+ * Time inline functions
+ */
+
+#ifndef _ODP_PLAT_TIME_INLINES_H_
+#define _ODP_PLAT_TIME_INLINES_H_
+
+#include <odp/api/std_types.h>
+#include <odp/api/plat/static_inline.h>
+#include <odp/api/hints.h>
+#include <odp/api/cpu.h>
+#include <odp/api/plat/time_types.h>
+
+/** @internal Nanoseconds in a second */
+#define _ODP_TIME_SEC_IN_NS 1000000000ULL
+
+/** @internal Time data for inline functions */
+extern _odp_time_global_t _odp_time_glob;
+
+/** @internal Read current time with a system call */
+odp_time_t _odp_time_cur_sys(void);
+
+/** @internal Inline function @return */
+static inline odp_time_t _odp_time_cur(void)
+{
+#ifdef _ODP_CPU_GLOBAL_TIME
+	if (odp_likely(_odp_time_glob.use_hw)) {
+		odp_time_t time;
+
+		time.count = _odp_cpu_global_time() - _odp_time_glob.hw_start;
+		return time;
+	}
+#endif
+
+	return _odp_time_cur_sys();
+}
+
+#ifdef __SIZEOF_INT128__
+/** @internal Inline function @param val @param mul @param shift @return */
+static inline uint64_t _odp_time_mul_shift(uint64_t val, uint64_t mul,
+					   uint32_t shift)
+{
+	return (uint64_t)(((unsigned __int128)val * mul) >> shift);
+}
+#endif
+
+/** @internal Inline function @param time @return */
+static inline uint64_t _odp_time_to_ns(odp_time_t time)
+{
+	if (odp_unlikely(!_odp_time_glob.use_hw))
+		return time.nsec;
+
+#ifdef __SIZEOF_INT128__
+	return _odp_time_mul_shift(time.count, _odp_time_glob.ns_mul,
+				   _odp_time_glob.ns_shift);
+#else
+	{
+		uint64_t freq_hz = _odp_time_glob.hw_freq_hz;
+		uint64_t count = time.count;
+		uint64_t sec = 0;
+
+		if (count >= freq_hz) {
+			sec   = count / freq_hz;
+			count = count - sec * freq_hz;
+		}
+
+		return (sec * _ODP_TIME_SEC_IN_NS) +
+		       (_ODP_TIME_SEC_IN_NS * count) / freq_hz;
+	}
+#endif
+}
+
+/** @internal Inline function @param ns @return */
+static inline odp_time_t _odp_time_from_ns(uint64_t ns)
+{
+	odp_time_t time;
+
+	if (odp_unlikely(!_odp_time_glob.use_hw)) {
+		time.nsec = ns;
+		return time;
+	}
+
+#ifdef __SIZEOF_INT128__
+	time.count = _odp_time_mul_shift(ns, _odp_time_glob.count_mul,
+					 _odp_time_glob.count_shift);
+#else
+	{
+		uint64_t freq_hz = _odp_time_glob.hw_freq_hz;
+		uint64_t sec = 0;
+
+		if (ns >= _ODP_TIME_SEC_IN_NS) {
+			sec = ns / _ODP_TIME_SEC_IN_NS;
+			ns  = ns - sec * _ODP_TIME_SEC_IN_NS;
+		}
+
+		time.count = sec * freq_hz +
+			     (ns * freq_hz) / _ODP_TIME_SEC_IN_NS;
+	}
+#endif
+
+	return time;
+}
+
+/** @internal Inline function @param t2 @param t1 @return */
+static inline int _odp_time_cmp(odp_time_t t2, odp_time_t t1)
+{
+	if (odp_likely(t2.u64 > t1.u64))
+		return 1;
+
+	if (t2.u64 < t1.u64)
+		return -1;
+
+	return 0;
+}
+
+/** @internal Inline function @param t2 @param t1 @return */
+static inline odp_time_t _odp_time_diff(odp_time_t t2, odp_time_t t1)
+{
+	odp_time_t time;
+
+	time.u64 = t2.u64 - t1.u64;
+
+	return time;
+}
+
+/** @internal Inline function @param t1 @param t2 @return */
+static inline odp_time_t _odp_time_sum(odp_time_t t1, odp_time_t t2)
+{
+	odp_time_t time;
+
+	time.u64 = t1.u64 + t2.u64;
+
+	return time;
+}
+
+#if ODP_ABI_COMPAT == 0
+
+/** @ingroup odp_time
+ *  @{
+ */
+
+#include <odp/api/plat/time_inlines_api.h>
+
+/**
+ * @}
+ */
+
+#endif
+
+#endif
@@ -0,0 +1,66 @@
+/* Copyright (c) 2017, Linaro Limited
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file
+ *
+ * Time inline functions
+ */
+
+#ifndef _ODP_PLAT_TIME_INLINES_API_H_
+#define _ODP_PLAT_TIME_INLINES_API_H_
+
+_ODP_INLINE odp_time_t odp_time_local(void)
+{
+	return _odp_time_cur();
+}
+
+_ODP_INLINE odp_time_t odp_time_global(void)
+{
+	return _odp_time_cur();
+}
+
+_ODP_INLINE odp_time_t odp_time_diff(odp_time_t t2, odp_time_t t1)
+{
+	return _odp_time_diff(t2, t1);
+}
+
+_ODP_INLINE uint64_t odp_time_to_ns(odp_time_t time)
+{
+	return _odp_time_to_ns(time);
+}
+
+_ODP_INLINE odp_time_t odp_time_local_from_ns(uint64_t ns)
+{
+	return _odp_time_from_ns(ns);
+}
+
+_ODP_INLINE odp_time_t odp_time_global_from_ns(uint64_t ns)
+{
+	return _odp_time_from_ns(ns);
+}
+
+_ODP_INLINE int odp_time_cmp(odp_time_t t2, odp_time_t t1)
+{
+	return _odp_time_cmp(t2, t1);
+}
+
+_ODP_INLINE odp_time_t odp_time_sum(odp_time_t t1, odp_time_t t2)
+{
+	return _odp_time_sum(t1, t2);
+}
+
+_ODP_INLINE uint64_t odp_time_local_res(void)
+{
+	return _odp_time_glob.res_hz;
+}
+
+_ODP_INLINE uint64_t odp_time_global_res(void)
+{
+	return _odp_time_glob.res_hz;
+}
+
+#endif
@@ -42,6 +42,36 @@ typedef struct odp_time_t {
 
 #define ODP_TIME_NULL ((odp_time_t){.u64 = 0})
 
+/** @internal Time data for inline functions */
+typedef struct _odp_time_global_t {
+	/** @internal HW time counter value at init */
+	uint64_t hw_start;
+
+	/** @internal HW time counter frequency in hz */
+	uint64_t hw_freq_hz;
+
+	/** @internal Multiplier for HW time counter to nanosecond
+	 *  conversion: ns = (count * ns_mul) >> ns_shift */
+	uint64_t ns_mul;
+
+	/** @internal Multiplier for nanosecond to HW time counter
+	 *  conversion: count = (ns * count_mul) >> count_shift */
+	uint64_t count_mul;
+
+	/** @internal Shift for counter to nanosecond conversion */
+	uint32_t ns_shift;
+
+	/** @internal Shift for nanosecond to counter conversion */
+	uint32_t count_shift;
+
+	/** @internal Time resolution in hz */
+	uint64_t res_hz;
+
+	/** @internal Time is based on HW time counter */
+	int use_hw;
+
+} _odp_time_global_t;
+
 /**
  * @}
  */
@@ -23,6 +23,11 @@ extern "C" {
 #include <odp/api/plat/buffer_types.h>
 #include <odp/api/plat/pool_types.h>
 
+#include <odp/api/plat/static_inline.h>
+#if ODP_ABI_COMPAT == 0
+#include <odp/api/plat/queue_inlines.h>
+#endif
+
 /** @ingroup odp_queue
  *  @{
  */
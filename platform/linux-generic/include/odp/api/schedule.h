@@ -19,6 +19,11 @@ extern "C" {
 
 #include <odp/api/plat/schedule_types.h>
 
+#include <odp/api/plat/static_inline.h>
+#if ODP_ABI_COMPAT == 0
+#include <odp/api/plat/schedule_inlines.h>
+#endif
+
 /** @ingroup odp_scheduler
  *  @{
  */
@@ -18,10 +18,13 @@ extern "C" {
 #endif
 
 #include <odp/api/std_types.h>
+#include <odp/api/plat/time_types.h>
 
+#include <odp/api/plat/static_inline.h>
+#if ODP_ABI_COMPAT == 0
+#include <odp/api/plat/time_inlines.h>
+#endif
 
-
-#include <odp/api/plat/time_types.h>
 #include <odp/api/spec/time.h>
 
 #ifdef __cplusplus
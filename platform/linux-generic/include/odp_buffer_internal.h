@@ -41,7 +41,11 @@ typedef struct seg_entry_t {
 	uint32_t  len;
 } seg_entry_t;
 
-/* Common buffer header */
+/* Common buffer header
+ *
+ * Fields which are accessed on every alloc, free, enqueue and schedule are
+ * placed first, so that together with the first segment entry they fit into
+ * the first cache line. Segment list and rarely used fields follow. */
 struct odp_buffer_hdr_t {
 
 	/* Buffer index in the pool */
@@ -56,35 +60,35 @@ struct odp_buffer_hdr_t {
 	/* Number of seg[] entries used */
 	uint8_t   num_seg;
 
-	/* Next header which continues the segment list */
-	void *next_seg;
+	/* Reference count */
+	odp_atomic_u32_t ref_cnt;
 
-	/* Last header of the segment list */
-	void *last_seg;
+	/* Event type. Maybe different than pool type (crypto compl event) */
+	int8_t    event_type;
 
-	/* Initial buffer data pointer */
-	uint8_t  *base_data;
+	/* Burst counts */
+	uint8_t   burst_num;
+	uint8_t   burst_first;
 
 	/* Pool pointer */
 	void *pool_ptr;
 
+	/* Next header which continues the segment list */
+	void *next_seg;
+
+	/* Last header of the segment list */
+	void *last_seg;
+
 	/* --- 40 bytes --- */
 
 	/* Segments */
 	seg_entry_t seg[CONFIG_PACKET_SEGS_PER_HDR];
 
-	/* Burst counts */
-	uint8_t   burst_num;
-	uint8_t   burst_first;
+	/* --- Rarely used data --- */
 
 	/* Next buf in a list */
 	struct odp_buffer_hdr_t *next;
 
-	/* Burst table */
-	struct odp_buffer_hdr_t *burst[BUFFER_BURST_SIZE];
-
-	/* --- Mostly read only data --- */
-
 	/* User context pointer or u64 */
 	union {
 		uint64_t    buf_u64;
@@ -92,15 +96,6 @@ struct odp_buffer_hdr_t {
 		const void *buf_cctx; /* const alias for ctx */
 	};
 
-	/* Reference count */
-	odp_atomic_u32_t ref_cnt;
-
-	/* Event type. Maybe different than pool type (crypto compl event) */
-	int8_t    event_type;
-
-	/* Initial buffer tail pointer */
-	uint8_t  *buf_end;
-
 	/* User area pointer */
 	void    *uarea_addr;
 
@@ -108,10 +103,21 @@ struct odp_buffer_hdr_t {
 	 * offset has to be used */
 	uint64_t ipc_data_offset;
 
+#ifdef ODP_SCHEDULE_STATS
+	/* Time of the last enqueue, for scheduler latency statistics */
+	uint64_t enq_time;
+#endif
+
+	/* Burst table */
+	struct odp_buffer_hdr_t *burst[BUFFER_BURST_SIZE];
+
 	/* Data or next header */
 	uint8_t data[0];
 } ODP_ALIGNED_CACHE;
 
+ODP_STATIC_ASSERT(offsetof(odp_buffer_hdr_t, seg) + sizeof(seg_entry_t) <=
+		  ODP_CACHE_LINE_SIZE, "BUFFER_HDR_HOT_FIELDS_TOO_LARGE");
+
 ODP_STATIC_ASSERT(CONFIG_PACKET_SEGS_PER_HDR < 256,
 		  "CONFIG_PACKET_SEGS_PER_HDR_TOO_LARGE");
 
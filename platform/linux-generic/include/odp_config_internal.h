@@ -17,10 +17,21 @@ extern "C" {
 #define ODP_CONFIG_POOLS 64
 
 /*
- * Maximum number of queues
+ * Default number of queues
+ *
+ * The number of queues is selected at global init time. It may be increased
+ * up to CONFIG_MAX_QUEUES with the ODP_NUM_QUEUES environment variable.
  */
 #define ODP_CONFIG_QUEUES 1024
 
+/*
+ * Maximum number of queues
+ *
+ * Memory for queues is reserved at global init time, but stays untouched
+ * until a queue is used. Must be a power of two.
+ */
+#define CONFIG_MAX_QUEUES (1024 * 1024)
+
 /*
  * Maximum number of ordered locks per queue
  */
@@ -115,6 +126,27 @@ extern "C" {
  */
 #define CONFIG_PACKET_SEG_LEN_MIN CONFIG_PACKET_MAX_SEG_LEN
 
+/*
+ * Minimum packet data copy length for non-temporal stores
+ *
+ * Packet data copies of this many bytes or more bypass the CPU cache on
+ * the destination side (when supported by the CPU), so that large copies do
+ * not evict the working set. Smaller copies use plain memcpy().
+ */
+#define CONFIG_PACKET_COPY_NT_LEN (32 * 1024)
+
+/*
+ * Store rarely used packet metadata outside of packet headers
+ *
+ * When enabled, the crypto operation result is stored in a per pool array
+ * indexed with the buffer index, instead of the tail of the packet header.
+ * The array costs one cache line per packet pool block. It pays off only
+ * when it keeps the header one cache line shorter, e.g. with a different
+ * number of segments per header. With the default configuration the header
+ * size is the same in both cases.
+ */
+#define CONFIG_PACKET_COLD_META 0
+
 /* Maximum number of shared memory blocks.
  *
  * This the the number of separate SHM areas that can be reserved concurrently
@@ -129,6 +161,11 @@ extern "C" {
  */
 #define CONFIG_BURST_SIZE 16
 
+/*
+ * Maximum number of packets in a packet vector
+ */
+#define CONFIG_PACKET_VECTOR_MAX_SIZE 256
+
 /*
  * Maximum number of events in a pool
  */
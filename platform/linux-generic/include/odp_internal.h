@@ -21,6 +21,7 @@ extern "C" {
 #include <odp/api/cpumask.h>
 #include <odp/api/thread.h>
 #include <odp_errno_define.h>
+#include <odp_time_internal.h>
 #include <stdio.h>
 #include <sys/types.h>
 
@@ -34,6 +35,8 @@ typedef struct {
 	int      cpu_count;
 	char     cpu_arch_str[128];
 	char     model_str[MAX_CPU_NUMBER][128];
+	int      numa_node[MAX_CPU_NUMBER];
+	int      num_numa_nodes;
 } system_info_t;
 
 typedef struct {
@@ -50,6 +53,7 @@ struct odp_global_data_s {
 	odp_abort_func_t abort_fn;
 	system_info_t system_info;
 	hugepage_info_t hugepage_info;
+	time_freq_info_t time_info;
 	odp_cpumask_t control_cpus;
 	odp_cpumask_t worker_cpus;
 	int num_cpus_installed;
@@ -86,7 +90,7 @@ int odp_cpumask_term_global(void);
 int odp_system_info_init(void);
 int odp_system_info_term(void);
 
-int odp_thread_init_global(void);
+int odp_thread_init_global(const odp_init_t *params);
 int odp_thread_init_local(odp_thread_type_t type);
 int odp_thread_term_local(void);
 int odp_thread_term_global(void);
@@ -0,0 +1,70 @@
+/* Copyright (c) 2017, Linaro Limited
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier:     BSD-3-Clause
+ */
+
+/**
+ * @file
+ *
+ * ODP software flow hashing of received packets - implementation internal
+ */
+
+#ifndef ODP_PACKET_FLOW_HASH_INTERNAL_H_
+#define ODP_PACKET_FLOW_HASH_INTERNAL_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <odp/api/packet.h>
+#include <odp/api/packet_io.h>
+
+/* Hash key length in bytes. Toeplitz hashes inputs up to
+ * FLOW_HASH_KEY_LEN - 4 bytes, which covers the IPv6 5-tuple. */
+#define FLOW_HASH_KEY_LEN   40
+#define FLOW_HASH_INPUT_MAX (FLOW_HASH_KEY_LEN - 4)
+
+typedef enum {
+	FLOW_HASH_NONE = 0,
+	FLOW_HASH_TOEPLITZ,
+	FLOW_HASH_CRC32C
+} flow_hash_alg_t;
+
+typedef struct {
+	/* Algorithm selected with ODP_PKTIO_FLOW_HASH. When none, hashing is
+	 * done only for pktios which spread packets over pktin queues. */
+	flow_hash_alg_t alg;
+
+	/* Algorithm used for spreading packets over pktin queues */
+	flow_hash_alg_t spread_alg;
+
+	uint8_t  key[FLOW_HASH_KEY_LEN];
+
+	/* Toeplitz hash of each nibble value in each input byte position,
+	 * high nibble first */
+	uint32_t toeplitz[FLOW_HASH_INPUT_MAX][2][16];
+
+	/* Initial value of CRC32C */
+	uint32_t crc_init;
+
+} flow_hash_global_t;
+
+/* Read configuration from the environment and build hash tables */
+void _odp_flow_hash_init(flow_hash_global_t *global);
+
+/* Calculate software flow hash of 'num' parsed packets. Hash input is
+ * the 5-tuple of TCP and UDP packets of protocols enabled with the _tcp and
+ * _udp bits of 'proto', and the 2-tuple of other IPv4/IPv6 packets of
+ * protocols enabled with the ipv4 and ipv6 bits. Packets which already have
+ * a flow hash (e.g. from HW) or which do not match are left untouched. */
+void _odp_flow_hash_packets(const flow_hash_global_t *global,
+			    flow_hash_alg_t alg,
+			    const odp_pktin_hash_proto_t *proto,
+			    odp_packet_t packets[], int num);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -104,12 +104,29 @@ typedef struct {
 /* Packet extra data types */
 #define PKT_EXTRA_TYPE_DPDK 1
 
+/**
+ * Rarely used packet metadata
+ *
+ * Stored in the tail of the packet header, or with CONFIG_PACKET_COLD_META
+ * in a per pool array outside of packet headers and indexed with the buffer
+ * index.
+ */
+typedef struct {
+	/* Result for crypto */
+	odp_crypto_generic_op_result_t op_result;
+} odp_packet_cold_t;
+
 /**
  * Internal Packet header
  *
  * To optimize fast path performance this struct is not initialized to zero in
  * packet_init(). Because of this any new fields added must be reviewed for
  * initialization requirements.
+ *
+ * Packet fields which are accessed on every received and transmitted packet
+ * fit into the first cache line after the buffer header. Rarely used metadata
+ * (see odp_packet_cold_t) is stored after all other fields, or outside of the
+ * header.
  */
 typedef struct {
 	/* common buffer header */
@@ -132,17 +149,26 @@ typedef struct {
 	 * Members below are not initialized by packet_init()
 	 */
 
+	/* Initial packet data pointer */
+	uint8_t *base_data;
+
+	/* Classifier destination queue */
+	queue_t dst_queue;
+
+	/* --- 64 bytes --- */
+
 	/* Flow hash value */
 	uint32_t flow_hash;
 
 	/* Timestamp value */
 	odp_time_t timestamp;
 
-	/* Classifier destination queue */
-	queue_t dst_queue;
+	/* Initial packet tail pointer */
+	uint8_t *buf_end;
 
-	/* Result for crypto */
-	odp_crypto_generic_op_result_t op_result;
+#if !CONFIG_PACKET_COLD_META
+	odp_packet_cold_t cold;
+#endif
 
 #ifdef ODP_PKTIO_DPDK
 	/* Type of extra data */
@@ -155,6 +181,10 @@ typedef struct {
 	uint8_t data[0];
 } odp_packet_hdr_t;
 
+ODP_STATIC_ASSERT(offsetof(odp_packet_hdr_t, flow_hash) -
+		  offsetof(odp_packet_hdr_t, p) <= ODP_CACHE_LINE_SIZE,
+		  "PACKET_HDR_HOT_FIELDS_TOO_LARGE");
+
 /**
  * Return the packet header
  */
@@ -178,6 +208,19 @@ static inline odp_packet_t packet_from_buf_hdr(odp_buffer_hdr_t *buf_hdr)
 	return (odp_packet_t)(odp_packet_hdr_t *)buf_hdr;
 }
 
+static inline odp_packet_cold_t *packet_cold(odp_packet_hdr_t *pkt_hdr)
+{
+#if CONFIG_PACKET_COLD_META
+	pool_t *pool = pkt_hdr->buf_hdr.pool_ptr;
+
+	return (odp_packet_cold_t *)(uintptr_t)
+		&pool->cold_base[(uint64_t)pkt_hdr->buf_hdr.index *
+				 pool->cold_size];
+#else
+	return &pkt_hdr->cold;
+#endif
+}
+
 static inline seg_entry_t *seg_entry_last(odp_packet_hdr_t *hdr)
 {
 	odp_packet_hdr_t *last;
@@ -243,7 +286,6 @@ static inline void copy_packet_cls_metadata(odp_packet_hdr_t *src_hdr,
 	dst_hdr->dst_queue = src_hdr->dst_queue;
 	dst_hdr->flow_hash = src_hdr->flow_hash;
 	dst_hdr->timestamp = src_hdr->timestamp;
-	dst_hdr->op_result = src_hdr->op_result;
 }
 
 static inline void pull_tail(odp_packet_hdr_t *pkt_hdr, uint32_t len)
@@ -276,6 +318,10 @@ int packet_alloc_multi(odp_pool_t pool_hdl, uint32_t len,
 int packet_parse_layer(odp_packet_hdr_t *pkt_hdr,
 		       odp_pktio_parser_layer_t layer);
 
+/* Parse a burst of packets received from a pktio */
+void packet_parse_layer_multi(const odp_packet_t pkt[], int num,
+			      odp_pktio_parser_layer_t layer);
+
 /* Reset parser metadata for a new parse */
 void packet_parse_reset(odp_packet_hdr_t *pkt_hdr);
 
@@ -25,6 +25,7 @@ extern "C" {
 #include <odp_debug_internal.h>
 #include <odp_packet_io_ring_internal.h>
 #include <odp_queue_if.h>
+#include <odp_packet_flow_hash_internal.h>
 
 #include <odp_config_internal.h>
 #include <odp/api/hints.h>
@@ -70,8 +71,28 @@ typedef struct {
 } pkt_pcap_t;
 #endif
 
+/* Maximum number of IPC pktin and pktout queues */
+#define PKTIO_IPC_QUEUES_MAX 8
+
+/* IPC ring ownership. Rings of a queue are shared with the remote process:
+ * local tx[i].send is remote rx[i].recv and local tx[i].free is remote
+ * rx[i].free. Each ring has a single producer side and a single consumer
+ * side, and each side uses always the same enqueue/dequeue mode.
+ *   tx[i].send  produced by the local sending thread of queue i (SP),
+ *               consumed by the remote receiving thread (SC)
+ *   tx[i].free  produced by the remote receiving thread (SP, MP for queue 0
+ *               in zero-copy mode), consumed locally by the sending thread
+ *               of queue i (SC, MC for queue 0)
+ *   rx[i].recv  produced by the remote sending thread (SP), consumed by the
+ *               local receiving thread of queue i (SC)
+ *   rx[i].free  produced by the local receiving thread of queue i (SP, MP
+ *               for queue 0 in zero-copy mode), consumed by the remote
+ *               sending thread (SC, MC for queue 0)
+ *   rx[i].cache local only, used by the receiving thread of queue i (SP/SC)
+ */
+
 typedef	struct {
-	/* TX */
+	/* TX, one ring pair per output queue */
 	struct  {
 		_ring_t	*send; /**< ODP ring for IPC msg packets
 					    indexes transmitted to shared
@@ -79,8 +100,9 @@ typedef	struct {
 		_ring_t	*free; /**< ODP ring for IPC msg packets
 					    indexes already processed by remote
 					    process */
-	} tx;
-	/* RX */
+		odp_ticketlock_t lock; /**< Queue lock */
+	} tx[PKTIO_IPC_QUEUES_MAX];
+	/* RX, one ring pair per input queue */
 	struct {
 		_ring_t	*recv; /**< ODP ring for IPC msg packets
 					    indexes received from shared
@@ -89,7 +111,13 @@ typedef	struct {
 					    indexes already processed by
 					    current process */
 		_ring_t	*cache; /**< local cache to keep packet order right */
-	} rx; /* slave */
+		odp_ticketlock_t lock; /**< Queue lock */
+	} rx[PKTIO_IPC_QUEUES_MAX]; /* slave */
+	int		num_queues;		/**< Number of shared ring sets
+						     created or mapped */
+	int		num_cache;		/**< Number of local rx caches */
+	odp_bool_t	lockless_rx;		/**< no locking for rx */
+	odp_bool_t	lockless_tx;		/**< no locking for tx */
 	void		*pool_base;		/**< Remote pool base addr */
 	void		*pool_mdata_base;	/**< Remote pool mdata base addr */
 	uint64_t	pkt_size;		/**< Packet size in remote pool */
@@ -106,6 +134,13 @@ typedef	struct {
 	odp_shm_t pinfo_shm;
 	odp_shm_t remote_pool_shm; /**< shm of remote pool get with
 					_ipc_map_remote_pool() */
+	int zero_copy;		/**< 1 - received packets are used in place
+				     from remote pool, 0 - copied */
+	pool_t *remote_pool;	/**< Local descriptor of remote pool in
+				     zero-copy mode */
+	void *remote_pool_ptr;	/**< Remote pool pointer in remote process */
+	uintptr_t remote_delta;	/**< Local minus remote address of remote
+				     pool */
 } _ipc_pktio_t;
 
 struct pktio_entry {
@@ -176,6 +211,22 @@ struct pktio_entry {
 		odp_queue_t        queue;
 		odp_pktout_queue_t pktout;
 	} out_queue[PKTIO_MAX_QUEUES];
+
+	/* Software flow hashing of received packets. When 'spread' is set,
+	 * all pktin event queues share the single driver queue and packets
+	 * are distributed over the event queues by the hash. */
+	struct {
+		flow_hash_alg_t        alg;
+		odp_pktin_hash_proto_t proto;
+		int                    spread;
+	} flow_hash;
+
+	/* Aggregation of received packets into packet vectors */
+	struct {
+		int        enable;
+		odp_pool_t pool;
+		uint32_t   max_size;
+	} vector;
 };
 
 typedef union {
@@ -186,6 +237,7 @@ typedef union {
 typedef struct {
 	odp_spinlock_t lock;
 	pktio_entry_t entries[ODP_CONFIG_PKTIO_ENTRIES];
+	flow_hash_global_t flow_hash;
 } pktio_table_t;
 
 typedef struct pktio_if_ops {
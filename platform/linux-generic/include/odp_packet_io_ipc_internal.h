@@ -26,17 +26,26 @@
  */
 struct pktio_info {
 	struct {
-		/* number of buffer*/
+		/* number of buffer blocks, including blocks skipped by
+		 * the pool */
 		int num;
+		/* base address of the pool in master process */
+		void *base_addr;
 		/* size of packet/segment in remote pool */
 		uint32_t block_size;
+		/* packet segment data length in remote pool */
+		uint32_t seg_len;
 		char pool_name[ODP_POOL_NAME_LEN];
+		/* number of queue ring sets created by master */
+		int num_queues;
 		/* 1 if master finished creation of all shared objects */
 		int init_done;
 	} master;
 	struct {
+		int num;
 		void *base_addr;
 		uint32_t block_size;
+		uint32_t seg_len;
 		char pool_name[ODP_POOL_NAME_LEN];
 		/* pid of the slave process written to shm and
 		 * used by master to look up memory created by
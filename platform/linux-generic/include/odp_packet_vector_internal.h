@@ -0,0 +1,81 @@
+/* Copyright (c) 2017, Linaro Limited
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier:     BSD-3-Clause
+ */
+
+/**
+ * @file
+ *
+ * ODP packet vector descriptor - implementation internal
+ */
+
+#ifndef ODP_PACKET_VECTOR_INTERNAL_H_
+#define ODP_PACKET_VECTOR_INTERNAL_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <odp/api/packet.h>
+#include <odp/api/debug.h>
+#include <odp_buffer_internal.h>
+#include <odp_packet_internal.h>
+#include <odp_pool_internal.h>
+
+/**
+ * Internal packet vector header
+ */
+typedef struct {
+	/* Common buffer header */
+	odp_buffer_hdr_t buf_hdr;
+
+	/* Number of valid packets in the table */
+	uint32_t size;
+
+	/* Packet handle table. Pool data area starts here. */
+	odp_packet_t packet[0];
+
+} odp_packet_vector_hdr_t;
+
+/* Vector headers are stored into the same sized blocks as packet headers */
+ODP_STATIC_ASSERT(sizeof(odp_packet_vector_hdr_t) <= sizeof(odp_packet_hdr_t),
+		  "PACKET_VECTOR_HDR_TOO_LARGE");
+
+static inline odp_packet_vector_hdr_t *pktv_hdr(odp_packet_vector_t pktv)
+{
+	return (odp_packet_vector_hdr_t *)(uintptr_t)pktv;
+}
+
+static inline odp_packet_vector_t pktv_handle(odp_packet_vector_hdr_t *hdr)
+{
+	return (odp_packet_vector_t)hdr;
+}
+
+static inline odp_packet_t *pktv_tbl(odp_packet_vector_hdr_t *hdr)
+{
+	return (odp_packet_t *)(uintptr_t)hdr->buf_hdr.seg[0].data;
+}
+
+/* Allocate up to 'num' empty vectors from a vector pool */
+static inline int pktv_alloc_multi(pool_t *pool, odp_packet_vector_hdr_t *hdr[],
+				   int num)
+{
+	int i, ret;
+
+	ret = buffer_alloc_multi(pool, (odp_buffer_hdr_t **)hdr, num);
+
+	for (i = 0; i < ret; i++)
+		hdr[i]->size = 0;
+
+	return ret;
+}
+
+/* Free vector and all packets in it */
+void pktv_free_full(odp_packet_vector_hdr_t *hdr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -20,31 +20,38 @@ extern "C" {
 
 #include <odp/api/shared_memory.h>
 #include <odp/api/ticketlock.h>
+#include <odp/api/cpumask.h>
 
 #include <odp_buffer_internal.h>
 #include <odp_config_internal.h>
 #include <odp_ring_internal.h>
 #include <odp/api/plat/strong_types.h>
 
+/* Thread local cache of buffer indexes. Caches of a pool are allocated
+ * together with the pool ring, pool->cache_size entries per thread. */
 typedef struct pool_cache_t {
 	uint32_t num;
-	uint32_t buf_index[CONFIG_POOL_CACHE_SIZE];
+	uint32_t buf_index[];
 
-} pool_cache_t ODP_ALIGNED_CACHE;
+} pool_cache_t;
 
 /* Buffer header ring */
 typedef struct {
 	/* Ring header */
 	ring_t   hdr;
 
-	/* Ring data: buffer handles */
-	uint32_t buf[CONFIG_POOL_MAX_NUM];
+	/* Ring data: buffer handles. Ring size is pool->ring_mask + 1. */
+	uint32_t buf[];
 
-} pool_ring_t ODP_ALIGNED_CACHE;
+} pool_ring_t;
 
 /* Callback function for pool destroy */
 typedef void (*pool_destroy_cb_fn)(void *pool);
 
+/* Callback function for freeing buffers of a remote pool */
+typedef void (*pool_free_cb_fn)(void *pool, odp_buffer_hdr_t *buf_hdr[],
+				int num);
+
 typedef struct pool_t {
 	odp_ticketlock_t lock ODP_ALIGNED_CACHE;
 
@@ -75,16 +82,56 @@ typedef struct pool_t {
 	pool_destroy_cb_fn ext_destroy;
 	void            *ext_desc;
 
-	pool_cache_t     local_cache[ODP_THREAD_COUNT_MAX];
+	/* Used by IPC zero-copy pktio. Buffers of a remote pool are owned by
+	 * another ODP instance and are returned to it on free. */
+	pool_free_cb_fn  remote_free;
+	void            *remote_ctx;
 
+	/* Ring, thread local caches and cold metadata share the ring shm
+	 * block. Cold metadata is indexed with the buffer index. */
 	odp_shm_t        ring_shm;
+	uint32_t         ring_shm_size;
+	uint32_t         cache_size;
+	uint32_t         cache_stride;
+	uint32_t         num_thr;
 	pool_ring_t     *ring;
+	uint8_t         *cache_base;
+	uint32_t         cold_size;
+	uint8_t         *cold_base;
+
+	/* NUMA aware pools have a ring per node. Node 'n' is the home node of
+	 * blocks from n * node_blocks to (n + 1) * node_blocks - 1. Other
+	 * pools have a single node. */
+	uint32_t         num_node;
+	uint32_t         node_blocks;
+	uint32_t         node_num[ODP_POOL_NUMA_NODES_MAX];
+	pool_ring_t     *node_ring[ODP_POOL_NUMA_NODES_MAX];
+
+	/* Packet pools with multiple buffer size classes. Class zero is the
+	 * pool itself and other classes are hidden pools, which have the
+	 * handle of the parent pool. Classes are in increasing seg_len order.
+	 * Packets are limited to CONFIG_PACKET_MAX_SEGS segments, so max_len
+	 * of a class may be less than max_len of the pool. Other pools have
+	 * a single class. */
+	uint32_t         num_class;
+	struct pool_t   *class_pool[ODP_POOL_MAX_SUBPARAMS + 1];
+	struct pool_t   *parent;
 
 } pool_t;
 
 typedef struct pool_table_t {
 	pool_t    pool[ODP_CONFIG_POOLS];
 	odp_shm_t shm;
+
+	/* Threads and CPUs for parallel pool init */
+	int           init_threads;
+	odp_cpumask_t init_cpus;
+
+	/* Number of NUMA nodes for NUMA aware pools */
+	uint32_t      num_node;
+
+	/* NUMA node id of each node ring index */
+	int           node_id[ODP_POOL_NUMA_NODES_MAX];
 } pool_table_t;
 
 extern pool_table_t *pool_tbl;
@@ -99,6 +146,15 @@ static inline pool_t *pool_entry_from_hdl(odp_pool_t pool_hdl)
 	return &pool_tbl->pool[_odp_typeval(pool_hdl)];
 }
 
+/* Maximum packet length of a packet pool, or of the parent pool of a buffer
+ * size class. The largest class stores the longest packets. */
+static inline uint32_t pool_max_len(pool_t *pool)
+{
+	pool_t *parent = pool->parent ? pool->parent : pool;
+
+	return parent->class_pool[parent->num_class - 1]->max_len;
+}
+
 static inline odp_buffer_hdr_t *buf_hdl_to_hdr(odp_buffer_t buf)
 {
 	return (odp_buffer_hdr_t *)(uintptr_t)buf;
@@ -107,6 +163,16 @@ static inline odp_buffer_hdr_t *buf_hdl_to_hdr(odp_buffer_t buf)
 int buffer_alloc_multi(pool_t *pool, odp_buffer_hdr_t *buf_hdr[], int num);
 void buffer_free_multi(odp_buffer_hdr_t *buf_hdr[], int num_free);
 
+/* Reserve a pool for buffers which are owned by another ODP instance and
+ * mapped into this process at 'base_addr'. Buffers are never allocated from
+ * a remote pool, freed buffers are passed to 'free_fn'. Handle of the remote
+ * pool is 'local', so that new packets are allocated from that pool. */
+pool_t *pool_create_remote(const char *name, odp_pool_t local,
+			   uint8_t *base_addr, uint32_t num,
+			   uint32_t block_size, uint32_t seg_len,
+			   pool_free_cb_fn free_fn, void *ctx);
+void pool_destroy_remote(pool_t *pool);
+
 #ifdef __cplusplus
 }
 #endif
@@ -20,6 +20,9 @@ extern "C" {
 
 /* Queue API functions */
 typedef struct {
+	/* Fast path functions, called directly from inline API */
+	_odp_queue_api_fn_t fast;
+
 	odp_queue_t (*queue_create)(const char *name,
 				    const odp_queue_param_t *param);
 	int (*queue_destroy)(odp_queue_t queue);
@@ -28,12 +31,6 @@ typedef struct {
 	int (*queue_context_set)(odp_queue_t queue, void *context,
 				 uint32_t len);
 	void *(*queue_context)(odp_queue_t queue);
-	int (*queue_enq)(odp_queue_t queue, odp_event_t ev);
-	int (*queue_enq_multi)(odp_queue_t queue, const odp_event_t events[],
-			       int num);
-	odp_event_t (*queue_deq)(odp_queue_t queue);
-	int (*queue_deq_multi)(odp_queue_t queue, odp_event_t events[],
-			       int num);
 	odp_queue_type_t (*queue_type)(odp_queue_t queue);
 	odp_schedule_sync_t (*queue_sched_type)(odp_queue_t queue);
 	odp_schedule_prio_t (*queue_sched_prio)(odp_queue_t queue);
@@ -35,6 +35,7 @@ typedef int (*schedule_term_local_fn_t)(void);
 typedef void (*schedule_order_lock_fn_t)(void);
 typedef void (*schedule_order_unlock_fn_t)(void);
 typedef unsigned (*schedule_max_ordered_locks_fn_t)(void);
+typedef uint32_t (*schedule_max_queues_fn_t)(void);
 typedef void (*schedule_save_context_fn_t)(uint32_t queue_index);
 
 typedef struct schedule_fn_t {
@@ -54,6 +55,7 @@ typedef struct schedule_fn_t {
 	schedule_order_lock_fn_t    order_lock;
 	schedule_order_unlock_fn_t  order_unlock;
 	schedule_max_ordered_locks_fn_t max_ordered_locks;
+	schedule_max_queues_fn_t    max_queues;
 
 	/* Called only when status_sync is set */
 	schedule_unsched_queue_fn_t unsched_queue;
@@ -66,22 +68,22 @@ extern const schedule_fn_t *sched_fn;
 
 /* Interface for the scheduler */
 int sched_cb_pktin_poll(int pktio_index, int num_queue, int index[]);
+int sched_cb_pktin_poll_one(int pktio_index, int rx_queue,
+			    odp_event_t evt_tbl[], odp_queue_t *queue);
 void sched_cb_pktio_stop_finalize(int pktio_index);
 odp_queue_t sched_cb_queue_handle(uint32_t queue_index);
 void sched_cb_queue_destroy_finalize(uint32_t queue_index);
 int sched_cb_queue_deq_multi(uint32_t queue_index, odp_event_t ev[], int num);
 int sched_cb_queue_empty(uint32_t queue_index);
+int sched_cb_queue_claim(uint32_t queue_index);
+uint32_t sched_cb_num_queues(void);
 
 /* API functions */
 typedef struct {
+	/* Fast path functions, called directly from inline API */
+	_odp_schedule_api_fn_t fast;
+
 	uint64_t (*schedule_wait_time)(uint64_t);
-	odp_event_t (*schedule)(odp_queue_t *, uint64_t);
-	int (*schedule_multi)(odp_queue_t *, uint64_t, odp_event_t [], int);
-	void (*schedule_pause)(void);
-	void (*schedule_resume)(void);
-	void (*schedule_release_atomic)(void);
-	void (*schedule_release_ordered)(void);
-	void (*schedule_prefetch)(int);
 	int (*schedule_num_prio)(void);
 	odp_schedule_group_t (*schedule_group_create)(const char *,
 						      const odp_thrmask_t *);
@@ -93,8 +95,6 @@ typedef struct {
 	int (*schedule_group_thrmask)(odp_schedule_group_t, odp_thrmask_t *);
 	int (*schedule_group_info)(odp_schedule_group_t,
 				   odp_schedule_group_info_t *);
-	void (*schedule_order_lock)(unsigned);
-	void (*schedule_order_unlock)(unsigned);
 
 } schedule_api_t;
 
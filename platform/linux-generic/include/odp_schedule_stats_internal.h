@@ -0,0 +1,215 @@
+/* Copyright (c) 2017, Linaro Limited
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier:     BSD-3-Clause
+ */
+
+/**
+ * @file
+ *
+ * ODP scheduler statistics - implementation internal
+ *
+ * Statistics are collected only when the implementation is configured with
+ * --enable-schedule-stats. Otherwise, all functions below are empty and
+ * compile away from the scheduler fast path.
+ */
+
+#ifndef ODP_SCHEDULE_STATS_INTERNAL_H_
+#define ODP_SCHEDULE_STATS_INTERNAL_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <odp/api/schedule.h>
+#include <odp/api/time.h>
+#include <odp/api/align.h>
+#include <odp/api/hints.h>
+#include <odp_buffer_internal.h>
+
+#ifdef ODP_SCHEDULE_STATS
+
+/* Per thread statistics. Each thread updates only its own entry. */
+typedef struct ODP_ALIGNED_CACHE {
+	odp_schedule_stats_t s;
+
+	/* Time when the current atomic context was taken, or zero */
+	uint64_t atomic_start;
+
+	/* Ordered stash is being released. Stashed events were stamped when
+	 * those were enqueued into the stash. */
+	int stash_release;
+} sched_stats_t;
+
+extern __thread sched_stats_t *_odp_sched_stats;
+
+int _odp_sched_stats_init_global(void);
+int _odp_sched_stats_term_global(void);
+int _odp_sched_stats_init_local(void);
+
+static inline uint64_t sched_stat_time(void)
+{
+	/* Global time, since events move between threads */
+	return odp_time_to_ns(odp_time_global());
+}
+
+static inline void sched_stat_calls(int num)
+{
+	_odp_sched_stats->s.calls++;
+	_odp_sched_stats->s.events += num;
+}
+
+static inline void sched_stat_empty_poll(void)
+{
+	_odp_sched_stats->s.empty_polls++;
+}
+
+static inline void sched_stat_pktin_poll(void)
+{
+	_odp_sched_stats->s.pktin_polls++;
+}
+
+static inline void sched_stat_atomic_start(void)
+{
+	_odp_sched_stats->atomic_start = sched_stat_time();
+}
+
+static inline void sched_stat_atomic_end(void)
+{
+	uint64_t start = _odp_sched_stats->atomic_start;
+
+	if (start == 0)
+		return;
+
+	_odp_sched_stats->s.atomic_holds++;
+	_odp_sched_stats->s.atomic_hold_ns += sched_stat_time() - start;
+	_odp_sched_stats->atomic_start = 0;
+}
+
+static inline void sched_stat_ordered_wait(uint64_t start)
+{
+	_odp_sched_stats->s.ordered_waits++;
+	_odp_sched_stats->s.ordered_wait_ns += sched_stat_time() - start;
+}
+
+static inline void sched_stat_stash_overflow(void)
+{
+	_odp_sched_stats->s.stash_overflows++;
+}
+
+static inline void sched_stat_stash_release(int release)
+{
+	_odp_sched_stats->stash_release = release;
+}
+
+/* Stamp events with enqueue time */
+static inline void sched_stat_enq(odp_buffer_hdr_t *buf_hdr[], int num)
+{
+	uint64_t now;
+	int i;
+
+	if (_odp_sched_stats->stash_release)
+		return;
+
+	now = sched_stat_time();
+
+	for (i = 0; i < num; i++)
+		buf_hdr[i]->enq_time = now;
+}
+
+/* Update latency histogram with events dequeued for scheduling */
+static inline void sched_stat_deq(odp_event_t ev[], int num)
+{
+	uint64_t now = sched_stat_time();
+	uint64_t *latency = _odp_sched_stats->s.latency;
+	int i;
+
+	for (i = 0; i < num; i++) {
+		odp_buffer_hdr_t *hdr = (odp_buffer_hdr_t *)(uintptr_t)ev[i];
+		uint64_t ns = now - hdr->enq_time;
+		int bucket = 0;
+
+		if (hdr->enq_time > now)
+			ns = 0;
+
+		if (ns > 1)
+			bucket = 63 - __builtin_clzll(ns);
+
+		if (bucket >= ODP_SCHEDULE_LATENCY_BUCKETS)
+			bucket = ODP_SCHEDULE_LATENCY_BUCKETS - 1;
+
+		latency[bucket]++;
+	}
+}
+
+#else
+
+static inline int _odp_sched_stats_init_global(void)
+{
+	return 0;
+}
+
+static inline int _odp_sched_stats_term_global(void)
+{
+	return 0;
+}
+
+static inline int _odp_sched_stats_init_local(void)
+{
+	return 0;
+}
+
+static inline uint64_t sched_stat_time(void)
+{
+	return 0;
+}
+
+static inline void sched_stat_calls(int num ODP_UNUSED)
+{
+}
+
+static inline void sched_stat_empty_poll(void)
+{
+}
+
+static inline void sched_stat_pktin_poll(void)
+{
+}
+
+static inline void sched_stat_atomic_start(void)
+{
+}
+
+static inline void sched_stat_atomic_end(void)
+{
+}
+
+static inline void sched_stat_ordered_wait(uint64_t start ODP_UNUSED)
+{
+}
+
+static inline void sched_stat_stash_overflow(void)
+{
+}
+
+static inline void sched_stat_stash_release(int release ODP_UNUSED)
+{
+}
+
+static inline void sched_stat_enq(odp_buffer_hdr_t *buf_hdr[] ODP_UNUSED,
+				  int num ODP_UNUSED)
+{
+}
+
+static inline void sched_stat_deq(odp_event_t ev[] ODP_UNUSED,
+				  int num ODP_UNUSED)
+{
+}
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
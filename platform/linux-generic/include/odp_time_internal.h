@@ -13,9 +13,20 @@ extern "C" {
 
 #include <stdint.h>
 
+/* Global time counter frequency information */
+typedef struct {
+	/* Counter frequency in hz. Zero when the counter is not used. */
+	uint64_t    hz;
+	/* Where the frequency value came from */
+	const char *src;
+	/* Estimated frequency error in parts per million */
+	uint32_t    err_ppm;
+
+} time_freq_info_t;
+
 int cpu_has_global_time(void);
 uint64_t cpu_global_time(void);
-uint64_t cpu_global_time_freq(void);
+uint64_t cpu_global_time_freq(time_freq_info_t *info);
 
 #ifdef __cplusplus
 }
@@ -22,6 +22,8 @@ AC_CONFIG_FILES([platform/linux-generic/Makefile
 		 platform/linux-generic/test/Makefile
 		 platform/linux-generic/test/validation/api/shmem/Makefile
 		 platform/linux-generic/test/validation/api/pktio/Makefile
+		 platform/linux-generic/test/validation/api/scheduler/Makefile
+		 platform/linux-generic/test/flow_hash/Makefile
 		 platform/linux-generic/test/mmap_vlan_ins/Makefile
 		 platform/linux-generic/test/pktio_ipc/Makefile
 		 platform/linux-generic/test/ring/Makefile
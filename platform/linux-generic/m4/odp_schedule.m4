@@ -13,3 +13,10 @@ AC_ARG_ENABLE([schedule-iquery],
 	AC_DEFINE([ODP_SCHEDULE_IQUERY], [1],
 		  [Define to 1 to enable interests query scheduler])
     fi])
+
+AC_ARG_ENABLE([schedule-stats],
+    [  --enable-schedule-stats    enable scheduler statistics collection],
+    [if test x$enableval = xyes; then
+	AC_DEFINE([ODP_SCHEDULE_STATS], [1],
+		  [Define to 1 to enable scheduler statistics])
+    fi])
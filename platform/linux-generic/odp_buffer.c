@@ -6,6 +6,7 @@
 
 #include "config.h"
 
+#include <odp/api/plat/buffer_inlines.h>
 #include <odp/api/buffer.h>
 #include <odp_pool_internal.h>
 #include <odp_buffer_internal.h>
@@ -16,22 +17,15 @@
 #include <stdio.h>
 #include <inttypes.h>
 
-odp_buffer_t odp_buffer_from_event(odp_event_t ev)
-{
-	return (odp_buffer_t)ev;
-}
+#include <odp/visibility_begin.h>
 
-odp_event_t odp_buffer_to_event(odp_buffer_t buf)
-{
-	return (odp_event_t)buf;
-}
+/* Fill in buffer header field offsets for inline functions */
+const _odp_buffer_inline_offset_t _odp_buffer_inline ODP_ALIGNED_CACHE = {
+	.addr       = offsetof(odp_buffer_hdr_t, seg[0].data),
+	.event_type = offsetof(odp_buffer_hdr_t, event_type)
+};
 
-void *odp_buffer_addr(odp_buffer_t buf)
-{
-	odp_buffer_hdr_t *hdr = buf_hdl_to_hdr(buf);
-
-	return hdr->seg[0].data;
-}
+#include <odp/visibility_end.h>
 
 uint32_t odp_buffer_size(odp_buffer_t buf)
 {
@@ -86,3 +80,8 @@ uint64_t odp_buffer_to_u64(odp_buffer_t hdl)
 {
 	return _odp_pri(hdl);
 }
+
+/* Include non-inlined versions of API functions */
+#if ODP_ABI_COMPAT == 1
+#include <odp/api/plat/buffer_inlines_api.h>
+#endif
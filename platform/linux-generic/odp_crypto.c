@@ -91,7 +91,7 @@ odp_crypto_generic_op_result_t *get_op_result_from_event(odp_event_t ev)
 {
 	odp_packet_hdr_t *hdr = odp_packet_hdr(odp_packet_from_event(ev));
 
-	return &hdr->op_result;
+	return &packet_cold(hdr)->op_result;
 }
 
 static
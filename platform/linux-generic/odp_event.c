@@ -6,6 +6,7 @@
 
 #include "config.h"
 
+#include <odp/api/plat/event_inlines.h>
 #include <odp/api/event.h>
 #include <odp/api/buffer.h>
 #include <odp/api/crypto.h>
@@ -14,13 +15,9 @@
 #include <odp/api/pool.h>
 #include <odp_buffer_internal.h>
 #include <odp_buffer_inlines.h>
+#include <odp_packet_vector_internal.h>
 #include <odp_debug_internal.h>
 
-odp_event_type_t odp_event_type(odp_event_t event)
-{
-	return _odp_buffer_event_type(odp_buffer_from_event(event));
-}
-
 void odp_event_free(odp_event_t event)
 {
 	switch (odp_event_type(event)) {
@@ -36,6 +33,9 @@ void odp_event_free(odp_event_t event)
 	case ODP_EVENT_CRYPTO_COMPL:
 		odp_crypto_compl_free(odp_crypto_compl_from_event(event));
 		break;
+	case ODP_EVENT_PACKET_VECTOR:
+		pktv_free_full(pktv_hdr(odp_packet_vector_from_event(event)));
+		break;
 	default:
 		ODP_ABORT("Invalid event type: %d\n", odp_event_type(event));
 	}
@@ -45,3 +45,8 @@ uint64_t odp_event_to_u64(odp_event_t hdl)
 {
 	return _odp_pri(hdl);
 }
+
+/* Include non-inlined versions of API functions */
+#if ODP_ABI_COMPAT == 1
+#include <odp/api/plat/event_inlines_api.h>
+#endif
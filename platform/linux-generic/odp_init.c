@@ -12,6 +12,7 @@
 #include <unistd.h>
 #include <odp_internal.h>
 #include <odp_schedule_if.h>
+#include <odp_schedule_stats_internal.h>
 #include <string.h>
 #include <stdio.h>
 #include <linux/limits.h>
@@ -78,7 +79,7 @@ int odp_init_global(odp_instance_t *instance,
 	}
 	stage = FDSERVER_INIT;
 
-	if (odp_thread_init_global()) {
+	if (odp_thread_init_global(params)) {
 		ODP_ERR("ODP thread init failed.\n");
 		goto init_failed;
 	}
@@ -96,8 +97,14 @@ int odp_init_global(odp_instance_t *instance,
 	}
 	stage = QUEUE_INIT;
 
+	if (_odp_sched_stats_init_global()) {
+		ODP_ERR("ODP schedule stats init failed.\n");
+		goto init_failed;
+	}
+
 	if (sched_fn->init_global()) {
 		ODP_ERR("ODP schedule init failed.\n");
+		_odp_sched_stats_term_global();
 		goto init_failed;
 	}
 	stage = SCHED_INIT;
@@ -208,6 +215,11 @@ int _odp_term_global(enum init_stage stage)
 			ODP_ERR("ODP schedule term failed.\n");
 			rc = -1;
 		}
+
+		if (_odp_sched_stats_term_global()) {
+			ODP_ERR("ODP schedule stats term failed.\n");
+			rc = -1;
+		}
 		/* Fall through */
 
 	case QUEUE_INIT:
@@ -312,6 +324,11 @@ int odp_init_local(odp_instance_t instance, odp_thread_type_t thr_type)
 	}
 	stage = QUEUE_INIT;
 
+	if (_odp_sched_stats_init_local()) {
+		ODP_ERR("ODP schedule stats local init failed.\n");
+		goto init_fail;
+	}
+
 	if (sched_fn->init_local()) {
 		ODP_ERR("ODP schedule local init failed.\n");
 		goto init_fail;
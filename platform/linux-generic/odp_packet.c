@@ -23,6 +23,10 @@
 #include <stdio.h>
 #include <inttypes.h>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 #include <odp/visibility_begin.h>
 
 /* Fill in packet header field offsets for inline functions */
@@ -158,6 +162,121 @@ static inline void seg_entry_find_offset(odp_packet_hdr_t **p_hdr,
 	*seg_idx = i;
 }
 
+/* Segment iterator for walking packet data without re-resolving the offset
+ * for every segment */
+typedef struct {
+	odp_packet_hdr_t *hdr;
+	uint8_t idx;
+	uint8_t *data;
+	uint32_t len;
+} seg_iter_t;
+
+static inline void seg_iter_init(seg_iter_t *it, odp_packet_hdr_t *pkt_hdr,
+				 uint32_t offset)
+{
+	seg_entry_t *seg;
+	uint32_t seg_offset, seg_idx;
+
+	if (odp_likely(CONFIG_PACKET_SEG_DISABLED ||
+		       pkt_hdr->buf_hdr.segcount == 1)) {
+		it->hdr  = pkt_hdr;
+		it->idx  = 0;
+		it->data = pkt_hdr->buf_hdr.seg[0].data + offset;
+		it->len  = pkt_hdr->buf_hdr.seg[0].len - offset;
+		return;
+	}
+
+	it->hdr = pkt_hdr;
+	it->idx = 0;
+	seg_entry_find_offset(&it->hdr, &it->idx, &seg_offset, &seg_idx,
+			      offset);
+	seg = seg_entry_next(&it->hdr, &it->idx);
+	it->data = seg->data + seg_offset;
+	it->len  = seg->len - seg_offset;
+}
+
+/* Step to the next segment. Caller ensures that there is one. */
+static inline void seg_iter_next(seg_iter_t *it)
+{
+	seg_entry_t *seg = seg_entry_next(&it->hdr, &it->idx);
+
+	it->data = seg->data;
+	it->len  = seg->len;
+}
+
+#ifdef __SSE2__
+/* Copy with non-temporal stores. Destination is aligned to 16 bytes first,
+ * source may be unaligned. Caller issues the store fence. */
+static void packet_memcpy_nt(uint8_t *dst, const uint8_t *src, uint32_t len)
+{
+	uint32_t head = (16 - ((uintptr_t)dst & 15)) & 15;
+	__m128i a, b, c, d;
+
+	if (len < head + 64) {
+		memcpy(dst, src, len);
+		return;
+	}
+
+	memcpy(dst, src, head);
+	dst += head;
+	src += head;
+	len -= head;
+
+	while (len >= 64) {
+		a = _mm_loadu_si128((const __m128i *)(uintptr_t)src);
+		b = _mm_loadu_si128((const __m128i *)(uintptr_t)(src + 16));
+		c = _mm_loadu_si128((const __m128i *)(uintptr_t)(src + 32));
+		d = _mm_loadu_si128((const __m128i *)(uintptr_t)(src + 48));
+		_mm_stream_si128((__m128i *)(uintptr_t)dst, a);
+		_mm_stream_si128((__m128i *)(uintptr_t)(dst + 16), b);
+		_mm_stream_si128((__m128i *)(uintptr_t)(dst + 32), c);
+		_mm_stream_si128((__m128i *)(uintptr_t)(dst + 48), d);
+		dst += 64;
+		src += 64;
+		len -= 64;
+	}
+
+	memcpy(dst, src, len);
+}
+#endif
+
+/* Packet data copy. Non-temporal stores are used when 'nt' is set and
+ * supported by the CPU. */
+static inline void packet_memcpy(void *dst, const void *src, uint32_t len,
+				 int nt)
+{
+#ifdef __SSE2__
+	if (nt) {
+		packet_memcpy_nt(dst, src, len);
+		return;
+	}
+#else
+	(void)nt;
+#endif
+	memcpy(dst, src, len);
+}
+
+static inline int packet_copy_nt(uint32_t len)
+{
+#ifdef __SSE2__
+	return len >= CONFIG_PACKET_COPY_NT_LEN;
+#else
+	(void)len;
+	return 0;
+#endif
+}
+
+/* Order non-temporal stores before any following stores */
+static inline void packet_copy_fence(int nt)
+{
+#ifdef __SSE2__
+	if (nt)
+		_mm_sfence();
+#else
+	(void)nt;
+#endif
+}
+
 static inline uint32_t packet_seg_len(odp_packet_hdr_t *pkt_hdr,
 				      uint32_t seg_idx)
 {
@@ -201,7 +320,7 @@ static inline void *packet_tail(odp_packet_hdr_t *pkt_hdr)
 static inline uint32_t seg_headroom(odp_packet_hdr_t *pkt_hdr, int seg_idx)
 {
 	seg_entry_t *seg = seg_entry(pkt_hdr, seg_idx);
-	odp_buffer_hdr_t *hdr = seg->hdr;
+	odp_packet_hdr_t *hdr = seg->hdr;
 	uint8_t *base = hdr->base_data;
 	uint8_t *head = seg->data;
 
@@ -212,7 +331,7 @@ static inline uint32_t seg_tailroom(odp_packet_hdr_t *pkt_hdr, int seg_idx)
 {
 	seg_entry_t *seg = seg_entry(pkt_hdr, seg_idx);
 
-	odp_buffer_hdr_t *hdr = seg->hdr;
+	odp_packet_hdr_t *hdr = seg->hdr;
 	uint8_t *tail         = seg->data + seg->len;
 
 	return hdr->buf_end - tail;
@@ -260,7 +379,7 @@ static inline void packet_seg_copy_md(odp_packet_hdr_t *dst,
 	dst->dst_queue = src->dst_queue;
 	dst->flow_hash = src->flow_hash;
 	dst->timestamp = src->timestamp;
-	dst->op_result = src->op_result;
+	*packet_cold(dst) = *packet_cold(src);
 
 	/* buffer header side packet metadata */
 	dst->buf_hdr.buf_u64    = src->buf_hdr.buf_u64;
@@ -348,7 +467,7 @@ static inline void link_segments(odp_packet_hdr_t *pkt_hdr[], int num)
 
 			buf_hdr = &pkt_hdr[cur]->buf_hdr;
 			hdr->buf_hdr.seg[i].hdr  = buf_hdr;
-			hdr->buf_hdr.seg[i].data = buf_hdr->base_data;
+			hdr->buf_hdr.seg[i].data = pkt_hdr[cur]->base_data;
 			hdr->buf_hdr.seg[i].len  = seg_len;
 
 			/* init_segments() handles first seg ref_cnt init */
@@ -386,7 +505,7 @@ static inline void init_segments(odp_packet_hdr_t *pkt_hdr[], int num)
 	seg_len = ((pool_t *)(hdr->buf_hdr.pool_ptr))->seg_len;
 
 	/* Defaults for single segment packet */
-	hdr->buf_hdr.seg[0].data = hdr->buf_hdr.base_data;
+	hdr->buf_hdr.seg[0].data = hdr->base_data;
 	hdr->buf_hdr.seg[0].len  = seg_len;
 
 	if (ODP_DEBUG == 1) {
@@ -420,7 +539,7 @@ static inline void reset_seg(odp_packet_hdr_t *pkt_hdr, int first, int num)
 	seg_entry_find_idx(&hdr, &idx, first);
 
 	for (i = 0; i < num; i++) {
-		base = hdr->buf_hdr.base_data;
+		base = hdr->base_data;
 		seg = seg_entry_next(&hdr, &idx);
 		seg->len  = seg_len;
 		seg->data = base;
@@ -528,15 +647,20 @@ static inline int seg_is_link(void *hdr)
 	return pkt_hdr != pkt_hdr->buf_hdr.seg[0].hdr;
 }
 
-static inline void buffer_ref_inc(odp_buffer_hdr_t *buf_hdr)
+static inline void buffer_ref_add(odp_buffer_hdr_t *buf_hdr, uint32_t num)
 {
 	uint32_t ref_cnt = odp_atomic_load_u32(&buf_hdr->ref_cnt);
 
 	/* First count increment after alloc */
 	if (odp_likely(ref_cnt) == 0)
-		odp_atomic_store_u32(&buf_hdr->ref_cnt, 2);
+		odp_atomic_store_u32(&buf_hdr->ref_cnt, num + 1);
 	else
-		odp_atomic_inc_u32(&buf_hdr->ref_cnt);
+		odp_atomic_add_u32(&buf_hdr->ref_cnt, num);
+}
+
+static inline void buffer_ref_inc(odp_buffer_hdr_t *buf_hdr)
+{
+	buffer_ref_add(buf_hdr, 1);
 }
 
 static inline uint32_t buffer_ref_dec(odp_buffer_hdr_t *buf_hdr)
@@ -799,34 +923,57 @@ static inline int packet_alloc(pool_t *pool, uint32_t len, int max_pkt,
 	return num;
 }
 
+/* Allocate from the smallest buffer size class which stores 'len' bytes in
+ * a single segment. Only the largest class chains segments. When a class
+ * runs out of buffers, larger classes are tried. */
+static int packet_alloc_class(pool_t *pool, uint32_t len, int max_num,
+			      odp_packet_t pkt[])
+{
+	uint32_t i;
+	int num = 0;
+
+	if (odp_likely(pool->num_class == 1))
+		return packet_alloc(pool, len, max_num,
+				    num_segments(len, pool->seg_len), pkt);
+
+	for (i = 0; i < pool->num_class - 1; i++)
+		if (len <= pool->class_pool[i]->seg_len)
+			break;
+
+	for (; i < pool->num_class && num < max_num; i++) {
+		pool_t *class = pool->class_pool[i];
+
+		num += packet_alloc(class, len, max_num - num,
+				    num_segments(len, class->seg_len),
+				    &pkt[num]);
+	}
+
+	return num;
+}
+
 int packet_alloc_multi(odp_pool_t pool_hdl, uint32_t len,
 		       odp_packet_t pkt[], int max_num)
 {
 	pool_t *pool = pool_entry_from_hdl(pool_hdl);
-	int num, num_seg;
-
-	num_seg = num_segments(len, pool->seg_len);
-	num     = packet_alloc(pool, len, max_num, num_seg, pkt);
 
-	return num;
+	return packet_alloc_class(pool, len, max_num, pkt);
 }
 
 odp_packet_t odp_packet_alloc(odp_pool_t pool_hdl, uint32_t len)
 {
 	pool_t *pool = pool_entry_from_hdl(pool_hdl);
 	odp_packet_t pkt;
-	int num, num_seg;
+	int num;
 
 	if (odp_unlikely(pool->params.type != ODP_POOL_PACKET)) {
 		__odp_errno = EINVAL;
 		return ODP_PACKET_INVALID;
 	}
 
-	if (odp_unlikely(len > pool->max_len))
+	if (odp_unlikely(len > pool_max_len(pool)))
 		return ODP_PACKET_INVALID;
 
-	num_seg = num_segments(len, pool->seg_len);
-	num     = packet_alloc(pool, len, 1, num_seg, &pkt);
+	num = packet_alloc_class(pool, len, 1, &pkt);
 
 	if (odp_unlikely(num == 0))
 		return ODP_PACKET_INVALID;
@@ -838,20 +985,16 @@ int odp_packet_alloc_multi(odp_pool_t pool_hdl, uint32_t len,
 			   odp_packet_t pkt[], int max_num)
 {
 	pool_t *pool = pool_entry_from_hdl(pool_hdl);
-	int num, num_seg;
 
 	if (odp_unlikely(pool->params.type != ODP_POOL_PACKET)) {
 		__odp_errno = EINVAL;
 		return -1;
 	}
 
-	if (odp_unlikely(len > pool->max_len))
+	if (odp_unlikely(len > pool_max_len(pool)))
 		return -1;
 
-	num_seg = num_segments(len, pool->seg_len);
-	num     = packet_alloc(pool, len, max_num, num_seg, pkt);
-
-	return num;
+	return packet_alloc_class(pool, len, max_num, pkt);
 }
 
 void odp_packet_free(odp_packet_t pkt)
@@ -929,22 +1072,6 @@ int odp_packet_reset(odp_packet_t pkt, uint32_t len)
 	return 0;
 }
 
-odp_packet_t odp_packet_from_event(odp_event_t ev)
-{
-	if (odp_unlikely(ev == ODP_EVENT_INVALID))
-		return ODP_PACKET_INVALID;
-
-	return (odp_packet_t)buf_to_packet_hdr((odp_buffer_t)ev);
-}
-
-odp_event_t odp_packet_to_event(odp_packet_t pkt)
-{
-	if (odp_unlikely(pkt == ODP_PACKET_INVALID))
-		return ODP_EVENT_INVALID;
-
-	return (odp_event_t)buffer_handle(packet_hdr(pkt));
-}
-
 /*
  *
  * Pointers and lengths
@@ -988,20 +1115,31 @@ int odp_packet_extend_head(odp_packet_t *pkt, uint32_t len,
 
 	if (len > headroom) {
 		pool_t *pool = pkt_hdr->buf_hdr.pool_ptr;
-		int num;
-		void *ptr;
-
-		if (odp_unlikely((frame_len + len) > pool->max_len))
-			return -1;
-
-		num = num_segments(len - headroom, pool->seg_len);
-		push_head(pkt_hdr, headroom);
-		ptr = add_segments(pkt_hdr, pool, len - headroom, num, 1);
+		int num = num_segments(len - headroom, pool->seg_len);
+		void *ptr = NULL;
+
+		if (odp_likely((frame_len + len) <= pool->max_len &&
+			       pkt_hdr->buf_hdr.segcount + num <=
+			       CONFIG_PACKET_MAX_SEGS)) {
+			push_head(pkt_hdr, headroom);
+			ptr = add_segments(pkt_hdr, pool, len - headroom, num,
+					   1);
+
+			if (ptr == NULL) {
+				/* segment alloc failed, rollback changes */
+				pull_head(pkt_hdr, headroom);
+			}
+		}
 
 		if (ptr == NULL) {
-			/* segment alloc failed, rollback changes */
-			pull_head(pkt_hdr, headroom);
-			return -1;
+			/* Copy into a new packet, which may be from a larger
+			 * buffer size class */
+			if (frame_len + len > pool_max_len(pool) ||
+			    odp_packet_add_data(pkt, 0, len) < 0)
+				return -1;
+
+			ptr = packet_hdr(*pkt);
+			ret = 1;
 		}
 
 		*pkt    = packet_handle(ptr);
@@ -1094,20 +1232,31 @@ int odp_packet_extend_tail(odp_packet_t *pkt, uint32_t len,
 
 	if (len > tailroom) {
 		pool_t *pool = pkt_hdr->buf_hdr.pool_ptr;
-		int num;
-		void *ptr;
-
-		if (odp_unlikely((frame_len + len) > pool->max_len))
-			return -1;
-
-		num = num_segments(len - tailroom, pool->seg_len);
-		push_tail(pkt_hdr, tailroom);
-		ptr = add_segments(pkt_hdr, pool, len - tailroom, num, 0);
+		int num = num_segments(len - tailroom, pool->seg_len);
+		void *ptr = NULL;
+
+		if (odp_likely((frame_len + len) <= pool->max_len &&
+			       pkt_hdr->buf_hdr.segcount + num <=
+			       CONFIG_PACKET_MAX_SEGS)) {
+			push_tail(pkt_hdr, tailroom);
+			ptr = add_segments(pkt_hdr, pool, len - tailroom, num,
+					   0);
+
+			if (ptr == NULL) {
+				/* segment alloc failed, rollback changes */
+				pull_tail(pkt_hdr, tailroom);
+			}
+		}
 
 		if (ptr == NULL) {
-			/* segment alloc failed, rollback changes */
-			pull_tail(pkt_hdr, tailroom);
-			return -1;
+			/* Copy into a new packet, which may be from a larger
+			 * buffer size class */
+			if (frame_len + len > pool_max_len(pool) ||
+			    odp_packet_add_data(pkt, tail_off, len) < 0)
+				return -1;
+
+			pkt_hdr = packet_hdr(*pkt);
+			ret = 1;
 		}
 	} else {
 		push_tail(pkt_hdr, len);
@@ -1452,8 +1601,13 @@ int odp_packet_concat(odp_packet_t *dst, odp_packet_t src)
 
 	ODP_ASSERT(odp_packet_has_ref(*dst) == 0);
 
-	/* Do a copy if packets are from different pools. */
-	if (odp_unlikely(dst_pool != src_pool)) {
+	/* Do a copy if packets are from different pools, if linked
+	 * segments would exceed the segment limit, or if segments are owned
+	 * by a remote pool. */
+	if (odp_unlikely(dst_pool != src_pool ||
+			 dst_pool->remote_free != NULL ||
+			 (uint32_t)dst_hdr->buf_hdr.segcount +
+			 src_hdr->buf_hdr.segcount > CONFIG_PACKET_MAX_SEGS)) {
 		if (odp_packet_extend_tail(dst, src_len, NULL, NULL) >= 0) {
 			(void)odp_packet_copy_from_pkt(*dst, dst_len,
 						       src, 0, src_len);
@@ -1536,48 +1690,62 @@ odp_packet_t odp_packet_copy_part(odp_packet_t pkt, uint32_t offset,
 int odp_packet_copy_to_mem(odp_packet_t pkt, uint32_t offset,
 			   uint32_t len, void *dst)
 {
-	void *mapaddr;
-	uint32_t seglen = 0; /* GCC */
+	seg_iter_t it;
 	uint32_t cpylen;
 	uint8_t *dstaddr = (uint8_t *)dst;
 	odp_packet_hdr_t *pkt_hdr = packet_hdr(pkt);
+	int nt = packet_copy_nt(len);
 
 	if (offset + len > pkt_hdr->frame_len)
 		return -1;
 
+	seg_iter_init(&it, pkt_hdr, offset);
+
 	while (len > 0) {
-		mapaddr = packet_map(pkt_hdr, offset, &seglen, NULL);
-		cpylen = len > seglen ? seglen : len;
-		memcpy(dstaddr, mapaddr, cpylen);
-		offset  += cpylen;
+		if (it.len == 0)
+			seg_iter_next(&it);
+
+		cpylen = len > it.len ? it.len : len;
+		packet_memcpy(dstaddr, it.data, cpylen, nt);
+		it.data += cpylen;
+		it.len  -= cpylen;
 		dstaddr += cpylen;
 		len     -= cpylen;
 	}
 
+	packet_copy_fence(nt);
+
 	return 0;
 }
 
 int odp_packet_copy_from_mem(odp_packet_t pkt, uint32_t offset,
 			     uint32_t len, const void *src)
 {
-	void *mapaddr;
-	uint32_t seglen = 0; /* GCC */
+	seg_iter_t it;
 	uint32_t cpylen;
 	const uint8_t *srcaddr = (const uint8_t *)src;
 	odp_packet_hdr_t *pkt_hdr = packet_hdr(pkt);
+	int nt = packet_copy_nt(len);
 
 	if (offset + len > pkt_hdr->frame_len)
 		return -1;
 
+	seg_iter_init(&it, pkt_hdr, offset);
+
 	while (len > 0) {
-		mapaddr = packet_map(pkt_hdr, offset, &seglen, NULL);
-		cpylen = len > seglen ? seglen : len;
-		memcpy(mapaddr, srcaddr, cpylen);
-		offset  += cpylen;
+		if (it.len == 0)
+			seg_iter_next(&it);
+
+		cpylen = len > it.len ? it.len : len;
+		packet_memcpy(it.data, srcaddr, cpylen, nt);
+		it.data += cpylen;
+		it.len  -= cpylen;
 		srcaddr += cpylen;
 		len     -= cpylen;
 	}
 
+	packet_copy_fence(nt);
+
 	return 0;
 }
 
@@ -1587,12 +1755,9 @@ int odp_packet_copy_from_pkt(odp_packet_t dst, uint32_t dst_offset,
 {
 	odp_packet_hdr_t *dst_hdr = packet_hdr(dst);
 	odp_packet_hdr_t *src_hdr = packet_hdr(src);
-	void *dst_map;
-	void *src_map;
-	uint32_t cpylen, minseg;
-	uint32_t dst_seglen = 0; /* GCC */
-	uint32_t src_seglen = 0; /* GCC */
-	int overlap;
+	seg_iter_t dst_it, src_it;
+	uint32_t cpylen;
+	int overlap, nt;
 
 	if (dst_offset + len > dst_hdr->frame_len ||
 	    src_offset + len > src_hdr->frame_len)
@@ -1615,23 +1780,35 @@ int odp_packet_copy_from_pkt(odp_packet_t dst, uint32_t dst_offset,
 		return 0;
 	}
 
+	nt = !overlap && packet_copy_nt(len);
+
+	/* Walk source and destination segments in lock-step */
+	seg_iter_init(&dst_it, dst_hdr, dst_offset);
+	seg_iter_init(&src_it, src_hdr, src_offset);
+
 	while (len > 0) {
-		dst_map = packet_map(dst_hdr, dst_offset, &dst_seglen, NULL);
-		src_map = packet_map(src_hdr, src_offset, &src_seglen, NULL);
+		if (dst_it.len == 0)
+			seg_iter_next(&dst_it);
+		if (src_it.len == 0)
+			seg_iter_next(&src_it);
 
-		minseg = dst_seglen > src_seglen ? src_seglen : dst_seglen;
-		cpylen = len > minseg ? minseg : len;
+		cpylen = dst_it.len > src_it.len ? src_it.len : dst_it.len;
+		cpylen = len > cpylen ? cpylen : len;
 
 		if (overlap)
-			memmove(dst_map, src_map, cpylen);
+			memmove(dst_it.data, src_it.data, cpylen);
 		else
-			memcpy(dst_map, src_map, cpylen);
+			packet_memcpy(dst_it.data, src_it.data, cpylen, nt);
 
-		dst_offset += cpylen;
-		src_offset += cpylen;
-		len        -= cpylen;
+		dst_it.data += cpylen;
+		dst_it.len  -= cpylen;
+		src_it.data += cpylen;
+		src_it.len  -= cpylen;
+		len         -= cpylen;
 	}
 
+	packet_copy_fence(nt);
+
 	return 0;
 }
 
@@ -1649,22 +1826,57 @@ int odp_packet_move_data(odp_packet_t pkt, uint32_t dst_offset,
 					pkt, src_offset, len);
 }
 
+int odp_packet_cmp_mem(odp_packet_t pkt, uint32_t offset, const void *src,
+		       uint32_t len)
+{
+	seg_iter_t it;
+	uint32_t cmplen;
+	int ret;
+	const uint8_t *srcaddr = (const uint8_t *)src;
+	odp_packet_hdr_t *pkt_hdr = packet_hdr(pkt);
+
+	ODP_ASSERT(offset + len <= pkt_hdr->frame_len);
+
+	seg_iter_init(&it, pkt_hdr, offset);
+
+	while (len > 0) {
+		if (it.len == 0)
+			seg_iter_next(&it);
+
+		cmplen = len > it.len ? it.len : len;
+		ret = memcmp(it.data, srcaddr, cmplen);
+		if (ret)
+			return ret;
+
+		it.data += cmplen;
+		it.len  -= cmplen;
+		srcaddr += cmplen;
+		len     -= cmplen;
+	}
+
+	return 0;
+}
+
 int _odp_packet_set_data(odp_packet_t pkt, uint32_t offset,
 			 uint8_t c, uint32_t len)
 {
-	void *mapaddr;
-	uint32_t seglen = 0; /* GCC */
+	seg_iter_t it;
 	uint32_t setlen;
 	odp_packet_hdr_t *pkt_hdr = packet_hdr(pkt);
 
 	if (offset + len > pkt_hdr->frame_len)
 		return -1;
 
+	seg_iter_init(&it, pkt_hdr, offset);
+
 	while (len > 0) {
-		mapaddr = packet_map(pkt_hdr, offset, &seglen, NULL);
-		setlen = len > seglen ? seglen : len;
-		memset(mapaddr, c, setlen);
-		offset  += setlen;
+		if (it.len == 0)
+			seg_iter_next(&it);
+
+		setlen = len > it.len ? it.len : len;
+		memset(it.data, c, setlen);
+		it.data += setlen;
+		it.len  -= setlen;
 		len     -= setlen;
 	}
 
@@ -1999,6 +2211,239 @@ static inline void parse_udp(packet_parser_t *prs,
 	*parseptr += sizeof(_odp_udphdr_t);
 }
 
+/**
+ * Parse L3 and L4 headers of a packet
+ *
+ * Parsing starts from 'parseptr', which is 'offset' bytes from the beginning
+ * of the frame. Protocol of the L3 header is defined by 'ethtype'.
+ */
+static inline int packet_parse_l3_l4(packet_parser_t *prs,
+				     const uint8_t *parseptr, uint32_t offset,
+				     uint32_t frame_len, uint32_t seg_len,
+				     odp_pktio_parser_layer_t layer,
+				     uint16_t ethtype)
+{
+	uint8_t ip_proto;
+
+	/* Set l3_offset+flag only for known ethtypes */
+	prs->l3_offset = offset;
+	prs->input_flags.l3 = 1;
+
+	/* Parse Layer 3 headers */
+	switch (ethtype) {
+	case _ODP_ETHTYPE_IPV4:
+		prs->input_flags.ipv4 = 1;
+		ip_proto = parse_ipv4(prs, &parseptr, &offset, frame_len);
+		break;
+
+	case _ODP_ETHTYPE_IPV6:
+		prs->input_flags.ipv6 = 1;
+		ip_proto = parse_ipv6(prs, &parseptr, &offset, frame_len,
+				      seg_len);
+		break;
+
+	case _ODP_ETHTYPE_ARP:
+		prs->input_flags.arp = 1;
+		ip_proto = 255;  /* Reserved invalid by IANA */
+		break;
+
+	default:
+		prs->input_flags.l3 = 0;
+		prs->l3_offset = ODP_PACKET_OFFSET_INVALID;
+		ip_proto = 255;  /* Reserved invalid by IANA */
+	}
+
+	if (layer == ODP_PKTIO_PARSER_LAYER_L3)
+		return prs->error_flags.all != 0;
+
+	/* Set l4_offset+flag only for known ip_proto */
+	prs->l4_offset = offset;
+	prs->input_flags.l4 = 1;
+
+	/* Parse Layer 4 headers */
+	switch (ip_proto) {
+	case _ODP_IPPROTO_ICMPv4:
+	/* Fall through */
+
+	case _ODP_IPPROTO_ICMPv6:
+		prs->input_flags.icmp = 1;
+		break;
+
+	case _ODP_IPPROTO_TCP:
+		if (odp_unlikely(offset + _ODP_TCPHDR_LEN > seg_len))
+			return -1;
+		prs->input_flags.tcp = 1;
+		parse_tcp(prs, &parseptr, NULL);
+		break;
+
+	case _ODP_IPPROTO_UDP:
+		if (odp_unlikely(offset + _ODP_UDPHDR_LEN > seg_len))
+			return -1;
+		prs->input_flags.udp = 1;
+		parse_udp(prs, &parseptr, NULL);
+		break;
+
+	case _ODP_IPPROTO_AH:
+		prs->input_flags.ipsec = 1;
+		prs->input_flags.ipsec_ah = 1;
+		break;
+
+	case _ODP_IPPROTO_ESP:
+		prs->input_flags.ipsec = 1;
+		prs->input_flags.ipsec_esp = 1;
+		break;
+
+	case _ODP_IPPROTO_SCTP:
+		prs->input_flags.sctp = 1;
+		break;
+
+	default:
+		prs->input_flags.l4 = 0;
+		prs->l4_offset = ODP_PACKET_OFFSET_INVALID;
+		break;
+	}
+
+	return prs->error_flags.all != 0;
+}
+
+/* Ethertype followed by the first byte of IPv4 header (version and IHL) of
+ * IPv4 packets without options, and by the version nibble of IPv6 packets */
+#define FAST_PARSE_IPV4 (((uint64_t)_ODP_ETHTYPE_IPV4 << 8) | 0x45)
+#define FAST_PARSE_IPV6 (((uint64_t)_ODP_ETHTYPE_IPV6 << 4) | 0x6)
+
+/* Shortest frame which may match the fast parser */
+#define FAST_PARSE_MIN_LEN (_ODP_ETHHDR_LEN + _ODP_VLANHDR_LEN + \
+			    _ODP_IPV4HDR_LEN + _ODP_UDPHDR_LEN)
+
+/* Prefetch distance of the burst parser in packets. Packet metadata is
+ * prefetched twice as far ahead, so that the data pointer of a packet is in
+ * cache when its data is prefetched. */
+#define PARSE_PREFETCH_DIST 4
+
+static inline uint64_t parse_load_be64(const uint8_t *ptr)
+{
+	uint64_t val;
+
+	memcpy(&val, ptr, sizeof(val));
+
+	return odp_be_to_cpu_64(val);
+}
+
+/**
+ * Parser fast path for the most common header shapes
+ *
+ * Handles Ethernet frames with zero or one VLAN tag, which carry TCP or UDP
+ * over IPv4 without options and fragmentation or over IPv6 without extension
+ * headers. Ethertype and IP version are checked with a single 64-bit compare.
+ * Returns non-zero without modifying parse results for other packets and
+ * for packets with errors.
+ */
+static inline int packet_parse_fast(packet_parser_t *prs, const uint8_t *ptr,
+				    uint32_t frame_len, uint32_t seg_len)
+{
+	_odp_packet_input_flags_t flags;
+	uint32_t l3_offset = _ODP_ETHHDR_LEN;
+	uint32_t l4_offset, l3_len;
+	uint64_t mac, word;
+	uint8_t ip_proto;
+
+	if (odp_unlikely(seg_len < FAST_PARSE_MIN_LEN))
+		return -1;
+
+	flags.all = 0;
+
+	/* Destination MAC address and ethertype followed by six bytes */
+	mac  = parse_load_be64(ptr);
+	word = parse_load_be64(ptr + l3_offset - 2);
+
+	if ((word >> 48) == _ODP_ETHTYPE_VLAN) {
+		flags.vlan = 1;
+		l3_offset += _ODP_VLANHDR_LEN;
+		word = parse_load_be64(ptr + l3_offset - 2);
+	}
+
+	if ((word >> 40) == FAST_PARSE_IPV4) {
+		const _odp_ipv4hdr_t *ipv4;
+		uint32_t dstaddr;
+		uint16_t frag_offset;
+
+		l4_offset = l3_offset + _ODP_IPV4HDR_LEN;
+		if (odp_unlikely(l4_offset + _ODP_UDPHDR_LEN > seg_len))
+			return -1;
+
+		ipv4 = (const _odp_ipv4hdr_t *)(uintptr_t)(ptr + l3_offset);
+		frag_offset = odp_be_to_cpu_16(ipv4->frag_offset);
+		if (_ODP_IPV4HDR_IS_FRAGMENT(frag_offset))
+			return -1;
+
+		l3_len   = (word >> 16) & 0xffff;
+		ip_proto = ipv4->proto;
+		dstaddr  = odp_be_to_cpu_32(ipv4->dst_addr);
+
+		flags.ipv4     = 1;
+		flags.ip_bcast = dstaddr == 0xffffffff;
+		flags.ip_mcast = (dstaddr >> 28) == 0xd;
+	} else if ((word >> 44) == FAST_PARSE_IPV6) {
+		const _odp_ipv6hdr_t *ipv6;
+
+		l4_offset = l3_offset + _ODP_IPV6HDR_LEN;
+		if (odp_unlikely(l4_offset + _ODP_UDPHDR_LEN > seg_len))
+			return -1;
+
+		ipv6 = (const _odp_ipv6hdr_t *)(uintptr_t)(ptr + l3_offset);
+
+		l3_len   = (word & 0xffff) + _ODP_IPV6HDR_LEN;
+		ip_proto = ipv6->next_hdr;
+
+		flags.ipv6     = 1;
+		flags.ip_mcast = ipv6->dst_addr.u8[0] == 0xff;
+	} else {
+		return -1;
+	}
+
+	if (odp_unlikely(l3_len > frame_len - l3_offset))
+		return -1;
+
+	if (ip_proto == _ODP_IPPROTO_TCP) {
+		const _odp_tcphdr_t *tcp;
+
+		if (odp_unlikely(l4_offset + _ODP_TCPHDR_LEN > seg_len))
+			return -1;
+
+		tcp = (const _odp_tcphdr_t *)(uintptr_t)(ptr + l4_offset);
+		if (odp_unlikely(tcp->hl < _ODP_TCPHDR_LEN / 4))
+			return -1;
+
+		flags.tcp    = 1;
+		flags.tcpopt = tcp->hl > _ODP_TCPHDR_LEN / 4;
+	} else if (ip_proto == _ODP_IPPROTO_UDP) {
+		const _odp_udphdr_t *udp;
+
+		udp = (const _odp_udphdr_t *)(uintptr_t)(ptr + l4_offset);
+		if (odp_unlikely(odp_be_to_cpu_16(udp->length) <
+				 _ODP_UDPHDR_LEN))
+			return -1;
+
+		flags.udp = 1;
+	} else {
+		return -1;
+	}
+
+	flags.eth       = 1;
+	flags.l2        = 1;
+	flags.l3        = 1;
+	flags.l4        = 1;
+	flags.jumbo     = frame_len > _ODP_ETH_LEN_MAX;
+	flags.eth_mcast = (mac >> 56) & 0x1;
+	flags.eth_bcast = (mac >> 16) == 0xffffffffffff;
+
+	prs->input_flags.all |= flags.all;
+	prs->l3_offset = l3_offset;
+	prs->l4_offset = l4_offset;
+
+	return 0;
+}
+
 /**
  * Parse common packet headers up to given layer
  *
@@ -2012,7 +2457,6 @@ int packet_parse_common(packet_parser_t *prs, const uint8_t *ptr,
 	uint32_t offset;
 	uint16_t ethtype;
 	const uint8_t *parseptr;
-	uint8_t  ip_proto;
 	const _odp_ethhdr_t *eth;
 	uint16_t macaddr0, macaddr2, macaddr4;
 	const _odp_vlanhdr_t *vlan;
@@ -2020,6 +2464,10 @@ int packet_parse_common(packet_parser_t *prs, const uint8_t *ptr,
 	if (layer == ODP_PKTIO_PARSER_LAYER_NONE)
 		return 0;
 
+	if (layer >= ODP_PKTIO_PARSER_LAYER_L4 &&
+	    packet_parse_fast(prs, ptr, frame_len, seg_len) == 0)
+		return 0;
+
 	/* We only support Ethernet for now */
 	prs->input_flags.eth = 1;
 	/* Assume valid L2 header, no CRC/FCS check in SW */
@@ -2087,98 +2535,169 @@ int packet_parse_common(packet_parser_t *prs, const uint8_t *ptr,
 	if (layer == ODP_PKTIO_PARSER_LAYER_L2)
 		return prs->error_flags.all != 0;
 
-	/* Set l3_offset+flag only for known ethtypes */
-	prs->l3_offset = offset;
-	prs->input_flags.l3 = 1;
+	return packet_parse_l3_l4(prs, parseptr, offset, frame_len, seg_len,
+				  layer, ethtype);
 
-	/* Parse Layer 3 headers */
-	switch (ethtype) {
-	case _ODP_ETHTYPE_IPV4:
-		prs->input_flags.ipv4 = 1;
-		ip_proto = parse_ipv4(prs, &parseptr, &offset, frame_len);
-		break;
+parse_exit:
+	return prs->error_flags.all != 0;
+}
 
-	case _ODP_ETHTYPE_IPV6:
-		prs->input_flags.ipv6 = 1;
-		ip_proto = parse_ipv6(prs, &parseptr, &offset, frame_len,
-				      seg_len);
-		break;
+/**
+ * Simple packet parser
+ */
+int packet_parse_layer(odp_packet_hdr_t *pkt_hdr,
+		       odp_pktio_parser_layer_t layer)
+{
+	uint32_t seg_len = packet_first_seg_len(pkt_hdr);
+	void *base = packet_data(pkt_hdr);
 
-	case _ODP_ETHTYPE_ARP:
-		prs->input_flags.arp = 1;
-		ip_proto = 255;  /* Reserved invalid by IANA */
-		break;
+	return packet_parse_common(&pkt_hdr->p, base, pkt_hdr->frame_len,
+				   seg_len, layer);
+}
 
-	default:
-		prs->input_flags.l3 = 0;
-		prs->l3_offset = ODP_PACKET_OFFSET_INVALID;
-		ip_proto = 255;  /* Reserved invalid by IANA */
+static inline void parse_prefetch(const odp_packet_t pkt[], int i, int num)
+{
+	odp_packet_hdr_t *pkt_hdr;
+
+	if (i + 2 * PARSE_PREFETCH_DIST < num) {
+		pkt_hdr = packet_hdr(pkt[i + 2 * PARSE_PREFETCH_DIST]);
+		odp_prefetch(pkt_hdr);
+		odp_prefetch(&pkt_hdr->p);
 	}
 
-	if (layer == ODP_PKTIO_PARSER_LAYER_L3)
-		return prs->error_flags.all != 0;
+	if (i + PARSE_PREFETCH_DIST < num)
+		odp_prefetch(packet_data(packet_hdr(pkt[i +
+						   PARSE_PREFETCH_DIST])));
+}
 
-	/* Set l4_offset+flag only for known ip_proto */
-	prs->l4_offset = offset;
-	prs->input_flags.l4 = 1;
+static inline void parse_prefetch_first(const odp_packet_t pkt[], int num)
+{
+	odp_packet_hdr_t *pkt_hdr;
+	int i;
 
-	/* Parse Layer 4 headers */
-	switch (ip_proto) {
-	case _ODP_IPPROTO_ICMPv4:
-	/* Fall through */
+	for (i = 0; i < num && i < 2 * PARSE_PREFETCH_DIST; i++) {
+		pkt_hdr = packet_hdr(pkt[i]);
+		odp_prefetch(pkt_hdr);
+		odp_prefetch(&pkt_hdr->p);
+	}
 
-	case _ODP_IPPROTO_ICMPv6:
-		prs->input_flags.icmp = 1;
-		break;
+	for (i = 0; i < num && i < PARSE_PREFETCH_DIST; i++)
+		odp_prefetch(packet_data(packet_hdr(pkt[i])));
+}
 
-	case _ODP_IPPROTO_TCP:
-		if (odp_unlikely(offset + _ODP_TCPHDR_LEN > seg_len))
-			return -1;
-		prs->input_flags.tcp = 1;
-		parse_tcp(prs, &parseptr, NULL);
-		break;
+/**
+ * Burst packet parser
+ *
+ * Headers of following packets are prefetched while parsing a packet.
+ */
+void packet_parse_layer_multi(const odp_packet_t pkt[], int num,
+			      odp_pktio_parser_layer_t layer)
+{
+	int i;
 
-	case _ODP_IPPROTO_UDP:
-		if (odp_unlikely(offset + _ODP_UDPHDR_LEN > seg_len))
-			return -1;
-		prs->input_flags.udp = 1;
-		parse_udp(prs, &parseptr, NULL);
-		break;
+	if (layer == ODP_PKTIO_PARSER_LAYER_NONE)
+		return;
 
-	case _ODP_IPPROTO_AH:
-		prs->input_flags.ipsec = 1;
-		prs->input_flags.ipsec_ah = 1;
-		break;
+	parse_prefetch_first(pkt, num);
 
-	case _ODP_IPPROTO_ESP:
-		prs->input_flags.ipsec = 1;
-		prs->input_flags.ipsec_esp = 1;
+	for (i = 0; i < num; i++) {
+		parse_prefetch(pkt, i, num);
+		packet_parse_layer(packet_hdr(pkt[i]), layer);
+	}
+}
+
+ODP_STATIC_ASSERT((int)ODP_PROTO_LAYER_ALL == (int)ODP_PKTIO_PARSER_LAYER_ALL,
+		  "Protocol and parser layers do not match");
+
+static int packet_parse_offset(odp_packet_hdr_t *pkt_hdr, uint32_t offset,
+			       const odp_packet_parse_param_t *param)
+{
+	packet_parser_t *prs = &pkt_hdr->p;
+	odp_pktio_parser_layer_t layer = (int)param->last_layer;
+	uint32_t len = packet_len(pkt_hdr);
+	uint8_t buf[PACKET_PARSE_SEG_LEN];
+	const uint8_t *ptr;
+	uint32_t seg_len;
+	uint16_t ethtype;
+	int ret;
+
+	if (odp_unlikely(offset >= len))
+		return -1;
+
+	ptr  = packet_map(pkt_hdr, offset, &seg_len, NULL);
+	len -= offset;
+
+	/* The parser expects PACKET_PARSE_SEG_LEN bytes of data */
+	if (odp_unlikely(seg_len < PACKET_PARSE_SEG_LEN)) {
+		if (len > PACKET_PARSE_SEG_LEN)
+			seg_len = PACKET_PARSE_SEG_LEN;
+		else
+			seg_len = len;
+
+		memset(buf, 0, sizeof(buf));
+		odp_packet_copy_to_mem(packet_handle(pkt_hdr), offset,
+				       seg_len, buf);
+		ptr = buf;
+	}
+
+	packet_parse_reset(pkt_hdr);
+
+	switch (param->proto) {
+	case ODP_PROTO_ETH:
+		if (layer != ODP_PKTIO_PARSER_LAYER_NONE)
+			prs->l2_offset = offset;
+
+		ret = packet_parse_common(prs, ptr, len, seg_len, layer);
 		break;
 
-	case _ODP_IPPROTO_SCTP:
-		prs->input_flags.sctp = 1;
+	case ODP_PROTO_IPV4:
+	case ODP_PROTO_IPV6:
+		if (layer < ODP_PKTIO_PARSER_LAYER_L3)
+			return -1;
+
+		ethtype = param->proto == ODP_PROTO_IPV4 ? _ODP_ETHTYPE_IPV4 :
+							    _ODP_ETHTYPE_IPV6;
+		prs->l2_offset = ODP_PACKET_OFFSET_INVALID;
+
+		ret = packet_parse_l3_l4(prs, ptr, 0, len, seg_len, layer,
+					 ethtype);
 		break;
 
 	default:
-		prs->input_flags.l4 = 0;
-		prs->l4_offset = ODP_PACKET_OFFSET_INVALID;
-		break;
+		return -1;
 	}
-parse_exit:
-	return prs->error_flags.all != 0;
+
+	/* Parser offsets are relative to the parse starting point */
+	if (prs->l3_offset != ODP_PACKET_OFFSET_INVALID)
+		prs->l3_offset += offset;
+
+	if (prs->l4_offset != ODP_PACKET_OFFSET_INVALID)
+		prs->l4_offset += offset;
+
+	return ret ? -1 : 0;
 }
 
-/**
- * Simple packet parser
- */
-int packet_parse_layer(odp_packet_hdr_t *pkt_hdr,
-		       odp_pktio_parser_layer_t layer)
+int odp_packet_parse(odp_packet_t pkt, uint32_t offset,
+		     const odp_packet_parse_param_t *param)
 {
-	uint32_t seg_len = packet_first_seg_len(pkt_hdr);
-	void *base = packet_data(pkt_hdr);
+	return packet_parse_offset(packet_hdr(pkt), offset, param);
+}
 
-	return packet_parse_common(&pkt_hdr->p, base, pkt_hdr->frame_len,
-				   seg_len, layer);
+int odp_packet_parse_multi(const odp_packet_t pkt[], const uint32_t offset[],
+			   int num, const odp_packet_parse_param_t *param)
+{
+	int i;
+
+	parse_prefetch_first(pkt, num);
+
+	for (i = 0; i < num; i++) {
+		parse_prefetch(pkt, i, num);
+
+		if (packet_parse_offset(packet_hdr(pkt[i]), offset[i], param))
+			return i;
+	}
+
+	return num;
 }
 
 uint64_t odp_packet_to_u64(odp_packet_t hdl)
@@ -2200,9 +2719,27 @@ odp_packet_t odp_packet_ref_static(odp_packet_t pkt)
 	return pkt;
 }
 
-odp_packet_t odp_packet_ref(odp_packet_t pkt, uint32_t offset)
+/* Copy segment table and length information of a link header */
+static inline void link_hdr_copy(odp_packet_hdr_t *dst,
+				 const odp_packet_hdr_t *src)
+{
+	int i;
+
+	for (i = 0; i < src->buf_hdr.num_seg; i++)
+		dst->buf_hdr.seg[i] = src->buf_hdr.seg[i];
+
+	dst->buf_hdr.num_seg  = src->buf_hdr.num_seg;
+	dst->buf_hdr.next_seg = src->buf_hdr.next_seg;
+	dst->buf_hdr.last_seg = src->buf_hdr.last_seg;
+	dst->buf_hdr.segcount = src->buf_hdr.segcount;
+	dst->frame_len        = src->frame_len;
+	dst->tailroom         = src->tailroom;
+	dst->headroom         = src->headroom;
+}
+
+int odp_packet_ref_multi(odp_packet_t pkt, uint32_t offset,
+			 odp_packet_t ref[], int num)
 {
-	odp_packet_t ref;
 	odp_packet_hdr_t *link_hdr;
 	odp_packet_hdr_t *next_hdr;
 	odp_packet_hdr_t *pkt_hdr = packet_hdr(pkt);
@@ -2216,32 +2753,33 @@ odp_packet_t odp_packet_ref(odp_packet_t pkt, uint32_t offset)
 
 	if (offset >= pkt_hdr->frame_len) {
 		ODP_DBG("offset too large\n");
-		return ODP_PACKET_INVALID;
+		return -1;
 	}
 
-	/* Allocate link segment */
-	if (packet_alloc(pkt_hdr->buf_hdr.pool_ptr, 0, 1, 1, &ref) != 1) {
+	/* Allocate all link segments at once. Each link header is a normal
+	 * pool block, the data area of which is not used. */
+	num = packet_alloc(pkt_hdr->buf_hdr.pool_ptr, 0, num, 1, ref);
+	if (odp_unlikely(num == 0)) {
 		ODP_DBG("segment alloc failed\n");
-		return ODP_PACKET_INVALID;
+		return -1;
 	}
 
-	link_hdr = packet_hdr(ref);
+	link_hdr = packet_hdr(ref[0]);
 
 	seg_entry_find_offset(&hdr, &idx, &seg_offset, &seg_idx, offset);
 	num_copy = hdr->buf_hdr.num_seg - idx;
 	segcount = pkt_hdr->buf_hdr.segcount;
 
-	/* In addition to segments, update reference count of
+	/* Reference counts are updated once per segment for all new
+	 * references. Segment entries of the first header are copied into
+	 * the new link headers, so that header is not referenced when it is
 	 * an existing link header. */
-	if (seg_is_link(hdr))
-		buffer_ref_inc((odp_buffer_hdr_t *)hdr);
-
 	seg = seg_entry_next(&hdr, &idx);
 	link_hdr->buf_hdr.num_seg = 1;
 	link_hdr->buf_hdr.seg[0].hdr  = seg->hdr;
 	link_hdr->buf_hdr.seg[0].data = seg->data + seg_offset;
 	link_hdr->buf_hdr.seg[0].len  = seg->len  - seg_offset;
-	buffer_ref_inc(seg->hdr);
+	buffer_ref_add(seg->hdr, num);
 
 	/* The 'CONFIG_PACKET_SEGS_PER_HDR > 1' condition is required to fix an
 	 * invalid error ('array subscript is above array bounds') thrown by
@@ -2249,7 +2787,7 @@ odp_packet_t odp_packet_ref(odp_packet_t pkt, uint32_t offset)
 	for (i = 1; CONFIG_PACKET_SEGS_PER_HDR > 1 && i < num_copy; i++) {
 		/* Update link header reference count */
 		if (idx == 0 && seg_is_link(hdr))
-			buffer_ref_inc((odp_buffer_hdr_t *)hdr);
+			buffer_ref_add((odp_buffer_hdr_t *)hdr, num);
 
 		seg = seg_entry_next(&hdr, &idx);
 
@@ -2257,7 +2795,7 @@ odp_packet_t odp_packet_ref(odp_packet_t pkt, uint32_t offset)
 		link_hdr->buf_hdr.seg[i].hdr  = seg->hdr;
 		link_hdr->buf_hdr.seg[i].data = seg->data;
 		link_hdr->buf_hdr.seg[i].len  = seg->len;
-		buffer_ref_inc(seg->hdr);
+		buffer_ref_add(seg->hdr, num);
 	}
 
 	next_hdr = hdr;
@@ -2266,10 +2804,10 @@ odp_packet_t odp_packet_ref(odp_packet_t pkt, uint32_t offset)
 	for (i = seg_idx + num_copy; i < segcount; i++) {
 		/* Update link header reference count */
 		if (idx == 0 && seg_is_link(hdr))
-			buffer_ref_inc((odp_buffer_hdr_t *)hdr);
+			buffer_ref_add((odp_buffer_hdr_t *)hdr, num);
 
 		seg = seg_entry_next(&hdr, &idx);
-		buffer_ref_inc(seg->hdr);
+		buffer_ref_add(seg->hdr, num);
 	}
 
 	len = pkt_hdr->frame_len - offset;
@@ -2284,8 +2822,21 @@ odp_packet_t odp_packet_ref(odp_packet_t pkt, uint32_t offset)
 	 * is not pushed through a reference. */
 	link_hdr->headroom          = 0;
 
-	return ref;
+	/* Rest of the link headers are identical to the first one */
+	for (i = 1; i < num; i++)
+		link_hdr_copy(packet_hdr(ref[i]), link_hdr);
+
+	return num;
+}
+
+odp_packet_t odp_packet_ref(odp_packet_t pkt, uint32_t offset)
+{
+	odp_packet_t ref;
 
+	if (odp_packet_ref_multi(pkt, offset, &ref, 1) != 1)
+		return ODP_PACKET_INVALID;
+
+	return ref;
 }
 
 odp_packet_t odp_packet_ref_pkt(odp_packet_t pkt, uint32_t offset,
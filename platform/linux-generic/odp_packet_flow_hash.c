@@ -0,0 +1,300 @@
+/* Copyright (c) 2017, Linaro Limited
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier:     BSD-3-Clause
+ */
+
+#include "config.h"
+
+#include <odp/api/hash.h>
+#include <odp/api/hints.h>
+#include <odp_packet_flow_hash_internal.h>
+#include <odp_packet_internal.h>
+#include <odp_debug_internal.h>
+
+#include <protocols/ip.h>
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <ctype.h>
+
+#if defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#endif
+
+/* Default Toeplitz key, which is used also by many NICs */
+static const uint8_t default_key[FLOW_HASH_KEY_LEN] = {
+	0x6d, 0x5a, 0x56, 0xda, 0x25, 0x5b, 0x0e, 0xc2,
+	0x41, 0x67, 0x25, 0x3d, 0x43, 0xa3, 0x8f, 0xb0,
+	0xd0, 0xca, 0x2b, 0xcb, 0xae, 0x7b, 0x30, 0xb4,
+	0x77, 0xcb, 0x2d, 0xa3, 0x80, 0x30, 0xf2, 0x0c,
+	0x6a, 0x42, 0xb7, 0x3b, 0xbe, 0xac, 0x01, 0xfa
+};
+
+/* Hash input: source and destination addresses followed by source and
+ * destination ports, all in network byte order */
+typedef union {
+	uint8_t  u8[FLOW_HASH_INPUT_MAX];
+	uint32_t u32[FLOW_HASH_INPUT_MAX / 4];
+} flow_tuple_t;
+
+static flow_hash_alg_t alg_from_str(const char *str)
+{
+	if (strcasecmp(str, "toeplitz") == 0)
+		return FLOW_HASH_TOEPLITZ;
+
+	if (strcasecmp(str, "crc32c") == 0)
+		return FLOW_HASH_CRC32C;
+
+	return FLOW_HASH_NONE;
+}
+
+static int hex_val(char c)
+{
+	if (c >= '0' && c <= '9')
+		return c - '0';
+
+	c = tolower(c);
+	if (c >= 'a' && c <= 'f')
+		return c - 'a' + 10;
+
+	return -1;
+}
+
+/* Parse a key of up to FLOW_HASH_KEY_LEN bytes given as hex digits. Shorter
+ * keys are zero padded. */
+static int key_from_str(const char *str, uint8_t key[])
+{
+	int i = 0;
+
+	memset(key, 0, FLOW_HASH_KEY_LEN);
+
+	if (str[0] == '0' && (str[1] == 'x' || str[1] == 'X'))
+		str += 2;
+
+	while (str[0] && str[1]) {
+		int hi = hex_val(str[0]);
+		int lo = hex_val(str[1]);
+
+		if (hi < 0 || lo < 0 || i == FLOW_HASH_KEY_LEN)
+			return -1;
+
+		key[i++] = (hi << 4) | lo;
+		str += 2;
+	}
+
+	if (str[0] || i == 0)
+		return -1;
+
+	return 0;
+}
+
+static void toeplitz_init(flow_hash_global_t *global)
+{
+	int pos, bit, val;
+
+	for (pos = 0; pos < FLOW_HASH_INPUT_MAX; pos++) {
+		uint64_t window = 0;
+		uint32_t bit_hash[8];
+
+		/* 40 key bits starting from the first bit of the input byte */
+		for (bit = 0; bit < 5; bit++)
+			window = (window << 8) | global->key[pos + bit];
+
+		/* Input bit 0 is the most significant bit of the byte */
+		for (bit = 0; bit < 8; bit++)
+			bit_hash[bit] = (uint32_t)(window >> (8 - bit));
+
+		for (val = 0; val < 16; val++) {
+			uint32_t hi = 0, lo = 0;
+
+			for (bit = 0; bit < 4; bit++) {
+				if (val & (0x8 >> bit)) {
+					hi ^= bit_hash[bit];
+					lo ^= bit_hash[bit + 4];
+				}
+			}
+
+			global->toeplitz[pos][0][val] = hi;
+			global->toeplitz[pos][1][val] = lo;
+		}
+	}
+}
+
+void _odp_flow_hash_init(flow_hash_global_t *global)
+{
+	const char *env;
+
+	memcpy(global->key, default_key, FLOW_HASH_KEY_LEN);
+
+	env = getenv("ODP_PKTIO_FLOW_HASH_KEY");
+	if (env && key_from_str(env, global->key)) {
+		ODP_ERR("Bad ODP_PKTIO_FLOW_HASH_KEY, using default key\n");
+		memcpy(global->key, default_key, FLOW_HASH_KEY_LEN);
+	}
+
+	toeplitz_init(global);
+	memcpy(&global->crc_init, global->key, sizeof(uint32_t));
+
+	global->alg = FLOW_HASH_NONE;
+	global->spread_alg = FLOW_HASH_TOEPLITZ;
+
+	env = getenv("ODP_PKTIO_FLOW_HASH");
+	if (env == NULL)
+		return;
+
+	global->alg = alg_from_str(env);
+
+	if (global->alg == FLOW_HASH_NONE) {
+		ODP_ERR("Unknown ODP_PKTIO_FLOW_HASH: %s\n", env);
+		return;
+	}
+
+	global->spread_alg = global->alg;
+
+	ODP_PRINT("Pktio: software flow hash: %s\n",
+		  global->alg == FLOW_HASH_TOEPLITZ ? "toeplitz" : "crc32c");
+}
+
+static inline uint32_t toeplitz_hash(const flow_hash_global_t *global,
+				     const flow_tuple_t *tuple, int len)
+{
+	uint32_t hash = 0;
+	int i;
+
+	for (i = 0; i < len; i++) {
+		uint8_t byte = tuple->u8[i];
+
+		hash ^= global->toeplitz[i][0][byte >> 4];
+		hash ^= global->toeplitz[i][1][byte & 0xf];
+	}
+
+	return hash;
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+__attribute__((target("sse4.2")))
+static uint32_t crc32c_hash_hw(uint32_t crc, const flow_tuple_t *tuple,
+			       int len)
+{
+	int i;
+
+	for (i = 0; i < len / 4; i++)
+		crc = __builtin_ia32_crc32si(crc, tuple->u32[i]);
+
+	return crc;
+}
+
+static inline uint32_t crc32c_hash(const flow_hash_global_t *global,
+				   const flow_tuple_t *tuple, int len)
+{
+	if (odp_likely(__builtin_cpu_supports("sse4.2")))
+		return crc32c_hash_hw(global->crc_init, tuple, len);
+
+	return odp_hash_crc32c(tuple, len, global->crc_init);
+}
+#elif defined(__ARM_FEATURE_CRC32)
+static inline uint32_t crc32c_hash(const flow_hash_global_t *global,
+				   const flow_tuple_t *tuple, int len)
+{
+	uint32_t crc = global->crc_init;
+	int i;
+
+	for (i = 0; i < len / 4; i++)
+		crc = __crc32cw(crc, tuple->u32[i]);
+
+	return crc;
+}
+#else
+static inline uint32_t crc32c_hash(const flow_hash_global_t *global,
+				   const flow_tuple_t *tuple, int len)
+{
+	return odp_hash_crc32c(tuple, len, global->crc_init);
+}
+#endif
+
+/* Copy hash input from packet headers. Returns input length, or zero when
+ * the packet is not hashed. */
+static inline int flow_tuple(odp_packet_hdr_t *pkt_hdr,
+			     const odp_pktin_hash_proto_t *proto,
+			     flow_tuple_t *tuple)
+{
+	const uint8_t *data = pkt_hdr->buf_hdr.seg[0].data;
+	uint32_t seg_len = pkt_hdr->buf_hdr.seg[0].len;
+	uint32_t l3 = pkt_hdr->p.l3_offset;
+	uint32_t l4 = pkt_hdr->p.l4_offset;
+	int tcp = pkt_hdr->p.input_flags.tcp;
+	int udp = pkt_hdr->p.input_flags.udp;
+	int ports, addr_len, addr_offset;
+
+	if (pkt_hdr->p.input_flags.ipv4) {
+		ports = (tcp && proto->proto.ipv4_tcp) ||
+			(udp && proto->proto.ipv4_udp);
+
+		if (!ports && !proto->proto.ipv4)
+			return 0;
+
+		addr_len    = 4;
+		addr_offset = offsetof(_odp_ipv4hdr_t, src_addr);
+	} else if (pkt_hdr->p.input_flags.ipv6) {
+		ports = (tcp && proto->proto.ipv6_tcp) ||
+			(udp && proto->proto.ipv6_udp);
+
+		if (!ports && !proto->proto.ipv6)
+			return 0;
+
+		addr_len    = 16;
+		addr_offset = offsetof(_odp_ipv6hdr_t, src_addr);
+	} else {
+		return 0;
+	}
+
+	/* All fragments of a datagram hash into the same value */
+	if (pkt_hdr->p.input_flags.ipfrag)
+		ports = 0;
+
+	if (odp_unlikely(l3 + addr_offset + 2 * addr_len > seg_len))
+		return 0;
+
+	memcpy(tuple->u8, data + l3 + addr_offset, 2 * addr_len);
+
+	if (!ports)
+		return 2 * addr_len;
+
+	if (odp_unlikely(l4 + 4 > seg_len))
+		return 0;
+
+	/* TCP and UDP ports are in the same place */
+	memcpy(&tuple->u8[2 * addr_len], data + l4, 4);
+
+	return 2 * addr_len + 4;
+}
+
+void _odp_flow_hash_packets(const flow_hash_global_t *global,
+			    flow_hash_alg_t alg,
+			    const odp_pktin_hash_proto_t *proto,
+			    odp_packet_t packets[], int num)
+{
+	flow_tuple_t tuple;
+	int i, len;
+
+	for (i = 0; i < num; i++) {
+		odp_packet_hdr_t *pkt_hdr = odp_packet_hdr(packets[i]);
+
+		if (pkt_hdr->p.input_flags.flow_hash)
+			continue;
+
+		len = flow_tuple(pkt_hdr, proto, &tuple);
+		if (len == 0)
+			continue;
+
+		if (alg == FLOW_HASH_CRC32C)
+			pkt_hdr->flow_hash = crc32c_hash(global, &tuple, len);
+		else
+			pkt_hdr->flow_hash = toeplitz_hash(global, &tuple, len);
+
+		pkt_hdr->p.input_flags.flow_hash = 1;
+	}
+}
@@ -12,6 +12,7 @@
 #include <odp_packet_io_internal.h>
 #include <odp/api/packet.h>
 #include <odp_packet_internal.h>
+#include <odp_packet_vector_internal.h>
 #include <odp_internal.h>
 #include <odp/api/spinlock.h>
 #include <odp/api/ticketlock.h>
@@ -67,6 +68,8 @@ int odp_pktio_init_global(void)
 
 	odp_spinlock_init(&pktio_tbl->lock);
 
+	_odp_flow_hash_init(&pktio_tbl->flow_hash);
+
 	for (i = 0; i < ODP_CONFIG_PKTIO_ENTRIES; ++i) {
 		pktio_entry = &pktio_tbl->entries[i];
 
@@ -147,6 +150,8 @@ static void init_out_queues(pktio_entry_t *entry)
 static void init_pktio_entry(pktio_entry_t *entry)
 {
 	pktio_cls_enabled_set(entry, 0);
+	memset(&entry->s.flow_hash, 0, sizeof(entry->s.flow_hash));
+	memset(&entry->s.vector, 0, sizeof(entry->s.vector));
 
 	init_in_queues(entry);
 	init_out_queues(entry);
@@ -478,6 +483,11 @@ int odp_pktio_start(odp_pktio_t hdl)
 			}
 		}
 
+		/* Spread event queues share a single driver queue, which
+		 * is polled through the first queue */
+		if (entry->s.flow_hash.spread)
+			num = 1;
+
 		sched_fn->pktio_start(pktio_to_id(hdl), num, index);
 	}
 
@@ -552,37 +562,129 @@ odp_pktio_t odp_pktio_lookup(const char *name)
 	return hdl;
 }
 
-static inline int pktin_recv_buf(odp_pktin_queue_t queue,
+/* Destination event queue of a received packet. Returns QUEUE_NULL when the
+ * packet stays on the event queue 'index'. Others are classified packets and
+ * packets spread by flow hash. */
+static inline queue_t pktin_dst_queue(pktio_entry_t *entry, int index,
+				      odp_packet_hdr_t *pkt_hdr)
+{
+	unsigned dst = 0;
+
+	if (pkt_hdr->p.input_flags.dst_queue)
+		return pkt_hdr->dst_queue;
+
+	if (odp_likely(!entry->s.flow_hash.spread))
+		return QUEUE_NULL;
+
+	if (pkt_hdr->p.input_flags.flow_hash)
+		dst = pkt_hdr->flow_hash % entry->s.num_in_queue;
+
+	if (dst == (unsigned)index)
+		return QUEUE_NULL;
+
+	return entry->s.in_queue[dst].queue_int;
+}
+
+/* Aggregate received packets into vectors of the same destination queue.
+ * Packet order per queue is maintained. Packets are passed as packet events
+ * when a vector cannot be allocated. */
+static int pktin_recv_vector(pktio_entry_t *entry, int index,
+			     odp_buffer_hdr_t *buffer_hdrs[],
+			     odp_packet_t packets[], int num)
+{
+	pool_t *pool = pool_entry_from_hdl(entry->s.vector.pool);
+	uint32_t max_size = entry->s.vector.max_size;
+	queue_t dst[num];
+	odp_packet_vector_hdr_t *pktv;
+	odp_buffer_hdr_t *buf_hdr;
+	odp_packet_t *tbl;
+	int i, j;
+	int num_rx = 0;
+
+	for (i = 0; i < num; i++)
+		dst[i] = pktin_dst_queue(entry, index,
+					 odp_packet_hdr(packets[i]));
+
+	for (i = 0; i < num; i++) {
+		queue_t queue = dst[i];
+
+		/* Already in a vector */
+		if (packets[i] == ODP_PACKET_INVALID)
+			continue;
+
+		if (odp_unlikely(pktv_alloc_multi(pool, &pktv, 1) != 1)) {
+			buf_hdr = packet_to_buf_hdr(packets[i]);
+
+			if (queue == QUEUE_NULL)
+				buffer_hdrs[num_rx++] = buf_hdr;
+			else if (queue_fn->enq(queue, buf_hdr) < 0)
+				odp_packet_free(packets[i]);
+
+			continue;
+		}
+
+		tbl = pktv_tbl(pktv);
+
+		for (j = i; j < num && pktv->size < max_size; j++) {
+			if (packets[j] == ODP_PACKET_INVALID ||
+			    dst[j] != queue)
+				continue;
+
+			tbl[pktv->size++] = packets[j];
+			packets[j] = ODP_PACKET_INVALID;
+		}
+
+		if (queue == QUEUE_NULL)
+			buffer_hdrs[num_rx++] = &pktv->buf_hdr;
+		else if (queue_fn->enq(queue, &pktv->buf_hdr) < 0)
+			pktv_free_full(pktv);
+	}
+
+	return num_rx;
+}
+
+static inline int pktin_recv_buf(pktio_entry_t *entry, int index,
 				 odp_buffer_hdr_t *buffer_hdrs[], int num)
 {
 	odp_packet_t pkt;
 	odp_packet_t packets[num];
-	odp_packet_hdr_t *pkt_hdr;
 	odp_buffer_hdr_t *buf_hdr;
+	queue_t dst_queue;
 	int i;
 	int pkts;
 	int num_rx = 0;
 
-	pkts = odp_pktin_recv(queue, packets, num);
+	pkts = odp_pktin_recv(entry->s.in_queue[index].pktin, packets, num);
+
+	if (odp_unlikely(entry->s.vector.enable) && pkts > 0)
+		return pktin_recv_vector(entry, index, buffer_hdrs, packets,
+					 pkts);
 
 	for (i = 0; i < pkts; i++) {
 		pkt = packets[i];
-		pkt_hdr = odp_packet_hdr(pkt);
 		buf_hdr = packet_to_buf_hdr(pkt);
+		dst_queue = pktin_dst_queue(entry, index, odp_packet_hdr(pkt));
 
-		if (pkt_hdr->p.input_flags.dst_queue) {
-			int ret;
-
-			ret = queue_fn->enq(pkt_hdr->dst_queue, buf_hdr);
-			if (ret < 0)
-				odp_packet_free(pkt);
+		if (dst_queue == QUEUE_NULL) {
+			buffer_hdrs[num_rx++] = buf_hdr;
 			continue;
 		}
-		buffer_hdrs[num_rx++] = buf_hdr;
+
+		if (queue_fn->enq(dst_queue, buf_hdr) < 0)
+			odp_packet_free(pkt);
 	}
 	return num_rx;
 }
 
+static inline int pktin_recv_buf_queue(queue_t q_int,
+				       odp_buffer_hdr_t *buffer_hdrs[], int num)
+{
+	odp_pktin_queue_t pktin = queue_fn->get_pktin(q_int);
+
+	return pktin_recv_buf(get_pktio_entry(pktin.pktio), pktin.index,
+			      buffer_hdrs, num);
+}
+
 static int pktout_enqueue(queue_t q_int, odp_buffer_hdr_t *buf_hdr)
 {
 	odp_packet_t pkt = packet_from_buf_hdr(buf_hdr);
@@ -622,8 +724,7 @@ static odp_buffer_hdr_t *pktin_dequeue(queue_t q_int)
 	if (buf_hdr != NULL)
 		return buf_hdr;
 
-	pkts = pktin_recv_buf(queue_fn->get_pktin(q_int),
-			      hdr_tbl, QUEUE_MULTI_MAX);
+	pkts = pktin_recv_buf_queue(q_int, hdr_tbl, QUEUE_MULTI_MAX);
 
 	if (pkts <= 0)
 		return NULL;
@@ -650,8 +751,7 @@ static int pktin_deq_multi(queue_t q_int, odp_buffer_hdr_t *buf_hdr[], int num)
 	if (nbr == num)
 		return nbr;
 
-	pkts = pktin_recv_buf(queue_fn->get_pktin(q_int),
-			      hdr_tbl, QUEUE_MULTI_MAX);
+	pkts = pktin_recv_buf_queue(q_int, hdr_tbl, QUEUE_MULTI_MAX);
 	if (pkts <= 0)
 		return nbr;
 
@@ -686,9 +786,9 @@ int sched_cb_pktin_poll(int pktio_index, int num_queue, int index[])
 
 	for (idx = 0; idx < num_queue; idx++) {
 		queue_t q_int;
-		odp_pktin_queue_t pktin = entry->s.in_queue[index[idx]].pktin;
 
-		num = pktin_recv_buf(pktin, hdr_tbl, QUEUE_MULTI_MAX);
+		num = pktin_recv_buf(entry, index[idx], hdr_tbl,
+				     QUEUE_MULTI_MAX);
 
 		if (num == 0)
 			continue;
@@ -705,6 +805,34 @@ int sched_cb_pktin_poll(int pktio_index, int num_queue, int index[])
 	return 0;
 }
 
+int sched_cb_pktin_poll_one(int pktio_index, int rx_queue,
+			    odp_event_t evt_tbl[], odp_queue_t *queue)
+{
+	int num;
+	pktio_entry_t *entry = pktio_entry_by_index(pktio_index);
+	int state = entry->s.state;
+
+	if (odp_unlikely(state != PKTIO_STATE_STARTED)) {
+		if (state < PKTIO_STATE_ACTIVE ||
+		    state == PKTIO_STATE_STOP_PENDING)
+			return -1;
+
+		ODP_DBG("interface not started\n");
+		return 0;
+	}
+
+	num = pktin_recv_buf(entry, rx_queue, (odp_buffer_hdr_t **)evt_tbl,
+			     QUEUE_MULTI_MAX);
+
+	if (odp_unlikely(num < 0)) {
+		ODP_ERR("Packet recv error\n");
+		return -1;
+	}
+
+	*queue = entry->s.in_queue[rx_queue].queue;
+	return num;
+}
+
 void sched_cb_pktio_stop_finalize(int pktio_index)
 {
 	int state;
@@ -886,6 +1014,7 @@ void odp_pktin_queue_param_init(odp_pktin_queue_param_t *param)
 	param->num_queues = 1;
 	/* no need to choose queue type since pktin mode defines it */
 	odp_queue_param_init(&param->queue_param);
+	param->vector.pool = ODP_POOL_INVALID;
 }
 
 void odp_pktout_queue_param_init(odp_pktout_queue_param_t *param)
@@ -1083,9 +1212,19 @@ int single_capability(odp_pktio_capability_t *capa)
 	return 0;
 }
 
+static int driver_capability(pktio_entry_t *entry,
+			     odp_pktio_capability_t *capa)
+{
+	if (entry->s.ops->capability)
+		return entry->s.ops->capability(entry, capa);
+
+	return single_capability(capa);
+}
+
 int odp_pktio_capability(odp_pktio_t pktio, odp_pktio_capability_t *capa)
 {
 	pktio_entry_t *entry;
+	odp_pktin_mode_t mode;
 	int ret;
 
 	entry = get_pktio_entry(pktio);
@@ -1094,16 +1233,28 @@ int odp_pktio_capability(odp_pktio_t pktio, odp_pktio_capability_t *capa)
 		return -1;
 	}
 
-	if (entry->s.ops->capability)
-		ret = entry->s.ops->capability(entry, capa);
-	else
-		ret = single_capability(capa);
+	ret = driver_capability(entry, capa);
+	if (ret)
+		return ret;
 
 	/* The same parser is used for all pktios */
-	if (ret == 0)
-		capa->config.parser.layer = ODP_PKTIO_PARSER_LAYER_ALL;
+	capa->config.parser.layer = ODP_PKTIO_PARSER_LAYER_ALL;
 
-	return ret;
+	/* Packets from a single queue driver are spread over multiple event
+	 * queues with software flow hashing */
+	mode = entry->s.param.in_mode;
+	if (capa->max_input_queues == 1 &&
+	    (mode == ODP_PKTIN_MODE_QUEUE || mode == ODP_PKTIN_MODE_SCHED))
+		capa->max_input_queues = PKTIO_MAX_QUEUES;
+
+	/* Packet vectors are formed from received bursts in software */
+	if (mode == ODP_PKTIN_MODE_QUEUE || mode == ODP_PKTIN_MODE_SCHED) {
+		capa->vector.supported = 1;
+		capa->vector.min_size  = 1;
+		capa->vector.max_size  = CONFIG_PACKET_VECTOR_MAX_SIZE;
+	}
+
+	return 0;
 }
 
 unsigned odp_pktio_max_index(void)
@@ -1164,6 +1315,71 @@ int odp_pktio_stats_reset(odp_pktio_t pktio)
 	return ret;
 }
 
+/* Select software flow hashing for the pktio. Hashing is enabled for all
+ * protocols with ODP_PKTIO_FLOW_HASH, or for requested protocols when
+ * packets are spread over input queues in software. */
+static void flow_hash_config(pktio_entry_t *entry,
+			     const odp_pktin_queue_param_t *param, int spread)
+{
+	flow_hash_global_t *global = &pktio_tbl->flow_hash;
+
+	entry->s.flow_hash.alg = FLOW_HASH_NONE;
+	entry->s.flow_hash.proto.all_bits = 0;
+	entry->s.flow_hash.spread = spread;
+
+	if (spread) {
+		entry->s.flow_hash.alg   = global->spread_alg;
+		entry->s.flow_hash.proto = param->hash_proto;
+	} else if (global->alg != FLOW_HASH_NONE) {
+		entry->s.flow_hash.alg = global->alg;
+
+		if (param->hash_enable)
+			entry->s.flow_hash.proto = param->hash_proto;
+		else
+			entry->s.flow_hash.proto.all_bits = UINT32_MAX;
+	}
+}
+
+static int vector_config(pktio_entry_t *entry,
+			 const odp_pktin_queue_param_t *param,
+			 const odp_pktio_capability_t *capa)
+{
+	const odp_pktin_vector_config_t *vector = &param->vector;
+	odp_pool_info_t info;
+
+	memset(&entry->s.vector, 0, sizeof(entry->s.vector));
+
+	if (!vector->enable)
+		return 0;
+
+	if (!capa->vector.supported) {
+		ODP_DBG("pktio %s: packet vectors not supported\n",
+			entry->s.name);
+		return -1;
+	}
+
+	if (vector->pool == ODP_POOL_INVALID ||
+	    odp_pool_info(vector->pool, &info) ||
+	    info.params.type != ODP_POOL_VECTOR) {
+		ODP_DBG("pktio %s: bad packet vector pool\n", entry->s.name);
+		return -1;
+	}
+
+	if (vector->max_size < capa->vector.min_size ||
+	    vector->max_size > capa->vector.max_size ||
+	    vector->max_size > info.params.vector.max_size) {
+		ODP_DBG("pktio %s: bad packet vector size %u\n",
+			entry->s.name, vector->max_size);
+		return -1;
+	}
+
+	entry->s.vector.enable   = 1;
+	entry->s.vector.pool     = vector->pool;
+	entry->s.vector.max_size = vector->max_size;
+
+	return 0;
+}
+
 static int abort_pktin_enqueue(queue_t q_int ODP_UNUSED,
 			       odp_buffer_hdr_t *buf_hdr ODP_UNUSED)
 {
@@ -1205,6 +1421,8 @@ int odp_pktin_queue_config(odp_pktio_t pktio,
 	odp_queue_t queue;
 	queue_t q_int;
 	odp_pktin_queue_param_t default_param;
+	odp_pktin_queue_param_t drv_param;
+	int spread;
 
 	if (param == NULL) {
 		odp_pktin_queue_param_init(&default_param);
@@ -1249,6 +1467,25 @@ int odp_pktin_queue_config(odp_pktio_t pktio,
 		return -1;
 	}
 
+	if (vector_config(entry, param, &capa))
+		return -1;
+
+	if (driver_capability(entry, &capa)) {
+		ODP_DBG("pktio %s: unable to read capabilities\n",
+			entry->s.name);
+		return -1;
+	}
+
+	spread = num_queues > capa.max_input_queues;
+
+	if (spread && !param->hash_enable) {
+		ODP_DBG("pktio %s: multiple input queues need hashing\n",
+			entry->s.name);
+		return -1;
+	}
+
+	flow_hash_config(entry, param, spread);
+
 	/* If re-configuring, destroy old queues */
 	if (entry->s.num_in_queue)
 		destroy_in_queues(entry, entry->s.num_in_queue);
@@ -1302,12 +1539,20 @@ int odp_pktin_queue_config(odp_pktio_t pktio,
 			entry->s.in_queue[i].queue_int = QUEUE_NULL;
 		}
 
-		entry->s.in_queue[i].pktin.index = i;
+		/* Spread event queues share driver queue zero */
+		entry->s.in_queue[i].pktin.index = spread ? 0 : i;
 		entry->s.in_queue[i].pktin.pktio = entry->s.handle;
 	}
 
 	entry->s.num_in_queue = num_queues;
 
+	if (spread) {
+		drv_param = *param;
+		drv_param.hash_enable = 0;
+		drv_param.num_queues  = 1;
+		param = &drv_param;
+	}
+
 	if (entry->s.ops->input_queues_config)
 		return entry->s.ops->input_queues_config(entry, param);
 
@@ -1567,7 +1812,14 @@ int odp_pktin_recv(odp_pktin_queue_t queue, odp_packet_t packets[], int num)
 		return -1;
 	}
 
-	return entry->s.ops->recv(entry, queue.index, packets, num);
+	num = entry->s.ops->recv(entry, queue.index, packets, num);
+
+	if (odp_unlikely(entry->s.flow_hash.alg != FLOW_HASH_NONE) && num > 0)
+		_odp_flow_hash_packets(&pktio_tbl->flow_hash,
+				       entry->s.flow_hash.alg,
+				       &entry->s.flow_hash.proto, packets, num);
+
+	return num;
 }
 
 int odp_pktin_recv_tmo(odp_pktin_queue_t queue, odp_packet_t packets[], int num,
@@ -0,0 +1,125 @@
+/* Copyright (c) 2017, Linaro Limited
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier:     BSD-3-Clause
+ */
+
+#include "config.h"
+
+#include <odp/api/packet.h>
+#include <odp/api/event.h>
+#include <odp/api/pool.h>
+#include <odp/api/hints.h>
+#include <odp_packet_vector_internal.h>
+#include <odp_debug_internal.h>
+
+#include <odp/api/plat/strong_types.h>
+
+odp_packet_vector_t odp_packet_vector_from_event(odp_event_t ev)
+{
+	if (odp_unlikely(ev == ODP_EVENT_INVALID))
+		return ODP_PACKET_VECTOR_INVALID;
+
+	ODP_ASSERT(odp_event_type(ev) == ODP_EVENT_PACKET_VECTOR);
+
+	return (odp_packet_vector_t)ev;
+}
+
+odp_event_t odp_packet_vector_to_event(odp_packet_vector_t pktv)
+{
+	if (odp_unlikely(pktv == ODP_PACKET_VECTOR_INVALID))
+		return ODP_EVENT_INVALID;
+
+	return (odp_event_t)pktv;
+}
+
+odp_packet_vector_t odp_packet_vector_alloc(odp_pool_t pool_hdl)
+{
+	pool_t *pool = pool_entry_from_hdl(pool_hdl);
+	odp_packet_vector_hdr_t *hdr;
+
+	ODP_ASSERT(pool->params.type == ODP_POOL_VECTOR);
+
+	if (odp_unlikely(pktv_alloc_multi(pool, &hdr, 1) != 1))
+		return ODP_PACKET_VECTOR_INVALID;
+
+	return pktv_handle(hdr);
+}
+
+void odp_packet_vector_free(odp_packet_vector_t pktv)
+{
+	odp_buffer_hdr_t *buf_hdr = &pktv_hdr(pktv)->buf_hdr;
+
+	buffer_free_multi(&buf_hdr, 1);
+}
+
+void pktv_free_full(odp_packet_vector_hdr_t *hdr)
+{
+	odp_buffer_hdr_t *buf_hdr = &hdr->buf_hdr;
+
+	if (hdr->size)
+		odp_packet_free_multi(pktv_tbl(hdr), hdr->size);
+
+	buffer_free_multi(&buf_hdr, 1);
+}
+
+uint32_t odp_packet_vector_tbl(odp_packet_vector_t pktv,
+			       odp_packet_t **pkt_tbl)
+{
+	odp_packet_vector_hdr_t *hdr = pktv_hdr(pktv);
+
+	*pkt_tbl = pktv_tbl(hdr);
+
+	return hdr->size;
+}
+
+uint32_t odp_packet_vector_size(odp_packet_vector_t pktv)
+{
+	return pktv_hdr(pktv)->size;
+}
+
+void odp_packet_vector_size_set(odp_packet_vector_t pktv, uint32_t size)
+{
+	odp_packet_vector_hdr_t *hdr = pktv_hdr(pktv);
+
+	ODP_ASSERT(size <= ((pool_t *)hdr->buf_hdr.pool_ptr)->
+		   params.vector.max_size);
+
+	hdr->size = size;
+}
+
+odp_pool_t odp_packet_vector_pool(odp_packet_vector_t pktv)
+{
+	pool_t *pool = pktv_hdr(pktv)->buf_hdr.pool_ptr;
+
+	return pool->pool_hdl;
+}
+
+int odp_packet_vector_valid(odp_packet_vector_t pktv)
+{
+	odp_packet_vector_hdr_t *hdr;
+	pool_t *pool;
+
+	if (pktv == ODP_PACKET_VECTOR_INVALID)
+		return 0;
+
+	if (odp_buffer_is_valid((odp_buffer_t)pktv) == 0)
+		return 0;
+
+	hdr  = pktv_hdr(pktv);
+	pool = hdr->buf_hdr.pool_ptr;
+
+	if (hdr->buf_hdr.event_type != ODP_EVENT_PACKET_VECTOR ||
+	    pool->params.type != ODP_POOL_VECTOR)
+		return 0;
+
+	if (hdr->size > pool->params.vector.max_size)
+		return 0;
+
+	return 1;
+}
+
+uint64_t odp_packet_vector_to_u64(odp_packet_vector_t hdl)
+{
+	return _odp_pri(hdl);
+}
@@ -6,6 +6,8 @@
 
 #include "config.h"
 
+#include <odp_posix_extensions.h>
+
 #include <odp/api/pool.h>
 #include <odp/api/shared_memory.h>
 #include <odp/api/align.h>
@@ -16,13 +18,20 @@
 #include <odp_internal.h>
 #include <odp_buffer_inlines.h>
 #include <odp_packet_internal.h>
+#include <odp_packet_vector_internal.h>
 #include <odp_config_internal.h>
 #include <odp_debug_internal.h>
 #include <odp_ring_internal.h>
 
 #include <string.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <inttypes.h>
+#include <pthread.h>
+#include <sched.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/syscall.h>
 
 #include <odp/api/plat/ticketlock_inlines.h>
 #define LOCK(a)      _odp_ticketlock_lock(a)
@@ -39,6 +48,28 @@
 /* Define a practical limit for contiguous memory allocations */
 #define MAX_SIZE   (10 * 1024 * 1024)
 
+/* Buffers are stored into the ring in bursts during pool init */
+#define INIT_BURST         64
+
+/* Maximum number of threads initializing a pool */
+#define INIT_THREADS_MAX   32
+
+/* Smaller pools are always initialized by the calling thread */
+#define INIT_PARALLEL_MIN  (16 * 1024)
+
+/* Smaller pools are not split between NUMA nodes */
+#define NUMA_POOL_MIN      1024
+
+/* NUMA memory policy, see mbind(2) */
+#define NUMA_MPOL_PREFERRED 1
+
+/* Per block size of the cold packet metadata array */
+#if CONFIG_PACKET_COLD_META
+#define PACKET_COLD_SIZE ROUNDUP_CACHE_LINE(sizeof(odp_packet_cold_t))
+#else
+#define PACKET_COLD_SIZE 0
+#endif
+
 ODP_STATIC_ASSERT(CONFIG_POOL_CACHE_SIZE > (2 * CACHE_BURST),
 		  "cache_burst_size_too_large_compared_to_cache_size");
 
@@ -50,10 +81,21 @@ ODP_STATIC_ASSERT(CONFIG_PACKET_SEG_SIZE < 0xffff,
 
 /* Thread local variables */
 typedef struct pool_local_t {
-	pool_cache_t *cache[ODP_CONFIG_POOLS];
 	int thr_id;
+	/* Node ring index of the thread's NUMA node */
+	int node;
 } pool_local_t;
 
+/* Range of blocks initialized by one thread */
+typedef struct init_range_t {
+	pool_t   *pool;
+	uint64_t  page_size;
+	uint32_t  first;
+	uint32_t  last;
+	uint32_t  uarea_idx;
+	pthread_t thread;
+} init_range_t;
+
 pool_table_t *pool_tbl;
 static __thread pool_local_t local;
 
@@ -79,6 +121,69 @@ static inline pool_t *pool_from_buf(odp_buffer_t buf)
 	return buf_hdr->pool_ptr;
 }
 
+static inline pool_cache_t *pool_cache(pool_t *pool, int thr)
+{
+	return (pool_cache_t *)(uintptr_t)&pool->cache_base[thr *
+							   pool->cache_stride];
+}
+
+/* Home node of a buffer in a NUMA aware pool */
+static inline uint32_t buf_node(pool_t *pool, uint32_t buffer_idx)
+{
+	return buffer_idx / pool->node_blocks;
+}
+
+/* Store buffer indexes into the rings of their home nodes */
+static void ring_enq_nodes(pool_t *pool, uint32_t data[], uint32_t num)
+{
+	uint32_t node_data[num];
+	uint32_t node, i, n;
+
+	for (node = 0; node < pool->num_node; node++) {
+		n = 0;
+
+		for (i = 0; i < num; i++)
+			if (buf_node(pool, data[i]) == node)
+				node_data[n++] = data[i];
+
+		if (n)
+			ring_enq_multi(&pool->node_ring[node]->hdr,
+				       pool->ring_mask, node_data, n);
+	}
+}
+
+static inline void ring_enq_home(pool_t *pool, uint32_t data[], uint32_t num)
+{
+	if (odp_likely(pool->num_node == 1))
+		ring_enq_multi(&pool->ring->hdr, pool->ring_mask, data, num);
+	else
+		ring_enq_nodes(pool, data, num);
+}
+
+/* Get buffer indexes from the local node ring. Other nodes are used only
+ * when the local node has run out of buffers. */
+static inline uint32_t ring_deq_local(pool_t *pool, uint32_t data[],
+				      uint32_t num)
+{
+	uint32_t node, i, n;
+
+	if (odp_likely(pool->num_node == 1))
+		return ring_deq_multi(&pool->ring->hdr, pool->ring_mask, data,
+				      num);
+
+	node = local.node % pool->num_node;
+	n    = ring_deq_multi(&pool->node_ring[node]->hdr, pool->ring_mask,
+			      data, num);
+
+	for (i = 1; n < num && i < pool->num_node; i++) {
+		node = (node + 1) % pool->num_node;
+		n   += ring_deq_multi(&pool->node_ring[node]->hdr,
+				      pool->ring_mask, &data[n], num - n);
+	}
+
+	return n;
+}
+
 static inline odp_buffer_hdr_t *buf_hdr_from_index(pool_t *pool,
 						   uint32_t buffer_idx)
 {
@@ -93,6 +198,136 @@ static inline odp_buffer_hdr_t *buf_hdr_from_index(pool_t *pool,
 	return buf_hdr;
 }
 
+/* Parallel pool init is selected with ODP_POOL_INIT_THREADS environment
+ * variable. The value is the maximum number of threads, which run on control
+ * CPUs, that initialize buffers of a large pool. */
+static void init_threads_config(void)
+{
+	const char *env = getenv("ODP_POOL_INIT_THREADS");
+	int num = 1;
+	int num_cpu;
+
+	odp_cpumask_copy(&pool_tbl->init_cpus, &odp_global_data.control_cpus);
+	num_cpu = odp_cpumask_count(&pool_tbl->init_cpus);
+
+	if (env && atoi(env) > 1) {
+		num = atoi(env);
+
+		if (num > num_cpu)
+			num = num_cpu;
+		if (num > INIT_THREADS_MAX)
+			num = INIT_THREADS_MAX;
+		if (num < 1)
+			num = 1;
+
+		ODP_PRINT("Pool: parallel init with %i threads\n", num);
+	}
+
+	pool_tbl->init_threads = num;
+}
+
+/* Read online NUMA node ids in ascending order from a node list
+ * (e.g. "0-1,4"). Returns the number of ids, or zero on failure. */
+static int numa_online_nodes(int node_id[], int max)
+{
+	FILE *file;
+	char str[256];
+	char *tok, *save = NULL;
+	int first, last, id;
+	int num = 0;
+
+	file = fopen("/sys/devices/system/node/online", "r");
+	if (file == NULL)
+		return 0;
+
+	if (fgets(str, sizeof(str), file) == NULL) {
+		fclose(file);
+		return 0;
+	}
+
+	fclose(file);
+
+	for (tok = strtok_r(str, ",\n", &save); tok != NULL;
+	     tok = strtok_r(NULL, ",\n", &save)) {
+		if (sscanf(tok, "%d-%d", &first, &last) != 2) {
+			if (sscanf(tok, "%d", &first) != 1)
+				return 0;
+			last = first;
+		}
+
+		for (id = first; id <= last && num < max; id++)
+			node_id[num++] = id;
+	}
+
+	return num;
+}
+
+/* Node ids of CPUs in ascending order, when online nodes are not known */
+static int numa_cpu_nodes(int node_id[], int max)
+{
+	int cpu, id, i;
+	int num = 0;
+	int max_id = -1;
+
+	for (cpu = 0; cpu < odp_global_data.num_cpus_installed &&
+	     cpu < MAX_CPU_NUMBER; cpu++)
+		if (odp_global_data.system_info.numa_node[cpu] > max_id)
+			max_id = odp_global_data.system_info.numa_node[cpu];
+
+	for (id = 0; id <= max_id && num < max; id++) {
+		for (i = 0; i < odp_global_data.num_cpus_installed &&
+		     i < MAX_CPU_NUMBER; i++) {
+			if (odp_global_data.system_info.numa_node[i] == id) {
+				node_id[num++] = id;
+				break;
+			}
+		}
+	}
+
+	return num;
+}
+
+/* Node ring index of a NUMA node id. Unknown nodes use the first ring. */
+static int numa_node_index(int node_id)
+{
+	uint32_t i;
+
+	for (i = 0; i < pool_tbl->num_node; i++)
+		if (pool_tbl->node_id[i] == node_id)
+			return i;
+
+	return 0;
+}
+
+/* NUMA aware pools are selected with ODP_POOL_NUMA environment variable.
+ * Those are used only when CPUs are spread over multiple NUMA nodes. Node
+ * ids may be sparse, node rings are indexed from zero. */
+static void numa_config(void)
+{
+	const char *env = getenv("ODP_POOL_NUMA");
+	int num = odp_global_data.system_info.num_numa_nodes;
+
+	pool_tbl->num_node   = 1;
+	pool_tbl->node_id[0] = 0;
+
+	if (env == NULL || atoi(env) == 0 || num < 2)
+		return;
+
+	num = numa_online_nodes(pool_tbl->node_id, ODP_POOL_NUMA_NODES_MAX);
+	if (num == 0)
+		num = numa_cpu_nodes(pool_tbl->node_id,
+				     ODP_POOL_NUMA_NODES_MAX);
+
+	if (num < 2) {
+		pool_tbl->node_id[0] = 0;
+		return;
+	}
+
+	pool_tbl->num_node = num;
+
+	ODP_PRINT("Pool: NUMA aware pools, %i nodes\n", num);
+}
+
 int odp_pool_init_global(void)
 {
 	uint32_t i;
@@ -118,6 +353,9 @@ int odp_pool_init_global(void)
 		pool->pool_idx = i;
 	}
 
+	init_threads_config();
+	numa_config();
+
 	ODP_DBG("\nPool init global\n");
 	ODP_DBG("  odp_buffer_hdr_t size %zu\n", sizeof(odp_buffer_hdr_t));
 	ODP_DBG("  odp_packet_hdr_t size %zu\n", sizeof(odp_packet_hdr_t));
@@ -161,27 +399,28 @@ int odp_pool_init_local(void)
 	memset(&local, 0, sizeof(pool_local_t));
 
 	for (i = 0; i < ODP_CONFIG_POOLS; i++) {
-		pool           = pool_entry(i);
-		local.cache[i] = &pool->local_cache[thr_id];
-		local.cache[i]->num = 0;
+		pool = pool_entry(i);
+
+		LOCK(&pool->lock);
+		if (pool->reserved && pool->cache_base)
+			pool_cache(pool, thr_id)->num = 0;
+		UNLOCK(&pool->lock);
 	}
 
 	local.thr_id = thr_id;
+	local.node   = 0;
+
+	if (odp_cpu_id() >= 0 && odp_cpu_id() < MAX_CPU_NUMBER)
+		local.node = numa_node_index(
+			odp_global_data.system_info.numa_node[odp_cpu_id()]);
+
 	return 0;
 }
 
 static void flush_cache(pool_cache_t *cache, pool_t *pool)
 {
-	ring_t *ring;
-	uint32_t mask;
-	uint32_t cache_num, i;
-
-	ring = &pool->ring->hdr;
-	mask = pool->ring_mask;
-	cache_num = cache->num;
-
-	for (i = 0; i < cache_num; i++)
-		ring_enq(ring, mask, cache->buf_index[i]);
+	if (cache->num)
+		ring_enq_home(pool, cache->buf_index, cache->num);
 
 	cache->num = 0;
 }
@@ -193,17 +432,34 @@ int odp_pool_term_local(void)
 	for (i = 0; i < ODP_CONFIG_POOLS; i++) {
 		pool_t *pool = pool_entry(i);
 
-		flush_cache(local.cache[i], pool);
+		LOCK(&pool->lock);
+		if (pool->reserved && pool->cache_base)
+			flush_cache(pool_cache(pool, local.thr_id), pool);
+		UNLOCK(&pool->lock);
 	}
 
 	return 0;
 }
 
-static pool_t *reserve_pool(void)
+/* Ring and thread local caches are sized by the pool: ring_size entries in
+ * each of the 'num_node' rings and cache_size entries in each cache. Caches
+ * are reserved only for the maximum number of threads. */
+static pool_t *reserve_pool(uint32_t ring_size, uint32_t cache_size,
+			    uint32_t num_node, uint32_t num_blocks,
+			    uint32_t cold_size)
 {
 	int i;
 	pool_t *pool;
 	char ring_name[ODP_POOL_NAME_LEN];
+	uint32_t num_thr = odp_thread_count_max();
+	uint32_t ring_len, cache_stride, shm_size, cold_offset, n;
+
+	ring_len     = ROUNDUP_CACHE_LINE(sizeof(pool_ring_t) +
+					  ring_size * sizeof(uint32_t));
+	cache_stride = ROUNDUP_CACHE_LINE(sizeof(pool_cache_t) +
+					  cache_size * sizeof(uint32_t));
+	cold_offset  = num_node * ring_len + num_thr * cache_stride;
+	shm_size     = cold_offset + num_blocks * cold_size;
 
 	for (i = 0; i < ODP_CONFIG_POOLS; i++) {
 		pool = pool_entry(i);
@@ -214,8 +470,7 @@ static pool_t *reserve_pool(void)
 			UNLOCK(&pool->lock);
 			sprintf(ring_name, "pool_ring_%d", i);
 			pool->ring_shm =
-				odp_shm_reserve(ring_name,
-						sizeof(pool_ring_t),
+				odp_shm_reserve(ring_name, shm_size,
 						ODP_CACHE_LINE_SIZE, 0);
 			if (odp_unlikely(pool->ring_shm == ODP_SHM_INVALID)) {
 				ODP_ERR("Unable to alloc pool ring %d\n", i);
@@ -225,6 +480,27 @@ static pool_t *reserve_pool(void)
 				break;
 			}
 			pool->ring = odp_shm_addr(pool->ring_shm);
+			memset(pool->ring, 0, shm_size);
+
+			pool->ring_mask     = ring_size - 1;
+			pool->ring_shm_size = shm_size;
+			pool->cache_size    = cache_size;
+			pool->cache_stride  = cache_stride;
+			pool->num_thr       = num_thr;
+			pool->num_node      = num_node;
+			pool->cache_base    = (uint8_t *)pool->ring +
+					      num_node * ring_len;
+			pool->cold_size     = cold_size;
+			pool->cold_base     = NULL;
+
+			if (cold_size)
+				pool->cold_base = (uint8_t *)pool->ring +
+						  cold_offset;
+
+			for (n = 0; n < num_node; n++)
+				pool->node_ring[n] = (pool_ring_t *)(uintptr_t)
+					((uint8_t *)pool->ring + n * ring_len);
+
 			return pool;
 		}
 		UNLOCK(&pool->lock);
@@ -233,92 +509,234 @@ static pool_t *reserve_pool(void)
 	return NULL;
 }
 
-static void init_buffers(pool_t *pool)
+/* Skip packet buffers which cross huge page boundaries. Some NICs cannot
+ * handle buffers which cross page boundaries. */
+static inline int block_skipped(pool_t *pool, uint64_t page_size, uint32_t i)
+{
+	uint64_t first_page, last_page;
+	uintptr_t addr;
+
+	if (pool->params.type != ODP_POOL_PACKET || page_size < FIRST_HP_SIZE)
+		return 0;
+
+	addr       = (uintptr_t)&pool->base_addr[(uint64_t)i * pool->block_size];
+	first_page = (uint64_t)addr & ~(page_size - 1);
+	last_page  = ((uint64_t)addr + pool->block_size - 1) & ~(page_size - 1);
+
+	return last_page != first_page;
+}
+
+static void init_buffer(pool_t *pool, uint32_t i, uint32_t uarea_idx)
 {
-	uint32_t i;
 	odp_buffer_hdr_t *buf_hdr;
 	odp_packet_hdr_t *pkt_hdr;
-	odp_shm_info_t shm_info;
 	void *addr;
 	void *uarea = NULL;
 	uint8_t *data;
 	uint32_t offset;
-	ring_t *ring;
-	uint32_t mask;
-	int type;
-	uint64_t page_size;
-	int skipped_blocks = 0;
+	int type = pool->params.type;
+
+	addr    = &pool->base_addr[(uint64_t)i * pool->block_size];
+	buf_hdr = addr;
+	pkt_hdr = addr;
+
+	if (pool->uarea_size)
+		uarea = &pool->uarea_base_addr[(uint64_t)uarea_idx *
+					       pool->uarea_size];
+	data = buf_hdr->data;
+
+	if (type == ODP_POOL_PACKET)
+		data = pkt_hdr->data;
+	else if (type == ODP_POOL_VECTOR)
+		data = (uint8_t *)((odp_packet_vector_hdr_t *)addr)->packet;
+
+	offset = pool->headroom;
+
+	/* move to correct align */
+	while (((uintptr_t)&data[offset]) % pool->align != 0)
+		offset++;
+
+	memset(buf_hdr, 0, (uintptr_t)data - (uintptr_t)buf_hdr);
+
+	/* Initialize buffer metadata */
+	buf_hdr->index = i;
+	buf_hdr->type = type;
+	buf_hdr->event_type = type;
+	buf_hdr->pool_ptr = pool;
+	buf_hdr->uarea_addr = uarea;
+	buf_hdr->segcount = 1;
+	buf_hdr->num_seg  = 1;
+	buf_hdr->next_seg = NULL;
+	buf_hdr->last_seg = buf_hdr;
+
+	/* Pointer to data start (of the first segment) */
+	buf_hdr->seg[0].hdr       = buf_hdr;
+	buf_hdr->seg[0].data      = &data[offset];
+	buf_hdr->seg[0].len       = pool->seg_len;
+
+	odp_atomic_init_u32(&buf_hdr->ref_cnt, 0);
+
+	/* Store base values for fast init */
+	if (type == ODP_POOL_PACKET) {
+		pkt_hdr->base_data = buf_hdr->seg[0].data;
+		pkt_hdr->buf_end   = &data[offset + pool->seg_len +
+					pool->tailroom];
+	}
+}
+
+/* Initialize blocks [first, last) and store them into the pool ring */
+static void *init_range(void *arg)
+{
+	init_range_t *range = arg;
+	pool_t *pool = range->pool;
+	uint32_t uarea_idx = range->uarea_idx;
+	uint32_t data[INIT_BURST];
+	uint32_t i, num = 0;
+
+	for (i = range->first; i < range->last; i++) {
+		if (block_skipped(pool, range->page_size, i))
+			continue;
+
+		init_buffer(pool, i, uarea_idx++);
+		data[num++] = i;
+
+		if (num == INIT_BURST) {
+			ring_enq_home(pool, data, num);
+			num = 0;
+		}
+	}
+
+	if (num)
+		ring_enq_home(pool, data, num);
+
+	return NULL;
+}
+
+static int init_thread_create(init_range_t *range, int cpu)
+{
+	pthread_attr_t attr;
+	cpu_set_t cpu_set;
+	int ret;
+
+	pthread_attr_init(&attr);
+	CPU_ZERO(&cpu_set);
+	CPU_SET(cpu, &cpu_set);
+	pthread_attr_setaffinity_np(&attr, sizeof(cpu_set_t), &cpu_set);
+
+	ret = pthread_create(&range->thread, &attr, init_range, range);
+	pthread_attr_destroy(&attr);
+
+	return ret;
+}
+
+/* Set preferred NUMA node of each node block range before the memory is
+ * touched. Failures are not fatal, the memory is then placed by the kernel
+ * default policy. */
+static void numa_bind(pool_t *pool, uint64_t page_size)
+{
+	uint64_t start, end, len;
+	unsigned long node_mask;
+	uint32_t node;
+	int node_id;
+	long ret;
+
+	for (node = 0; node < pool->num_node; node++) {
+		start = (uint64_t)node * pool->node_blocks * pool->block_size;
+		end   = start + (uint64_t)pool->node_blocks * pool->block_size;
+
+		if (end > pool->shm_size)
+			end = pool->shm_size;
+
+		/* Pages shared by two nodes stay on the lower node */
+		start = ROUNDUP_ALIGN(start, page_size);
+		end   = ROUNDUP_ALIGN(end, page_size);
+
+		if (end <= start)
+			continue;
+
+		node_id = pool_tbl->node_id[node];
+
+		if (node_id >= (int)(sizeof(node_mask) * 8)) {
+			ODP_DBG("node %i not in mbind() mask\n", node_id);
+			continue;
+		}
+
+		len       = end - start;
+		node_mask = 1UL << node_id;
+
+		ret = syscall(SYS_mbind, &pool->base_addr[start], len,
+			      NUMA_MPOL_PREFERRED, &node_mask,
+			      sizeof(node_mask) * 8, 0);
+
+		if (ret)
+			ODP_DBG("mbind() to node %i failed: %s\n", node_id,
+				strerror(errno));
+	}
+}
+
+static void init_buffers(pool_t *pool)
+{
+	odp_shm_info_t shm_info;
+	init_range_t range[INIT_THREADS_MAX];
+	int created[INIT_THREADS_MAX];
+	uint32_t block, used;
+	int num_thr, i, cpu;
 
 	if (odp_shm_info(pool->shm, &shm_info))
 		ODP_ABORT("Shm info failed\n");
 
-	page_size = shm_info.page_size;
-	ring = &pool->ring->hdr;
-	mask = pool->ring_mask;
-	type = pool->params.type;
-
-	for (i = 0; i < pool->num + skipped_blocks ; i++) {
-		addr    = &pool->base_addr[i * pool->block_size];
-		buf_hdr = addr;
-		pkt_hdr = addr;
-		/* Skip packet buffers which cross huge page boundaries. Some
-		 * NICs cannot handle buffers which cross page boundaries. */
-		if (pool->params.type == ODP_POOL_PACKET &&
-		    page_size >= FIRST_HP_SIZE) {
-			uint64_t first_page;
-			uint64_t last_page;
-
-			first_page = ((uint64_t)(uintptr_t)addr &
-					~(page_size - 1));
-			last_page = (((uint64_t)(uintptr_t)addr +
-					pool->block_size - 1) &
-					~(page_size - 1));
-			if (last_page != first_page) {
-				skipped_blocks++;
-				continue;
-			}
-		}
-		if (pool->uarea_size)
-			uarea = &pool->uarea_base_addr[(i - skipped_blocks) *
-						       pool->uarea_size];
-		data = buf_hdr->data;
+	num_thr = pool_tbl->init_threads;
 
-		if (type == ODP_POOL_PACKET)
-			data = pkt_hdr->data;
+	if (pool->num < INIT_PARALLEL_MIN)
+		num_thr = 1;
 
-		offset = pool->headroom;
+	if (pool->num_node > 1)
+		numa_bind(pool, shm_info.page_size);
 
-		/* move to correct align */
-		while (((uintptr_t)&data[offset]) % pool->align != 0)
-			offset++;
+	memset(pool->node_num, 0, sizeof(pool->node_num));
 
-		memset(buf_hdr, 0, (uintptr_t)data - (uintptr_t)buf_hdr);
+	/* Split buffers evenly between threads. Skipped blocks are found
+	 * from block addresses without touching pool memory. */
+	block = 0;
+	used  = 0;
 
-		/* Initialize buffer metadata */
-		buf_hdr->index = i;
-		buf_hdr->type = type;
-		buf_hdr->event_type = type;
-		buf_hdr->pool_ptr = pool;
-		buf_hdr->uarea_addr = uarea;
-		buf_hdr->segcount = 1;
-		buf_hdr->num_seg  = 1;
-		buf_hdr->next_seg = NULL;
-		buf_hdr->last_seg = buf_hdr;
+	for (i = 0; i < num_thr; i++) {
+		uint32_t end = ((uint64_t)pool->num * (i + 1)) / num_thr;
 
-		/* Pointer to data start (of the first segment) */
-		buf_hdr->seg[0].hdr       = buf_hdr;
-		buf_hdr->seg[0].data      = &data[offset];
-		buf_hdr->seg[0].len       = pool->seg_len;
+		range[i].pool      = pool;
+		range[i].page_size = shm_info.page_size;
+		range[i].first     = block;
+		range[i].uarea_idx = used;
 
-		odp_atomic_init_u32(&buf_hdr->ref_cnt, 0);
+		while (used < end) {
+			if (!block_skipped(pool, shm_info.page_size, block)) {
+				pool->node_num[buf_node(pool, block)]++;
+				used++;
+			}
+			block++;
+		}
+
+		range[i].last = block;
+	}
+
+	/* The calling thread initializes the first range */
+	cpu = odp_cpumask_first(&pool_tbl->init_cpus);
+
+	for (i = 1; i < num_thr; i++) {
+		cpu = odp_cpumask_next(&pool_tbl->init_cpus, cpu);
+		if (cpu < 0)
+			cpu = odp_cpumask_first(&pool_tbl->init_cpus);
+
+		created[i] = init_thread_create(&range[i], cpu) == 0;
+	}
 
-		/* Store base values for fast init */
-		buf_hdr->base_data = buf_hdr->seg[0].data;
-		buf_hdr->buf_end   = &data[offset + pool->seg_len +
-				     pool->tailroom];
+	init_range(&range[0]);
 
-		/* Store buffer index into the global pool */
-		ring_enq(ring, mask, i);
+	for (i = 1; i < num_thr; i++) {
+		if (created[i])
+			pthread_join(range[i].thread, NULL);
+		else
+			init_range(&range[i]);
 	}
 }
 
@@ -338,16 +756,19 @@ static bool shm_is_from_huge_pages(odp_shm_t shm)
 	return (info.page_size >= huge_page_size);
 }
 
+/* Create a pool. A non-zero 'class_len' creates a buffer size class of
+ * a packet pool, which stores 'class_len' bytes per segment. */
 static odp_pool_t pool_create(const char *name, odp_pool_param_t *params,
-			      uint32_t shmflags)
+			      uint32_t shmflags, uint32_t class_len)
 {
 	pool_t *pool;
 	uint32_t uarea_size, headroom, tailroom;
 	odp_shm_t shm;
 	uint32_t seg_len, align, num, hdr_size, block_size;
 	uint32_t max_len;
-	uint32_t ring_size;
+	uint32_t ring_size, cache_size, num_node, node_blocks, i;
 	uint32_t num_extra = 0;
+	uint32_t cold_size = 0;
 	int name_len;
 	const char *postfix = "_uarea";
 	char uarea_name[ODP_POOL_NAME_LEN + sizeof(postfix)];
@@ -396,11 +817,24 @@ static odp_pool_t pool_create(const char *name, odp_pool_param_t *params,
 		if (seg_len < CONFIG_PACKET_SEG_LEN_MIN)
 			seg_len = CONFIG_PACKET_SEG_LEN_MIN;
 
+		if (class_len) {
+			seg_len = class_len;
+
+			if (seg_len < PACKET_PARSE_SEG_LEN)
+				seg_len = PACKET_PARSE_SEG_LEN;
+
+			seg_len = ROUNDUP_CACHE_LINE(seg_len);
+
+			if (seg_len > CONFIG_PACKET_MAX_SEG_LEN)
+				seg_len = CONFIG_PACKET_MAX_SEG_LEN;
+		}
+
 		/* Make sure that at least one 'max_len' packet can fit in the
 		 * pool. */
 		if (params->pkt.max_len != 0)
 			max_len = params->pkt.max_len;
-		if ((max_len + seg_len - 1) / seg_len > CONFIG_PACKET_MAX_SEGS)
+		if (!class_len &&
+		    (max_len + seg_len - 1) / seg_len > CONFIG_PACKET_MAX_SEGS)
 			seg_len = (max_len + CONFIG_PACKET_MAX_SEGS - 1) /
 				CONFIG_PACKET_MAX_SEGS;
 		if (seg_len > CONFIG_PACKET_MAX_SEG_LEN) {
@@ -408,16 +842,27 @@ static odp_pool_t pool_create(const char *name, odp_pool_param_t *params,
 			return ODP_POOL_INVALID;
 		}
 
+		/* Longer packets are stored in a larger buffer size class */
+		if (class_len &&
+		    max_len / seg_len >= CONFIG_PACKET_MAX_SEGS)
+			max_len = seg_len * CONFIG_PACKET_MAX_SEGS;
+
 		headroom    = CONFIG_PACKET_HEADROOM;
 		tailroom    = CONFIG_PACKET_TAILROOM;
 		num         = params->pkt.num;
 		uarea_size  = params->pkt.uarea_size;
+		cold_size   = PACKET_COLD_SIZE;
 		break;
 
 	case ODP_POOL_TIMEOUT:
 		num = params->tmo.num;
 		break;
 
+	case ODP_POOL_VECTOR:
+		num     = params->vector.num;
+		seg_len = params->vector.max_size * sizeof(odp_packet_t);
+		break;
+
 	default:
 		ODP_ERR("Bad pool type");
 		return ODP_POOL_INVALID;
@@ -426,7 +871,57 @@ static odp_pool_t pool_create(const char *name, odp_pool_param_t *params,
 	if (uarea_size)
 		uarea_size = ROUNDUP_CACHE_LINE(uarea_size);
 
-	pool = reserve_pool();
+	hdr_size = sizeof(odp_packet_hdr_t);
+	hdr_size = ROUNDUP_CACHE_LINE(hdr_size);
+
+	block_size = ROUNDUP_CACHE_LINE(hdr_size + align + headroom + seg_len +
+					tailroom);
+
+	/* Allocate extra memory for skipping packet buffers which cross huge
+	 * page boundaries. */
+	if (params->type == ODP_POOL_PACKET) {
+		num_extra = (((uint64_t)num * block_size +
+				FIRST_HP_SIZE - 1) / FIRST_HP_SIZE);
+		num_extra += (((uint64_t)num_extra * block_size +
+				FIRST_HP_SIZE - 1) / FIRST_HP_SIZE);
+	}
+
+	/* Buffers are addressed with 32 bit offsets */
+	if ((uint64_t)(num + num_extra) * block_size > UINT32_MAX ||
+	    (uint64_t)num * uarea_size > UINT32_MAX) {
+		ODP_ERR("Pool too large: %u buffers of %u bytes\n", num,
+			block_size);
+		return ODP_POOL_INVALID;
+	}
+
+	/* NUMA aware pools are split into equal block ranges per node. Each
+	 * node ring must fit all usable blocks of the node. */
+	num_node    = 1;
+	node_blocks = num + num_extra;
+
+	if (pool_tbl->num_node > 1 && num >= NUMA_POOL_MIN) {
+		num_node    = pool_tbl->num_node;
+		node_blocks = (num + num_extra + num_node - 1) / num_node;
+	}
+
+	ring_size = node_blocks < num ? node_blocks : num;
+
+	if (ring_size <= RING_SIZE_MIN)
+		ring_size = RING_SIZE_MIN;
+	else
+		ring_size = ROUNDUP_POWER2_U32(ring_size);
+
+	/* Small pools do not benefit from large caches. Limit cached buffers
+	 * to a quarter of the pool, but keep room for a burst. */
+	cache_size = CONFIG_POOL_CACHE_SIZE;
+
+	if (num / 4 < cache_size)
+		cache_size = num / 4;
+	if (cache_size < 2 * CACHE_BURST)
+		cache_size = 2 * CACHE_BURST;
+
+	pool = reserve_pool(ring_size, cache_size, num_node, num + num_extra,
+			    cold_size);
 
 	if (pool == NULL) {
 		ODP_ERR("No more free pools");
@@ -447,27 +942,9 @@ static odp_pool_t pool_create(const char *name, odp_pool_param_t *params,
 
 	pool->params = *params;
 
-	hdr_size = sizeof(odp_packet_hdr_t);
-	hdr_size = ROUNDUP_CACHE_LINE(hdr_size);
-
-	block_size = ROUNDUP_CACHE_LINE(hdr_size + align + headroom + seg_len +
-					tailroom);
-
-	/* Allocate extra memory for skipping packet buffers which cross huge
-	 * page boundaries. */
-	if (params->type == ODP_POOL_PACKET) {
-		num_extra = (((uint64_t)(num * block_size) +
-				FIRST_HP_SIZE - 1) / FIRST_HP_SIZE);
-		num_extra += (((uint64_t)(num_extra * block_size) +
-				FIRST_HP_SIZE - 1) / FIRST_HP_SIZE);
-	}
-
-	if (num <= RING_SIZE_MIN)
-		ring_size = RING_SIZE_MIN;
-	else
-		ring_size = ROUNDUP_POWER2_U32(num);
+	pool->shm       = ODP_SHM_INVALID;
+	pool->uarea_shm = ODP_SHM_INVALID;
 
-	pool->ring_mask      = ring_size - 1;
 	pool->num            = num;
 	pool->align          = align;
 	pool->headroom       = headroom;
@@ -481,6 +958,12 @@ static odp_pool_t pool_create(const char *name, odp_pool_param_t *params,
 	pool->uarea_shm_size = num * uarea_size;
 	pool->ext_desc       = NULL;
 	pool->ext_destroy    = NULL;
+	pool->remote_free    = NULL;
+	pool->remote_ctx     = NULL;
+	pool->node_blocks    = node_blocks;
+	pool->num_class      = 1;
+	pool->class_pool[0]  = pool;
+	pool->parent         = NULL;
 
 	shm = odp_shm_reserve(pool->name, pool->shm_size,
 			      ODP_PAGE_SIZE, shmflags);
@@ -496,7 +979,6 @@ static odp_pool_t pool_create(const char *name, odp_pool_param_t *params,
 
 	pool->base_addr = odp_shm_addr(pool->shm);
 
-	pool->uarea_shm = ODP_SHM_INVALID;
 	if (uarea_size) {
 		shm = odp_shm_reserve(uarea_name, pool->uarea_shm_size,
 				      ODP_PAGE_SIZE, shmflags);
@@ -511,7 +993,9 @@ static odp_pool_t pool_create(const char *name, odp_pool_param_t *params,
 		pool->uarea_base_addr = odp_shm_addr(pool->uarea_shm);
 	}
 
-	ring_init(&pool->ring->hdr);
+	for (i = 0; i < num_node; i++)
+		ring_init(&pool->node_ring[i]->hdr);
+
 	init_buffers(pool);
 
 	return pool->pool_hdl;
@@ -523,15 +1007,166 @@ error:
 	if (pool->uarea_shm != ODP_SHM_INVALID)
 		odp_shm_free(pool->uarea_shm);
 
+	odp_shm_free(pool->ring_shm);
+
 	LOCK(&pool->lock);
-	pool->reserved = 0;
+	pool->reserved   = 0;
+	pool->ring       = NULL;
+	pool->cache_base = NULL;
+	pool->cold_base  = NULL;
+	UNLOCK(&pool->lock);
+	return ODP_POOL_INVALID;
+}
+
+pool_t *pool_create_remote(const char *name, odp_pool_t local,
+			   uint8_t *base_addr, uint32_t num,
+			   uint32_t block_size, uint32_t seg_len,
+			   pool_free_cb_fn free_fn, void *ctx)
+{
+	pool_t *pool;
+
+	/* Buffers are never stored into the ring or caches */
+	pool = reserve_pool(RING_SIZE_MIN, 0, 1, num, PACKET_COLD_SIZE);
+
+	if (pool == NULL) {
+		ODP_ERR("No more free pools");
+		return NULL;
+	}
+
+	strncpy(pool->name, name, ODP_POOL_NAME_LEN - 1);
+	pool->name[ODP_POOL_NAME_LEN - 1] = 0;
+
+	memset(&pool->params, 0, sizeof(odp_pool_param_t));
+	pool->params.type    = ODP_POOL_PACKET;
+	pool->params.pkt.num = num;
+	pool->params.pkt.len = seg_len;
+
+	pool->num             = num;
+	pool->align           = ODP_CONFIG_BUFFER_ALIGN_MIN;
+	pool->headroom        = CONFIG_PACKET_HEADROOM;
+	pool->seg_len         = seg_len;
+	pool->max_seg_len     = CONFIG_PACKET_HEADROOM + seg_len +
+				CONFIG_PACKET_TAILROOM;
+	pool->max_len         = seg_len;
+	pool->tailroom        = CONFIG_PACKET_TAILROOM;
+	pool->block_size      = block_size;
+	pool->uarea_size      = 0;
+	pool->shm_size        = 0;
+	pool->uarea_shm_size  = 0;
+	pool->shm             = ODP_SHM_INVALID;
+	pool->uarea_shm       = ODP_SHM_INVALID;
+	pool->base_addr       = base_addr;
+	pool->uarea_base_addr = NULL;
+	pool->ext_desc        = NULL;
+	pool->ext_destroy     = NULL;
+	pool->remote_free     = free_fn;
+	pool->remote_ctx      = ctx;
+	pool->node_blocks     = num;
+	pool->node_num[0]     = num;
+	pool->num_class       = 1;
+	pool->class_pool[0]   = pool;
+	pool->mem_from_huge_pages = 0;
+
+	/* Like a buffer size class, remote pool is seen as the local pool.
+	 * Packets which need more memory are copied into the local pool. */
+	pool->pool_hdl        = local;
+	pool->parent          = pool_entry_from_hdl(local);
+
+	/* Ring stays empty, all allocations from a remote pool fail */
+	ring_init(&pool->ring->hdr);
+
+	return pool;
+}
+
+void pool_destroy_remote(pool_t *pool)
+{
+	LOCK(&pool->lock);
+	pool->remote_free = NULL;
+	pool->remote_ctx  = NULL;
+	pool->reserved    = 0;
+	odp_shm_free(pool->ring_shm);
+	pool->ring       = NULL;
+	pool->cache_base = NULL;
+	pool->cold_base  = NULL;
+	pool->pool_hdl   = pool_index_to_handle(pool->pool_idx);
+	pool->parent     = NULL;
 	UNLOCK(&pool->lock);
+}
+
+/* Create a packet pool with multiple buffer size classes. Each class is
+ * a pool of its own with a ring and thread local caches. */
+static odp_pool_t pool_create_classes(const char *name,
+				      odp_pool_param_t *params,
+				      uint32_t shmflags)
+{
+	odp_pool_param_t class_param;
+	char class_name[ODP_POOL_NAME_LEN];
+	odp_pool_t pool_hdl = ODP_POOL_INVALID;
+	odp_pool_t class_hdl;
+	pool_t *pool = NULL;
+	pool_t *class;
+	uint32_t num_class = params->pkt.num_subparam + 1;
+	uint32_t max_len = params->pkt.max_len;
+	uint32_t i, len;
+
+	if (max_len == 0)
+		max_len = CONFIG_PACKET_MAX_LEN;
+
+	class_param = *params;
+	class_param.pkt.num_subparam = 0;
+
+	for (i = 0; i < num_class; i++) {
+		if (i > 0) {
+			class_param.pkt.num = params->pkt.sub[i - 1].num;
+			class_param.pkt.len = params->pkt.sub[i - 1].len;
+		}
+
+		len = class_param.pkt.len ? class_param.pkt.len : 1;
+
+		/* The largest class must store a 'max_len' packet */
+		if (i == num_class - 1 &&
+		    (max_len + len - 1) / len > CONFIG_PACKET_MAX_SEGS)
+			len = (max_len + CONFIG_PACKET_MAX_SEGS - 1) /
+			      CONFIG_PACKET_MAX_SEGS;
+
+		snprintf(class_name, sizeof(class_name), "%.*s_c%u",
+			 ODP_POOL_NAME_LEN - 8, name ? name : "", i);
+
+		class_hdl = pool_create(i ? class_name : name, &class_param,
+					shmflags, len);
+
+		if (class_hdl == ODP_POOL_INVALID)
+			goto error;
+
+		class = pool_entry_from_hdl(class_hdl);
+
+		if (i == 0) {
+			pool     = class;
+			pool_hdl = class_hdl;
+		} else {
+			class->parent   = pool;
+			class->pool_hdl = pool_hdl;
+		}
+
+		pool->class_pool[i] = class;
+		pool->num_class     = i + 1;
+	}
+
+	pool->params = *params;
+
+	return pool_hdl;
+
+error:
+	if (pool != NULL)
+		odp_pool_destroy(pool_hdl);
+
 	return ODP_POOL_INVALID;
 }
 
 static int check_params(odp_pool_param_t *params)
 {
 	odp_pool_capability_t capa;
+	int i;
 
 	if (odp_pool_capability(&capa) < 0)
 		return -1;
@@ -579,6 +1214,30 @@ static int check_params(odp_pool_param_t *params)
 			return -1;
 		}
 
+		if (params->pkt.num_subparam > capa.pkt.max_num_subparam) {
+			printf("pkt.num_subparam too large %u\n",
+			       params->pkt.num_subparam);
+			return -1;
+		}
+
+		for (i = 0; i < params->pkt.num_subparam; i++) {
+			uint32_t prev_len = i ? params->pkt.sub[i - 1].len :
+						params->pkt.len;
+
+			if (params->pkt.sub[i].len <= prev_len ||
+			    params->pkt.sub[i].len > capa.pkt.max_len) {
+				printf("pkt.sub[%i].len bad value %u\n", i,
+				       params->pkt.sub[i].len);
+				return -1;
+			}
+
+			if (params->pkt.sub[i].num > capa.pkt.max_num) {
+				printf("pkt.sub[%i].num too large %u\n", i,
+				       params->pkt.sub[i].num);
+				return -1;
+			}
+		}
+
 		break;
 
 	case ODP_POOL_TIMEOUT:
@@ -588,6 +1247,20 @@ static int check_params(odp_pool_param_t *params)
 		}
 		break;
 
+	case ODP_POOL_VECTOR:
+		if (params->vector.num > capa.vector.max_num) {
+			printf("vector.num too large %u\n", params->vector.num);
+			return -1;
+		}
+
+		if (params->vector.max_size == 0 ||
+		    params->vector.max_size > capa.vector.max_size) {
+			printf("vector.max_size bad value %u\n",
+			       params->vector.max_size);
+			return -1;
+		}
+		break;
+
 	default:
 		printf("bad pool type %i\n", params->type);
 		return -1;
@@ -603,20 +1276,20 @@ odp_pool_t odp_pool_create(const char *name, odp_pool_param_t *params)
 	if (check_params(params))
 		return ODP_POOL_INVALID;
 
-	if (params && (params->type == ODP_POOL_PACKET))
+	if (params && (params->type == ODP_POOL_PACKET)) {
 		shm_flags = ODP_SHM_PROC;
 
-	return pool_create(name, params, shm_flags);
+		if (params->pkt.num_subparam)
+			return pool_create_classes(name, params, shm_flags);
+	}
+
+	return pool_create(name, params, shm_flags, 0);
 }
 
-int odp_pool_destroy(odp_pool_t pool_hdl)
+static int pool_destroy(pool_t *pool)
 {
-	pool_t *pool = pool_entry_from_hdl(pool_hdl);
 	int i;
 
-	if (pool == NULL)
-		return -1;
-
 	LOCK(&pool->lock);
 
 	if (pool->reserved == 0) {
@@ -625,6 +1298,12 @@ int odp_pool_destroy(odp_pool_t pool_hdl)
 		return -1;
 	}
 
+	if (pool->remote_free) {
+		UNLOCK(&pool->lock);
+		ODP_ERR("Remote pool is destroyed by its pktio\n");
+		return -1;
+	}
+
 	/* Destroy external DPDK mempool */
 	if (pool->ext_destroy) {
 		pool->ext_destroy(pool->ext_desc);
@@ -633,8 +1312,8 @@ int odp_pool_destroy(odp_pool_t pool_hdl)
 	}
 
 	/* Make sure local caches are empty */
-	for (i = 0; i < ODP_THREAD_COUNT_MAX; i++)
-		flush_cache(&pool->local_cache[i], pool);
+	for (i = 0; i < (int)pool->num_thr; i++)
+		flush_cache(pool_cache(pool, i), pool);
 
 	odp_shm_free(pool->shm);
 
@@ -643,12 +1322,37 @@ int odp_pool_destroy(odp_pool_t pool_hdl)
 
 	pool->reserved = 0;
 	odp_shm_free(pool->ring_shm);
-	pool->ring = NULL;
+	pool->ring       = NULL;
+	pool->cache_base = NULL;
+	pool->cold_base  = NULL;
+	pool->pool_hdl   = pool_index_to_handle(pool->pool_idx);
+	pool->parent     = NULL;
+	pool->num_class  = 0;
 	UNLOCK(&pool->lock);
 
 	return 0;
 }
 
+int odp_pool_destroy(odp_pool_t pool_hdl)
+{
+	pool_t *pool = pool_entry_from_hdl(pool_hdl);
+	uint32_t i;
+	int ret = 0;
+
+	if (pool == NULL)
+		return -1;
+
+	/* Hidden buffer size classes first */
+	for (i = 1; i < pool->num_class; i++)
+		if (pool_destroy(pool->class_pool[i]))
+			ret = -1;
+
+	if (pool_destroy(pool))
+		ret = -1;
+
+	return ret;
+}
+
 odp_event_type_t _odp_buffer_event_type(odp_buffer_t buf)
 {
 	return buf_hdl_to_hdr(buf)->event_type;
@@ -668,7 +1372,7 @@ odp_pool_t odp_pool_lookup(const char *name)
 		pool = pool_entry(i);
 
 		LOCK(&pool->lock);
-		if (strcmp(name, pool->name) == 0) {
+		if (pool->parent == NULL && strcmp(name, pool->name) == 0) {
 			/* found it */
 			UNLOCK(&pool->lock);
 			return pool->pool_hdl;
@@ -682,25 +1386,34 @@ odp_pool_t odp_pool_lookup(const char *name)
 int odp_pool_info(odp_pool_t pool_hdl, odp_pool_info_t *info)
 {
 	pool_t *pool = pool_entry_from_hdl(pool_hdl);
+	uint32_t i;
 
 	if (pool == NULL || info == NULL)
 		return -1;
 
 	info->name = pool->name;
 	info->params = pool->params;
+	info->num_node = pool->num_node;
+
+	memset(info->node_num, 0, sizeof(info->node_num));
+	memset(info->node_id, 0, sizeof(info->node_id));
+	memcpy(info->node_num, pool->node_num,
+	       pool->num_node * sizeof(uint32_t));
+
+	for (i = 0; i < pool->num_node; i++)
+		info->node_id[i] = pool_tbl->node_id[i];
 
 	return 0;
 }
 
 int buffer_alloc_multi(pool_t *pool, odp_buffer_hdr_t *buf_hdr[], int max_num)
 {
-	ring_t *ring;
-	uint32_t mask, i;
+	uint32_t i;
 	pool_cache_t *cache;
 	uint32_t cache_num, num_ch, num_deq, burst;
 	odp_buffer_hdr_t *hdr;
 
-	cache = local.cache[pool->pool_idx];
+	cache = pool_cache(pool, local.thr_id);
 
 	cache_num = cache->num;
 	num_ch    = max_num;
@@ -729,9 +1442,7 @@ int buffer_alloc_multi(pool_t *pool, odp_buffer_hdr_t *buf_hdr[], int max_num)
 		 * and not uint32_t. */
 		uint32_t data[burst];
 
-		ring      = &pool->ring->hdr;
-		mask      = pool->ring_mask;
-		burst     = ring_deq_multi(ring, mask, data, burst);
+		burst     = ring_deq_local(pool, data, burst);
 		cache_num = burst - num_deq;
 
 		if (odp_unlikely(burst < num_deq)) {
@@ -763,24 +1474,20 @@ static inline void buffer_free_to_pool(pool_t *pool,
 				       odp_buffer_hdr_t *buf_hdr[], int num)
 {
 	int i;
-	ring_t *ring;
-	uint32_t mask;
 	pool_cache_t *cache;
 	uint32_t cache_num;
 
-	cache = local.cache[pool->pool_idx];
+	cache = pool_cache(pool, local.thr_id);
 
 	/* Special case of a very large free. Move directly to
 	 * the global pool. */
-	if (odp_unlikely(num > CONFIG_POOL_CACHE_SIZE)) {
+	if (odp_unlikely((uint32_t)num > pool->cache_size)) {
 		uint32_t buf_index[num];
 
-		ring  = &pool->ring->hdr;
-		mask  = pool->ring_mask;
 		for (i = 0; i < num; i++)
 			buf_index[i] = buf_hdr[i]->index;
 
-		ring_enq_multi(ring, mask, buf_index, num);
+		ring_enq_home(pool, buf_index, num);
 
 		return;
 	}
@@ -789,13 +1496,10 @@ static inline void buffer_free_to_pool(pool_t *pool,
 	 * transfer. */
 	cache_num = cache->num;
 
-	if (odp_unlikely((int)(CONFIG_POOL_CACHE_SIZE - cache_num) < num)) {
+	if (odp_unlikely((int)(pool->cache_size - cache_num) < num)) {
 		uint32_t index;
 		int burst = CACHE_BURST;
 
-		ring  = &pool->ring->hdr;
-		mask  = pool->ring_mask;
-
 		if (odp_unlikely(num > CACHE_BURST))
 			burst = num;
 		if (odp_unlikely((uint32_t)num > cache_num))
@@ -811,7 +1515,7 @@ static inline void buffer_free_to_pool(pool_t *pool,
 			for (i = 0; i < burst; i++)
 				data[i] = cache->buf_index[index + i];
 
-			ring_enq_multi(ring, mask, data, burst);
+			ring_enq_home(pool, data, burst);
 		}
 
 		cache_num -= burst;
@@ -823,6 +1527,30 @@ static inline void buffer_free_to_pool(pool_t *pool,
 	cache->num = cache_num + num;
 }
 
+/* Buffers of other NUMA nodes are returned directly to their home node
+ * rings, so that local caches hold only local buffers */
+static void buffer_free_numa(pool_t *pool, odp_buffer_hdr_t *buf_hdr[],
+			     int num)
+{
+	odp_buffer_hdr_t *local_hdr[num];
+	uint32_t remote_idx[num];
+	uint32_t node = local.node % pool->num_node;
+	int i, num_local = 0, num_remote = 0;
+
+	for (i = 0; i < num; i++) {
+		if (buf_node(pool, buf_hdr[i]->index) == node)
+			local_hdr[num_local++] = buf_hdr[i];
+		else
+			remote_idx[num_remote++] = buf_hdr[i]->index;
+	}
+
+	if (num_remote)
+		ring_enq_home(pool, remote_idx, num_remote);
+
+	if (num_local)
+		buffer_free_to_pool(pool, local_hdr, num_local);
+}
+
 void buffer_free_multi(odp_buffer_hdr_t *buf_hdr[], int num_total)
 {
 	pool_t *pool;
@@ -844,7 +1572,12 @@ void buffer_free_multi(odp_buffer_hdr_t *buf_hdr[], int num_total)
 			num = i - first;
 		}
 
-		buffer_free_to_pool(pool, &buf_hdr[first], num);
+		if (odp_unlikely(pool->remote_free != NULL))
+			pool->remote_free(pool, &buf_hdr[first], num);
+		else if (odp_unlikely(pool->num_node > 1))
+			buffer_free_numa(pool, &buf_hdr[first], num);
+		else
+			buffer_free_to_pool(pool, &buf_hdr[first], num);
 
 		if (i == num_total)
 			return;
@@ -915,17 +1648,24 @@ int odp_pool_capability(odp_pool_capability_t *capa)
 	capa->pkt.min_seg_len      = CONFIG_PACKET_SEG_LEN_MIN;
 	capa->pkt.max_seg_len      = max_seg_len;
 	capa->pkt.max_uarea_size   = MAX_SIZE;
+	capa->pkt.max_num_subparam = ODP_POOL_MAX_SUBPARAMS;
 
 	/* Timeout pools */
 	capa->tmo.max_pools = ODP_CONFIG_POOLS;
 	capa->tmo.max_num   = CONFIG_POOL_MAX_NUM;
 
+	/* Packet vector pools */
+	capa->vector.max_pools = ODP_CONFIG_POOLS;
+	capa->vector.max_num   = CONFIG_POOL_MAX_NUM;
+	capa->vector.max_size  = CONFIG_PACKET_VECTOR_MAX_SIZE;
+
 	return 0;
 }
 
 void odp_pool_print(odp_pool_t pool_hdl)
 {
 	pool_t *pool;
+	uint32_t i;
 
 	pool = pool_entry_from_hdl(pool_hdl);
 
@@ -938,7 +1678,8 @@ void odp_pool_print(odp_pool_t pool_hdl)
 	       pool->params.type == ODP_POOL_BUFFER ? "buffer" :
 	       (pool->params.type == ODP_POOL_PACKET ? "packet" :
 	       (pool->params.type == ODP_POOL_TIMEOUT ? "timeout" :
-		"unknown")));
+	       (pool->params.type == ODP_POOL_VECTOR ? "packet vector" :
+		"unknown"))));
 	printf("  pool shm        %" PRIu64 "\n",
 	       odp_shm_to_u64(pool->shm));
 	printf("  user area shm   %" PRIu64 "\n",
@@ -947,7 +1688,7 @@ void odp_pool_print(odp_pool_t pool_hdl)
 	printf("  align           %u\n", pool->align);
 	printf("  headroom        %u\n", pool->headroom);
 	printf("  seg len         %u\n", pool->seg_len);
-	printf("  max data len    %u\n", pool->max_len);
+	printf("  max data len    %u\n", pool_max_len(pool));
 	printf("  tailroom        %u\n", pool->tailroom);
 	printf("  block size      %u\n", pool->block_size);
 	printf("  uarea size      %u\n", pool->uarea_size);
@@ -955,6 +1696,23 @@ void odp_pool_print(odp_pool_t pool_hdl)
 	printf("  base addr       %p\n", pool->base_addr);
 	printf("  uarea shm size  %u\n", pool->uarea_shm_size);
 	printf("  uarea base addr %p\n", pool->uarea_base_addr);
+	printf("  ring size       %u\n", pool->ring_mask + 1);
+	printf("  NUMA nodes      %u\n", pool->num_node);
+
+	for (i = 0; i < pool->num_node; i++)
+		printf("    node %i num    %u\n", pool_tbl->node_id[i],
+		       pool->node_num[i]);
+
+	printf("  cache size      %u\n", pool->cache_size);
+	printf("  cache threads   %u\n", pool->num_thr);
+	printf("  cold meta size  %u\n", pool->cold_size);
+	printf("  size classes    %u\n", pool->num_class);
+
+	for (i = 1; i < pool->num_class; i++)
+		printf("    class %u seg len %u num %u\n", i,
+		       pool->class_pool[i]->seg_len,
+		       pool->class_pool[i]->num);
+	printf("  ring shm size   %u\n", pool->ring_shm_size);
 	printf("\n");
 }
 
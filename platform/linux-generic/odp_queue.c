@@ -19,9 +19,11 @@
 #include <odp/api/shared_memory.h>
 #include <odp/api/schedule.h>
 #include <odp_schedule_if.h>
+#include <odp_schedule_stats_internal.h>
 #include <odp_config_internal.h>
 #include <odp_packet_io_internal.h>
 #include <odp_debug_internal.h>
+#include <odp_ring_internal.h>
 #include <odp/api/hints.h>
 #include <odp/api/sync.h>
 #include <odp/api/traffic_mngr.h>
@@ -31,16 +33,30 @@
 #include <odp/api/plat/ticketlock_inlines.h>
 #define LOCK(a)      _odp_ticketlock_lock(a)
 #define UNLOCK(a)    _odp_ticketlock_unlock(a)
-#define LOCK_INIT(a) odp_ticketlock_init(a)
 
 #include <string.h>
+#include <stdlib.h>
 #include <inttypes.h>
 
 static int queue_init(queue_entry_t *queue, const char *name,
 		      const odp_queue_param_t *param);
 
+/* Queue table is followed by queue entries and the free index ring in the
+ * same shared memory block. Memory of a queue entry is not touched before
+ * the queue is created for the first time. */
 typedef struct queue_table_t {
-	queue_entry_t  queue[ODP_CONFIG_QUEUES];
+	/* Queue entries */
+	queue_entry_t   *queue;
+
+	/* Ring of destroyed queue indexes available for reuse */
+	ring_t          *free_ring;
+
+	/* Number of queues */
+	uint32_t         num_queues;
+
+	/* Queue entries starting from this index have never been used */
+	odp_atomic_u32_t next_index;
+
 } queue_table_t;
 
 static queue_table_t *queue_tbl;
@@ -67,31 +83,97 @@ queue_entry_t *get_qentry(uint32_t queue_id)
 	return &queue_tbl->queue[queue_id];
 }
 
-static int queue_init_global(void)
+/* Number of queues from ODP_NUM_QUEUES environment variable. Rounded up to
+ * a power of two and limited to the range supported by the scheduler. */
+static uint32_t queue_num_config(void)
 {
+	const char *env = getenv("ODP_NUM_QUEUES");
+	uint32_t max = sched_fn->max_queues();
+	unsigned long num;
+
+	if (max > CONFIG_MAX_QUEUES)
+		max = CONFIG_MAX_QUEUES;
+
+	if (env == NULL)
+		return ODP_CONFIG_QUEUES;
+
+	num = strtoul(env, NULL, 0);
+
+	if (num <= ODP_CONFIG_QUEUES)
+		return ODP_CONFIG_QUEUES;
+
+	if (num >= max)
+		return max;
+
+	return ROUNDUP_POWER2_U32(num);
+}
+
+static queue_entry_t *queue_alloc(void)
+{
+	queue_entry_t *queue;
+	uint32_t mask = queue_tbl->num_queues - 1;
 	uint32_t i;
+
+	i = ring_deq(queue_tbl->free_ring, mask);
+
+	if (i != RING_EMPTY)
+		return get_qentry(i);
+
+	/* Take an entry which has not been used before. Zeroed shared memory
+	 * is a free queue with an unlocked lock. */
+	i = odp_atomic_load_u32(&queue_tbl->next_index);
+
+	do {
+		if (i >= queue_tbl->num_queues)
+			return NULL;
+	} while (!odp_atomic_cas_u32(&queue_tbl->next_index, &i, i + 1));
+
+	queue = get_qentry(i);
+	queue->s.index  = i;
+	queue->s.handle = queue_from_id(i);
+
+	return queue;
+}
+
+static inline void queue_free(queue_entry_t *queue)
+{
+	ring_enq(queue_tbl->free_ring, queue_tbl->num_queues - 1,
+		 queue->s.index);
+}
+
+static int queue_init_global(void)
+{
 	odp_shm_t shm;
+	uint32_t num = queue_num_config();
+	uint64_t tbl_size, entry_size, ring_size;
+	uint8_t *addr;
 
 	ODP_DBG("Queue init ... ");
 
+	tbl_size   = ROUNDUP_CACHE_LINE(sizeof(queue_table_t));
+	entry_size = (uint64_t)num * sizeof(queue_entry_t);
+	ring_size  = sizeof(ring_t) + (uint64_t)num * sizeof(uint32_t);
+
 	shm = odp_shm_reserve("odp_queues",
-			      sizeof(queue_table_t),
-			      sizeof(queue_entry_t), 0);
+			      tbl_size + entry_size + ring_size,
+			      ODP_CACHE_LINE_SIZE, 0);
 
-	queue_tbl = odp_shm_addr(shm);
+	addr = odp_shm_addr(shm);
 
-	if (queue_tbl == NULL)
+	if (addr == NULL)
 		return -1;
 
-	memset(queue_tbl, 0, sizeof(queue_table_t));
+	queue_tbl = (queue_table_t *)(uintptr_t)addr;
 
-	for (i = 0; i < ODP_CONFIG_QUEUES; i++) {
-		/* init locks */
-		queue_entry_t *queue = get_qentry(i);
-		LOCK_INIT(&queue->s.lock);
-		queue->s.index  = i;
-		queue->s.handle = queue_from_id(i);
-	}
+	/* Only the table header is initialized. Queue entries and ring data
+	 * are initialized on first use. */
+	memset(queue_tbl, 0, sizeof(queue_table_t));
+	queue_tbl->queue      = (queue_entry_t *)(uintptr_t)(addr + tbl_size);
+	queue_tbl->free_ring  = (ring_t *)(uintptr_t)(addr + tbl_size +
+						      entry_size);
+	queue_tbl->num_queues = num;
+	odp_atomic_init_u32(&queue_tbl->next_index, 0);
+	ring_init(queue_tbl->free_ring);
 
 	ODP_DBG("done\n");
 	ODP_DBG("Queue init global\n");
@@ -99,6 +181,7 @@ static int queue_init_global(void)
 		sizeof(struct queue_entry_s));
 	ODP_DBG("  queue_entry_t size        %zu\n",
 		sizeof(queue_entry_t));
+	ODP_DBG("  number of queues          %" PRIu32 "\n", num);
 	ODP_DBG("\n");
 
 	return 0;
@@ -119,9 +202,11 @@ static int queue_term_global(void)
 	int ret = 0;
 	int rc = 0;
 	queue_entry_t *queue;
-	int i;
+	uint32_t i, num;
+
+	num = odp_atomic_load_u32(&queue_tbl->next_index);
 
-	for (i = 0; i < ODP_CONFIG_QUEUES; i++) {
+	for (i = 0; i < num; i++) {
 		queue = &queue_tbl->queue[i];
 		LOCK(&queue->s.lock);
 		if (queue->s.status != QUEUE_STATUS_FREE) {
@@ -145,7 +230,7 @@ static int queue_capability(odp_queue_capability_t *capa)
 	memset(capa, 0, sizeof(odp_queue_capability_t));
 
 	/* Reserve some queues for internal use */
-	capa->max_queues        = ODP_CONFIG_QUEUES - NUM_INTERNAL_QUEUES;
+	capa->max_queues        = queue_tbl->num_queues - NUM_INTERNAL_QUEUES;
 	capa->max_ordered_locks = sched_fn->max_ordered_locks();
 	capa->max_sched_groups  = sched_fn->num_grps();
 	capa->sched_prios       = odp_schedule_num_prio();
@@ -186,10 +271,9 @@ static int queue_lock_count(odp_queue_t handle)
 static odp_queue_t queue_create(const char *name,
 				const odp_queue_param_t *param)
 {
-	uint32_t i;
 	queue_entry_t *queue;
-	odp_queue_t handle = ODP_QUEUE_INVALID;
-	odp_queue_type_t type = ODP_QUEUE_TYPE_PLAIN;
+	odp_queue_t handle;
+	odp_queue_type_t type;
 	odp_queue_param_t default_param;
 
 	if (param == NULL) {
@@ -197,37 +281,33 @@ static odp_queue_t queue_create(const char *name,
 		param = &default_param;
 	}
 
-	for (i = 0; i < ODP_CONFIG_QUEUES; i++) {
-		queue = &queue_tbl->queue[i];
+	queue = queue_alloc();
 
-		if (queue->s.status != QUEUE_STATUS_FREE)
-			continue;
+	if (queue == NULL)
+		return ODP_QUEUE_INVALID;
 
-		LOCK(&queue->s.lock);
-		if (queue->s.status == QUEUE_STATUS_FREE) {
-			if (queue_init(queue, name, param)) {
-				UNLOCK(&queue->s.lock);
-				return handle;
-			}
+	LOCK(&queue->s.lock);
+	if (queue_init(queue, name, param)) {
+		UNLOCK(&queue->s.lock);
+		queue_free(queue);
+		return ODP_QUEUE_INVALID;
+	}
 
-			type = queue->s.type;
+	type = queue->s.type;
 
-			if (type == ODP_QUEUE_TYPE_SCHED)
-				queue->s.status = QUEUE_STATUS_NOTSCHED;
-			else
-				queue->s.status = QUEUE_STATUS_READY;
+	if (type == ODP_QUEUE_TYPE_SCHED)
+		queue->s.status = QUEUE_STATUS_NOTSCHED;
+	else
+		queue->s.status = QUEUE_STATUS_READY;
 
-			handle = queue->s.handle;
-			UNLOCK(&queue->s.lock);
-			break;
-		}
-		UNLOCK(&queue->s.lock);
-	}
+	handle = queue->s.handle;
+	UNLOCK(&queue->s.lock);
 
-	if (handle != ODP_QUEUE_INVALID && type == ODP_QUEUE_TYPE_SCHED) {
+	if (type == ODP_QUEUE_TYPE_SCHED) {
 		if (sched_fn->init_queue(queue->s.index,
 					 &queue->s.param.sched)) {
 			queue->s.status = QUEUE_STATUS_FREE;
+			queue_free(queue);
 			ODP_ERR("schedule queue init failed\n");
 			return ODP_QUEUE_INVALID;
 		}
@@ -239,19 +319,26 @@ static odp_queue_t queue_create(const char *name,
 void sched_cb_queue_destroy_finalize(uint32_t queue_index)
 {
 	queue_entry_t *queue = get_qentry(queue_index);
+	int free = 0;
 
 	LOCK(&queue->s.lock);
 
 	if (queue->s.status == QUEUE_STATUS_DESTROYED) {
 		queue->s.status = QUEUE_STATUS_FREE;
 		sched_fn->destroy_queue(queue_index);
+		free = 1;
 	}
 	UNLOCK(&queue->s.lock);
+
+	if (free)
+		queue_free(queue);
 }
 
 static int queue_destroy(odp_queue_t handle)
 {
 	queue_entry_t *queue;
+	int free = 1;
+
 	queue = handle_to_qentry(handle);
 
 	if (handle == ODP_QUEUE_INVALID)
@@ -285,12 +372,16 @@ static int queue_destroy(odp_queue_t handle)
 	case QUEUE_STATUS_SCHED:
 		/* Queue is still in scheduling */
 		queue->s.status = QUEUE_STATUS_DESTROYED;
+		free = 0;
 		break;
 	default:
 		ODP_ABORT("Unexpected queue status\n");
 	}
 	UNLOCK(&queue->s.lock);
 
+	if (free)
+		queue_free(queue);
+
 	return 0;
 }
 
@@ -310,9 +401,11 @@ static void *queue_context(odp_queue_t handle)
 
 static odp_queue_t queue_lookup(const char *name)
 {
-	uint32_t i;
+	uint32_t i, num;
 
-	for (i = 0; i < ODP_CONFIG_QUEUES; i++) {
+	num = odp_atomic_load_u32(&queue_tbl->next_index);
+
+	for (i = 0; i < num; i++) {
 		queue_entry_t *queue = &queue_tbl->queue[i];
 
 		if (queue->s.status == QUEUE_STATUS_FREE ||
@@ -340,6 +433,10 @@ static inline int enq_multi(queue_t q_int, odp_buffer_hdr_t *buf_hdr[],
 	odp_buffer_hdr_t *hdr, *tail, *next_hdr;
 
 	queue = qentry_from_int(q_int);
+
+	/* Events stashed in ordered context are stamped here */
+	sched_stat_enq(buf_hdr, num);
+
 	if (sched_fn->ord_enq_multi(q_int, (void **)buf_hdr, num, &ret))
 		return ret;
 
@@ -619,7 +716,7 @@ static int queue_info(odp_queue_t handle, odp_queue_info_t *info)
 
 	queue_id = queue_to_id(handle);
 
-	if (odp_unlikely(queue_id >= ODP_CONFIG_QUEUES)) {
+	if (odp_unlikely(queue_id >= queue_tbl->num_queues)) {
 		ODP_ERR("Invalid queue handle:%" PRIu64 "\n",
 			odp_queue_to_u64(handle));
 		return -1;
@@ -645,6 +742,11 @@ static int queue_info(odp_queue_t handle, odp_queue_info_t *info)
 	return 0;
 }
 
+uint32_t sched_cb_num_queues(void)
+{
+	return queue_tbl->num_queues;
+}
+
 odp_queue_t sched_cb_queue_handle(uint32_t queue_index)
 {
 	return queue_from_id(queue_index);
@@ -683,6 +785,26 @@ int sched_cb_queue_empty(uint32_t queue_index)
 	return ret;
 }
 
+/* Claim an empty queue that is not scheduled. The caller holds the queue
+ * as if it had been scheduled to it and releases it by adding it back to
+ * scheduling. Not for schedulers that need status_sync. */
+int sched_cb_queue_claim(uint32_t queue_index)
+{
+	queue_entry_t *queue = get_qentry(queue_index);
+	int ret = 0;
+
+	LOCK(&queue->s.lock);
+
+	if (queue->s.status == QUEUE_STATUS_NOTSCHED) {
+		queue->s.status = QUEUE_STATUS_SCHED;
+		ret = 1;
+	}
+
+	UNLOCK(&queue->s.lock);
+
+	return ret;
+}
+
 static uint64_t queue_to_u64(odp_queue_t hdl)
 {
 	return _odp_pri(hdl);
@@ -747,16 +869,18 @@ static odp_queue_t queue_to_ext(queue_t q_int)
 
 /* API functions */
 queue_api_t queue_default_api = {
+	.fast = {
+		.enq = queue_enq,
+		.enq_multi = queue_enq_multi,
+		.deq = queue_deq,
+		.deq_multi = queue_deq_multi
+	},
 	.queue_create = queue_create,
 	.queue_destroy = queue_destroy,
 	.queue_lookup = queue_lookup,
 	.queue_capability = queue_capability,
 	.queue_context_set = queue_context_set,
 	.queue_context = queue_context,
-	.queue_enq = queue_enq,
-	.queue_enq_multi = queue_enq_multi,
-	.queue_deq = queue_deq,
-	.queue_deq_multi = queue_deq_multi,
 	.queue_type = queue_type,
 	.queue_sched_type = queue_sched_type,
 	.queue_sched_prio = queue_sched_prio,
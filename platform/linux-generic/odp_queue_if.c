@@ -6,6 +6,7 @@
 
 #include "config.h"
 
+#include <odp/api/plat/queue_inlines.h>
 #include <odp_queue_if.h>
 
 extern const queue_api_t queue_default_api;
@@ -14,6 +15,13 @@ extern const queue_fn_t queue_default_fn;
 const queue_api_t *queue_api = &queue_default_api;
 const queue_fn_t *queue_fn = &queue_default_fn;
 
+#include <odp/visibility_begin.h>
+
+/* Fast path functions for inline API */
+const _odp_queue_api_fn_t *_odp_queue_api = &queue_default_api.fast;
+
+#include <odp/visibility_end.h>
+
 odp_queue_t odp_queue_create(const char *name, const odp_queue_param_t *param)
 {
 	return queue_api->queue_create(name, param);
@@ -44,26 +52,6 @@ void *odp_queue_context(odp_queue_t queue)
 	return queue_api->queue_context(queue);
 }
 
-int odp_queue_enq(odp_queue_t queue, odp_event_t ev)
-{
-	return queue_api->queue_enq(queue, ev);
-}
-
-int odp_queue_enq_multi(odp_queue_t queue, const odp_event_t events[], int num)
-{
-	return queue_api->queue_enq_multi(queue, events, num);
-}
-
-odp_event_t odp_queue_deq(odp_queue_t queue)
-{
-	return queue_api->queue_deq(queue);
-}
-
-int odp_queue_deq_multi(odp_queue_t queue, odp_event_t events[], int num)
-{
-	return queue_api->queue_deq_multi(queue, events, num);
-}
-
 odp_queue_type_t odp_queue_type(odp_queue_t queue)
 {
 	return queue_api->queue_type(queue);
@@ -103,3 +91,8 @@ int odp_queue_info(odp_queue_t queue, odp_queue_info_t *info)
 {
 	return queue_api->queue_info(queue, info);
 }
+
+/* Include non-inlined versions of API functions */
+#if ODP_ABI_COMPAT == 1
+#include <odp/api/plat/queue_inlines_api.h>
+#endif
@@ -7,8 +7,16 @@
 #include "config.h"
 
 #include <string.h>
+#include <stdlib.h>
+#include <inttypes.h>
+#include <limits.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
 #include <odp/api/schedule.h>
 #include <odp_schedule_if.h>
+#include <odp_schedule_stats_internal.h>
 #include <odp/api/align.h>
 #include <odp/api/shared_memory.h>
 #include <odp_internal.h>
@@ -23,6 +31,7 @@
 #include <odp_align_internal.h>
 #include <odp/api/sync.h>
 #include <odp/api/packet_io.h>
+#include <odp/api/event.h>
 #include <odp_ring_internal.h>
 #include <odp_timer_internal.h>
 
@@ -52,6 +61,21 @@ ODP_STATIC_ASSERT((ODP_SCHED_PRIO_NORMAL > 0) &&
 /* Size of poll weight table */
 #define WEIGHT_TBL_SIZE ((QUEUES_PER_PRIO - 1) * PREFER_RATIO)
 
+/* In topology aware mode, a thread polls priority queues of other NUMA
+ * domains after this many polls which found local priority queues empty. */
+#define STEAL_POLLS 16
+
+/* Adaptive idle mode: a thread spins this many empty schedule rounds, then
+ * pauses the CPU between rounds, and finally sleeps until new work arrives */
+#define IDLE_SPIN_ROUNDS  1000
+#define IDLE_PAUSE_ROUNDS 1000
+
+/* Number of CPU pause instructions between rounds in the pause stage */
+#define IDLE_PAUSE_NUM    16
+
+/* With a timed wait, time is checked every this many empty rounds */
+#define WAIT_CHECK_ROUNDS 8
+
 /* Packet input poll cmd queues */
 #define PKTIO_CMD_QUEUES  4
 
@@ -85,26 +109,9 @@ ODP_STATIC_ASSERT((ODP_SCHED_PRIO_NORMAL > 0) &&
 /* Mask for wrapping around pktio poll command index */
 #define PKTIO_RING_MASK (PKTIO_RING_SIZE - 1)
 
-/* Priority queue ring size. In worst case, all event queues are scheduled
- * queues and have the same priority. The ring size must be larger than or
- * equal to ODP_CONFIG_QUEUES / QUEUES_PER_PRIO, so that it can hold all
- * queues in the worst case. */
-#define PRIO_QUEUE_RING_SIZE  (ODP_CONFIG_QUEUES / QUEUES_PER_PRIO)
-
-/* Mask for wrapping around priority queue index */
-#define PRIO_QUEUE_MASK  (PRIO_QUEUE_RING_SIZE - 1)
-
 /* Priority queue empty, not a valid queue index. */
 #define PRIO_QUEUE_EMPTY NULL_INDEX
 
-/* For best performance, the number of queues should be a power of two. */
-ODP_STATIC_ASSERT(CHECK_IS_POWER2(ODP_CONFIG_QUEUES),
-		  "Number_of_queues_is_not_power_of_two");
-
-/* Ring size must be power of two, so that MAX_QUEUE_IDX_MASK can be used. */
-ODP_STATIC_ASSERT(CHECK_IS_POWER2(PRIO_QUEUE_RING_SIZE),
-		  "Ring_size_is_not_power_of_two");
-
 /* Ring size must be power of two, so that PKTIO_RING_MASK can be used. */
 ODP_STATIC_ASSERT(CHECK_IS_POWER2(PKTIO_RING_SIZE),
 		  "pktio_ring_size_is_not_power_of_two");
@@ -126,6 +133,9 @@ ODP_STATIC_ASSERT((8 * sizeof(pri_mask_t)) >= QUEUES_PER_PRIO,
 /* Maximum number of dequeues */
 #define MAX_DEQ CONFIG_BURST_SIZE
 
+/* Packet input is received directly into the local event stash */
+ODP_STATIC_ASSERT(MAX_DEQ >= QUEUE_MULTI_MAX, "Too_small_event_stash");
+
 /* Ordered stash size */
 #define MAX_ORDERED_STASH 512
 
@@ -153,7 +163,10 @@ typedef struct {
 	int pause;
 	uint16_t round;
 	uint16_t pktin_polls;
+	uint16_t empty_polls;
 	uint32_t queue_index;
+	/* Number of events scheduled in the current atomic context */
+	uint32_t atomic_events;
 	odp_queue_t queue;
 	odp_event_t ev_stash[MAX_DEQ];
 	struct {
@@ -173,17 +186,15 @@ typedef struct {
 	uint8_t weight_tbl[WEIGHT_TBL_SIZE];
 	uint8_t grp_weight[WEIGHT_TBL_SIZE];
 
-} sched_local_t;
-
-/* Priority queue */
-typedef struct {
-	/* Ring header */
-	ring_t ring;
+	/* Priority queues of own and other NUMA domains */
+	pri_mask_t local_mask;
+	pri_mask_t remote_mask;
 
-	/* Ring data: queue indexes */
-	uint32_t queue_index[PRIO_QUEUE_RING_SIZE];
+	/* Number of own priority queues, zero when not topology aware */
+	uint8_t num_local;
+	uint8_t local_id[QUEUES_PER_PRIO];
 
-} prio_queue_t ODP_ALIGNED_CACHE;
+} sched_local_t;
 
 /* Packet IO queue */
 typedef struct {
@@ -216,12 +227,60 @@ typedef struct {
 
 } order_context_t ODP_ALIGNED_CACHE;
 
+/* Schedule groups of a thread. Only the control path writes the table, while
+ * holding grp_lock. It publishes an update by incrementing 'seq' to an odd
+ * value before and to an even value after changing the table. Scheduling
+ * threads read their own table without locking, and retry when 'seq' changes
+ * during the read. */
+typedef struct {
+	odp_atomic_u32_t seq ODP_ALIGNED_CACHE;
+	int              num;
+	uint8_t          grp[NUM_SCHED_GRPS];
+} sched_thr_grp_t;
+
+/* Scheduling parameters of a queue */
+typedef struct {
+	int         grp;
+	int         prio;
+	int         queue_per_prio;
+	int         sync;
+	unsigned    order_lock_count;
+	/* Maximum number of events per dequeue */
+	uint32_t    burst;
+	/* Maximum number of events per atomic context */
+	uint32_t    atomic_max;
+	/* Next queue in the same priority queue */
+	uint32_t    next;
+} sched_queue_t;
+
+/* Priority queue: FIFO list of queue indexes linked through per queue data.
+ * A queue is in at most one priority queue at a time, so priority queues
+ * share the number of queues worth of link storage and never overflow. */
+typedef struct {
+	odp_spinlock_t   lock ODP_ALIGNED_CACHE;
+	odp_atomic_u32_t head;
+	uint32_t         tail;
+} prio_queue_t ODP_ALIGNED_CACHE;
+
+/* Scheduler global data is followed by per queue data in the same shared
+ * memory block. It is sized by the number of queues and stays untouched until
+ * used. */
 typedef struct {
 	pri_mask_t     pri_mask[NUM_PRIO];
 	odp_spinlock_t mask_lock;
 
+	/* Priority queues */
 	prio_queue_t   prio_q[NUM_SCHED_GRPS][NUM_PRIO][QUEUES_PER_PRIO];
 
+	/* Number of NUMA domains in topology aware mode, or zero. Priority
+	 * queue 'id' is homed on domain 'id % num_domain'. */
+	int            num_domain;
+	uint32_t       steal_polls;
+
+	/* Maximum sleep time in adaptive idle mode, or zero when threads
+	 * only spin */
+	uint64_t       idle_ns;
+
 	odp_spinlock_t poll_cmd_lock;
 	/* Number of commands in a command queue */
 	uint16_t       num_pktio_cmd[PKTIO_CMD_QUEUES];
@@ -237,7 +296,6 @@ typedef struct {
 
 	odp_thrmask_t    mask_all;
 	odp_spinlock_t   grp_lock;
-	odp_atomic_u32_t grp_epoch;
 
 	struct {
 		char           name[ODP_SCHED_GROUP_NAME_LEN];
@@ -245,20 +303,22 @@ typedef struct {
 		int	       allocated;
 	} sched_grp[NUM_SCHED_GRPS];
 
-	struct {
-		int         grp;
-		int         prio;
-		int         queue_per_prio;
-		int         sync;
-		unsigned    order_lock_count;
-	} queue[ODP_CONFIG_QUEUES];
+	sched_thr_grp_t  thr_grp[ODP_THREAD_COUNT_MAX];
 
 	struct {
 		/* Number of active commands for a pktio interface */
 		int num_cmd;
 	} pktio[NUM_PKTIO];
 
-	order_context_t order[ODP_CONFIG_QUEUES];
+	/* Per queue data, indexed by queue index */
+	sched_queue_t   *queue;
+	order_context_t *order;
+
+	/* Sleeping threads wait for a change of 'seq' (futex) */
+	struct {
+		odp_atomic_u32_t seq;
+		odp_atomic_u32_t num;
+	} idle ODP_ALIGNED_CACHE;
 
 } sched_global_t;
 
@@ -271,6 +331,57 @@ static __thread sched_local_t sched_local;
 /* Function prototypes */
 static inline void schedule_release_context(void);
 
+static void prio_queue_init(prio_queue_t *prio_q)
+{
+	odp_spinlock_init(&prio_q->lock);
+	odp_atomic_init_u32(&prio_q->head, PRIO_QUEUE_EMPTY);
+	prio_q->tail = PRIO_QUEUE_EMPTY;
+}
+
+/* Add queue into the priority queue tail */
+static inline void prio_queue_enq(prio_queue_t *prio_q, uint32_t qi)
+{
+	sched->queue[qi].next = PRIO_QUEUE_EMPTY;
+
+	odp_spinlock_lock(&prio_q->lock);
+
+	if (prio_q->tail == PRIO_QUEUE_EMPTY)
+		odp_atomic_store_u32(&prio_q->head, qi);
+	else
+		sched->queue[prio_q->tail].next = qi;
+
+	prio_q->tail = qi;
+
+	odp_spinlock_unlock(&prio_q->lock);
+}
+
+/* Remove queue from the priority queue head */
+static inline uint32_t prio_queue_deq(prio_queue_t *prio_q)
+{
+	uint32_t qi;
+
+	/* Check without locking. Empty priority queues are polled often. */
+	if (odp_atomic_load_u32(&prio_q->head) == PRIO_QUEUE_EMPTY)
+		return PRIO_QUEUE_EMPTY;
+
+	odp_spinlock_lock(&prio_q->lock);
+
+	qi = odp_atomic_load_u32(&prio_q->head);
+
+	if (qi != PRIO_QUEUE_EMPTY) {
+		uint32_t next = sched->queue[qi].next;
+
+		odp_atomic_store_u32(&prio_q->head, next);
+
+		if (next == PRIO_QUEUE_EMPTY)
+			prio_q->tail = PRIO_QUEUE_EMPTY;
+	}
+
+	odp_spinlock_unlock(&prio_q->lock);
+
+	return qi;
+}
+
 static void sched_local_init(void)
 {
 	int i;
@@ -297,47 +408,167 @@ static void sched_local_init(void)
 				offset = 0;
 		}
 	}
+
+	sched_local.local_mask = (1 << QUEUES_PER_PRIO) - 1;
+
+	if (sched->num_domain) {
+		int cpu = odp_cpu_id();
+		int domain = 0;
+
+		if (cpu >= 0 && cpu < MAX_CPU_NUMBER)
+			domain = odp_global_data.system_info.numa_node[cpu] %
+				 sched->num_domain;
+
+		sched_local.local_mask = 0;
+
+		for (i = 0; i < QUEUES_PER_PRIO; i++) {
+			if (i % sched->num_domain == domain) {
+				sched_local.local_id[sched_local.num_local++] =
+					i;
+				sched_local.local_mask |= 1 << i;
+			} else {
+				sched_local.remote_mask |= 1 << i;
+			}
+		}
+
+		/* Prefer own priority queues */
+		for (i = 0; i < WEIGHT_TBL_SIZE; i++) {
+			id = sched_local.weight_tbl[i] % sched_local.num_local;
+			sched_local.weight_tbl[i] = sched_local.local_id[id];
+		}
+	}
+}
+
+/* Topology aware mode is selected with ODP_SCHED_TOPOLOGY environment
+ * variable. With value 1, it is used only when CPUs are spread over multiple
+ * NUMA nodes. A larger value sets the number of domains, and CPUs are mapped
+ * to domains by NUMA node modulo the number of domains. */
+static void topology_init(void)
+{
+	const char *env = getenv("ODP_SCHED_TOPOLOGY");
+	int num = odp_global_data.system_info.num_numa_nodes;
+
+	if (env == NULL || atoi(env) <= 0)
+		return;
+
+	if (atoi(env) > 1)
+		num = atoi(env);
+
+	if (num < 2)
+		return;
+
+	if (num > QUEUES_PER_PRIO)
+		num = QUEUES_PER_PRIO;
+
+	sched->num_domain  = num;
+	sched->steal_polls = STEAL_POLLS;
+
+	env = getenv("ODP_SCHED_STEAL_POLLS");
+	if (env)
+		sched->steal_polls = atoi(env);
+
+	ODP_PRINT("Scheduler: topology aware, %i domains, steal after %"
+		  PRIu32 " empty polls\n", num, sched->steal_polls);
+}
+
+/* Adaptive idle mode is selected with ODP_SCHED_IDLE environment variable.
+ * The value is the maximum sleep time in microseconds. Threads wake up at
+ * least this often to poll packet input. */
+static void idle_init(void)
+{
+	const char *env = getenv("ODP_SCHED_IDLE");
+
+	odp_atomic_init_u32(&sched->idle.seq, 0);
+	odp_atomic_init_u32(&sched->idle.num, 0);
+
+	if (env == NULL || atoi(env) <= 0)
+		return;
+
+	sched->idle_ns = (uint64_t)atoi(env) * ODP_TIME_USEC_IN_NS;
+
+	ODP_PRINT("Scheduler: adaptive idle, max sleep %" PRIu64 " us\n",
+		  sched->idle_ns / ODP_TIME_USEC_IN_NS);
+}
+
+static inline void idle_sleep(uint32_t seq, uint64_t ns)
+{
+	struct timespec ts;
+
+	ts.tv_sec  = ns / ODP_TIME_SEC_IN_NS;
+	ts.tv_nsec = ns % ODP_TIME_SEC_IN_NS;
+
+	/* Not a private futex, since threads may be processes sharing the
+	 * scheduler memory */
+	syscall(SYS_futex, &sched->idle.seq.v, FUTEX_WAIT, seq, &ts, NULL, 0);
+}
+
+/* Wake up sleeping threads after a queue has been added into a priority
+ * queue */
+static inline void idle_wake(void)
+{
+	if (odp_likely(sched->idle_ns == 0))
+		return;
+
+	/* Pairs with the barrier of a thread announcing its sleep */
+	odp_mb_full();
+
+	if (odp_atomic_load_u32(&sched->idle.num) == 0)
+		return;
+
+	odp_atomic_inc_u32(&sched->idle.seq);
+	syscall(SYS_futex, &sched->idle.seq.v, FUTEX_WAKE, INT_MAX, NULL, NULL,
+		0);
 }
 
 static int schedule_init_global(void)
 {
 	odp_shm_t shm;
 	int i, j, grp;
+	uint32_t num_queues = sched_cb_num_queues();
+	uint64_t global_size, queue_size, order_size, size;
+	uint8_t *addr;
 
 	ODP_DBG("Schedule init ... ");
 
-	shm = odp_shm_reserve("odp_scheduler",
-			      sizeof(sched_global_t),
-			      ODP_CACHE_LINE_SIZE, 0);
+	global_size = ROUNDUP_CACHE_LINE(sizeof(sched_global_t));
+	queue_size  = ROUNDUP_CACHE_LINE((uint64_t)num_queues *
+					 sizeof(sched_queue_t));
+	order_size  = (uint64_t)num_queues * sizeof(order_context_t);
+	size = global_size + queue_size + order_size;
+
+	shm = odp_shm_reserve("odp_scheduler", size, ODP_CACHE_LINE_SIZE, 0);
 
-	sched = odp_shm_addr(shm);
+	addr = odp_shm_addr(shm);
 
-	if (sched == NULL) {
+	if (addr == NULL) {
 		ODP_ERR("Schedule init: Shm reserve failed.\n");
 		return -1;
 	}
 
+	sched = (sched_global_t *)(uintptr_t)addr;
+
+	/* Per queue data is not initialized here, so that memory of unused
+	 * queues is not touched. It is zero in a newly reserved shm block. */
 	memset(sched, 0, sizeof(sched_global_t));
 
 	sched->shm  = shm;
 	odp_spinlock_init(&sched->mask_lock);
 
-	for (grp = 0; grp < NUM_SCHED_GRPS; grp++) {
-		for (i = 0; i < NUM_PRIO; i++) {
-			for (j = 0; j < QUEUES_PER_PRIO; j++) {
-				prio_queue_t *prio_q;
-				int k;
+	addr += global_size;
+	sched->queue = (sched_queue_t *)(uintptr_t)addr;
+	addr += queue_size;
+	sched->order = (order_context_t *)(uintptr_t)addr;
 
-				prio_q = &sched->prio_q[grp][i][j];
-				ring_init(&prio_q->ring);
+	for (grp = 0; grp < NUM_SCHED_GRPS; grp++)
+		for (i = 0; i < NUM_PRIO; i++)
+			for (j = 0; j < QUEUES_PER_PRIO; j++)
+				prio_queue_init(&sched->prio_q[grp][i][j]);
 
-				for (k = 0; k < PRIO_QUEUE_RING_SIZE; k++) {
-					prio_q->queue_index[k] =
-					PRIO_QUEUE_EMPTY;
-				}
-			}
-		}
-	}
+	ODP_DBG("Scheduler shm: %" PRIu64 " bytes for %" PRIu32 " queues\n",
+		size, num_queues);
+
+	topology_init();
+	idle_init();
 
 	odp_spinlock_init(&sched->poll_cmd_lock);
 	for (i = 0; i < PKTIO_CMD_QUEUES; i++) {
@@ -351,7 +582,9 @@ static int schedule_init_global(void)
 		sched->pktio_cmd[i].cmd_index = PKTIO_CMD_FREE;
 
 	odp_spinlock_init(&sched->grp_lock);
-	odp_atomic_init_u32(&sched->grp_epoch, 0);
+
+	for (i = 0; i < ODP_THREAD_COUNT_MAX; i++)
+		odp_atomic_init_u32(&sched->thr_grp[i].seq, 0);
 
 	for (i = 0; i < NUM_SCHED_GRPS; i++) {
 		memset(sched->sched_grp[i].name, 0, ODP_SCHED_GROUP_NAME_LEN);
@@ -383,11 +616,13 @@ static int schedule_term_global(void)
 	for (grp = 0; grp < NUM_SCHED_GRPS; grp++) {
 		for (i = 0; i < NUM_PRIO; i++) {
 			for (j = 0; j < QUEUES_PER_PRIO; j++) {
-				ring_t *ring = &sched->prio_q[grp][i][j].ring;
+				prio_queue_t *prio_q;
 				uint32_t qi;
 
-				while ((qi = ring_deq(ring, PRIO_QUEUE_MASK)) !=
-				       RING_EMPTY) {
+				prio_q = &sched->prio_q[grp][i][j];
+
+				while ((qi = prio_queue_deq(prio_q)) !=
+				       PRIO_QUEUE_EMPTY) {
 					odp_event_t events[1];
 					int num;
 
@@ -431,34 +666,74 @@ static int schedule_term_local(void)
 	return 0;
 }
 
+/* Rebuild group table of a thread. Called with grp_lock held. */
+static void thr_grp_update(int thr)
+{
+	sched_thr_grp_t *thr_grp = &sched->thr_grp[thr];
+	uint32_t seq = odp_atomic_load_u32(&thr_grp->seq);
+	int i;
+	int num = 0;
+
+	odp_atomic_store_u32(&thr_grp->seq, seq + 1);
+	odp_mb_full();
+
+	for (i = 0; i < NUM_SCHED_GRPS; i++) {
+		if (odp_thrmask_isset(&sched->sched_grp[i].mask, thr)) {
+			thr_grp->grp[num] = i;
+			num++;
+		}
+	}
+
+	thr_grp->num = num;
+
+	odp_atomic_store_rel_u32(&thr_grp->seq, seq + 2);
+}
+
+/* Update group mask and group tables of those threads which joined or left
+ * the group. Called with grp_lock held. */
 static inline void grp_update_mask(int grp, const odp_thrmask_t *new_mask)
 {
+	odp_thrmask_t changed;
+	int thr;
+
+	odp_thrmask_xor(&changed, &sched->sched_grp[grp].mask, new_mask);
 	odp_thrmask_copy(&sched->sched_grp[grp].mask, new_mask);
-	odp_atomic_add_rel_u32(&sched->grp_epoch, 1);
+
+	for (thr = odp_thrmask_first(&changed); thr >= 0;
+	     thr = odp_thrmask_next(&changed, thr))
+		thr_grp_update(thr);
 }
 
+/* Copy own group table into local data */
 static inline int grp_update_tbl(void)
 {
-	int i;
-	int num = 0;
-	int thr = sched_local.thr;
+	sched_thr_grp_t *thr_grp = &sched->thr_grp[sched_local.thr];
+	uint32_t seq;
+	int i, num;
 
-	odp_spinlock_lock(&sched->grp_lock);
+	while (1) {
+		seq = odp_atomic_load_acq_u32(&thr_grp->seq);
 
-	for (i = 0; i < NUM_SCHED_GRPS; i++) {
-		if (sched->sched_grp[i].allocated == 0)
+		if (odp_unlikely(seq & 1)) {
+			odp_cpu_pause();
 			continue;
-
-		if (odp_thrmask_isset(&sched->sched_grp[i].mask, thr)) {
-			sched_local.grp[num] = i;
-			num++;
 		}
+
+		num = thr_grp->num;
+
+		for (i = 0; i < num; i++)
+			sched_local.grp[i] = thr_grp->grp[i];
+
+		odp_mb_acquire();
+
+		if (odp_likely(odp_atomic_load_u32(&thr_grp->seq) == seq))
+			break;
 	}
 
-	odp_spinlock_unlock(&sched->grp_lock);
+	sched_local.grp_epoch = seq;
 
 	/* Update group weights. Round robin over all thread's groups. */
-	for (i = 0; i < WEIGHT_TBL_SIZE; i++)
+	for (i = 0; num && i < WEIGHT_TBL_SIZE; i++)
 		sched_local.grp_weight[i] = i % num;
 
 	sched_local.num_grp = num;
@@ -470,11 +745,29 @@ static unsigned schedule_max_ordered_locks(void)
 	return CONFIG_QUEUE_MAX_ORD_LOCKS;
 }
 
+static uint32_t schedule_max_queues(void)
+{
+	return CONFIG_MAX_QUEUES;
+}
+
 static inline int queue_per_prio(uint32_t queue_index)
 {
 	return ((QUEUES_PER_PRIO - 1) & queue_index);
 }
 
+/* Priority queue id for a queue which is (re)scheduled by this thread. In
+ * topology aware mode, queues are scheduled into priority queues of the
+ * thread's own NUMA domain. A domain may then hold all queues in only one
+ * priority queue, which is fine since priority queues are unbounded lists. */
+static inline int queue_sched_id(uint32_t queue_index)
+{
+	if (sched_local.num_local)
+		return sched_local.local_id[queue_index %
+					    sched_local.num_local];
+
+	return sched->queue[queue_index].queue_per_prio;
+}
+
 static void pri_set(int id, int prio)
 {
 	odp_spinlock_lock(&sched->mask_lock);
@@ -500,12 +793,26 @@ static void pri_set_queue(uint32_t queue_index, int prio)
 {
 	int id = queue_per_prio(queue_index);
 
+	/* Queue may be scheduled into any priority queue */
+	if (sched->num_domain) {
+		for (id = 0; id < QUEUES_PER_PRIO; id++)
+			pri_set(id, prio);
+		return;
+	}
+
 	return pri_set(id, prio);
 }
 
 static void pri_clr_queue(uint32_t queue_index, int prio)
 {
 	int id = queue_per_prio(queue_index);
+
+	if (sched->num_domain) {
+		for (id = 0; id < QUEUES_PER_PRIO; id++)
+			pri_clr(id, prio);
+		return;
+	}
+
 	pri_clr(id, prio);
 }
 
@@ -513,6 +820,7 @@ static int schedule_init_queue(uint32_t queue_index,
 			       const odp_schedule_param_t *sched_param)
 {
 	int i;
+	uint32_t burst;
 	int prio = sched_param->prio;
 
 	pri_set_queue(queue_index, prio);
@@ -522,6 +830,22 @@ static int schedule_init_queue(uint32_t queue_index,
 	sched->queue[queue_index].sync = sched_param->sync;
 	sched->queue[queue_index].order_lock_count = sched_param->lock_count;
 
+	burst = sched_param->burst_size;
+	if (burst == 0 || burst > MAX_DEQ)
+		burst = MAX_DEQ;
+
+	/* A burst must not exceed the events per atomic context limit */
+	if (sched_param->sync == ODP_SCHED_SYNC_ATOMIC &&
+	    !sched_param->atomic_sticky &&
+	    sched_param->atomic_max_events &&
+	    sched_param->atomic_max_events < burst)
+		burst = sched_param->atomic_max_events;
+
+	sched->queue[queue_index].burst = burst;
+	sched->queue[queue_index].atomic_max = sched_param->atomic_sticky ?
+					       UINT32_MAX :
+					       sched_param->atomic_max_events;
+
 	odp_atomic_init_u64(&sched->order[queue_index].ctx, 0);
 	odp_atomic_init_u64(&sched->order[queue_index].next_ctx, 0);
 
@@ -645,12 +969,14 @@ static void schedule_release_atomic(void)
 	if (qi != PRIO_QUEUE_EMPTY && sched_local.num  == 0) {
 		int grp = sched->queue[qi].grp;
 		int prio = sched->queue[qi].prio;
-		int queue_per_prio = sched->queue[qi].queue_per_prio;
-		ring_t *ring = &sched->prio_q[grp][prio][queue_per_prio].ring;
+		int id = queue_sched_id(qi);
+
+		sched_stat_atomic_end();
 
 		/* Release current atomic queue */
-		ring_enq(ring, PRIO_QUEUE_MASK, qi);
+		prio_queue_enq(&sched->prio_q[grp][prio][id], qi);
 		sched_local.queue_index = PRIO_QUEUE_EMPTY;
+		idle_wake();
 	}
 }
 
@@ -665,12 +991,21 @@ static inline int ordered_own_turn(uint32_t queue_index)
 
 static inline void wait_for_order(uint32_t queue_index)
 {
+	uint64_t start;
+
+	if (ordered_own_turn(queue_index))
+		return;
+
+	start = sched_stat_time();
+
 	/* Busy loop to synchronize ordered processing */
 	while (1) {
 		if (ordered_own_turn(queue_index))
 			break;
 		odp_cpu_pause();
 	}
+
+	sched_stat_ordered_wait(start);
 }
 
 /**
@@ -682,6 +1017,9 @@ static inline void ordered_stash_release(void)
 {
 	int i;
 
+	/* Keep enqueue time stamps of stashed events */
+	sched_stat_stash_release(1);
+
 	for (i = 0; i < sched_local.ordered.stash_num; i++) {
 		queue_entry_t *queue_entry;
 		odp_buffer_hdr_t **buf_hdr;
@@ -693,6 +1031,7 @@ static inline void ordered_stash_release(void)
 
 		queue_fn->enq_multi(qentry_to_int(queue_entry), buf_hdr, num);
 	}
+	sched_stat_stash_release(0);
 	sched_local.ordered.stash_num = 0;
 }
 
@@ -780,6 +1119,9 @@ static int schedule_ord_enq_multi(queue_t q_int, void *buf_hdr[],
 	    odp_unlikely(stash_num >=  MAX_ORDERED_STASH)) {
 		/* If the local stash is full, wait until it is our turn and
 		 * then release the stash and do enqueue directly. */
+		if (stash_num >= MAX_ORDERED_STASH)
+			sched_stat_stash_overflow();
+
 		wait_for_order(src_queue);
 
 		sched_local.ordered.in_order = 1;
@@ -800,18 +1142,20 @@ static int schedule_ord_enq_multi(queue_t q_int, void *buf_hdr[],
 }
 
 static inline int do_schedule_grp(odp_queue_t *out_queue, odp_event_t out_ev[],
-				  unsigned int max_num, int grp, int first)
+				  unsigned int max_num, int grp, int first,
+				  pri_mask_t id_mask)
 {
 	int prio, i;
 	int ret;
 	int id;
-	unsigned int max_deq = MAX_DEQ;
 	uint32_t qi;
+	pri_mask_t pri_mask;
 
 	/* Schedule events */
 	for (prio = 0; prio < NUM_PRIO; prio++) {
+		pri_mask = sched->pri_mask[prio] & id_mask;
 
-		if (sched->pri_mask[prio] == 0)
+		if (pri_mask == 0)
 			continue;
 
 		/* Select the first ring based on weights */
@@ -820,43 +1164,46 @@ static inline int do_schedule_grp(odp_queue_t *out_queue, odp_event_t out_ev[],
 		for (i = 0; i < QUEUES_PER_PRIO;) {
 			int num;
 			int ordered;
+			unsigned int max_deq;
 			odp_queue_t handle;
-			ring_t *ring;
+			prio_queue_t *prio_q;
 
 			if (id >= QUEUES_PER_PRIO)
 				id = 0;
 
-			/* No queues created for this priority queue */
-			if (odp_unlikely((sched->pri_mask[prio] & (1 << id))
-			    == 0)) {
+			/* No queues created for this priority queue, or
+			 * priority queue is not polled this time */
+			if (odp_unlikely((pri_mask & (1 << id)) == 0)) {
 				i++;
 				id++;
 				continue;
 			}
 
 			/* Get queue index from the priority queue */
-			ring = &sched->prio_q[grp][prio][id].ring;
-			qi   = ring_deq(ring, PRIO_QUEUE_MASK);
+			prio_q = &sched->prio_q[grp][prio][id];
+			qi     = prio_queue_deq(prio_q);
 
 			/* Priority queue empty */
-			if (qi == RING_EMPTY) {
+			if (qi == PRIO_QUEUE_EMPTY) {
 				i++;
 				id++;
 				continue;
 			}
 
+			max_deq = sched->queue[qi].burst;
+
 			/* Low priorities have smaller batch size to limit
 			 * head of line blocking latency. */
-			if (odp_unlikely(MAX_DEQ > 1 &&
+			if (odp_unlikely(max_deq > 1 &&
 					 prio > ODP_SCHED_PRIO_DEFAULT))
-				max_deq = MAX_DEQ / 2;
+				max_deq = max_deq / 2;
 
 			ordered = queue_is_ordered(qi);
 
 			/* Do not cache ordered events locally to improve
 			 * parallelism. Ordered context can only be released
 			 * when the local cache is empty. */
-			if (ordered && max_num < MAX_DEQ)
+			if (ordered && max_num < max_deq)
 				max_deq = max_num;
 
 			num = sched_cb_queue_deq_multi(qi, sched_local.ev_stash,
@@ -875,6 +1222,8 @@ static inline int do_schedule_grp(odp_queue_t *out_queue, odp_event_t out_ev[],
 				continue;
 			}
 
+			sched_stat_deq(sched_local.ev_stash, num);
+
 			handle            = sched_cb_queue_handle(qi);
 			sched_local.num   = num;
 			sched_local.index = 0;
@@ -892,14 +1241,16 @@ static inline int do_schedule_grp(odp_queue_t *out_queue, odp_event_t out_ev[],
 				sched_local.ordered.src_queue = qi;
 
 				/* Continue scheduling ordered queues */
-				ring_enq(ring, PRIO_QUEUE_MASK, qi);
+				prio_queue_enq(prio_q, qi);
 
 			} else if (queue_is_atomic(qi)) {
 				/* Hold queue during atomic access */
 				sched_local.queue_index = qi;
+				sched_local.atomic_events = num;
+				sched_stat_atomic_start();
 			} else {
 				/* Continue scheduling the queue */
-				ring_enq(ring, PRIO_QUEUE_MASK, qi);
+				prio_queue_enq(prio_q, qi);
 			}
 
 			/* Output the source queue handle */
@@ -913,6 +1264,149 @@ static inline int do_schedule_grp(odp_queue_t *out_queue, odp_event_t out_ev[],
 	return 0;
 }
 
+/* Schedule queues of all thread's groups, starting from group 'grp_id' */
+static inline int do_schedule_grps(odp_queue_t *out_queue,
+				   odp_event_t out_ev[], unsigned int max_num,
+				   int num_grp, int grp_id, int first,
+				   pri_mask_t id_mask)
+{
+	int i, ret;
+
+	for (i = 0; i < num_grp; i++) {
+		int grp;
+
+		grp = sched_local.grp[grp_id];
+		ret = do_schedule_grp(out_queue, out_ev, max_num, grp, first,
+				      id_mask);
+
+		if (odp_likely(ret))
+			return ret;
+
+		grp_id++;
+		if (odp_unlikely(grp_id >= num_grp))
+			grp_id = 0;
+	}
+
+	return 0;
+}
+
+static inline int thr_in_grp(int grp)
+{
+	int i;
+
+	for (i = 0; i < sched_local.num_grp; i++)
+		if (sched_local.grp[i] == grp)
+			return 1;
+
+	return 0;
+}
+
+/*
+ * Deliver packets received by a poll command
+ *   * Packets of a parallel queue are returned directly to the polling
+ *     thread.
+ *   * Packets of an atomic queue are returned directly when the queue is
+ *     empty and not scheduled. The polling thread takes the atomic context
+ *     like it would when scheduling the queue.
+ *   * Otherwise, and always for ordered queues, packets are enqueued into
+ *     the destination queue.
+ * Packets are in the local event stash.
+ */
+static inline int pktin_deliver(odp_queue_t handle, int num,
+				odp_queue_t *out_queue, odp_event_t out_ev[],
+				unsigned int max_num)
+{
+	uint32_t qi = queue_to_id(handle);
+	int direct = 0;
+	int ret;
+
+	if (thr_in_grp(sched->queue[qi].grp)) {
+		if (queue_is_atomic(qi)) {
+			direct = sched_cb_queue_claim(qi);
+			if (direct) {
+				sched_local.queue_index = qi;
+				sched_local.atomic_events = num;
+				sched_stat_atomic_start();
+			}
+		} else if (!queue_is_ordered(qi)) {
+			direct = 1;
+		}
+	}
+
+	if (!direct) {
+		odp_buffer_hdr_t **buf_hdr;
+
+		buf_hdr = (odp_buffer_hdr_t **)(void *)sched_local.ev_stash;
+		ret = queue_fn->enq_multi(queue_fn->from_ext(handle), buf_hdr,
+					  num);
+
+		if (odp_unlikely(ret < num)) {
+			for (ret = ret < 0 ? 0 : ret; ret < num; ret++)
+				odp_event_free(sched_local.ev_stash[ret]);
+		}
+
+		return 0;
+	}
+
+	sched_local.num   = num;
+	sched_local.index = 0;
+	sched_local.queue = handle;
+
+	if (out_queue)
+		*out_queue = handle;
+
+	return copy_events(out_ev, max_num);
+}
+
+/*
+ * Continue scheduling the atomic queue of the current context, when the queue
+ * allows more events per context than were already scheduled.
+ */
+static inline int atomic_continue(odp_queue_t *out_queue,
+				  odp_event_t out_ev[], unsigned int max_num)
+{
+	uint32_t qi = sched_local.queue_index;
+	uint32_t max_deq = sched->queue[qi].burst;
+	uint32_t left;
+	odp_queue_t handle;
+	int num;
+
+	if (odp_likely(sched_local.atomic_events >= sched->queue[qi].atomic_max))
+		return 0;
+
+	left = sched->queue[qi].atomic_max - sched_local.atomic_events;
+	if (left < max_deq)
+		max_deq = left;
+
+	num = sched_cb_queue_deq_multi(qi, sched_local.ev_stash, max_deq);
+
+	if (num <= 0) {
+		/* An empty queue was removed from scheduling by the dequeue,
+		 * so the context is released without returning the queue
+		 * into its priority queue. */
+		sched_stat_atomic_end();
+		sched_local.queue_index = PRIO_QUEUE_EMPTY;
+
+		if (num < 0)
+			sched_cb_queue_destroy_finalize(qi);
+
+		return 0;
+	}
+
+	sched_stat_deq(sched_local.ev_stash, num);
+
+	handle = sched_cb_queue_handle(qi);
+	sched_local.atomic_events += num;
+	sched_local.num   = num;
+	sched_local.index = 0;
+	sched_local.queue = handle;
+
+	if (out_queue)
+		*out_queue = handle;
+
+	return copy_events(out_ev, max_num);
+}
+
 /*
  * Schedule queues
  */
@@ -934,6 +1428,14 @@ static inline int do_schedule(odp_queue_t *out_queue, odp_event_t out_ev[],
 		return ret;
 	}
 
+	if (sched_local.queue_index != PRIO_QUEUE_EMPTY &&
+	    odp_likely(!sched_local.pause)) {
+		ret = atomic_continue(out_queue, out_ev, max_num);
+
+		if (ret)
+			return ret;
+	}
+
 	schedule_release_context();
 
 	if (odp_unlikely(sched_local.pause))
@@ -949,29 +1451,34 @@ static inline int do_schedule(odp_queue_t *out_queue, odp_event_t out_ev[],
 	sched_local.round = round;
 	first = sched_local.weight_tbl[round];
 
-	epoch = odp_atomic_load_acq_u32(&sched->grp_epoch);
+	epoch = odp_atomic_load_u32(&sched->thr_grp[sched_local.thr].seq);
 	num_grp = sched_local.num_grp;
 
-	if (odp_unlikely(sched_local.grp_epoch != epoch)) {
+	if (odp_unlikely(sched_local.grp_epoch != epoch))
 		num_grp = grp_update_tbl();
-		sched_local.grp_epoch = epoch;
-	}
 
 	grp_id = sched_local.grp_weight[round];
 
 	/* Schedule queues per group and priority */
-	for (i = 0; i < num_grp; i++) {
-		int grp;
+	ret = do_schedule_grps(out_queue, out_ev, max_num, num_grp, grp_id,
+			       first, sched_local.local_mask);
 
-		grp = sched_local.grp[grp_id];
-		ret = do_schedule_grp(out_queue, out_ev, max_num, grp, first);
+	if (odp_likely(ret)) {
+		sched_local.empty_polls = 0;
+		return ret;
+	}
 
-		if (odp_likely(ret))
-			return ret;
+	/* Steal work from other NUMA domains after local priority queues have
+	 * been found empty many times in a row */
+	if (odp_unlikely(sched_local.remote_mask) &&
+	    ++sched_local.empty_polls >= sched->steal_polls) {
+		sched_local.empty_polls = 0;
 
-		grp_id++;
-		if (odp_unlikely(grp_id >= num_grp))
-			grp_id = 0;
+		ret = do_schedule_grps(out_queue, out_ev, max_num, num_grp,
+				       grp_id, 0, sched_local.remote_mask);
+
+		if (ret)
+			return ret;
 	}
 
 	/*
@@ -991,6 +1498,8 @@ static inline int do_schedule(odp_queue_t *out_queue, odp_event_t out_ev[],
 		ring_t *ring;
 		uint32_t cmd_index;
 		pktio_cmd_t *cmd;
+		odp_queue_t handle;
+		int num;
 
 		if (odp_unlikely(sched->num_pktio_cmd[id] == 0))
 			continue;
@@ -1003,10 +1512,12 @@ static inline int do_schedule(odp_queue_t *out_queue, odp_event_t out_ev[],
 
 		cmd = &sched->pktio_cmd[cmd_index];
 
-		/* Poll packet input */
-		if (odp_unlikely(sched_cb_pktin_poll(cmd->pktio_index,
-						     cmd->num_pktin,
-						     cmd->pktin))){
+		/* Poll packet input. Each command has a single pktin. */
+		num = sched_cb_pktin_poll_one(cmd->pktio_index, cmd->pktin[0],
+					      sched_local.ev_stash, &handle);
+		sched_stat_pktin_poll();
+
+		if (odp_unlikely(num < 0)) {
 			/* Pktio stopped or closed. Remove poll command and call
 			 * stop_finalize when all commands of the pktio has
 			 * been removed. */
@@ -1019,6 +1530,16 @@ static inline int do_schedule(odp_queue_t *out_queue, odp_event_t out_ev[],
 			/* Continue scheduling the pktio */
 			ring_enq(ring, PKTIO_RING_MASK, cmd_index);
 
+			if (num) {
+				ret = pktin_deliver(handle, num, out_queue,
+						    out_ev, max_num);
+
+				if (ret) {
+					sched_local.pktin_polls++;
+					return ret;
+				}
+			}
+
 			/* Do not iterate through all pktin poll command queues
 			 * every time. */
 			if (odp_likely(sched_local.pktin_polls & 0xf))
@@ -1035,9 +1556,14 @@ static int schedule_loop(odp_queue_t *out_queue, uint64_t wait,
 			 odp_event_t out_ev[],
 			 unsigned int max_num)
 {
-	odp_time_t next, wtime;
+	odp_time_t next, wtime, now;
 	int first = 1;
 	int ret;
+	int sleep = 0;
+	uint32_t rounds = 0;
+	uint32_t seq = 0;
+	uint64_t sleep_ns, left_ns;
+	int i;
 
 	while (1) {
 		ret = do_schedule(out_queue, out_ev, max_num);
@@ -1045,23 +1571,68 @@ static int schedule_loop(odp_queue_t *out_queue, uint64_t wait,
 		if (ret)
 			break;
 
-		if (wait == ODP_SCHED_WAIT)
-			continue;
+		sched_stat_empty_poll();
 
 		if (wait == ODP_SCHED_NO_WAIT)
 			break;
 
-		if (first) {
-			wtime = odp_time_local_from_ns(wait);
-			next = odp_time_sum(odp_time_local(), wtime);
-			first = 0;
+		rounds++;
+
+		if (wait != ODP_SCHED_WAIT) {
+			if (first) {
+				wtime = odp_time_local_from_ns(wait);
+				next = odp_time_sum(odp_time_local(), wtime);
+				first = 0;
+			} else if ((rounds % WAIT_CHECK_ROUNDS) == 0 &&
+				   odp_time_cmp(next, odp_time_local()) < 0) {
+				break;
+			}
+		}
+
+		if (odp_likely(sched->idle_ns == 0) ||
+		    rounds <= IDLE_SPIN_ROUNDS)
+			continue;
+
+		if (rounds <= IDLE_SPIN_ROUNDS + IDLE_PAUSE_ROUNDS) {
+			for (i = 0; i < IDLE_PAUSE_NUM; i++)
+				odp_cpu_pause();
 			continue;
 		}
 
-		if (odp_time_cmp(next, odp_time_local()) < 0)
-			break;
+		/* Announce sleep and poll once more before sleeping. Any
+		 * queue scheduled after this is either found by the poll or
+		 * changes the sequence number. */
+		if (!sleep) {
+			seq = odp_atomic_load_u32(&sched->idle.seq);
+			odp_atomic_inc_u32(&sched->idle.num);
+			odp_mb_full();
+			sleep = 1;
+			continue;
+		}
+
+		sleep_ns = sched->idle_ns;
+
+		if (wait != ODP_SCHED_WAIT) {
+			now = odp_time_local();
+
+			if (odp_time_cmp(next, now) < 0)
+				break;
+
+			left_ns = odp_time_to_ns(odp_time_diff(next, now));
+			if (left_ns < sleep_ns)
+				sleep_ns = left_ns;
+		}
+
+		idle_sleep(seq, sleep_ns);
+		odp_atomic_dec_u32(&sched->idle.num);
+		sleep = 0;
 	}
 
+	if (sleep)
+		odp_atomic_dec_u32(&sched->idle.num);
+
+	sched_stat_calls(ret);
+
 	return ret;
 }
 
@@ -1374,10 +1945,10 @@ static int schedule_sched_queue(uint32_t queue_index)
 {
 	int grp            = sched->queue[queue_index].grp;
 	int prio           = sched->queue[queue_index].prio;
-	int queue_per_prio = sched->queue[queue_index].queue_per_prio;
-	ring_t *ring       = &sched->prio_q[grp][prio][queue_per_prio].ring;
+	int id             = queue_sched_id(queue_index);
 
-	ring_enq(ring, PRIO_QUEUE_MASK, queue_index);
+	prio_queue_enq(&sched->prio_q[grp][prio][id], queue_index);
+	idle_wake();
 	return 0;
 }
 
@@ -1404,20 +1975,25 @@ const schedule_fn_t schedule_default_fn = {
 	.order_lock = order_lock,
 	.order_unlock = order_unlock,
 	.max_ordered_locks = schedule_max_ordered_locks,
+	.max_queues = schedule_max_queues,
 	.unsched_queue = NULL,
 	.save_context = NULL
 };
 
 /* Fill in scheduler API calls */
 const schedule_api_t schedule_default_api = {
+	.fast = {
+		.schedule                 = schedule,
+		.schedule_multi           = schedule_multi,
+		.schedule_pause           = schedule_pause,
+		.schedule_resume          = schedule_resume,
+		.schedule_release_atomic  = schedule_release_atomic,
+		.schedule_release_ordered = schedule_release_ordered,
+		.schedule_prefetch        = schedule_prefetch,
+		.schedule_order_lock      = schedule_order_lock,
+		.schedule_order_unlock    = schedule_order_unlock
+	},
 	.schedule_wait_time       = schedule_wait_time,
-	.schedule                 = schedule,
-	.schedule_multi           = schedule_multi,
-	.schedule_pause           = schedule_pause,
-	.schedule_resume          = schedule_resume,
-	.schedule_release_atomic  = schedule_release_atomic,
-	.schedule_release_ordered = schedule_release_ordered,
-	.schedule_prefetch        = schedule_prefetch,
 	.schedule_num_prio        = schedule_num_prio,
 	.schedule_group_create    = schedule_group_create,
 	.schedule_group_destroy   = schedule_group_destroy,
@@ -1425,7 +2001,5 @@ const schedule_api_t schedule_default_api = {
 	.schedule_group_join      = schedule_group_join,
 	.schedule_group_leave     = schedule_group_leave,
 	.schedule_group_thrmask   = schedule_group_thrmask,
-	.schedule_group_info      = schedule_group_info,
-	.schedule_order_lock      = schedule_order_lock,
-	.schedule_order_unlock    = schedule_order_unlock
+	.schedule_group_info      = schedule_group_info
 };
@@ -6,6 +6,7 @@
 
 #include "config.h"
 
+#include <odp/api/plat/schedule_inlines.h>
 #include <odp_schedule_if.h>
 
 extern const schedule_fn_t schedule_sp_fn;
@@ -18,55 +19,29 @@ extern const schedule_fn_t schedule_iquery_fn;
 extern const schedule_api_t schedule_iquery_api;
 
 #ifdef ODP_SCHEDULE_SP
+#define SCHED_API schedule_sp_api
 const schedule_fn_t *sched_fn   = &schedule_sp_fn;
-const schedule_api_t *sched_api = &schedule_sp_api;
 #elif defined(ODP_SCHEDULE_IQUERY)
+#define SCHED_API schedule_iquery_api
 const schedule_fn_t *sched_fn   = &schedule_iquery_fn;
-const schedule_api_t *sched_api = &schedule_iquery_api;
 #else
+#define SCHED_API schedule_default_api
 const schedule_fn_t  *sched_fn  = &schedule_default_fn;
-const schedule_api_t *sched_api = &schedule_default_api;
 #endif
 
-uint64_t odp_schedule_wait_time(uint64_t ns)
-{
-	return sched_api->schedule_wait_time(ns);
-}
-
-odp_event_t odp_schedule(odp_queue_t *from, uint64_t wait)
-{
-	return sched_api->schedule(from, wait);
-}
+const schedule_api_t *sched_api = &SCHED_API;
 
-int odp_schedule_multi(odp_queue_t *from, uint64_t wait, odp_event_t events[],
-		       int num)
-{
-	return sched_api->schedule_multi(from, wait, events, num);
-}
+#include <odp/visibility_begin.h>
 
-void odp_schedule_pause(void)
-{
-	return sched_api->schedule_pause();
-}
+/* Fast path functions for inline API. Scheduler is selected at build time,
+ * so the table points directly to its functions. */
+const _odp_schedule_api_fn_t *_odp_sched_api = &SCHED_API.fast;
 
-void odp_schedule_resume(void)
-{
-	return sched_api->schedule_resume();
-}
+#include <odp/visibility_end.h>
 
-void odp_schedule_release_atomic(void)
-{
-	return sched_api->schedule_release_atomic();
-}
-
-void odp_schedule_release_ordered(void)
-{
-	return sched_api->schedule_release_ordered();
-}
-
-void odp_schedule_prefetch(int num)
+uint64_t odp_schedule_wait_time(uint64_t ns)
 {
-	return sched_api->schedule_prefetch(num);
+	return sched_api->schedule_wait_time(ns);
 }
 
 int odp_schedule_num_prio(void)
@@ -114,12 +89,7 @@ int odp_schedule_group_info(odp_schedule_group_t group,
 	return sched_api->schedule_group_info(group, info);
 }
 
-void odp_schedule_order_lock(unsigned lock_index)
-{
-	return sched_api->schedule_order_lock(lock_index);
-}
-
-void odp_schedule_order_unlock(unsigned lock_index)
-{
-	return sched_api->schedule_order_unlock(lock_index);
-}
+/* Include non-inlined versions of API functions */
+#if ODP_ABI_COMPAT == 1
+#include <odp/api/plat/schedule_inlines_api.h>
+#endif
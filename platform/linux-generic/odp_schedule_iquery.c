@@ -8,6 +8,7 @@
 
 #include <odp/api/schedule.h>
 #include <odp_schedule_if.h>
+#include <odp_schedule_stats_internal.h>
 #include <odp/api/align.h>
 #include <odp/api/queue.h>
 #include <odp/api/shared_memory.h>
@@ -669,6 +670,8 @@ static inline void pktio_poll_input(void)
 
 		cmd = &sched->pktio_poll.commands[index];
 
+		sched_stat_pktin_poll();
+
 		/* Poll packet input */
 		if (odp_unlikely(sched_cb_pktin_poll(cmd->pktio,
 						     cmd->count,
@@ -752,6 +755,8 @@ static int schedule_loop(odp_queue_t *out_queue, uint64_t wait,
 		if (count)
 			break;
 
+		sched_stat_empty_poll();
+
 		if (wait == ODP_SCHED_WAIT)
 			continue;
 
@@ -769,6 +774,8 @@ static int schedule_loop(odp_queue_t *out_queue, uint64_t wait,
 			break;
 	}
 
+	sched_stat_calls(count);
+
 	return count;
 }
 
@@ -1094,6 +1101,7 @@ static void schedule_release_atomic(void)
 	if ((thread_local.atomic != NULL) &&
 	    (thread_local.cache.count == 0)) {
 		queue_index = thread_local.atomic - sched->availables;
+		sched_stat_atomic_end();
 		thread_local.atomic = NULL;
 		sched->availables[queue_index] = true;
 	}
@@ -1110,12 +1118,21 @@ static inline int ordered_own_turn(uint32_t queue_index)
 
 static inline void wait_for_order(uint32_t queue_index)
 {
+	uint64_t start;
+
+	if (ordered_own_turn(queue_index))
+		return;
+
+	start = sched_stat_time();
+
 	/* Busy loop to synchronize ordered processing */
 	while (1) {
 		if (ordered_own_turn(queue_index))
 			break;
 		odp_cpu_pause();
 	}
+
+	sched_stat_ordered_wait(start);
 }
 
 /**
@@ -1127,6 +1144,9 @@ static inline void ordered_stash_release(void)
 {
 	int i;
 
+	/* Keep enqueue time stamps of stashed events */
+	sched_stat_stash_release(1);
+
 	for (i = 0; i < thread_local.ordered.stash_num; i++) {
 		queue_entry_t *queue_entry;
 		odp_buffer_hdr_t **buf_hdr;
@@ -1138,6 +1158,7 @@ static inline void ordered_stash_release(void)
 
 		queue_fn->enq_multi(qentry_to_int(queue_entry), buf_hdr, num);
 	}
+	sched_stat_stash_release(0);
 	thread_local.ordered.stash_num = 0;
 }
 
@@ -1211,6 +1232,9 @@ static int schedule_ord_enq_multi(queue_t q_int, void *buf_hdr[],
 	    odp_unlikely(stash_num >=  MAX_ORDERED_STASH)) {
 		/* If the local stash is full, wait until it is our turn and
 		 * then release the stash and do enqueue directly. */
+		if (stash_num >= MAX_ORDERED_STASH)
+			sched_stat_stash_overflow();
+
 		wait_for_order(src_queue);
 
 		thread_local.ordered.in_order = 1;
@@ -1295,6 +1319,12 @@ static unsigned schedule_max_ordered_locks(void)
 	return CONFIG_QUEUE_MAX_ORD_LOCKS;
 }
 
+static uint32_t schedule_max_queues(void)
+{
+	/* Queue bitmaps are sized at compile time */
+	return ODP_CONFIG_QUEUES;
+}
+
 static inline bool is_atomic_queue(unsigned int queue_index)
 {
 	return (sched->queues[queue_index].sync == ODP_SCHED_SYNC_ATOMIC);
@@ -1309,6 +1339,7 @@ static void schedule_save_context(uint32_t queue_index)
 {
 	if (is_atomic_queue(queue_index)) {
 		thread_local.atomic = &sched->availables[queue_index];
+		sched_stat_atomic_start();
 	} else if (is_ordered_queue(queue_index)) {
 		uint64_t ctx;
 		odp_atomic_u64_t *next_ctx;
@@ -1339,20 +1370,25 @@ const schedule_fn_t schedule_iquery_fn = {
 	.order_lock    = order_lock,
 	.order_unlock  = order_unlock,
 	.max_ordered_locks = schedule_max_ordered_locks,
+	.max_queues    = schedule_max_queues,
 	.unsched_queue = schedule_unsched_queue,
 	.save_context  = schedule_save_context
 };
 
 /* Fill in scheduler API calls */
 const schedule_api_t schedule_iquery_api = {
+	.fast = {
+		.schedule                 = schedule,
+		.schedule_multi           = schedule_multi,
+		.schedule_pause           = schedule_pause,
+		.schedule_resume          = schedule_resume,
+		.schedule_release_atomic  = schedule_release_atomic,
+		.schedule_release_ordered = schedule_release_ordered,
+		.schedule_prefetch        = schedule_prefetch,
+		.schedule_order_lock      = schedule_order_lock,
+		.schedule_order_unlock    = schedule_order_unlock
+	},
 	.schedule_wait_time       = schedule_wait_time,
-	.schedule                 = schedule,
-	.schedule_multi           = schedule_multi,
-	.schedule_pause           = schedule_pause,
-	.schedule_resume          = schedule_resume,
-	.schedule_release_atomic  = schedule_release_atomic,
-	.schedule_release_ordered = schedule_release_ordered,
-	.schedule_prefetch        = schedule_prefetch,
 	.schedule_num_prio        = number_of_priorites,
 	.schedule_group_create    = schedule_group_create,
 	.schedule_group_destroy   = schedule_group_destroy,
@@ -1360,9 +1396,7 @@ const schedule_api_t schedule_iquery_api = {
 	.schedule_group_join      = schedule_group_join,
 	.schedule_group_leave     = schedule_group_leave,
 	.schedule_group_thrmask   = schedule_group_thrmask,
-	.schedule_group_info      = schedule_group_info,
-	.schedule_order_lock      = schedule_order_lock,
-	.schedule_order_unlock    = schedule_order_unlock
+	.schedule_group_info      = schedule_group_info
 };
 
 static void thread_set_interest(sched_thread_local_t *thread,
@@ -1485,13 +1519,28 @@ static inline int consume_queue(int prio, unsigned int queue_index)
 {
 	int count;
 	unsigned int max = MAX_DEQ;
+	unsigned int burst = sched->queues[queue_index].burst_size;
 	event_cache_t *cache = &thread_local.cache;
 
+	/* Per queue burst size */
+	if (burst && burst < max)
+		max = burst;
+
+	/* An atomic context is released after each burst, so a burst must not
+	 * exceed the events per context limit */
+	if (is_atomic_queue(queue_index) &&
+	    !sched->queues[queue_index].atomic_sticky) {
+		burst = sched->queues[queue_index].atomic_max_events;
+
+		if (burst && burst < max)
+			max = burst;
+	}
+
 	/* Low priorities have smaller batch size to limit
 	 * head of line blocking latency.
 	 */
-	if (odp_unlikely(MAX_DEQ > 1 && prio > ODP_SCHED_PRIO_DEFAULT))
-		max = MAX_DEQ / 2;
+	if (odp_unlikely(max > 1 && prio > ODP_SCHED_PRIO_DEFAULT))
+		max = max / 2;
 
 	/* For ordered queues we want consecutive events to
 	 * be dispatched to separate threads, so do not cache
@@ -1513,6 +1562,8 @@ static inline int consume_queue(int prio, unsigned int queue_index)
 	if (count == 0)
 		return 0;
 
+	sched_stat_deq(cache->stash, count);
+
 	cache->top = &cache->stash[0];
 	cache->count = count;
 	cache->queue = sched_cb_queue_handle(queue_index);
@@ -13,6 +13,7 @@
 #include <odp/api/schedule.h>
 #include <odp/api/shared_memory.h>
 #include <odp_schedule_if.h>
+#include <odp_schedule_stats_internal.h>
 #include <odp_debug_internal.h>
 #include <odp_align_internal.h>
 #include <odp_config_internal.h>
@@ -247,6 +248,11 @@ static unsigned max_ordered_locks(void)
 	return NUM_ORDERED_LOCKS;
 }
 
+static uint32_t max_queues(void)
+{
+	return NUM_QUEUE;
+}
+
 static void add_group(sched_group_t *sched_group, int thr, int group)
 {
 	int num;
@@ -492,8 +498,8 @@ static uint64_t schedule_wait_time(uint64_t ns)
 	return ns;
 }
 
-static int schedule_multi(odp_queue_t *from, uint64_t wait,
-			  odp_event_t events[], int max_events ODP_UNUSED)
+static inline int do_schedule_multi(odp_queue_t *from, uint64_t wait,
+				    odp_event_t events[])
 {
 	odp_time_t t1;
 	int update_t1 = 1;
@@ -517,6 +523,8 @@ static int schedule_multi(odp_queue_t *from, uint64_t wait,
 		cmd = sched_cmd();
 
 		if (cmd && cmd->s.type == CMD_PKTIO) {
+			sched_stat_pktin_poll();
+
 			if (sched_cb_pktin_poll(cmd->s.index, cmd->s.num_pktin,
 						cmd->s.pktin_idx)) {
 				/* Pktio stopped or closed. */
@@ -531,6 +539,8 @@ static int schedule_multi(odp_queue_t *from, uint64_t wait,
 		}
 
 		if (cmd == NULL) {
+			sched_stat_empty_poll();
+
 			/* All priority queues are empty */
 			if (wait == ODP_SCHED_NO_WAIT)
 				return 0;
@@ -555,6 +565,7 @@ static int schedule_multi(odp_queue_t *from, uint64_t wait,
 		num = sched_cb_queue_deq_multi(qi, events, 1);
 
 		if (num > 0) {
+			sched_stat_deq(events, num);
 			sched_local.cmd = cmd;
 
 			if (from)
@@ -579,6 +590,17 @@ static int schedule_multi(odp_queue_t *from, uint64_t wait,
 	}
 }
 
+static int schedule_multi(odp_queue_t *from, uint64_t wait,
+			  odp_event_t events[], int max_events ODP_UNUSED)
+{
+	int num;
+
+	num = do_schedule_multi(from, wait, events);
+	sched_stat_calls(num);
+
+	return num;
+}
+
 static odp_event_t schedule(odp_queue_t *from, uint64_t wait)
 {
 	odp_event_t ev;
@@ -842,20 +864,25 @@ const schedule_fn_t schedule_sp_fn = {
 	.order_lock    = order_lock,
 	.order_unlock  = order_unlock,
 	.max_ordered_locks = max_ordered_locks,
+	.max_queues    = max_queues,
 	.unsched_queue = NULL,
 	.save_context  = NULL
 };
 
 /* Fill in scheduler API calls */
 const schedule_api_t schedule_sp_api = {
+	.fast = {
+		.schedule                 = schedule,
+		.schedule_multi           = schedule_multi,
+		.schedule_pause           = schedule_pause,
+		.schedule_resume          = schedule_resume,
+		.schedule_release_atomic  = schedule_release_atomic,
+		.schedule_release_ordered = schedule_release_ordered,
+		.schedule_prefetch        = schedule_prefetch,
+		.schedule_order_lock      = schedule_order_lock,
+		.schedule_order_unlock    = schedule_order_unlock
+	},
 	.schedule_wait_time       = schedule_wait_time,
-	.schedule                 = schedule,
-	.schedule_multi           = schedule_multi,
-	.schedule_pause           = schedule_pause,
-	.schedule_resume          = schedule_resume,
-	.schedule_release_atomic  = schedule_release_atomic,
-	.schedule_release_ordered = schedule_release_ordered,
-	.schedule_prefetch        = schedule_prefetch,
 	.schedule_num_prio        = schedule_num_prio,
 	.schedule_group_create    = schedule_group_create,
 	.schedule_group_destroy   = schedule_group_destroy,
@@ -863,7 +890,5 @@ const schedule_api_t schedule_sp_api = {
 	.schedule_group_join      = schedule_group_join,
 	.schedule_group_leave     = schedule_group_leave,
 	.schedule_group_thrmask   = schedule_group_thrmask,
-	.schedule_group_info      = schedule_group_info,
-	.schedule_order_lock      = schedule_order_lock,
-	.schedule_order_unlock    = schedule_order_unlock
+	.schedule_group_info      = schedule_group_info
 };
@@ -0,0 +1,204 @@
+/* Copyright (c) 2017, Linaro Limited
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier:     BSD-3-Clause
+ */
+
+#include "config.h"
+
+#include <odp/api/schedule.h>
+#include <odp/api/shared_memory.h>
+#include <odp/api/thread.h>
+#include <odp_schedule_stats_internal.h>
+#include <odp_debug_internal.h>
+
+#include <string.h>
+#include <inttypes.h>
+
+#ifdef ODP_SCHEDULE_STATS
+
+typedef struct {
+	sched_stats_t thr[ODP_THREAD_COUNT_MAX];
+	odp_shm_t shm;
+} sched_stats_global_t;
+
+static sched_stats_global_t *stats_global;
+
+__thread sched_stats_t *_odp_sched_stats;
+
+int _odp_sched_stats_init_global(void)
+{
+	odp_shm_t shm;
+
+	shm = odp_shm_reserve("odp_sched_stats", sizeof(sched_stats_global_t),
+			      ODP_CACHE_LINE_SIZE, 0);
+
+	stats_global = odp_shm_addr(shm);
+
+	if (stats_global == NULL) {
+		ODP_ERR("Schedule stats: shm reserve failed.\n");
+		return -1;
+	}
+
+	memset(stats_global, 0, sizeof(sched_stats_global_t));
+	stats_global->shm = shm;
+
+	return 0;
+}
+
+int _odp_sched_stats_term_global(void)
+{
+	if (odp_shm_free(stats_global->shm)) {
+		ODP_ERR("Schedule stats: shm free failed.\n");
+		return -1;
+	}
+
+	stats_global = NULL;
+	return 0;
+}
+
+int _odp_sched_stats_init_local(void)
+{
+	int thr = odp_thread_id();
+
+	if (thr < 0 || thr >= ODP_THREAD_COUNT_MAX)
+		return -1;
+
+	/* Thread id may have been used by an earlier thread */
+	_odp_sched_stats = &stats_global->thr[thr];
+	memset(_odp_sched_stats, 0, sizeof(sched_stats_t));
+	return 0;
+}
+
+static void stats_sum(odp_schedule_stats_t *sum, const odp_schedule_stats_t *s)
+{
+	int i;
+
+	sum->calls           += s->calls;
+	sum->events          += s->events;
+	sum->empty_polls     += s->empty_polls;
+	sum->pktin_polls     += s->pktin_polls;
+	sum->atomic_holds    += s->atomic_holds;
+	sum->atomic_hold_ns  += s->atomic_hold_ns;
+	sum->ordered_waits   += s->ordered_waits;
+	sum->ordered_wait_ns += s->ordered_wait_ns;
+	sum->stash_overflows += s->stash_overflows;
+
+	for (i = 0; i < ODP_SCHEDULE_LATENCY_BUCKETS; i++)
+		sum->latency[i] += s->latency[i];
+}
+
+int odp_schedule_stats(odp_schedule_stats_t *stats)
+{
+	int i;
+
+	memset(stats, 0, sizeof(odp_schedule_stats_t));
+
+	/* Counters are updated without synchronization. A snapshot of
+	 * a running system may be slightly inconsistent. */
+	for (i = 0; i < ODP_THREAD_COUNT_MAX; i++)
+		stats_sum(stats, &stats_global->thr[i].s);
+
+	return 0;
+}
+
+int odp_schedule_thr_stats(int thr, odp_schedule_stats_t *stats)
+{
+	if (thr < 0 || thr >= ODP_THREAD_COUNT_MAX)
+		return -1;
+
+	memset(stats, 0, sizeof(odp_schedule_stats_t));
+	stats_sum(stats, &stats_global->thr[thr].s);
+
+	return 0;
+}
+
+/* Upper limit of the latency bucket which contains the percentile */
+static uint64_t latency_percentile(const odp_schedule_stats_t *stats,
+				   uint64_t total, double percentile)
+{
+	uint64_t limit = (uint64_t)(total * percentile / 100.0);
+	uint64_t sum = 0;
+	int i;
+
+	for (i = 0; i < ODP_SCHEDULE_LATENCY_BUCKETS - 1; i++) {
+		sum += stats->latency[i];
+
+		if (sum > limit)
+			break;
+	}
+
+	return (UINT64_C(2) << i) - 1;
+}
+
+void odp_schedule_stats_print(void)
+{
+	odp_schedule_stats_t stats;
+	uint64_t total = 0;
+	int i;
+
+	odp_schedule_stats(&stats);
+
+	for (i = 0; i < ODP_SCHEDULE_LATENCY_BUCKETS; i++)
+		total += stats.latency[i];
+
+	ODP_PRINT("\nScheduler statistics\n");
+	ODP_PRINT("--------------------\n");
+	ODP_PRINT("  calls             %" PRIu64 "\n", stats.calls);
+	ODP_PRINT("  events            %" PRIu64 "\n", stats.events);
+	ODP_PRINT("  events per call   %.2f\n", stats.calls ?
+		  (double)stats.events / stats.calls : 0.0);
+	ODP_PRINT("  empty polls       %" PRIu64 "\n", stats.empty_polls);
+	ODP_PRINT("  pktin polls       %" PRIu64 "\n", stats.pktin_polls);
+	ODP_PRINT("  atomic holds      %" PRIu64 "\n", stats.atomic_holds);
+	ODP_PRINT("  atomic hold avg   %" PRIu64 " ns\n",
+		  stats.atomic_holds ?
+		  stats.atomic_hold_ns / stats.atomic_holds : 0);
+	ODP_PRINT("  ordered waits     %" PRIu64 "\n", stats.ordered_waits);
+	ODP_PRINT("  ordered wait avg  %" PRIu64 " ns\n",
+		  stats.ordered_waits ?
+		  stats.ordered_wait_ns / stats.ordered_waits : 0);
+	ODP_PRINT("  stash overflows   %" PRIu64 "\n", stats.stash_overflows);
+	ODP_PRINT("  latency samples   %" PRIu64 "\n", total);
+
+	if (total) {
+		ODP_PRINT("  latency p50       < %" PRIu64 " ns\n",
+			  latency_percentile(&stats, total, 50.0));
+		ODP_PRINT("  latency p99       < %" PRIu64 " ns\n",
+			  latency_percentile(&stats, total, 99.0));
+		ODP_PRINT("  latency p99.9     < %" PRIu64 " ns\n",
+			  latency_percentile(&stats, total, 99.9));
+		ODP_PRINT("  latency histogram\n");
+
+		for (i = 0; i < ODP_SCHEDULE_LATENCY_BUCKETS; i++) {
+			if (stats.latency[i] == 0)
+				continue;
+
+			ODP_PRINT("    %12" PRIu64 " ns  %" PRIu64 "\n",
+				  i ? (UINT64_C(1) << i) : 0, stats.latency[i]);
+		}
+	}
+
+	ODP_PRINT("\n");
+}
+
+#else
+
+int odp_schedule_stats(odp_schedule_stats_t *stats ODP_UNUSED)
+{
+	return -1;
+}
+
+int odp_schedule_thr_stats(int thr ODP_UNUSED,
+			   odp_schedule_stats_t *stats ODP_UNUSED)
+{
+	return -1;
+}
+
+void odp_schedule_stats_print(void)
+{
+	ODP_PRINT("\nScheduler statistics not enabled "
+		  "(configure with --enable-schedule-stats)\n\n");
+}
+
+#endif
@@ -316,6 +316,71 @@ static int systemcpu(system_info_t *sysinfo)
 	return 0;
 }
 
+/*
+ * NUMA node of a CPU from /sys/devices/system/cpu/cpu%d/node%d link. Physical
+ * package id is used when the kernel does not report NUMA nodes.
+ */
+static int systemcpu_numa_node(int cpu)
+{
+	char path[256];
+	DIR *dir;
+	struct dirent *dirent;
+	FILE *file;
+	int node = -1;
+
+	snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d", cpu);
+
+	dir = opendir(path);
+	if (dir == NULL)
+		return 0;
+
+	while ((dirent = readdir(dir)) != NULL) {
+		if (sscanf(dirent->d_name, "node%d", &node) == 1)
+			break;
+		node = -1;
+	}
+
+	closedir(dir);
+
+	if (node >= 0)
+		return node;
+
+	snprintf(path, sizeof(path),
+		 "/sys/devices/system/cpu/cpu%d/topology/physical_package_id",
+		 cpu);
+
+	file = fopen(path, "r");
+	if (file == NULL)
+		return 0;
+
+	if (fscanf(file, "%d", &node) != 1 || node < 0)
+		node = 0;
+
+	fclose(file);
+
+	return node;
+}
+
+static void systemcpu_numa(system_info_t *sysinfo)
+{
+	int cpu;
+	int num = 1;
+
+	for (cpu = 0; cpu < MAX_CPU_NUMBER; cpu++) {
+		int node = 0;
+
+		if (cpu < odp_global_data.num_cpus_installed)
+			node = systemcpu_numa_node(cpu);
+
+		sysinfo->numa_node[cpu] = node;
+
+		if (node >= num)
+			num = node + 1;
+	}
+
+	sysinfo->num_numa_nodes = num;
+}
+
 /*
  * Huge page information
  */
@@ -363,6 +428,8 @@ int odp_system_info_init(void)
 		return -1;
 	}
 
+	systemcpu_numa(&odp_global_data.system_info);
+
 	system_hp(&odp_global_data.hugepage_info);
 
 	return 0;
@@ -490,7 +557,7 @@ int odp_cpu_count(void)
 void odp_sys_info_print(void)
 {
 	int len;
-	int max_len = 512;
+	int max_len = 1024;
 	char str[max_len];
 
 	len = snprintf(str, max_len, "\n"
@@ -502,13 +569,29 @@ void odp_sys_info_print(void)
 		       "CPU freq (hz):   %" PRIu64 "\n"
 		       "Cache line size: %i\n"
 		       "CPU count:       %i\n"
-		       "\n",
+		       "NUMA nodes:      %i\n",
 		       odp_version_api_str(),
 		       odp_version_impl_name(),
 		       odp_cpu_model_str(),
 		       odp_cpu_hz_max(),
 		       odp_sys_cache_line_size(),
-		       odp_cpu_count());
+		       odp_cpu_count(),
+		       odp_global_data.system_info.num_numa_nodes);
+
+	if (odp_global_data.time_info.hz)
+		len += snprintf(&str[len], max_len - len,
+				"Time source:     %s\n"
+				"Time freq (hz):  %" PRIu64 "\n"
+				"Time freq error: %" PRIu32 " ppm\n"
+				"\n",
+				odp_global_data.time_info.src,
+				odp_global_data.time_info.hz,
+				odp_global_data.time_info.err_ppm);
+	else
+		len += snprintf(&str[len], max_len - len,
+				"Time source:     %s\n"
+				"\n",
+				odp_global_data.time_info.src);
 
 	str[len] = '\0';
 	ODP_PRINT("%s", str);
@@ -41,6 +41,7 @@ typedef struct {
 	};
 
 	uint32_t       num;
+	uint32_t       num_max;
 	uint32_t       num_worker;
 	uint32_t       num_control;
 	odp_spinlock_t lock;
@@ -55,9 +56,10 @@ static thread_globals_t *thread_globals;
 static __thread thread_state_t *this_thread;
 
 
-int odp_thread_init_global(void)
+int odp_thread_init_global(const odp_init_t *params)
 {
 	odp_shm_t shm;
+	uint32_t num_max = ODP_THREAD_COUNT_MAX;
 
 	shm = odp_shm_reserve("odp_thread_globals",
 			      sizeof(thread_globals_t),
@@ -71,6 +73,22 @@ int odp_thread_init_global(void)
 	memset(thread_globals, 0, sizeof(thread_globals_t));
 	odp_spinlock_init(&thread_globals->lock);
 
+	/* Per thread resources (e.g. pool caches) are sized by the maximum
+	 * number of threads the application has requested */
+	if (params && (params->num_worker > 0 || params->num_control > 0)) {
+		num_max = 0;
+
+		if (params->num_worker > 0)
+			num_max += params->num_worker;
+		if (params->num_control > 0)
+			num_max += params->num_control;
+
+		if (num_max > ODP_THREAD_COUNT_MAX)
+			num_max = ODP_THREAD_COUNT_MAX;
+	}
+
+	thread_globals->num_max = num_max;
+
 	return 0;
 }
 
@@ -90,10 +108,10 @@ static int alloc_id(odp_thread_type_t type)
 	int thr;
 	odp_thrmask_t *all = &thread_globals->all;
 
-	if (thread_globals->num >= ODP_THREAD_COUNT_MAX)
+	if (thread_globals->num >= thread_globals->num_max)
 		return -1;
 
-	for (thr = 0; thr < ODP_THREAD_COUNT_MAX; thr++) {
+	for (thr = 0; thr < (int)thread_globals->num_max; thr++) {
 		if (odp_thrmask_isset(all, thr) == 0) {
 			odp_thrmask_set(all, thr);
 
@@ -211,7 +229,7 @@ int odp_thread_count(void)
 
 int odp_thread_count_max(void)
 {
-	return ODP_THREAD_COUNT_MAX;
+	return thread_globals->num_max;
 }
 
 odp_thread_type_t odp_thread_type(void)
@@ -9,21 +9,23 @@
 #include <odp_posix_extensions.h>
 
 #include <time.h>
+#include <odp/api/plat/time_inlines.h>
 #include <odp/api/time.h>
 #include <odp/api/hints.h>
 #include <odp_debug_internal.h>
 #include <odp_time_internal.h>
+#include <odp_internal.h>
 #include <string.h>
 #include <inttypes.h>
 
-typedef struct time_global_t {
-	struct timespec spec_start;
-	int             use_hw;
-	uint64_t        hw_start;
-	uint64_t        hw_freq_hz;
-} time_global_t;
+#include <odp/visibility_begin.h>
 
-static time_global_t global;
+/* Time data for inline functions */
+_odp_time_global_t _odp_time_glob;
+
+#include <odp/visibility_end.h>
+
+static struct timespec spec_start;
 
 /*
  * Posix timespec based functions
@@ -58,7 +60,7 @@ static inline odp_time_t time_spec_cur(void)
 	if (odp_unlikely(ret != 0))
 		ODP_ABORT("clock_gettime failed\n");
 
-	time.nsec = time_spec_diff_nsec(&sys_time, &global.spec_start);
+	time.nsec = time_spec_diff_nsec(&sys_time, &spec_start);
 
 	return time;
 }
@@ -75,20 +77,6 @@ static inline uint64_t time_spec_res(void)
 	return ODP_TIME_SEC_IN_NS / (uint64_t)tres.tv_nsec;
 }
 
-static inline uint64_t time_spec_to_ns(odp_time_t time)
-{
-	return time.nsec;
-}
-
-static inline odp_time_t time_spec_from_ns(uint64_t ns)
-{
-	odp_time_t time;
-
-	time.nsec = ns;
-
-	return time;
-}
-
 /*
  * HW time counter based functions
  */
@@ -97,177 +85,58 @@ static inline odp_time_t time_hw_cur(void)
 {
 	odp_time_t time;
 
-	time.count = cpu_global_time() - global.hw_start;
+	time.count = cpu_global_time() - _odp_time_glob.hw_start;
 
 	return time;
 }
 
-static inline uint64_t time_hw_res(void)
+#ifdef __SIZEOF_INT128__
+/* Calculate multiplier and shift for converting a value from 'from_hz'
+ * to 'to_hz' units: result = (val * mul) >> shift. The largest shift which
+ * keeps the multiplier below 2^63 is selected for best precision. */
+static void time_mul_shift(uint64_t to_hz, uint64_t from_hz, uint64_t *mul,
+			   uint32_t *shift)
 {
-	return global.hw_freq_hz;
-}
-
-static inline uint64_t time_hw_to_ns(odp_time_t time)
-{
-	uint64_t nsec;
-	uint64_t freq_hz = global.hw_freq_hz;
-	uint64_t count = time.count;
-	uint64_t sec = 0;
-
-	if (count >= freq_hz) {
-		sec   = count / freq_hz;
-		count = count - sec * freq_hz;
-	}
+	uint32_t s = 0;
 
-	nsec = (ODP_TIME_SEC_IN_NS * count) / freq_hz;
+	while (s < 96 &&
+	       (((unsigned __int128)to_hz << (s + 1)) / from_hz) <
+	       (UINT64_C(1) << 63))
+		s++;
 
-	return (sec * ODP_TIME_SEC_IN_NS) + nsec;
+	*mul   = (uint64_t)(((unsigned __int128)to_hz << s) / from_hz);
+	*shift = s;
 }
+#endif
 
-static inline odp_time_t time_hw_from_ns(uint64_t ns)
-{
-	odp_time_t time;
-	uint64_t count;
-	uint64_t freq_hz = global.hw_freq_hz;
-	uint64_t sec = 0;
-
-	if (ns >= ODP_TIME_SEC_IN_NS) {
-		sec = ns / ODP_TIME_SEC_IN_NS;
-		ns  = ns - sec * ODP_TIME_SEC_IN_NS;
-	}
-
-	count  = sec * freq_hz;
-	count += (ns * freq_hz) / ODP_TIME_SEC_IN_NS;
-
-	time.count = count;
+#include <odp/visibility_begin.h>
 
-	return time;
-}
-
-/*
- * Common functions
- */
-
-static inline odp_time_t time_cur(void)
+/* Current time for inline functions, when HW time counter cannot be read
+ * inline */
+odp_time_t _odp_time_cur_sys(void)
 {
-	if (global.use_hw)
+	if (_odp_time_glob.use_hw)
 		return time_hw_cur();
 
 	return time_spec_cur();
 }
 
-static inline uint64_t time_res(void)
-{
-	if (global.use_hw)
-		return time_hw_res();
-
-	return time_spec_res();
-}
-
-static inline int time_cmp(odp_time_t t2, odp_time_t t1)
-{
-	if (odp_likely(t2.u64 > t1.u64))
-		return 1;
-
-	if (t2.u64 < t1.u64)
-		return -1;
-
-	return 0;
-}
-
-static inline odp_time_t time_sum(odp_time_t t1, odp_time_t t2)
-{
-	odp_time_t time;
-
-	time.u64 = t1.u64 + t2.u64;
-
-	return time;
-}
-
-static inline uint64_t time_to_ns(odp_time_t time)
-{
-	if (global.use_hw)
-		return time_hw_to_ns(time);
-
-	return time_spec_to_ns(time);
-}
-
-static inline odp_time_t time_from_ns(uint64_t ns)
-{
-	if (global.use_hw)
-		return time_hw_from_ns(ns);
-
-	return time_spec_from_ns(ns);
-}
+#include <odp/visibility_end.h>
 
 static inline void time_wait_until(odp_time_t time)
 {
 	odp_time_t cur;
 
 	do {
-		cur = time_cur();
-	} while (time_cmp(time, cur) > 0);
-}
-
-odp_time_t odp_time_local(void)
-{
-	return time_cur();
-}
-
-odp_time_t odp_time_global(void)
-{
-	return time_cur();
-}
-
-odp_time_t odp_time_diff(odp_time_t t2, odp_time_t t1)
-{
-	odp_time_t time;
-
-	time.u64 = t2.u64 - t1.u64;
-
-	return time;
-}
-
-uint64_t odp_time_to_ns(odp_time_t time)
-{
-	return time_to_ns(time);
-}
-
-odp_time_t odp_time_local_from_ns(uint64_t ns)
-{
-	return time_from_ns(ns);
-}
-
-odp_time_t odp_time_global_from_ns(uint64_t ns)
-{
-	return time_from_ns(ns);
-}
-
-int odp_time_cmp(odp_time_t t2, odp_time_t t1)
-{
-	return time_cmp(t2, t1);
-}
-
-odp_time_t odp_time_sum(odp_time_t t1, odp_time_t t2)
-{
-	return time_sum(t1, t2);
-}
-
-uint64_t odp_time_local_res(void)
-{
-	return time_res();
-}
-
-uint64_t odp_time_global_res(void)
-{
-	return time_res();
+		cur = _odp_time_cur();
+	} while (_odp_time_cmp(time, cur) > 0);
 }
 
 void odp_time_wait_ns(uint64_t ns)
 {
-	odp_time_t cur = time_cur();
-	odp_time_t wait = time_from_ns(ns);
-	odp_time_t end_time = time_sum(cur, wait);
+	odp_time_t cur = _odp_time_cur();
+	odp_time_t wait = _odp_time_from_ns(ns);
+	odp_time_t end_time = _odp_time_sum(cur, wait);
 
 	time_wait_until(end_time);
 }
@@ -281,26 +150,44 @@ int odp_time_init_global(void)
 {
 	int ret = 0;
 
-	memset(&global, 0, sizeof(time_global_t));
+	memset(&_odp_time_glob, 0, sizeof(_odp_time_global_t));
 
 	if (cpu_has_global_time()) {
-		global.use_hw = 1;
-		global.hw_freq_hz  = cpu_global_time_freq();
+		time_freq_info_t *info = &odp_global_data.time_info;
+		uint64_t hz = cpu_global_time_freq(info);
 
-		if (global.hw_freq_hz == 0)
+		if (hz == 0)
 			return -1;
 
-		printf("HW time counter freq: %" PRIu64 " hz\n\n",
-		       global.hw_freq_hz);
+		info->hz = hz;
+
+		_odp_time_glob.hw_freq_hz = hz;
+		_odp_time_glob.res_hz     = hz;
 
-		global.hw_start = cpu_global_time();
+#ifdef __SIZEOF_INT128__
+		time_mul_shift(ODP_TIME_SEC_IN_NS, hz, &_odp_time_glob.ns_mul,
+			       &_odp_time_glob.ns_shift);
+		time_mul_shift(hz, ODP_TIME_SEC_IN_NS,
+			       &_odp_time_glob.count_mul,
+			       &_odp_time_glob.count_shift);
+#endif
+
+		printf("HW time counter freq: %" PRIu64 " hz\n\n", hz);
+
+		_odp_time_glob.hw_start = cpu_global_time();
+		_odp_time_glob.use_hw   = 1;
 		return 0;
 	}
 
-	global.spec_start.tv_sec  = 0;
-	global.spec_start.tv_nsec = 0;
+	spec_start.tv_sec  = 0;
+	spec_start.tv_nsec = 0;
+
+	ret = clock_gettime(CLOCK_MONOTONIC_RAW, &spec_start);
 
-	ret = clock_gettime(CLOCK_MONOTONIC_RAW, &global.spec_start);
+	odp_global_data.time_info.hz  = 0;
+	odp_global_data.time_info.src = "CLOCK_MONOTONIC_RAW";
+
+	_odp_time_glob.res_hz = time_spec_res();
 
 	return ret;
 }
@@ -309,3 +196,8 @@ int odp_time_term_global(void)
 {
 	return 0;
 }
+
+/* Include non-inlined versions of API functions */
+#if ODP_ABI_COMPAT == 1
+#include <odp/api/plat/time_inlines_api.h>
+#endif
@@ -124,7 +124,7 @@ static inline void mbuf_update(struct rte_mbuf *mbuf, odp_packet_hdr_t *pkt_hdr,
 	mbuf->pkt_len = pkt_len;
 	mbuf->refcnt = 1;
 
-	if (odp_unlikely(pkt_hdr->buf_hdr.base_data !=
+	if (odp_unlikely(pkt_hdr->base_data !=
 			 pkt_hdr->buf_hdr.seg[0].data))
 		mbuf->data_off = mbuf_data_off(mbuf, pkt_hdr);
 }
@@ -137,7 +137,7 @@ static inline void mbuf_update(struct rte_mbuf *mbuf, odp_packet_hdr_t *pkt_hdr,
 static void mbuf_init(struct rte_mempool *mp, struct rte_mbuf *mbuf,
 		      odp_packet_hdr_t *pkt_hdr)
 {
-	void *buf_addr = pkt_hdr->buf_hdr.base_data - RTE_PKTMBUF_HEADROOM;
+	void *buf_addr = pkt_hdr->base_data - RTE_PKTMBUF_HEADROOM;
 
 	memset(mbuf, 0, sizeof(struct rte_mbuf));
 
@@ -1271,6 +1271,13 @@ static int dpdk_open(odp_pktio_t id ODP_UNUSED,
 		pkt_dpdk->min_rx_burst = 0;
 
 	if (ODP_DPDK_ZERO_COPY) {
+		/* DPDK mempool covers a single buffer size class */
+		if (pool_entry->num_class > 1) {
+			ODP_ERR("Pools with buffer size classes are not "
+				"supported in zero-copy mode\n");
+			return -1;
+		}
+
 		if (pool_entry->ext_desc != NULL)
 			pkt_pool = (struct rte_mempool *)pool_entry->ext_desc;
 		else
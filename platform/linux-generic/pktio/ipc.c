@@ -29,6 +29,9 @@
 static const char pktio_ipc_mac[] = {0x12, 0x12, 0x12, 0x12, 0x12, 0x12};
 
 static odp_shm_t _ipc_map_remote_pool(const char *name, int pid);
+static int _ipc_zc_init(pktio_entry_t *pktio_entry, int num,
+			void *remote_base, uint32_t block_size,
+			uint32_t seg_len);
 
 static const char *_ipc_odp_buffer_pool_shm_name(odp_pool_t pool_hdl)
 {
@@ -64,86 +67,103 @@ static int _ipc_master_start(pktio_entry_t *pktio_entry)
 	pktio_entry->s.ipc.pool_base = odp_shm_addr(shm);
 	pktio_entry->s.ipc.pool_mdata_base = (char *)odp_shm_addr(shm);
 
+	_ipc_zc_init(pktio_entry, pinfo->slave.num, pinfo->slave.base_addr,
+		     pinfo->slave.block_size, pinfo->slave.seg_len);
+
 	odp_atomic_store_u32(&pktio_entry->s.ipc.ready, 1);
 
 	IPC_ODP_DBG("%s started.\n",  pktio_entry->s.name);
 	return 0;
 }
 
+/* Names of queue 0 rings are the same as with a single queue pktio. Queue
+ * number is appended to ring names of other queues. */
+static void _ipc_ring_name(char *name, size_t size, const char *dev,
+			   const char *suffix, int queue)
+{
+	if (queue == 0)
+		snprintf(name, size, "%s%s", dev, suffix);
+	else
+		snprintf(name, size, "%s%s%d", dev, suffix, queue);
+}
+
+static _ring_t *_ipc_ring_create(const char *dev, const char *suffix,
+				 int queue)
+{
+	char ipc_shm_name[ODP_POOL_NAME_LEN + sizeof("_m_prod0")];
+	_ring_t *r;
+
+	_ipc_ring_name(ipc_shm_name, sizeof(ipc_shm_name), dev, suffix, queue);
+	r = _ring_create(ipc_shm_name, PKTIO_IPC_ENTRIES,
+			 _RING_SHM_PROC | _RING_NO_LIST);
+	if (!r) {
+		ODP_ERR("pid %d unable to create ipc ring %s name\n",
+			getpid(), ipc_shm_name);
+		return NULL;
+	}
+	ODP_DBG("Created IPC ring: %s, count %d, free %d\n",
+		ipc_shm_name, _ring_count(r), _ring_free_count(r));
+
+	return r;
+}
+
+static void _ipc_rings_destroy(const char *dev, int queue)
+{
+	static const char * const suffix[] = {"_s_cons", "_s_prod",
+					      "_m_cons", "_m_prod"};
+	char ipc_shm_name[ODP_POOL_NAME_LEN + sizeof("_m_prod0")];
+	unsigned i;
+
+	for (i = 0; i < sizeof(suffix) / sizeof(suffix[0]); i++) {
+		_ipc_ring_name(ipc_shm_name, sizeof(ipc_shm_name), dev,
+			       suffix[i], queue);
+		_ring_destroy(ipc_shm_name);
+	}
+}
+
+/* Each queue has its own set of rings. Master sends packets through _m_prod
+ * ring and slave returns those through _m_cons ring. _s_prod and _s_cons
+ * rings are used in the other direction. */
+static int _ipc_master_rings_create(pktio_entry_t *pktio_entry,
+				    const char *dev, int queue)
+{
+	_ipc_pktio_t *ipc = &pktio_entry->s.ipc;
+
+	ipc->tx[queue].send = _ipc_ring_create(dev, "_m_prod", queue);
+	ipc->tx[queue].free = _ipc_ring_create(dev, "_m_cons", queue);
+	ipc->rx[queue].recv = _ipc_ring_create(dev, "_s_prod", queue);
+	ipc->rx[queue].free = _ipc_ring_create(dev, "_s_cons", queue);
+
+	if (!ipc->tx[queue].send || !ipc->tx[queue].free ||
+	    !ipc->rx[queue].recv || !ipc->rx[queue].free) {
+		_ipc_rings_destroy(dev, queue);
+		return -1;
+	}
+
+	return 0;
+}
+
 static int _ipc_init_master(pktio_entry_t *pktio_entry,
 			    const char *dev,
 			    odp_pool_t pool_hdl)
 {
-	char ipc_shm_name[ODP_POOL_NAME_LEN + sizeof("_m_prod")];
 	pool_t *pool;
 	struct pktio_info *pinfo;
 	const char *pool_name;
 
 	pool = pool_entry_from_hdl(pool_hdl);
-	(void)pool;
 
-	if (strlen(dev) > (ODP_POOL_NAME_LEN - sizeof("_m_prod"))) {
+	if (strlen(dev) > (ODP_POOL_NAME_LEN - sizeof("_m_prod0"))) {
 		ODP_ERR("too big ipc name\n");
 		return -1;
 	}
 
-	/* generate name in shm like ipc_pktio_r for
-	 * to be processed packets ring.
-	 */
-	snprintf(ipc_shm_name, sizeof(ipc_shm_name), "%s_m_prod", dev);
-	pktio_entry->s.ipc.tx.send = _ring_create(ipc_shm_name,
-			PKTIO_IPC_ENTRIES,
-			_RING_SHM_PROC | _RING_NO_LIST);
-	if (!pktio_entry->s.ipc.tx.send) {
-		ODP_ERR("pid %d unable to create ipc ring %s name\n",
-			getpid(), ipc_shm_name);
+	/* Rings of the first queue are created here, rings of other
+	 * queues when those are configured. */
+	if (_ipc_master_rings_create(pktio_entry, dev, 0))
 		return -1;
-	}
-	ODP_DBG("Created IPC ring: %s, count %d, free %d\n",
-		ipc_shm_name, _ring_count(pktio_entry->s.ipc.tx.send),
-		_ring_free_count(pktio_entry->s.ipc.tx.send));
 
-	/* generate name in shm like ipc_pktio_p for
-	 * already processed packets
-	 */
-	snprintf(ipc_shm_name, sizeof(ipc_shm_name), "%s_m_cons", dev);
-	pktio_entry->s.ipc.tx.free = _ring_create(ipc_shm_name,
-			PKTIO_IPC_ENTRIES,
-			_RING_SHM_PROC | _RING_NO_LIST);
-	if (!pktio_entry->s.ipc.tx.free) {
-		ODP_ERR("pid %d unable to create ipc ring %s name\n",
-			getpid(), ipc_shm_name);
-		goto free_m_prod;
-	}
-	ODP_DBG("Created IPC ring: %s, count %d, free %d\n",
-		ipc_shm_name, _ring_count(pktio_entry->s.ipc.tx.free),
-		_ring_free_count(pktio_entry->s.ipc.tx.free));
-
-	snprintf(ipc_shm_name, sizeof(ipc_shm_name), "%s_s_prod", dev);
-	pktio_entry->s.ipc.rx.recv = _ring_create(ipc_shm_name,
-			PKTIO_IPC_ENTRIES,
-			_RING_SHM_PROC | _RING_NO_LIST);
-	if (!pktio_entry->s.ipc.rx.recv) {
-		ODP_ERR("pid %d unable to create ipc ring %s name\n",
-			getpid(), ipc_shm_name);
-		goto free_m_cons;
-	}
-	ODP_DBG("Created IPC ring: %s, count %d, free %d\n",
-		ipc_shm_name, _ring_count(pktio_entry->s.ipc.rx.recv),
-		_ring_free_count(pktio_entry->s.ipc.rx.recv));
-
-	snprintf(ipc_shm_name, sizeof(ipc_shm_name), "%s_s_cons", dev);
-	pktio_entry->s.ipc.rx.free = _ring_create(ipc_shm_name,
-			PKTIO_IPC_ENTRIES,
-			_RING_SHM_PROC | _RING_NO_LIST);
-	if (!pktio_entry->s.ipc.rx.free) {
-		ODP_ERR("pid %d unable to create ipc ring %s name\n",
-			getpid(), ipc_shm_name);
-		goto free_s_prod;
-	}
-	ODP_DBG("Created IPC ring: %s, count %d, free %d\n",
-		ipc_shm_name, _ring_count(pktio_entry->s.ipc.rx.free),
-		_ring_free_count(pktio_entry->s.ipc.rx.free));
+	pktio_entry->s.ipc.num_queues = 1;
 
 	/* Set up pool name for remote info */
 	pinfo = pktio_entry->s.ipc.pinfo;
@@ -151,10 +171,16 @@ static int _ipc_init_master(pktio_entry_t *pktio_entry,
 	if (strlen(pool_name) > ODP_POOL_NAME_LEN) {
 		ODP_ERR("pid %d ipc pool name %s is too big %d\n",
 			getpid(), pool_name, strlen(pool_name));
-		goto free_s_prod;
+		_ipc_rings_destroy(dev, 0);
+		return -1;
 	}
 
 	memcpy(pinfo->master.pool_name, pool_name, strlen(pool_name));
+	pinfo->master.num = pool->shm_size / pool->block_size;
+	pinfo->master.base_addr = pool->base_addr;
+	pinfo->master.block_size = pool->block_size;
+	pinfo->master.seg_len = pool->seg_len;
+	pinfo->master.num_queues = 1;
 	pinfo->slave.base_addr = 0;
 	pinfo->slave.pid = 0;
 	pinfo->slave.init_done = 0;
@@ -167,17 +193,6 @@ static int _ipc_init_master(pktio_entry_t *pktio_entry,
 	_ipc_master_start(pktio_entry);
 
 	return 0;
-
-free_s_prod:
-	snprintf(ipc_shm_name, sizeof(ipc_shm_name), "%s_s_prod", dev);
-	_ring_destroy(ipc_shm_name);
-free_m_cons:
-	snprintf(ipc_shm_name, sizeof(ipc_shm_name), "%s_m_cons", dev);
-	_ring_destroy(ipc_shm_name);
-free_m_prod:
-	snprintf(ipc_shm_name, sizeof(ipc_shm_name), "%s_m_prod", dev);
-	_ring_destroy(ipc_shm_name);
-	return -1;
 }
 
 static void _ipc_export_pool(struct pktio_info *pinfo,
@@ -188,7 +203,9 @@ static void _ipc_export_pool(struct pktio_info *pinfo,
 	snprintf(pinfo->slave.pool_name, ODP_POOL_NAME_LEN, "%s",
 		 _ipc_odp_buffer_pool_shm_name(pool_hdl));
 	pinfo->slave.pid = odp_global_data.main_pid;
+	pinfo->slave.num = pool->shm_size / pool->block_size;
 	pinfo->slave.block_size = pool->block_size;
+	pinfo->slave.seg_len = pool->seg_len;
 	pinfo->slave.base_addr = pool->base_addr;
 }
 
@@ -232,14 +249,72 @@ static int _ipc_init_slave(const char *dev,
 	return 0;
 }
 
+static _ring_t *_ipc_ring_map(const char *dev, const char *suffix,
+			      int queue, int pid)
+{
+	char ipc_shm_name[ODP_POOL_NAME_LEN + sizeof("_m_prod0")];
+	_ring_t *r;
+
+	_ipc_ring_name(ipc_shm_name, sizeof(ipc_shm_name), dev, suffix, queue);
+	r = _ipc_shm_map(ipc_shm_name, pid);
+	if (!r) {
+		ODP_DBG("pid %d unable to find ipc ring %s name\n",
+			getpid(), ipc_shm_name);
+		return NULL;
+	}
+	ODP_DBG("Connected IPC ring: %s, count %d, free %d\n",
+		ipc_shm_name, _ring_count(r), _ring_free_count(r));
+
+	return r;
+}
+
+static int _ipc_slave_rings_map(pktio_entry_t *pktio_entry,
+				const char *dev, int queue, int pid)
+{
+	_ipc_pktio_t *ipc = &pktio_entry->s.ipc;
+
+	ipc->rx[queue].recv = _ipc_ring_map(dev, "_m_prod", queue, pid);
+	ipc->rx[queue].free = _ipc_ring_map(dev, "_m_cons", queue, pid);
+	ipc->tx[queue].send = _ipc_ring_map(dev, "_s_prod", queue, pid);
+	ipc->tx[queue].free = _ipc_ring_map(dev, "_s_cons", queue, pid);
+
+	if (!ipc->rx[queue].recv || !ipc->rx[queue].free ||
+	    !ipc->tx[queue].send || !ipc->tx[queue].free) {
+		_ipc_rings_destroy(dev, queue);
+		return -1;
+	}
+
+	return 0;
+}
+
+/* Number of queue ring sets needed by the current queue configuration */
+static int _ipc_num_queues(pktio_entry_t *pktio_entry)
+{
+	unsigned num = pktio_entry->s.num_in_queue;
+
+	if (pktio_entry->s.num_out_queue > num)
+		num = pktio_entry->s.num_out_queue;
+
+	return num ? num : 1;
+}
+
+/* Local rx cache ring names are unique per pktio and queue */
+static void _ipc_cache_name(char *name, size_t size,
+			    pktio_entry_t *pktio_entry, int queue)
+{
+	snprintf(name, size, "ipc_rx_cache_%d_%d",
+		 pktio_to_id(pktio_entry->s.handle), queue);
+}
+
 static int _ipc_slave_start(pktio_entry_t *pktio_entry)
 {
-	char ipc_shm_name[ODP_POOL_NAME_LEN + sizeof("_slave_r")];
 	struct pktio_info *pinfo;
 	odp_shm_t shm;
 	char tail[ODP_POOL_NAME_LEN];
 	char dev[ODP_POOL_NAME_LEN];
+	int num_queues;
 	int pid;
+	int i;
 
 	if (sscanf(pktio_entry->s.name, "ipc:%d:%s", &pid, tail) != 2) {
 		ODP_ERR("wrong pktio name\n");
@@ -248,59 +323,42 @@ static int _ipc_slave_start(pktio_entry_t *pktio_entry)
 
 	sprintf(dev, "ipc:%s", tail);
 
-	snprintf(ipc_shm_name, sizeof(ipc_shm_name), "%s_m_prod", dev);
-	pktio_entry->s.ipc.rx.recv  = _ipc_shm_map(ipc_shm_name, pid);
-	if (!pktio_entry->s.ipc.rx.recv) {
-		ODP_DBG("pid %d unable to find ipc ring %s name\n",
-			getpid(), dev);
+	/* Master creates rings of other than the first queue when its queues
+	 * are configured. Wait until it has as many queues as needed here. */
+	pinfo = pktio_entry->s.ipc.pinfo;
+	num_queues = _ipc_num_queues(pktio_entry);
+	if (pinfo->master.num_queues < num_queues) {
+		ODP_DBG("%s: master has %d queues, %d needed\n",
+			pktio_entry->s.name, pinfo->master.num_queues,
+			num_queues);
 		sleep(1);
 		return -1;
 	}
-	ODP_DBG("Connected IPC ring: %s, count %d, free %d\n",
-		ipc_shm_name, _ring_count(pktio_entry->s.ipc.rx.recv),
-		_ring_free_count(pktio_entry->s.ipc.rx.recv));
 
-	snprintf(ipc_shm_name, sizeof(ipc_shm_name), "%s_m_cons", dev);
-	pktio_entry->s.ipc.rx.free = _ipc_shm_map(ipc_shm_name, pid);
-	if (!pktio_entry->s.ipc.rx.free) {
-		ODP_ERR("pid %d unable to find ipc ring %s name\n",
-			getpid(), dev);
-		goto free_m_prod;
+	for (i = 0; i < num_queues; i++) {
+		if (_ipc_slave_rings_map(pktio_entry, dev, i, pid)) {
+			while (i--)
+				_ipc_rings_destroy(dev, i);
+			sleep(1);
+			return -1;
+		}
 	}
-	ODP_DBG("Connected IPC ring: %s, count %d, free %d\n",
-		ipc_shm_name, _ring_count(pktio_entry->s.ipc.rx.free),
-		_ring_free_count(pktio_entry->s.ipc.rx.free));
 
-	snprintf(ipc_shm_name, sizeof(ipc_shm_name), "%s_s_prod", dev);
-	pktio_entry->s.ipc.tx.send = _ipc_shm_map(ipc_shm_name, pid);
-	if (!pktio_entry->s.ipc.tx.send) {
-		ODP_ERR("pid %d unable to find ipc ring %s name\n",
-			getpid(), dev);
-		goto free_m_cons;
-	}
-	ODP_DBG("Connected IPC ring: %s, count %d, free %d\n",
-		ipc_shm_name, _ring_count(pktio_entry->s.ipc.tx.send),
-		_ring_free_count(pktio_entry->s.ipc.tx.send));
-
-	snprintf(ipc_shm_name, sizeof(ipc_shm_name), "%s_s_cons", dev);
-	pktio_entry->s.ipc.tx.free = _ipc_shm_map(ipc_shm_name, pid);
-	if (!pktio_entry->s.ipc.tx.free) {
-		ODP_ERR("pid %d unable to find ipc ring %s name\n",
-			getpid(), dev);
-		goto free_s_prod;
-	}
-	ODP_DBG("Connected IPC ring: %s, count %d, free %d\n",
-		ipc_shm_name, _ring_count(pktio_entry->s.ipc.tx.free),
-		_ring_free_count(pktio_entry->s.ipc.tx.free));
+	pktio_entry->s.ipc.num_queues = num_queues;
 
 	/* Get info about remote pool */
-	pinfo = pktio_entry->s.ipc.pinfo;
 	shm = _ipc_map_remote_pool(pinfo->master.pool_name,
 				   pid);
 	pktio_entry->s.ipc.remote_pool_shm = shm;
 	pktio_entry->s.ipc.pool_mdata_base = (char *)odp_shm_addr(shm);
 	pktio_entry->s.ipc.pkt_size = pinfo->master.block_size;
 
+	if (shm != ODP_SHM_INVALID)
+		_ipc_zc_init(pktio_entry, pinfo->master.num,
+			     pinfo->master.base_addr,
+			     pinfo->master.block_size,
+			     pinfo->master.seg_len);
+
 	_ipc_export_pool(pinfo, pktio_entry->s.ipc.pool);
 
 	odp_atomic_store_u32(&pktio_entry->s.ipc.ready, 1);
@@ -308,20 +366,6 @@ static int _ipc_slave_start(pktio_entry_t *pktio_entry)
 
 	ODP_DBG("%s started.\n",  pktio_entry->s.name);
 	return 0;
-
-free_s_prod:
-	snprintf(ipc_shm_name, sizeof(ipc_shm_name), "%s_s_prod", dev);
-	shm = odp_shm_lookup(ipc_shm_name);
-	odp_shm_free(shm);
-free_m_cons:
-	snprintf(ipc_shm_name, sizeof(ipc_shm_name), "%s_m_cons", dev);
-	shm = odp_shm_lookup(ipc_shm_name);
-	odp_shm_free(shm);
-free_m_prod:
-	snprintf(ipc_shm_name, sizeof(ipc_shm_name), "%s_m_prod", dev);
-	shm = odp_shm_lookup(ipc_shm_name);
-	odp_shm_free(shm);
-	return -1;
 }
 
 static int ipc_pktio_open(odp_pktio_t id ODP_UNUSED,
@@ -335,6 +379,7 @@ static int ipc_pktio_open(odp_pktio_t id ODP_UNUSED,
 	char name[ODP_POOL_NAME_LEN + sizeof("_info")];
 	char tail[ODP_POOL_NAME_LEN];
 	odp_shm_t shm;
+	int i;
 
 	ODP_STATIC_ASSERT(ODP_POOL_NAME_LEN == _RING_NAMESIZE,
 			  "mismatch pool and ring name arrays");
@@ -342,11 +387,29 @@ static int ipc_pktio_open(odp_pktio_t id ODP_UNUSED,
 	if (strncmp(dev, "ipc", 3))
 		return -1;
 
+	/* Packets are shared as offsets into a single pool shm. Pools with
+	 * buffer size classes are rejected, so unlike other pktio types
+	 * ipc receive never selects a size class per packet. */
+	if (pool_entry_from_hdl(pool)->num_class > 1) {
+		ODP_ERR("Pools with buffer size classes are not supported\n");
+		return -1;
+	}
+
 	odp_atomic_init_u32(&pktio_entry->s.ipc.ready, 0);
 
-	pktio_entry->s.ipc.rx.cache = _ring_create("ipc_rx_cache",
-						   PKTIO_IPC_ENTRIES,
-						   _RING_NO_LIST);
+	/* Zero-copy receive is enabled with odp_pktio_config() */
+	pktio_entry->s.ipc.zero_copy = 0;
+	pktio_entry->s.ipc.remote_pool = NULL;
+
+	pktio_entry->s.ipc.num_queues = 0;
+	pktio_entry->s.ipc.num_cache = 0;
+	pktio_entry->s.ipc.lockless_rx = 0;
+	pktio_entry->s.ipc.lockless_tx = 0;
+
+	for (i = 0; i < PKTIO_IPC_QUEUES_MAX; i++) {
+		odp_ticketlock_init(&pktio_entry->s.ipc.rx[i].lock);
+		odp_ticketlock_init(&pktio_entry->s.ipc.tx[i].lock);
+	}
 
 	/* Shared info about remote pktio */
 	if (sscanf(dev, "ipc:%d:%s", &pid, tail) == 2) {
@@ -380,6 +443,7 @@ static int ipc_pktio_open(odp_pktio_t id ODP_UNUSED,
 
 		pinfo = odp_shm_addr(shm);
 		pinfo->master.init_done = 0;
+		pinfo->master.num_queues = 0;
 		pinfo->master.pool_name[0] = 0;
 		pktio_entry->s.ipc.pinfo = pinfo;
 		pktio_entry->s.ipc.pinfo_shm = shm;
@@ -390,7 +454,8 @@ static int ipc_pktio_open(odp_pktio_t id ODP_UNUSED,
 	return ret;
 }
 
-static void _ipc_free_ring_packets(pktio_entry_t *pktio_entry, _ring_t *r)
+static void _ipc_free_ring_packets(pktio_entry_t *pktio_entry, _ring_t *r,
+				   int mc)
 {
 	uintptr_t offsets[PKTIO_IPC_ENTRIES];
 	int ret;
@@ -408,8 +473,12 @@ static void _ipc_free_ring_packets(pktio_entry_t *pktio_entry, _ring_t *r)
 	rbuf_p = (void *)&offsets;
 
 	while (1) {
-		ret = _ring_mc_dequeue_burst(r, rbuf_p,
-					     PKTIO_IPC_ENTRIES);
+		if (mc)
+			ret = _ring_mc_dequeue_burst(r, rbuf_p,
+						     PKTIO_IPC_ENTRIES);
+		else
+			ret = _ring_sc_dequeue_burst(r, rbuf_p,
+						     PKTIO_IPC_ENTRIES);
 		if (ret <= 0)
 			break;
 		for (i = 0; i < ret; i++) {
@@ -424,7 +493,143 @@ static void _ipc_free_ring_packets(pktio_entry_t *pktio_entry, _ring_t *r)
 	}
 }
 
-static int ipc_pktio_recv_lockless(pktio_entry_t *pktio_entry,
+/* Free packets the remote process has returned to a queue. Each queue ring is
+ * drained only by the sending thread of the queue. Queue 0 ring receives also
+ * packets freed by a zero-copy receiver from any thread, so every queue
+ * drains it with multi-consumer dequeue. */
+static void _ipc_free_tx_packets(pktio_entry_t *pktio_entry, int index)
+{
+	_ipc_pktio_t *ipc = &pktio_entry->s.ipc;
+
+	if (index)
+		_ipc_free_ring_packets(pktio_entry, ipc->tx[index].free, 0);
+
+	_ipc_free_ring_packets(pktio_entry, ipc->tx[0].free, 1);
+}
+
+/* Enqueue all offsets to the free ring of a queue, spin until the remote
+ * process makes room for them. Only the receiving thread of a queue
+ * produces to its ring, except that zero-copy packets are returned through
+ * queue 0 ring from any thread. */
+static void _ipc_ring_put_offsets(_ipc_pktio_t *ipc, int index,
+				  uintptr_t offsets[], int num)
+{
+	_ring_t *r = ipc->rx[index].free;
+	int mp = (index == 0 && ipc->remote_pool != NULL);
+	void **rbuf_p;
+	int done = 0;
+	int ret;
+
+	while (done < num) {
+		rbuf_p = (void *)&offsets[done];
+		if (mp)
+			ret = _ring_mp_enqueue_burst(r, rbuf_p, num - done);
+		else
+			ret = _ring_sp_enqueue_burst(r, rbuf_p, num - done);
+		if (odp_unlikely(ret < 0))
+			ODP_ABORT("ipc: odp_ring_enqueue_burst r_p fail\n");
+
+		if (odp_unlikely(ret != num - done)) {
+			IPC_ODP_DBG("odp_ring_full: %d, odp_ring_count %d,"
+				    " _ring_free_count %d\n",
+				    _ring_full(r), _ring_count(r),
+				    _ring_free_count(r));
+		}
+
+		done += ret;
+	}
+}
+
+/* Move pointers of a single segment packet header between address spaces
+ * of the remote and the local process. */
+static inline void _ipc_zc_rebase(odp_packet_hdr_t *phdr, uintptr_t delta)
+{
+	odp_buffer_hdr_t *buf_hdr = &phdr->buf_hdr;
+
+	buf_hdr->seg[0].hdr  = (void *)((uintptr_t)buf_hdr->seg[0].hdr +
+					delta);
+	buf_hdr->seg[0].data = (uint8_t *)((uintptr_t)buf_hdr->seg[0].data +
+					   delta);
+	buf_hdr->last_seg    = (void *)((uintptr_t)buf_hdr->last_seg + delta);
+	phdr->base_data      = (uint8_t *)((uintptr_t)phdr->base_data + delta);
+	phdr->buf_end        = (uint8_t *)((uintptr_t)phdr->buf_end + delta);
+}
+
+/* Take ownership of a packet in the remote pool without copying it */
+static inline odp_packet_t _ipc_zc_import(_ipc_pktio_t *ipc,
+					  odp_packet_hdr_t *phdr)
+{
+	odp_buffer_hdr_t *buf_hdr = &phdr->buf_hdr;
+
+	if (odp_unlikely(ipc->remote_pool_ptr == NULL))
+		ipc->remote_pool_ptr = buf_hdr->pool_ptr;
+
+	_ipc_zc_rebase(phdr, ipc->remote_delta);
+	buf_hdr->pool_ptr = ipc->remote_pool;
+
+	/* Remote user area is not mapped. Data offset is not needed anymore,
+	 * so it stores the remote pointer until the packet is returned. */
+	buf_hdr->ipc_data_offset = (uintptr_t)buf_hdr->uarea_addr;
+	buf_hdr->uarea_addr = NULL;
+
+	phdr->input = ODP_PKTIO_INVALID;
+
+	return packet_handle(phdr);
+}
+
+/* Return freed zero-copy packets to the remote process */
+static void _ipc_zc_free(void *pool, odp_buffer_hdr_t *buf_hdr[], int num)
+{
+	pktio_entry_t *pktio_entry = ((pool_t *)pool)->remote_ctx;
+	_ipc_pktio_t *ipc = &pktio_entry->s.ipc;
+	uintptr_t offsets[num];
+	int i;
+
+	for (i = 0; i < num; i++) {
+		odp_buffer_hdr_t *hdr = buf_hdr[i];
+
+		hdr->pool_ptr   = ipc->remote_pool_ptr;
+		hdr->uarea_addr = (void *)(uintptr_t)hdr->ipc_data_offset;
+		_ipc_zc_rebase((odp_packet_hdr_t *)hdr, -ipc->remote_delta);
+
+		offsets[i] = (uint8_t *)hdr - (uint8_t *)ipc->pool_mdata_base;
+	}
+
+	_ipc_ring_put_offsets(ipc, 0, offsets, num);
+}
+
+static int _ipc_zc_init(pktio_entry_t *pktio_entry, int num,
+			void *remote_base, uint32_t block_size,
+			uint32_t seg_len)
+{
+	_ipc_pktio_t *ipc = &pktio_entry->s.ipc;
+	char name[ODP_POOL_NAME_LEN];
+	pool_t *pool;
+
+	if (!ipc->zero_copy)
+		return 0;
+
+	snprintf(name, sizeof(name), "zc-%s", pktio_entry->s.name);
+	pool = pool_create_remote(name, ipc->pool, ipc->pool_mdata_base, num,
+				  block_size, seg_len, _ipc_zc_free,
+				  pktio_entry);
+	if (pool == NULL) {
+		ODP_ERR("%s: zero-copy disabled\n", pktio_entry->s.name);
+		ipc->zero_copy = 0;
+		return -1;
+	}
+
+	ipc->remote_pool = pool;
+	ipc->remote_pool_ptr = NULL;
+	ipc->remote_delta = (uintptr_t)ipc->pool_mdata_base -
+			    (uintptr_t)remote_base;
+
+	IPC_ODP_DBG("%s: zero-copy receive, remote pool %p mapped to %p\n",
+		    pktio_entry->s.name, remote_base, ipc->pool_mdata_base);
+	return 0;
+}
+
+static int ipc_pktio_recv_lockless(pktio_entry_t *pktio_entry, int index,
 				   odp_packet_t pkt_table[], int len)
 {
 	int pkts = 0;
@@ -435,6 +640,7 @@ static int ipc_pktio_recv_lockless(pktio_entry_t *pktio_entry,
 	void **ipcbufs_p = (void *)&offsets[0];
 	uint32_t ready;
 	int pkts_ring;
+	int num_free = 0;
 
 	ready = odp_atomic_load_u32(&pktio_entry->s.ipc.ready);
 	if (odp_unlikely(!ready)) {
@@ -442,19 +648,17 @@ static int ipc_pktio_recv_lockless(pktio_entry_t *pktio_entry,
 		return 0;
 	}
 
-	_ipc_free_ring_packets(pktio_entry, pktio_entry->s.ipc.tx.free);
-
 	/* rx from cache */
-	r = pktio_entry->s.ipc.rx.cache;
-	pkts = _ring_mc_dequeue_burst(r, ipcbufs_p, len);
+	r = pktio_entry->s.ipc.rx[index].cache;
+	pkts = _ring_sc_dequeue_burst(r, ipcbufs_p, len);
 	if (odp_unlikely(pkts < 0))
 		ODP_ABORT("internal error dequeue\n");
 
 	/* rx from other app */
 	if (pkts == 0) {
 		ipcbufs_p = (void *)&offsets[0];
-		r = pktio_entry->s.ipc.rx.recv;
-		pkts = _ring_mc_dequeue_burst(r, ipcbufs_p, len);
+		r = pktio_entry->s.ipc.rx[index].recv;
+		pkts = _ring_sc_dequeue_burst(r, ipcbufs_p, len);
 		if (odp_unlikely(pkts < 0))
 			ODP_ABORT("internal error dequeue\n");
 	}
@@ -478,6 +682,15 @@ static int ipc_pktio_recv_lockless(pktio_entry_t *pktio_entry,
 		if (odp_unlikely(pool == ODP_POOL_INVALID))
 			ODP_ABORT("invalid pool");
 
+		/* Single segment packets are passed by handle in zero-copy
+		 * mode. Remote process gets those back on free. */
+		if (pktio_entry->s.ipc.remote_pool &&
+		    phdr->buf_hdr.segcount == 1) {
+			pkt_table[i] = _ipc_zc_import(&pktio_entry->s.ipc,
+						      phdr);
+			continue;
+		}
+
 		data_pool_off = phdr->buf_hdr.ipc_data_offset;
 
 		pkt = odp_packet_alloc(pool, phdr->frame_len);
@@ -517,13 +730,16 @@ static int ipc_pktio_recv_lockless(pktio_entry_t *pktio_entry,
 		odp_packet_hdr(pkt)->p = phdr->p;
 
 		pkt_table[i] = pkt;
+
+		/* Copied packets are released immediately */
+		offsets[num_free++] = offsets[i];
 	}
 
 	/* put back to rx ring dequed but not processed packets*/
 	if (pkts != i) {
 		ipcbufs_p = (void *)&offsets[i];
-		r_p = pktio_entry->s.ipc.rx.cache;
-		pkts_ring = _ring_mp_enqueue_burst(r_p, ipcbufs_p, pkts - i);
+		r_p = pktio_entry->s.ipc.rx[index].cache;
+		pkts_ring = _ring_sp_enqueue_burst(r_p, ipcbufs_p, pkts - i);
 
 		if (pkts_ring != (pkts - i))
 			ODP_ABORT("bug to enqueue packets\n");
@@ -537,48 +753,34 @@ static int ipc_pktio_recv_lockless(pktio_entry_t *pktio_entry,
 	pkts = i;
 
 	/* Now tell other process that we no longer need that buffers.*/
-	r_p = pktio_entry->s.ipc.rx.free;
-
-repeat:
-
-	ipcbufs_p = (void *)&offsets[0];
-	pkts_ring = _ring_mp_enqueue_burst(r_p, ipcbufs_p, pkts);
-	if (odp_unlikely(pkts_ring < 0))
-		ODP_ABORT("ipc: odp_ring_mp_enqueue_bulk r_p fail\n");
-
-	for (i = 0; i < pkts; i++) {
+	for (i = 0; i < num_free; i++) {
 		IPC_ODP_DBG("%d/%d send to be free packet offset %x\n",
-			    i, pkts, offsets[i]);
+			    i, num_free, offsets[i]);
 	}
 
-	if (odp_unlikely(pkts != pkts_ring)) {
-		IPC_ODP_DBG("odp_ring_full: %d, odp_ring_count %d,"
-			    " _ring_free_count %d\n",
-			    _ring_full(r_p), _ring_count(r_p),
-			    _ring_free_count(r_p));
-		ipcbufs_p = (void *)&offsets[pkts_ring - 1];
-		pkts = pkts - pkts_ring;
-		goto repeat;
-	}
+	_ipc_ring_put_offsets(&pktio_entry->s.ipc, index, offsets, num_free);
 
 	return pkts;
 }
 
-static int ipc_pktio_recv(pktio_entry_t *pktio_entry, int index ODP_UNUSED,
+static int ipc_pktio_recv(pktio_entry_t *pktio_entry, int index,
 			  odp_packet_t pkt_table[], int len)
 {
+	_ipc_pktio_t *ipc = &pktio_entry->s.ipc;
 	int ret;
 
-	odp_ticketlock_lock(&pktio_entry->s.rxl);
+	if (!ipc->lockless_rx)
+		odp_ticketlock_lock(&ipc->rx[index].lock);
 
-	ret = ipc_pktio_recv_lockless(pktio_entry, pkt_table, len);
+	ret = ipc_pktio_recv_lockless(pktio_entry, index, pkt_table, len);
 
-	odp_ticketlock_unlock(&pktio_entry->s.rxl);
+	if (!ipc->lockless_rx)
+		odp_ticketlock_unlock(&ipc->rx[index].lock);
 
 	return ret;
 }
 
-static int ipc_pktio_send_lockless(pktio_entry_t *pktio_entry,
+static int ipc_pktio_send_lockless(pktio_entry_t *pktio_entry, int index,
 				   const odp_packet_t pkt_table[], int len)
 {
 	_ring_t *r;
@@ -589,11 +791,21 @@ static int ipc_pktio_send_lockless(pktio_entry_t *pktio_entry,
 	odp_packet_t pkt_table_mapped[len]; /**< Ready to send packet has to be
 					      * in memory mapped pool. */
 	uintptr_t offsets[len];
+	uint32_t free_cnt;
 
 	if (odp_unlikely(!ready))
 		return 0;
 
-	_ipc_free_ring_packets(pktio_entry, pktio_entry->s.ipc.tx.free);
+	_ipc_free_tx_packets(pktio_entry, index);
+
+	/* Send only as many packets as fit into the ring, so that the caller
+	 * keeps ownership of the rest. This thread is the only producer. */
+	free_cnt = _ring_free_count(pktio_entry->s.ipc.tx[index].send);
+	if (odp_unlikely(free_cnt < (uint32_t)len)) {
+		len = free_cnt;
+		if (len == 0)
+			return 0;
+	}
 
 	/* Copy packets to shm shared pool if they are in different
 	 * pool, or if they are references (we can't share across IPC).
@@ -649,10 +861,10 @@ static int ipc_pktio_send_lockless(pktio_entry_t *pktio_entry,
 
 	/* Put packets to ring to be processed by other process. */
 	rbuf_p = (void *)&offsets[0];
-	r = pktio_entry->s.ipc.tx.send;
-	ret = _ring_mp_enqueue_burst(r, rbuf_p, len);
+	r = pktio_entry->s.ipc.tx[index].send;
+	ret = _ring_sp_enqueue_burst(r, rbuf_p, len);
 	if (odp_unlikely(ret < 0)) {
-		ODP_ERR("pid %d odp_ring_mp_enqueue_bulk fail, ipc_slave %d, ret %d\n",
+		ODP_ERR("pid %d odp_ring_sp_enqueue_burst fail, ipc_slave %d, ret %d\n",
 			getpid(),
 			(PKTIO_TYPE_IPC_SLAVE == pktio_entry->s.ipc.type),
 			ret);
@@ -665,16 +877,19 @@ static int ipc_pktio_send_lockless(pktio_entry_t *pktio_entry,
 	return len;
 }
 
-static int ipc_pktio_send(pktio_entry_t *pktio_entry, int index ODP_UNUSED,
+static int ipc_pktio_send(pktio_entry_t *pktio_entry, int index,
 			  const odp_packet_t pkt_table[], int len)
 {
+	_ipc_pktio_t *ipc = &pktio_entry->s.ipc;
 	int ret;
 
-	odp_ticketlock_lock(&pktio_entry->s.txl);
+	if (!ipc->lockless_tx)
+		odp_ticketlock_lock(&ipc->tx[index].lock);
 
-	ret = ipc_pktio_send_lockless(pktio_entry, pkt_table, len);
+	ret = ipc_pktio_send_lockless(pktio_entry, index, pkt_table, len);
 
-	odp_ticketlock_unlock(&pktio_entry->s.txl);
+	if (!ipc->lockless_tx)
+		odp_ticketlock_unlock(&ipc->tx[index].lock);
 
 	return ret;
 }
@@ -707,24 +922,41 @@ static int ipc_start(pktio_entry_t *pktio_entry)
 		return _ipc_slave_start(pktio_entry);
 }
 
+/* Number of 1 ms waits for the remote process to consume send rings on stop */
+#define IPC_STOP_WAIT_MS 1000
+
 static int ipc_stop(pktio_entry_t *pktio_entry)
 {
-	unsigned tx_send = 0, tx_free = 0;
+	_ipc_pktio_t *ipc = &pktio_entry->s.ipc;
+	unsigned tx_send, tx_free = 0;
+	int i, wait;
 
-	odp_atomic_store_u32(&pktio_entry->s.ipc.ready, 0);
+	odp_atomic_store_u32(&ipc->ready, 0);
 
-	if (pktio_entry->s.ipc.tx.send)
-		_ipc_free_ring_packets(pktio_entry, pktio_entry->s.ipc.tx.send);
-	/* other process can transfer packets from one ring to
-	 * other, use delay here to free that packets. */
-	sleep(1);
-	if (pktio_entry->s.ipc.tx.free)
-		_ipc_free_ring_packets(pktio_entry, pktio_entry->s.ipc.tx.free);
+	/* Send rings are consumed only by the remote process. Packets are not
+	 * taken back from those, but the remote process is given time to
+	 * consume them and return the packets through free rings. Free rings
+	 * are drained in the same consumer mode as on transmit. */
+	for (wait = 0; ; wait++) {
+		tx_send = 0;
 
-	if (pktio_entry->s.ipc.tx.send)
-		tx_send = _ring_count(pktio_entry->s.ipc.tx.send);
-	if (pktio_entry->s.ipc.tx.free)
-		tx_free = _ring_count(pktio_entry->s.ipc.tx.free);
+		for (i = 0; i < ipc->num_queues; i++) {
+			_ipc_free_tx_packets(pktio_entry, i);
+
+			if (ipc->tx[i].send)
+				tx_send += _ring_count(ipc->tx[i].send);
+		}
+
+		if (tx_send == 0 || wait == IPC_STOP_WAIT_MS)
+			break;
+
+		usleep(1000);
+	}
+
+	for (i = 0; i < ipc->num_queues; i++) {
+		if (ipc->tx[i].free)
+			tx_free += _ring_count(ipc->tx[i].free);
+	}
 	if (tx_send | tx_free) {
 		ODP_DBG("IPC rings: tx send %d tx free %d\n",
 			tx_send, tx_free);
@@ -735,15 +967,22 @@ static int ipc_stop(pktio_entry_t *pktio_entry)
 
 static int ipc_close(pktio_entry_t *pktio_entry)
 {
-	char ipc_shm_name[ODP_POOL_NAME_LEN + sizeof("_m_prod")];
+	_ipc_pktio_t *ipc = &pktio_entry->s.ipc;
 	char *dev = pktio_entry->s.name;
 	char name[ODP_POOL_NAME_LEN];
 	char tail[ODP_POOL_NAME_LEN];
 	int pid = 0;
+	int i;
 
 	ipc_stop(pktio_entry);
 
-	odp_shm_free(pktio_entry->s.ipc.remote_pool_shm);
+	/* All zero-copy packets must have been freed by now */
+	if (ipc->remote_pool) {
+		pool_destroy_remote(ipc->remote_pool);
+		ipc->remote_pool = NULL;
+	}
+
+	odp_shm_free(ipc->remote_pool_shm);
 
 	if (sscanf(dev, "ipc:%d:%s", &pid, tail) == 2)
 		snprintf(name, sizeof(name), "ipc:%s", tail);
@@ -751,22 +990,107 @@ static int ipc_close(pktio_entry_t *pktio_entry)
 		snprintf(name, sizeof(name), "%s", dev);
 
 	/* unlink this pktio info for both master and slave */
-	odp_shm_free(pktio_entry->s.ipc.pinfo_shm);
+	odp_shm_free(ipc->pinfo_shm);
 
 	/* destroy rings */
-	snprintf(ipc_shm_name, sizeof(ipc_shm_name), "%s_s_cons", name);
-	_ring_destroy(ipc_shm_name);
-	snprintf(ipc_shm_name, sizeof(ipc_shm_name), "%s_s_prod", name);
-	_ring_destroy(ipc_shm_name);
-	snprintf(ipc_shm_name, sizeof(ipc_shm_name), "%s_m_cons", name);
-	_ring_destroy(ipc_shm_name);
-	snprintf(ipc_shm_name, sizeof(ipc_shm_name), "%s_m_prod", name);
-	_ring_destroy(ipc_shm_name);
-	_ring_destroy("ipc_rx_cache");
+	for (i = 0; i < ipc->num_queues; i++)
+		_ipc_rings_destroy(name, i);
+
+	for (i = 0; i < ipc->num_cache; i++) {
+		_ipc_cache_name(name, sizeof(name), pktio_entry, i);
+		_ring_destroy(name);
+	}
+
+	ipc->num_queues = 0;
+	ipc->num_cache = 0;
+
+	return 0;
+}
+
+static int ipc_capability(pktio_entry_t *pktio_entry ODP_UNUSED,
+			  odp_pktio_capability_t *capa)
+{
+	memset(capa, 0, sizeof(odp_pktio_capability_t));
+
+	capa->max_input_queues  = PKTIO_IPC_QUEUES_MAX;
+	capa->max_output_queues = PKTIO_IPC_QUEUES_MAX;
+	capa->set_op.op.promisc_mode = 1;
+	capa->config.pktin.bit.zero_copy = 1;
+
+	return 0;
+}
+
+static int ipc_config(pktio_entry_t *pktio_entry,
+		      const odp_pktio_config_t *config)
+{
+	/* Zero-copy receive keeps packets in the remote pool until freed */
+	pktio_entry->s.ipc.zero_copy = config->pktin.bit.zero_copy;
+
+	return 0;
+}
+
+/* Create local rx caches and, on master side, shared rings for all
+ * configured queues. Slave maps the shared rings on start. */
+static int _ipc_queues_config(pktio_entry_t *pktio_entry)
+{
+	_ipc_pktio_t *ipc = &pktio_entry->s.ipc;
+	struct pktio_info *pinfo = ipc->pinfo;
+	char name[ODP_POOL_NAME_LEN];
+	int num_queues = _ipc_num_queues(pktio_entry);
+	int i;
+
+	for (i = ipc->num_cache; i < (int)pktio_entry->s.num_in_queue; i++) {
+		_ipc_cache_name(name, sizeof(name), pktio_entry, i);
+		ipc->rx[i].cache = _ring_create(name, PKTIO_IPC_ENTRIES,
+						_RING_NO_LIST);
+		if (!ipc->rx[i].cache) {
+			ODP_ERR("unable to create ipc rx cache %s\n", name);
+			return -1;
+		}
+		ipc->num_cache = i + 1;
+	}
+
+	if (ipc->type != PKTIO_TYPE_IPC_MASTER)
+		return 0;
+
+	for (i = ipc->num_queues; i < num_queues; i++) {
+		if (_ipc_master_rings_create(pktio_entry, pktio_entry->s.name,
+					     i))
+			return -1;
+		ipc->num_queues = i + 1;
+	}
+
+	/* Rings must be visible before slave looks them up */
+	odp_mb_release();
+	pinfo->master.num_queues = ipc->num_queues;
 
 	return 0;
 }
 
+static int ipc_input_queues_config(pktio_entry_t *pktio_entry,
+				   const odp_pktin_queue_param_t *p)
+{
+	odp_pktin_mode_t mode = pktio_entry->s.param.in_mode;
+
+	/* Scheduler synchronizes input queue polls. Only single thread
+	 * at a time polls a queue */
+	if (mode == ODP_PKTIN_MODE_SCHED)
+		pktio_entry->s.ipc.lockless_rx = 1;
+	else
+		pktio_entry->s.ipc.lockless_rx =
+			(p->op_mode == ODP_PKTIO_OP_MT_UNSAFE);
+
+	return _ipc_queues_config(pktio_entry);
+}
+
+static int ipc_output_queues_config(pktio_entry_t *pktio_entry,
+				    const odp_pktout_queue_param_t *p)
+{
+	pktio_entry->s.ipc.lockless_tx = (p->op_mode == ODP_PKTIO_OP_MT_UNSAFE);
+
+	return _ipc_queues_config(pktio_entry);
+}
+
 static int ipc_pktio_init_global(void)
 {
 	_ring_tailq_init();
@@ -792,5 +1116,8 @@ const pktio_if_ops_t ipc_pktio_ops = {
 	.mac_get = ipc_mac_addr_get,
 	.pktin_ts_res = NULL,
 	.pktin_ts_from_ns = NULL,
-	.config = NULL
+	.capability = ipc_capability,
+	.config = ipc_config,
+	.input_queues_config = ipc_input_queues_config,
+	.output_queues_config = ipc_output_queues_config
 };
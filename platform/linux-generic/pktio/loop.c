@@ -128,9 +128,6 @@ static int loopback_recv(pktio_entry_t *pktio_entry, int index ODP_UNUSED,
 				}
 				pkt = new_pkt;
 			}
-		} else {
-			packet_parse_layer(pkt_hdr,
-					   pktio_entry->s.config.parser.layer);
 		}
 
 		packet_set_ts(pkt_hdr, ts);
@@ -139,6 +136,10 @@ static int loopback_recv(pktio_entry_t *pktio_entry, int index ODP_UNUSED,
 		pkts[num_rx++] = pkt;
 	}
 
+	if (!pktio_cls_enabled(pktio_entry))
+		packet_parse_layer_multi(pkts, num_rx,
+					 pktio_entry->s.config.parser.layer);
+
 	pktio_entry->s.stats.in_errors += failed;
 	pktio_entry->s.stats.in_ucast_pkts += num_rx - failed;
 
@@ -351,7 +351,7 @@ static int netmap_open(odp_pktio_t id ODP_UNUSED, pktio_entry_t *pktio_entry,
 	pkt_nm->pool = pool;
 
 	/* max frame len taking into account the l2-offset */
-	pkt_nm->max_frame_len = pool_entry_from_hdl(pool)->max_len;
+	pkt_nm->max_frame_len = pool_max_len(pool_entry_from_hdl(pool));
 
 	/* allow interface to be opened with or without the 'netmap:' prefix */
 	prefix = "netmap:";
@@ -646,14 +646,14 @@ static inline int netmap_pkt_to_odp(pktio_entry_t *pktio_entry,
 		if (odp_unlikely(len > pktio_entry->s.pkt_nm.max_frame_len)) {
 			ODP_ERR("RX: frame too big %" PRIu16 " %zu!\n", len,
 				pktio_entry->s.pkt_nm.max_frame_len);
-			goto fail;
+			break;
 		}
 
 		if (pktio_cls_enabled(pktio_entry)) {
 			if (cls_classify_packet(pktio_entry,
 						(const uint8_t *)slot.buf, len,
 						len, &pool, &parsed_hdr))
-				goto fail;
+				break;
 		}
 
 		pkt = pkt_tbl[i];
@@ -663,23 +663,23 @@ static inline int netmap_pkt_to_odp(pktio_entry_t *pktio_entry,
 		/* For now copy the data in the mbuf,
 		   worry about zero-copy later */
 		if (odp_packet_copy_from_mem(pkt, 0, len, slot.buf) != 0)
-			goto fail;
+			break;
 
 		pkt_hdr->input = pktio_entry->s.handle;
 
 		if (pktio_cls_enabled(pktio_entry))
 			copy_packet_cls_metadata(&parsed_hdr, pkt_hdr);
-		else
-			packet_parse_layer(pkt_hdr,
-					   pktio_entry->s.config.parser.layer);
 
 		packet_set_ts(pkt_hdr, ts);
 	}
 
-	return i;
+	if (odp_unlikely(i < num))
+		odp_packet_free_multi(&pkt_tbl[i], num - i);
+
+	if (!pktio_cls_enabled(pktio_entry))
+		packet_parse_layer_multi(pkt_tbl, i,
+					 pktio_entry->s.config.parser.layer);
 
-fail:
-	odp_packet_free_multi(&pkt_tbl[i], num - i);
 	return i;
 }
 
@@ -254,8 +254,6 @@ static int pcapif_recv_pkt(pktio_entry_t *pktio_entry, int index ODP_UNUSED,
 			break;
 		}
 
-		packet_parse_layer(pkt_hdr,
-				   pktio_entry->s.config.parser.layer);
 		pktio_entry->s.stats.in_octets += pkt_hdr->frame_len;
 
 		packet_set_ts(pkt_hdr, ts);
@@ -267,6 +265,8 @@ static int pcapif_recv_pkt(pktio_entry_t *pktio_entry, int index ODP_UNUSED,
 	}
 	pktio_entry->s.stats.in_ucast_pkts += i;
 
+	packet_parse_layer_multi(pkts, i, pktio_entry->s.config.parser.layer);
+
 	odp_ticketlock_unlock(&pktio_entry->s.rxl);
 
 	return i;
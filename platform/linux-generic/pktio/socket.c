@@ -672,18 +672,16 @@ static int sock_mmsg_recv(pktio_entry_t *pktio_entry, int index ODP_UNUSED,
 			continue;
 		}
 
-		pkt_hdr->input = pktio_entry->s.handle;
-
-		if (!pktio_cls_enabled(pktio_entry))
-			packet_parse_layer(pkt_hdr,
-					   pktio_entry->s.config.parser.layer);
-
 		pkt_hdr->input = pktio_entry->s.handle;
 		packet_set_ts(pkt_hdr, ts);
 
 		pkt_table[nb_rx++] = pkt;
 	}
 
+	if (!pktio_cls_enabled(pktio_entry))
+		packet_parse_layer_multi(pkt_table, nb_rx,
+					 pktio_entry->s.config.parser.layer);
+
 	/* Free unused pkt buffers */
 	for (; i < nb_pkts; i++)
 		odp_packet_free(pkt_table[i]);
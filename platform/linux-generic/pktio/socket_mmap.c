@@ -232,9 +232,6 @@ static inline unsigned pkt_mmap_v2_rx(pktio_entry_t *pktio_entry,
 
 		if (pktio_cls_enabled(pktio_entry))
 			copy_packet_cls_metadata(&parsed_hdr, hdr);
-		else
-			packet_parse_layer(hdr,
-					   pktio_entry->s.config.parser.layer);
 
 		packet_set_ts(hdr, ts);
 
@@ -245,6 +242,11 @@ static inline unsigned pkt_mmap_v2_rx(pktio_entry_t *pktio_entry,
 	}
 
 	ring->frame_num = frame_num;
+
+	if (!pktio_cls_enabled(pktio_entry))
+		packet_parse_layer_multi(pkt_table, nb_rx,
+					 pktio_entry->s.config.parser.layer);
+
 	return nb_rx;
 }
 
@@ -214,9 +214,6 @@ static odp_packet_t pack_odp_pkt(pktio_entry_t *pktio_entry, const void *data,
 
 	if (pktio_cls_enabled(pktio_entry))
 		copy_packet_cls_metadata(&parsed_hdr, pkt_hdr);
-	else
-		packet_parse_layer(pkt_hdr,
-				   pktio_entry->s.config.parser.layer);
 
 	packet_set_ts(pkt_hdr, ts);
 	pkt_hdr->input = pktio_entry->s.handle;
@@ -258,6 +255,10 @@ static int tap_pktio_recv(pktio_entry_t *pktio_entry, int index ODP_UNUSED,
 			break;
 	}
 
+	if (!pktio_cls_enabled(pktio_entry))
+		packet_parse_layer_multi(pkts, i,
+					 pktio_entry->s.config.parser.layer);
+
 	odp_ticketlock_unlock(&pktio_entry->s.rxl);
 
 	return i;
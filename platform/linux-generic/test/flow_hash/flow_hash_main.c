@@ -0,0 +1,445 @@
+/* Copyright (c) 2017, Linaro Limited
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier:     BSD-3-Clause
+ */
+
+#include "config.h"
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <arpa/inet.h>
+
+#include <odp_api.h>
+#include <odp/helper/odph_api.h>
+#include <test_debug.h>
+#include <odp_cunit_common.h>
+#include <odp_packet_flow_hash_internal.h>
+
+#define PKT_LEN     128
+#define NUM_PKT     64
+#define NUM_FLOWS   32
+#define NUM_QUEUES  4
+#define RECV_ROUNDS 1000
+
+/* Test vectors of the Microsoft RSS specification ("Verifying the RSS Hash
+ * Calculation"), which are computed with the default key */
+typedef struct {
+	const char *dst;
+	const char *src;
+	uint16_t dst_port;
+	uint16_t src_port;
+	uint32_t hash_ip;
+	uint32_t hash_ip_port;
+} rss_vector_t;
+
+static const rss_vector_t rss_ipv4[] = {
+	{"161.142.100.80", "66.9.149.187", 1766, 2794,
+	 0x323e8fc2, 0x51ccc178},
+	{"65.69.140.83", "199.92.111.2", 4739, 14230,
+	 0xd718262a, 0xc626b0ea},
+	{"12.22.207.184", "24.19.198.95", 38024, 12898,
+	 0xd2d0a5de, 0x5c2b394a},
+	{"209.142.163.6", "38.27.205.30", 2217, 48228,
+	 0x82989176, 0xafc7327f},
+	{"202.188.127.2", "153.39.163.191", 1303, 44251,
+	 0x5d1809c5, 0x10e828a2}
+};
+
+static const rss_vector_t rss_ipv6[] = {
+	{"3ffe:2501:200:3::1", "3ffe:2501:200:1fff::7", 1766, 2794,
+	 0x2cc18cd5, 0x40207d3d},
+	{"ff02::1", "3ffe:501:8::260:97ff:fe40:efab", 4739, 14230,
+	 0x0f0c461c, 0xdde51bbf},
+	{"fe80::200:f8ff:fe21:67cf", "3ffe:1900:4545:3:200:f8ff:fe21:67cf",
+	 38024, 44251, 0x4b61e985, 0x02d1feef}
+};
+
+#define NUM_IPV4 (sizeof(rss_ipv4) / sizeof(rss_ipv4[0]))
+#define NUM_IPV6 (sizeof(rss_ipv6) / sizeof(rss_ipv6[0]))
+
+static flow_hash_global_t flow_hash;
+static odp_pool_t pool;
+
+/* Build an Ethernet/IP/TCP or UDP packet from a test vector. Returns
+ * the hash input (addresses and ports) in 'tuple'. */
+static odp_packet_t build_packet(const rss_vector_t *v, int ipv6, int udp,
+				 uint8_t tuple[], int *tuple_len)
+{
+	odp_packet_t pkt;
+	odph_ethhdr_t *eth;
+	uint8_t *l4;
+	uint32_t l3_len = ipv6 ? ODPH_IPV6HDR_LEN : ODPH_IPV4HDR_LEN;
+	uint32_t l4_len = PKT_LEN - ODPH_ETHHDR_LEN - l3_len;
+	uint8_t proto = udp ? ODPH_IPPROTO_UDP : ODPH_IPPROTO_TCP;
+	int addr_len = ipv6 ? 16 : 4;
+	uint16_t port;
+
+	pkt = odp_packet_alloc(pool, PKT_LEN);
+	if (pkt == ODP_PACKET_INVALID)
+		return pkt;
+
+	eth = odp_packet_data(pkt);
+	memset(eth, 0, PKT_LEN);
+	eth->type = odp_cpu_to_be_16(ipv6 ? ODPH_ETHTYPE_IPV6 :
+				     ODPH_ETHTYPE_IPV4);
+
+	if (ipv6) {
+		odph_ipv6hdr_t *ip = (odph_ipv6hdr_t *)(eth + 1);
+
+		ip->ver_tc_flow = odp_cpu_to_be_32(0x60000000);
+		ip->payload_len = odp_cpu_to_be_16(l4_len);
+		ip->next_hdr    = proto;
+		ip->hop_limit   = 64;
+		inet_pton(AF_INET6, v->src, ip->src_addr);
+		inet_pton(AF_INET6, v->dst, ip->dst_addr);
+		memcpy(tuple, ip->src_addr, 16);
+		memcpy(&tuple[16], ip->dst_addr, 16);
+	} else {
+		odph_ipv4hdr_t *ip = (odph_ipv4hdr_t *)(eth + 1);
+
+		ip->ver_ihl = ODPH_IPV4 << 4 | ODPH_IPV4HDR_IHL_MIN;
+		ip->tot_len = odp_cpu_to_be_16(l3_len + l4_len);
+		ip->ttl     = 64;
+		ip->proto   = proto;
+		inet_pton(AF_INET, v->src, &ip->src_addr);
+		inet_pton(AF_INET, v->dst, &ip->dst_addr);
+		memcpy(tuple, &ip->src_addr, 4);
+		memcpy(&tuple[4], &ip->dst_addr, 4);
+	}
+
+	l4 = (uint8_t *)(eth + 1) + l3_len;
+
+	if (udp) {
+		odph_udphdr_t *udph = (odph_udphdr_t *)l4;
+
+		udph->src_port = odp_cpu_to_be_16(v->src_port);
+		udph->dst_port = odp_cpu_to_be_16(v->dst_port);
+		udph->length   = odp_cpu_to_be_16(l4_len);
+	} else {
+		odph_tcphdr_t *tcph = (odph_tcphdr_t *)l4;
+
+		tcph->src_port = odp_cpu_to_be_16(v->src_port);
+		tcph->dst_port = odp_cpu_to_be_16(v->dst_port);
+		tcph->hl       = ODPH_TCPHDR_LEN / 4;
+	}
+
+	port = odp_cpu_to_be_16(v->src_port);
+	memcpy(&tuple[2 * addr_len], &port, 2);
+	port = odp_cpu_to_be_16(v->dst_port);
+	memcpy(&tuple[2 * addr_len + 2], &port, 2);
+	*tuple_len = 2 * addr_len + 4;
+
+	if (!ipv6) {
+		odp_packet_l3_offset_set(pkt, ODPH_ETHHDR_LEN);
+		odph_ipv4_csum_update(pkt);
+	}
+
+	return pkt;
+}
+
+static odp_packet_t parsed_packet(const rss_vector_t *v, int ipv6,
+				  uint8_t tuple[], int *tuple_len)
+{
+	odp_packet_parse_param_t param;
+	odp_packet_t pkt;
+
+	pkt = build_packet(v, ipv6, 0, tuple, tuple_len);
+	CU_ASSERT_FATAL(pkt != ODP_PACKET_INVALID);
+
+	param.proto      = ODP_PROTO_ETH;
+	param.last_layer = ODP_PROTO_LAYER_ALL;
+	CU_ASSERT_FATAL(odp_packet_parse(pkt, 0, &param) == 0);
+	CU_ASSERT(odp_packet_has_tcp(pkt));
+
+	return pkt;
+}
+
+/* Hash a packet with only the given protocol bits enabled */
+static int hash_packet(odp_packet_t pkt, flow_hash_alg_t alg,
+		       uint32_t proto_bits, uint32_t *hash)
+{
+	odp_pktin_hash_proto_t proto;
+
+	proto.all_bits = proto_bits;
+	odp_packet_has_flow_hash_clr(pkt);
+
+	_odp_flow_hash_packets(&flow_hash, alg, &proto, &pkt, 1);
+
+	if (!odp_packet_has_flow_hash(pkt))
+		return -1;
+
+	*hash = odp_packet_flow_hash(pkt);
+	return 0;
+}
+
+static void test_toeplitz(const rss_vector_t vec[], int num, int ipv6)
+{
+	odp_pktin_hash_proto_t ip, ip_port;
+	uint8_t tuple[FLOW_HASH_INPUT_MAX];
+	uint32_t hash;
+	int i, len;
+
+	ip.all_bits = 0;
+	ip_port.all_bits = 0;
+
+	if (ipv6) {
+		ip.proto.ipv6 = 1;
+		ip_port.proto.ipv6_tcp = 1;
+	} else {
+		ip.proto.ipv4 = 1;
+		ip_port.proto.ipv4_tcp = 1;
+	}
+
+	for (i = 0; i < num; i++) {
+		odp_packet_t pkt = parsed_packet(&vec[i], ipv6, tuple, &len);
+
+		CU_ASSERT(hash_packet(pkt, FLOW_HASH_TOEPLITZ, ip.all_bits,
+				      &hash) == 0);
+		CU_ASSERT(hash == vec[i].hash_ip);
+
+		CU_ASSERT(hash_packet(pkt, FLOW_HASH_TOEPLITZ,
+				      ip_port.all_bits, &hash) == 0);
+		CU_ASSERT(hash == vec[i].hash_ip_port);
+
+		/* UDP ports are not included when only TCP is selected */
+		ip_port.proto.ipv4_udp = 1;
+		ip_port.proto.ipv6_udp = 1;
+		CU_ASSERT(hash_packet(pkt, FLOW_HASH_TOEPLITZ,
+				      ip_port.all_bits, &hash) == 0);
+		CU_ASSERT(hash == vec[i].hash_ip_port);
+		ip_port.proto.ipv4_udp = 0;
+		ip_port.proto.ipv6_udp = 0;
+
+		odp_packet_free(pkt);
+	}
+}
+
+static void flow_hash_test_toeplitz_ipv4(void)
+{
+	test_toeplitz(rss_ipv4, NUM_IPV4, 0);
+}
+
+static void flow_hash_test_toeplitz_ipv6(void)
+{
+	test_toeplitz(rss_ipv6, NUM_IPV6, 1);
+}
+
+static void flow_hash_test_not_selected(void)
+{
+	odp_pktin_hash_proto_t proto;
+	uint8_t tuple[FLOW_HASH_INPUT_MAX];
+	odp_packet_t pkt;
+	uint32_t hash;
+	int len;
+
+	/* IPv6 protocol bits do not select IPv4 packets */
+	pkt = parsed_packet(&rss_ipv4[0], 0, tuple, &len);
+	proto.all_bits = 0;
+	proto.proto.ipv6 = 1;
+	proto.proto.ipv6_tcp = 1;
+	CU_ASSERT(hash_packet(pkt, FLOW_HASH_TOEPLITZ, proto.all_bits,
+			      &hash) < 0);
+
+	/* An existing hash is not overwritten */
+	odp_packet_flow_hash_set(pkt, 0x12345678);
+	proto.proto.ipv4 = 1;
+	_odp_flow_hash_packets(&flow_hash, FLOW_HASH_TOEPLITZ, &proto,
+			       &pkt, 1);
+	CU_ASSERT(odp_packet_flow_hash(pkt) == 0x12345678);
+
+	odp_packet_free(pkt);
+}
+
+static void test_crc32c(const rss_vector_t vec[], int num, int ipv6)
+{
+	odp_pktin_hash_proto_t ip, ip_port;
+	uint8_t tuple[FLOW_HASH_INPUT_MAX];
+	uint32_t hash, init;
+	int i, len;
+
+	/* CRC is initialized with the first four key bytes */
+	memcpy(&init, flow_hash.key, sizeof(init));
+
+	ip.all_bits = 0;
+	ip_port.all_bits = 0;
+
+	if (ipv6) {
+		ip.proto.ipv6 = 1;
+		ip_port.proto.ipv6_tcp = 1;
+	} else {
+		ip.proto.ipv4 = 1;
+		ip_port.proto.ipv4_tcp = 1;
+	}
+
+	for (i = 0; i < num; i++) {
+		odp_packet_t pkt = parsed_packet(&vec[i], ipv6, tuple, &len);
+
+		CU_ASSERT(hash_packet(pkt, FLOW_HASH_CRC32C, ip.all_bits,
+				      &hash) == 0);
+		CU_ASSERT(hash == odp_hash_crc32c(tuple, len - 4, init));
+
+		CU_ASSERT(hash_packet(pkt, FLOW_HASH_CRC32C, ip_port.all_bits,
+				      &hash) == 0);
+		CU_ASSERT(hash == odp_hash_crc32c(tuple, len, init));
+
+		odp_packet_free(pkt);
+	}
+}
+
+static void flow_hash_test_crc32c(void)
+{
+	test_crc32c(rss_ipv4, NUM_IPV4, 0);
+	test_crc32c(rss_ipv6, NUM_IPV6, 1);
+}
+
+/* Loop pktio has a single driver queue. When more pktin queues are
+ * requested, packets are spread over them by flow hash. */
+static void flow_hash_test_spread(void)
+{
+	odp_pktio_param_t pktio_param;
+	odp_pktin_queue_param_t pktin_param;
+	odp_pktio_capability_t capa;
+	odp_queue_t queue[NUM_QUEUES];
+	odp_pktout_queue_t pktout;
+	odp_packet_t pkt[NUM_PKT];
+	uint8_t tuple[FLOW_HASH_INPUT_MAX];
+	int num_queue[NUM_QUEUES];
+	int i, ret, len, used, num_recv, round;
+	odp_pktio_t pktio;
+
+	odp_pktio_param_init(&pktio_param);
+	pktio_param.in_mode  = ODP_PKTIN_MODE_QUEUE;
+	pktio_param.out_mode = ODP_PKTOUT_MODE_DIRECT;
+
+	pktio = odp_pktio_open("loop", pool, &pktio_param);
+	CU_ASSERT_FATAL(pktio != ODP_PKTIO_INVALID);
+
+	CU_ASSERT_FATAL(odp_pktio_capability(pktio, &capa) == 0);
+	CU_ASSERT_FATAL(capa.max_input_queues >= NUM_QUEUES);
+
+	odp_pktin_queue_param_init(&pktin_param);
+	pktin_param.num_queues  = NUM_QUEUES;
+	pktin_param.hash_enable = 1;
+	pktin_param.hash_proto.proto.ipv4_udp = 1;
+
+	CU_ASSERT_FATAL(odp_pktin_queue_config(pktio, &pktin_param) == 0);
+	CU_ASSERT_FATAL(odp_pktout_queue_config(pktio, NULL) == 0);
+	CU_ASSERT_FATAL(odp_pktin_event_queue(pktio, queue, NUM_QUEUES) ==
+			NUM_QUEUES);
+	CU_ASSERT_FATAL(odp_pktout_queue(pktio, &pktout, 1) == 1);
+	CU_ASSERT_FATAL(odp_pktio_start(pktio) == 0);
+
+	/* Each flow is sent twice */
+	for (i = 0; i < NUM_PKT; i++) {
+		rss_vector_t v = rss_ipv4[0];
+
+		v.src_port = 1000 + (i % NUM_FLOWS);
+		pkt[i] = build_packet(&v, 0, 1, tuple, &len);
+		CU_ASSERT_FATAL(pkt[i] != ODP_PACKET_INVALID);
+	}
+
+	for (i = 0; i < NUM_PKT; i += ret) {
+		ret = odp_pktout_send(pktout, &pkt[i], NUM_PKT - i);
+		CU_ASSERT_FATAL(ret > 0);
+	}
+
+	memset(num_queue, 0, sizeof(num_queue));
+	num_recv = 0;
+
+	for (round = 0; round < RECV_ROUNDS && num_recv < NUM_PKT; round++) {
+		for (i = 0; i < NUM_QUEUES; i++) {
+			odp_event_t ev;
+			odp_packet_t p;
+
+			while ((ev = odp_queue_deq(queue[i])) !=
+			       ODP_EVENT_INVALID) {
+				CU_ASSERT(odp_event_type(ev) ==
+					  ODP_EVENT_PACKET);
+				p = odp_packet_from_event(ev);
+
+				CU_ASSERT(odp_packet_has_flow_hash(p));
+				CU_ASSERT(odp_packet_flow_hash(p) %
+					  NUM_QUEUES == (uint32_t)i);
+
+				num_queue[i]++;
+				num_recv++;
+				odp_packet_free(p);
+			}
+		}
+	}
+
+	CU_ASSERT(num_recv == NUM_PKT);
+
+	used = 0;
+	for (i = 0; i < NUM_QUEUES; i++)
+		if (num_queue[i])
+			used++;
+
+	CU_ASSERT(used > 1);
+
+	CU_ASSERT(odp_pktio_stop(pktio) == 0);
+	CU_ASSERT(odp_pktio_close(pktio) == 0);
+}
+
+static int flow_hash_suite_init(void)
+{
+	odp_pool_param_t params;
+
+	odp_pool_param_init(&params);
+	params.type        = ODP_POOL_PACKET;
+	params.pkt.num     = 2 * NUM_PKT;
+	params.pkt.len     = PKT_LEN;
+	params.pkt.seg_len = PKT_LEN;
+
+	pool = odp_pool_create("flow_hash_pool", &params);
+	if (pool == ODP_POOL_INVALID)
+		return -1;
+
+	/* Default key and algorithm selection */
+	unsetenv("ODP_PKTIO_FLOW_HASH_KEY");
+	unsetenv("ODP_PKTIO_FLOW_HASH");
+	_odp_flow_hash_init(&flow_hash);
+
+	return 0;
+}
+
+static int flow_hash_suite_term(void)
+{
+	if (odp_pool_destroy(pool))
+		return -1;
+
+	return 0;
+}
+
+static odp_testinfo_t flow_hash_suite[] = {
+	ODP_TEST_INFO(flow_hash_test_toeplitz_ipv4),
+	ODP_TEST_INFO(flow_hash_test_toeplitz_ipv6),
+	ODP_TEST_INFO(flow_hash_test_not_selected),
+	ODP_TEST_INFO(flow_hash_test_crc32c),
+	ODP_TEST_INFO(flow_hash_test_spread),
+	ODP_TEST_INFO_NULL,
+};
+
+static odp_suiteinfo_t flow_hash_suites[] = {
+	{"flow hash", flow_hash_suite_init, flow_hash_suite_term,
+		flow_hash_suite},
+	ODP_SUITE_INFO_NULL
+};
+
+int main(int argc, char *argv[])
+{
+	int ret;
+
+	/* let helper collect its own arguments (e.g. --odph_proc) */
+	if (odp_cunit_parse_options(argc, argv))
+		return -1;
+
+	ret = odp_cunit_register(flow_hash_suites);
+
+	if (ret == 0)
+		ret = odp_cunit_run();
+
+	return ret;
+}
@@ -12,6 +12,10 @@
 int run_time_sec;
 /** Pid of the master process */
 int master_pid;
+/** Number of pktin and pktout queues */
+int num_queues;
+/** Enable zero-copy packet input */
+int zero_copy;
 
 int ipc_odp_packet_send_or_free(odp_pktio_t pktio,
 				odp_packet_t pkt_tbl[], int num)
@@ -58,6 +62,9 @@ int ipc_odp_packet_send_or_free(odp_pktio_t pktio,
 odp_pktio_t create_pktio(odp_pool_t pool, int master_pid)
 {
 	odp_pktio_param_t pktio_param;
+	odp_pktio_config_t config;
+	odp_pktin_queue_param_t pktin_param;
+	odp_pktout_queue_param_t pktout_param;
 	odp_pktio_t ipc_pktio;
 	char name[30];
 
@@ -75,12 +82,30 @@ odp_pktio_t create_pktio(odp_pool_t pool, int master_pid)
 		return ODP_PKTIO_INVALID;
 	}
 
-	if (odp_pktin_queue_config(ipc_pktio, NULL)) {
+	odp_pktio_config_init(&config);
+	config.pktin.bit.zero_copy = zero_copy;
+
+	if (odp_pktio_config(ipc_pktio, &config)) {
+		LOG_ERR("Error: ipc pktio %s config failed.\n", name);
+		odp_pktio_close(ipc_pktio);
+		return ODP_PKTIO_INVALID;
+	}
+
+	/* Each queue is used by a single thread */
+	odp_pktin_queue_param_init(&pktin_param);
+	pktin_param.op_mode = ODP_PKTIO_OP_MT_UNSAFE;
+	pktin_param.num_queues = num_queues;
+
+	odp_pktout_queue_param_init(&pktout_param);
+	pktout_param.op_mode = ODP_PKTIO_OP_MT_UNSAFE;
+	pktout_param.num_queues = num_queues;
+
+	if (odp_pktin_queue_config(ipc_pktio, &pktin_param)) {
 		LOG_ERR("Input queue config failed\n");
 		return ODP_PKTIO_INVALID;
 	}
 
-	if (odp_pktout_queue_config(ipc_pktio, NULL)) {
+	if (odp_pktout_queue_config(ipc_pktio, &pktout_param)) {
 		LOG_ERR("Output queue config failed\n");
 		return ODP_PKTIO_INVALID;
 	}
@@ -102,15 +127,19 @@ void parse_args(int argc, char *argv[])
 	static struct option longopts[] = {
 		{"time", required_argument, NULL, 't'},
 		{"pid", required_argument, NULL, 'p'}, /* master process pid */
+		{"queues", required_argument, NULL, 'q'},
+		{"zero-copy", no_argument, NULL, 'z'},
 		{"help", no_argument, NULL, 'h'},     /* return 'h' */
 		{NULL, 0, NULL, 0}
 	};
 
 	run_time_sec = 0; /* loop forever if time to run is 0 */
 	master_pid = 0;
+	num_queues = 1;
+	zero_copy = 0;
 
 	while (1) {
-		opt = getopt_long(argc, argv, "+t:p:h",
+		opt = getopt_long(argc, argv, "+t:p:q:zh",
 				  longopts, &long_index);
 
 		if (opt == -1)
@@ -123,6 +152,14 @@ void parse_args(int argc, char *argv[])
 		case 'p':
 			master_pid = atoi(optarg);
 			break;
+		case 'q':
+			num_queues = atoi(optarg);
+			if (num_queues < 1)
+				num_queues = 1;
+			break;
+		case 'z':
+			zero_copy = 1;
+			break;
 		case 'h':
 		default:
 			usage(argv[0]);
@@ -165,6 +202,8 @@ void usage(char *progname)
 	       "Optional OPTIONS\n"
 	       "  -h, --help           Display help and exit.\n"
 	       "  -t, --time           Time to run in seconds.\n"
+	       "  -q, --queues         Number of pktin and pktout queues.\n"
+	       "  -z, --zero-copy      Enable zero-copy packet input.\n"
 	       "\n", NO_PATH(progname), NO_PATH(progname)
 	    );
 }
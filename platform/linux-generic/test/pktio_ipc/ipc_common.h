@@ -75,6 +75,12 @@ int run_time_sec;
 /** PID of the master process */
 int master_pid;
 
+/** Number of pktin and pktout queues */
+int num_queues;
+
+/** Enable zero-copy packet input */
+int zero_copy;
+
 /* helper funcs */
 void parse_args(int argc, char *argv[]);
 void print_info(char *progname);
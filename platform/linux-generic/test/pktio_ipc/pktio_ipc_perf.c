@@ -0,0 +1,421 @@
+/* Copyright (c) 2017, Linaro Limited
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier:     BSD-3-Clause
+ */
+
+#include "config.h"
+
+/**
+ * @file
+ *
+ * @example pktio_ipc_perf.c  ODP IPC throughput test application.
+ *		Without -p option the application is the transmitter. It opens
+ *		ipc pktio, allocates packets and sends those as fast as
+ *		possible. With -p option the application is the receiver. It
+ *		connects to the transmitter, reads first bytes of each packet,
+ *		frees the packet and reports the receive rate. With -z
+ *		option the receiver measures zero-copy receive, and checks
+ *		that the first received packet can be copied and extended.
+ *		With -q option both processes use multiple pktin/pktout
+ *		queues, each served by its own worker thread.
+ */
+
+#include "ipc_common.h"
+
+/** Packet length used in the test */
+#define PERF_PKT_LEN	64
+
+/** Number of packets in the transmitter pool */
+#define PERF_POOL_SIZE	(4 * SHM_PKT_POOL_SIZE)
+
+/** Packets per burst */
+#define PERF_BURST	32
+
+/** Maximum number of queues, one worker thread per queue */
+#define PERF_MAX_QUEUES	8
+
+/** Number of zero-copy packet checks: extend tail, extend head, concat */
+#define PERF_ZC_TESTS	3
+
+/** Per worker statistics */
+typedef struct {
+	uint64_t pkts;
+	uint64_t sum;
+	odp_time_t first;
+	odp_time_t last;
+	int ret;
+} perf_stats_t;
+
+/** Test arguments shared by all worker threads */
+typedef struct {
+	odp_pktio_t pktio;
+	odp_pool_t pool;
+	odp_time_t start;
+	odp_time_t wait;
+	odp_atomic_u32_t next_queue;
+	perf_stats_t stats[PERF_MAX_QUEUES];
+} perf_args_t;
+
+static perf_args_t perf_args;
+
+static int time_expired(odp_time_t start, odp_time_t wait)
+{
+	odp_time_t diff;
+
+	if (!run_time_sec)
+		return 0;
+
+	diff = odp_time_diff(odp_time_local(), start);
+	return odp_time_cmp(wait, diff) < 0;
+}
+
+static odp_pktio_t open_and_start(odp_pool_t pool, odp_time_t start,
+				  odp_time_t wait)
+{
+	odp_pktio_t ipc_pktio = ODP_PKTIO_INVALID;
+
+	for (;;) {
+		if (time_expired(start, wait))
+			return ODP_PKTIO_INVALID;
+
+		ipc_pktio = create_pktio(pool, master_pid);
+		if (ipc_pktio != ODP_PKTIO_INVALID)
+			break;
+		if (!master_pid)
+			return ODP_PKTIO_INVALID;
+	}
+
+	/* start ipc pktio, i.e. wait until other process connects */
+	for (;;) {
+		if (time_expired(start, wait)) {
+			odp_pktio_close(ipc_pktio);
+			return ODP_PKTIO_INVALID;
+		}
+
+		if (!odp_pktio_start(ipc_pktio))
+			break;
+	}
+
+	return ipc_pktio;
+}
+
+static int run_tx(void *arg)
+{
+	perf_args_t *args = arg;
+	int queue = odp_atomic_fetch_inc_u32(&args->next_queue);
+	perf_stats_t *stats = &args->stats[queue];
+	odp_packet_t pkt_tbl[PERF_BURST];
+	odp_pktin_queue_t pktin[PERF_MAX_QUEUES];
+	odp_pktout_queue_t pktout[PERF_MAX_QUEUES];
+	int pkts, sent, i;
+
+	if (odp_pktin_queue(args->pktio, pktin, PERF_MAX_QUEUES) <= queue ||
+	    odp_pktout_queue(args->pktio, pktout, PERF_MAX_QUEUES) <= queue) {
+		LOG_ERR("no pktio queue %d\n", queue);
+		stats->ret = -1;
+		return -1;
+	}
+
+	while (!time_expired(args->start, args->wait)) {
+		/* Drain and drop anything sent back */
+		pkts = odp_pktin_recv(pktin[queue], pkt_tbl, PERF_BURST);
+		if (pkts > 0)
+			odp_packet_free_multi(pkt_tbl, pkts);
+
+		pkts = odp_packet_alloc_multi(args->pool, PERF_PKT_LEN,
+					      pkt_tbl, PERF_BURST);
+		if (pkts <= 0)
+			continue;
+
+		sent = odp_pktout_send(pktout[queue], pkt_tbl, pkts);
+		if (sent < 0)
+			sent = 0;
+
+		for (i = sent; i < pkts; i++)
+			odp_packet_free(pkt_tbl[i]);
+
+		stats->pkts += sent;
+	}
+
+	return 0;
+}
+
+/* Copy, extend or concatenate a zero-copy received packet. Packet memory is
+ * owned by the transmitter, new packets are allocated from the pool of the
+ * receiving pktio. Packet handle is updated when packet data is moved. */
+static int check_zero_copy(odp_packet_t *pkt, int test, odp_pool_t pool)
+{
+	odp_packet_t copy;
+	uint32_t len = odp_packet_len(*pkt);
+	uint32_t tailroom = odp_packet_tailroom(*pkt);
+	uint32_t headroom = odp_packet_headroom(*pkt);
+	uint32_t new_len = len;
+	uint32_t offset = 0;
+	uint8_t data[PERF_PKT_LEN];
+	uint8_t buf[PERF_PKT_LEN];
+	int ret = 0;
+
+	if (odp_packet_pool(*pkt) != pool) {
+		LOG_ERR("zero-copy packet not from pktio pool\n");
+		return -1;
+	}
+
+	if (len > PERF_PKT_LEN || odp_packet_copy_to_mem(*pkt, 0, len, data))
+		return -1;
+
+	copy = odp_packet_copy(*pkt, odp_packet_pool(*pkt));
+	if (copy == ODP_PACKET_INVALID ||
+	    odp_packet_pool(copy) != pool || odp_packet_len(copy) != len ||
+	    odp_packet_copy_to_mem(copy, 0, len, buf) ||
+	    memcmp(data, buf, len)) {
+		LOG_ERR("zero-copy packet copy failed\n");
+		if (copy != ODP_PACKET_INVALID)
+			odp_packet_free(copy);
+		return -1;
+	}
+
+	/* Extensions beyond head- and tailroom need new memory */
+	switch (test) {
+	case 0:
+		ret = odp_packet_extend_tail(pkt, tailroom + 1, NULL, NULL);
+		new_len += tailroom + 1;
+		break;
+	case 1:
+		ret = odp_packet_extend_head(pkt, headroom + 1, NULL, NULL);
+		new_len += headroom + 1;
+		offset = headroom + 1;
+		break;
+	default:
+		/* Copy is consumed */
+		ret = odp_packet_concat(pkt, copy);
+		offset = len;
+		new_len += len;
+		copy = ODP_PACKET_INVALID;
+		break;
+	}
+
+	if (copy != ODP_PACKET_INVALID)
+		odp_packet_free(copy);
+
+	if (ret < 0 || odp_packet_pool(*pkt) != pool ||
+	    odp_packet_len(*pkt) != new_len ||
+	    odp_packet_copy_to_mem(*pkt, offset, len, buf) ||
+	    memcmp(data, buf, len)) {
+		LOG_ERR("zero-copy packet test %d failed\n", test);
+		return -1;
+	}
+
+	return 0;
+}
+
+static int run_rx(void *arg)
+{
+	perf_args_t *args = arg;
+	int queue = odp_atomic_fetch_inc_u32(&args->next_queue);
+	perf_stats_t *stats = &args->stats[queue];
+	odp_packet_t pkt_tbl[PERF_BURST];
+	odp_pktin_queue_t pktin[PERF_MAX_QUEUES];
+	int test = 0;
+	int pkts, i;
+
+	if (odp_pktin_queue(args->pktio, pktin, PERF_MAX_QUEUES) <= queue) {
+		LOG_ERR("no input queue %d\n", queue);
+		stats->ret = -1;
+		return -1;
+	}
+
+	while (!time_expired(args->start, args->wait)) {
+		pkts = odp_pktin_recv(pktin[queue], pkt_tbl, PERF_BURST);
+		if (pkts <= 0)
+			continue;
+
+		if (odp_unlikely(stats->pkts == 0))
+			stats->first = odp_time_local();
+
+		/* Check manipulation of first few zero-copy packets */
+		for (i = 0; zero_copy && i < pkts && test < PERF_ZC_TESTS;
+		     i++, test++) {
+			if (check_zero_copy(&pkt_tbl[i], test, args->pool)) {
+				odp_packet_free_multi(pkt_tbl, pkts);
+				stats->ret = -1;
+				return -1;
+			}
+		}
+
+		/* Touch packet data like a real application would do */
+		for (i = 0; i < pkts; i++) {
+			uint8_t *data = odp_packet_data(pkt_tbl[i]);
+
+			stats->sum += data[0];
+		}
+
+		odp_packet_free_multi(pkt_tbl, pkts);
+		stats->pkts += pkts;
+		stats->last = odp_time_local();
+	}
+
+	return 0;
+}
+
+static int print_stats(void)
+{
+	odp_time_t first = ODP_TIME_NULL;
+	odp_time_t last = ODP_TIME_NULL;
+	uint64_t pkts = 0;
+	uint64_t sum = 0;
+	uint64_t nsec;
+	int i;
+
+	for (i = 0; i < num_queues; i++) {
+		perf_stats_t *stats = &perf_args.stats[i];
+
+		if (stats->ret)
+			return -1;
+
+		if (!master_pid) {
+			printf("TX queue %d: %" PRIu64 " packets\n", i,
+			       stats->pkts);
+			continue;
+		}
+
+		printf("RX queue %d: %" PRIu64 " packets\n", i, stats->pkts);
+
+		if (stats->pkts == 0)
+			continue;
+
+		if (pkts == 0 || odp_time_cmp(stats->first, first) < 0)
+			first = stats->first;
+		if (odp_time_cmp(stats->last, last) > 0)
+			last = stats->last;
+
+		pkts += stats->pkts;
+		sum += stats->sum;
+	}
+
+	if (!master_pid)
+		return 0;
+
+	nsec = odp_time_to_ns(odp_time_diff(last, first));
+
+	printf("RX (%s, %d queues): %" PRIu64 " packets in %" PRIu64 " ms, "
+	       "%.3f Mpps (sum %" PRIu64 ")\n",
+	       zero_copy ? "zero-copy" : "copy",
+	       num_queues, pkts, (uint64_t)(nsec / ODP_TIME_MSEC_IN_NS),
+	       nsec ? (double)pkts * 1000.0 / nsec : 0.0, sum);
+
+	return pkts > 1000 ? 0 : -1;
+}
+
+static void run_workers(odp_instance_t instance)
+{
+	odph_odpthread_t thread_tbl[PERF_MAX_QUEUES];
+	odp_cpumask_t cpumask;
+	int cpus[ODP_THREAD_COUNT_MAX];
+	int num_cpus = 0;
+	int cpu;
+	int i;
+
+	/* Transmitter and receiver use different CPUs when possible */
+	odp_cpumask_default_worker(&cpumask, 0);
+	for (cpu = odp_cpumask_first(&cpumask);
+	     cpu >= 0 && num_cpus < ODP_THREAD_COUNT_MAX;
+	     cpu = odp_cpumask_next(&cpumask, cpu))
+		cpus[num_cpus++] = cpu;
+
+	memset(thread_tbl, 0, sizeof(thread_tbl));
+	odp_atomic_init_u32(&perf_args.next_queue, 0);
+
+	for (i = 0; i < num_queues; i++) {
+		odp_cpumask_t thd_mask;
+		odph_odpthread_params_t thr_params;
+
+		memset(&thr_params, 0, sizeof(thr_params));
+		thr_params.start    = master_pid ? run_rx : run_tx;
+		thr_params.arg      = &perf_args;
+		thr_params.thr_type = ODP_THREAD_WORKER;
+		thr_params.instance = instance;
+
+		cpu = cpus[((master_pid ? num_queues : 0) + i) % num_cpus];
+		odp_cpumask_zero(&thd_mask);
+		odp_cpumask_set(&thd_mask, cpu);
+		odph_odpthreads_create(&thread_tbl[i], &thd_mask, &thr_params);
+	}
+
+	for (i = 0; i < num_queues; i++)
+		odph_odpthreads_join(&thread_tbl[i]);
+}
+
+int main(int argc, char *argv[])
+{
+	odp_instance_t instance;
+	odp_pool_param_t params;
+	odp_pool_t pool;
+	odp_pktio_t ipc_pktio;
+	odp_time_t start, wait;
+	int ret;
+
+	/* Parse and store the application arguments */
+	parse_args(argc, argv);
+
+	if (num_queues > PERF_MAX_QUEUES) {
+		LOG_ERR("Error: max %d queues supported\n", PERF_MAX_QUEUES);
+		exit(EXIT_FAILURE);
+	}
+
+	if (odp_init_global(&instance, NULL, NULL)) {
+		LOG_ERR("Error: ODP global init failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	if (odp_init_local(instance, ODP_THREAD_CONTROL)) {
+		LOG_ERR("Error: ODP local init failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	odp_pool_param_init(&params);
+	params.pkt.seg_len = SHM_PKT_POOL_BUF_SIZE;
+	params.pkt.len     = SHM_PKT_POOL_BUF_SIZE;
+	params.pkt.num     = PERF_POOL_SIZE;
+	params.type        = ODP_POOL_PACKET;
+
+	pool = odp_pool_create(TEST_IPC_POOL_NAME, &params);
+	if (pool == ODP_POOL_INVALID) {
+		LOG_ERR("Error: packet pool create failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	wait  = odp_time_local_from_ns(run_time_sec * ODP_TIME_SEC_IN_NS);
+	start = odp_time_local();
+	ret   = -1;
+
+	ipc_pktio = open_and_start(pool, start, wait);
+	if (ipc_pktio != ODP_PKTIO_INVALID) {
+		memset(&perf_args, 0, sizeof(perf_args));
+		perf_args.pktio = ipc_pktio;
+		perf_args.pool  = pool;
+		perf_args.start = start;
+		perf_args.wait  = wait;
+
+		run_workers(instance);
+		ret = print_stats();
+
+		odp_pktio_stop(ipc_pktio);
+		odp_pktio_close(ipc_pktio);
+	}
+
+	if (odp_pool_destroy(pool))
+		LOG_ERR("Error: odp_pool_destroy() failed.\n");
+
+	if (odp_term_local()) {
+		LOG_ERR("Error: odp_term_local() failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	if (odp_term_global(instance)) {
+		LOG_ERR("Error: odp_term_global() failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	return ret;
+}
@@ -0,0 +1,50 @@
+#!/bin/sh
+#
+# Copyright (c) 2017, Linaro Limited
+# All rights reserved.
+#
+# SPDX-License-Identifier:	BSD-3-Clause
+#
+
+# Measure IPC pktio receive rate with copy and zero-copy receive, and with
+# multiple queues.
+# Test binary is searched in the same places as in pktio_ipc_run.sh.
+PATH=./pktio_ipc:$PATH
+PATH=$(dirname $0):$PATH
+PATH=$(dirname $0)/../../../../platform/linux-generic/test/pktio_ipc:$PATH
+PATH=.:$PATH
+
+RUNTIME_TX=8
+RUNTIME_RX=4
+
+run_mode()
+{
+	local ret=0
+
+	echo "==== IPC throughput, $1 receive, $2 queue(s) ===="
+	pktio_ipc_perf${EXEEXT} -t ${RUNTIME_TX} -q $2 &
+	IPC_PID=$!
+
+	if [ "$1" = "zero-copy" ]; then
+		pktio_ipc_perf${EXEEXT} -p ${IPC_PID} -t ${RUNTIME_RX} -q $2 -z
+	else
+		pktio_ipc_perf${EXEEXT} -p ${IPC_PID} -t ${RUNTIME_RX} -q $2
+	fi
+	ret=$?
+
+	wait ${IPC_PID}
+	rm -rf /dev/shm/${UID}/odp-${IPC_PID}* 2>&1 > /dev/null
+
+	if [ $ret -ne 0 ]; then
+		echo "!!! $1 FAILED $ret !!!"
+		exit $ret
+	fi
+}
+
+run_mode copy 1
+run_mode zero-copy 1
+run_mode copy 4
+run_mode zero-copy 4
+
+echo "!!!PASSED!!!"
+exit 0
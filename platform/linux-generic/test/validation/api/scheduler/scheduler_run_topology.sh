@@ -0,0 +1,31 @@
+#!/bin/sh
+#
+# Copyright (c) 2017, Linaro Limited
+# All rights reserved.
+#
+# SPDX-License-Identifier:	BSD-3-Clause
+#
+
+# Run scheduler validation tests in topology aware mode. Four domains are
+# forced, so that the test runs also on a single NUMA node system. All
+# threads are then in the first domain, which schedules all queues into
+# a single priority queue.
+
+# directories where scheduler_main binary can be found:
+# -in the validation dir when running make check (intree or out of tree)
+# -in the script directory, when running after 'make install', or
+# -in the validation when running standalone intree.
+# -in the current directory.
+# running stand alone out of tree requires setting PATH
+PATH=${TEST_DIR}/api/scheduler:$PATH
+PATH=$(dirname $0):$PATH
+PATH=$(dirname $0)/../../../../../../test/validation/api/scheduler:$PATH
+PATH=.:$PATH
+
+scheduler_main_path=$(which scheduler_main${EXEEXT})
+if [ ! -x "$scheduler_main_path" ] ; then
+	echo "cannot find scheduler_main: please set you PATH for it."
+	exit 1
+fi
+
+ODP_SCHED_TOPOLOGY=4 ODP_SCHED_STEAL_POLLS=4 scheduler_main${EXEEXT}
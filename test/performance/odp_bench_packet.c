@@ -45,6 +45,9 @@
 /** Number of times to run tests for each packet size */
 #define TEST_SIZE_RUN_COUNT 10
 
+/** Number of segments in segmented test packets */
+#define TEST_NUM_SEGS 4
+
 /** Maximum burst size for *_multi operations */
 #define TEST_MAX_BURST 64
 
@@ -363,6 +366,49 @@ static void alloc_packets_twice(void)
 			      TEST_REPEAT_COUNT);
 }
 
+/* Create packets of 'len' bytes by concatenating TEST_NUM_SEGS packets, so
+ * that packet data spans multiple segments */
+static void allocate_segmented_packets(uint32_t len, odp_packet_t pkt[],
+				       int num)
+{
+	int i, j;
+	uint32_t seg_len = len / TEST_NUM_SEGS;
+	odp_packet_t seg;
+
+	allocate_test_packets(len - (TEST_NUM_SEGS - 1) * seg_len, pkt, num);
+
+	for (i = 0; i < num; i++) {
+		for (j = 1; j < TEST_NUM_SEGS; j++) {
+			seg = odp_packet_alloc(gbl_args->pool, seg_len);
+			if (seg == ODP_PACKET_INVALID)
+				LOG_ABORT("Allocating test packets failed\n");
+
+			if (odp_packet_concat(&pkt[i], seg) < 0)
+				LOG_ABORT("Test packet concat failed\n");
+		}
+	}
+}
+
+static void create_segmented_packets(void)
+{
+	allocate_segmented_packets(gbl_args->pkt.len, gbl_args->pkt_tbl,
+				   TEST_REPEAT_COUNT);
+}
+
+static void create_segmented_packets_twice(void)
+{
+	allocate_segmented_packets(gbl_args->pkt.len, gbl_args->pkt_tbl,
+				   TEST_REPEAT_COUNT);
+	allocate_segmented_packets(gbl_args->pkt.len, gbl_args->pkt2_tbl,
+				   TEST_REPEAT_COUNT);
+}
+
+static void alloc_ref_multi_packets(void)
+{
+	allocate_test_packets(gbl_args->pkt.len, gbl_args->pkt2_tbl,
+			      TEST_REPEAT_COUNT);
+}
+
 static void create_packets(void)
 {
 	int i;
@@ -420,6 +466,111 @@ static void create_events(void)
 		gbl_args->event_tbl[i] = odp_packet_to_event(pkt_tbl[i]);
 }
 
+/* Copy packet data into data table for compare tests */
+static void copy_packets_to_data(void)
+{
+	int i;
+	uint32_t len = gbl_args->pkt.len;
+	odp_packet_t *pkt_tbl = gbl_args->pkt_tbl;
+
+	for (i = 0; i < TEST_REPEAT_COUNT; i++) {
+		if (odp_packet_copy_to_mem(pkt_tbl[i], 0, len,
+					   gbl_args->data_tbl[i]))
+			LOG_ABORT("Copying test packet data failed\n");
+	}
+}
+
+static void create_cmp_packets(void)
+{
+	create_packets();
+	copy_packets_to_data();
+}
+
+static void create_segmented_cmp_packets(void)
+{
+	create_segmented_packets();
+	copy_packets_to_data();
+}
+
+static void write_udp_headers(odp_packet_t pkt, int ipv6)
+{
+	uint32_t len = odp_packet_len(pkt);
+	uint32_t l3_len = len - ODPH_ETHHDR_LEN;
+	uint32_t l4_offset;
+	odph_ethhdr_t *eth;
+	odph_udphdr_t *udp;
+
+	eth = odp_packet_data(pkt);
+	memset(eth, 0, ODPH_ETHHDR_LEN);
+	eth->dst.addr[5] = 1;
+	eth->src.addr[5] = 2;
+
+	if (ipv6) {
+		odph_ipv6hdr_t *ip = odp_packet_offset(pkt, ODPH_ETHHDR_LEN,
+						       NULL, NULL);
+
+		eth->type = odp_cpu_to_be_16(ODPH_ETHTYPE_IPV6);
+		memset(ip, 0, ODPH_IPV6HDR_LEN);
+		ip->ver_tc_flow = odp_cpu_to_be_32(0x60000000);
+		ip->payload_len = odp_cpu_to_be_16(l3_len - ODPH_IPV6HDR_LEN);
+		ip->next_hdr = ODPH_IPPROTO_UDP;
+		ip->hop_limit = 64;
+		ip->src_addr[15] = 1;
+		ip->dst_addr[15] = 2;
+		l4_offset = ODPH_ETHHDR_LEN + ODPH_IPV6HDR_LEN;
+	} else {
+		odph_ipv4hdr_t *ip = odp_packet_offset(pkt, ODPH_ETHHDR_LEN,
+						       NULL, NULL);
+
+		eth->type = odp_cpu_to_be_16(ODPH_ETHTYPE_IPV4);
+		memset(ip, 0, ODPH_IPV4HDR_LEN);
+		ip->ver_ihl = ODPH_IPV4 << 4 | ODPH_IPV4HDR_IHL_MIN;
+		ip->tot_len = odp_cpu_to_be_16(l3_len);
+		ip->ttl = 64;
+		ip->proto = ODPH_IPPROTO_UDP;
+		ip->src_addr = odp_cpu_to_be_32(0x0a000001);
+		ip->dst_addr = odp_cpu_to_be_32(0x0a000002);
+		l4_offset = ODPH_ETHHDR_LEN + ODPH_IPV4HDR_LEN;
+	}
+
+	udp = odp_packet_offset(pkt, l4_offset, NULL, NULL);
+	udp->src_port = odp_cpu_to_be_16(1024);
+	udp->dst_port = odp_cpu_to_be_16(2048);
+	udp->length = odp_cpu_to_be_16(len - l4_offset);
+	udp->chksum = 0;
+}
+
+static void create_udp_packets(int num, int ipv6)
+{
+	int i;
+	odp_packet_t *pkt_tbl = gbl_args->pkt_tbl;
+
+	allocate_test_packets(gbl_args->pkt.len, pkt_tbl, num);
+
+	for (i = 0; i < num; i++)
+		write_udp_headers(pkt_tbl[i], ipv6);
+}
+
+static void create_ipv4_packets(void)
+{
+	create_udp_packets(TEST_REPEAT_COUNT, 0);
+}
+
+static void create_ipv6_packets(void)
+{
+	create_udp_packets(TEST_REPEAT_COUNT, 1);
+}
+
+static void create_ipv4_packets_multi(void)
+{
+	create_udp_packets(TEST_REPEAT_COUNT * gbl_args->appl.burst_size, 0);
+}
+
+static void create_ipv6_packets_multi(void)
+{
+	create_udp_packets(TEST_REPEAT_COUNT * gbl_args->appl.burst_size, 1);
+}
+
 static void free_packets(void)
 {
 	odp_packet_free_multi(gbl_args->pkt_tbl, TEST_REPEAT_COUNT);
@@ -431,6 +582,12 @@ static void free_packets_multi(void)
 			      TEST_REPEAT_COUNT * gbl_args->appl.burst_size);
 }
 
+static void free_ref_multi_packets(void)
+{
+	free_packets_multi();
+	odp_packet_free_multi(gbl_args->pkt2_tbl, TEST_REPEAT_COUNT);
+}
+
 static void free_packets_twice(void)
 {
 	odp_packet_free_multi(gbl_args->pkt_tbl, TEST_REPEAT_COUNT);
@@ -986,6 +1143,19 @@ static int bench_packet_copy_from_pkt(void)
 	return !ret;
 }
 
+static int bench_packet_cmp_mem(void)
+{
+	int i;
+	uint32_t ret = 0;
+	uint32_t len = gbl_args->pkt.len;
+	odp_packet_t *pkt_tbl = gbl_args->pkt_tbl;
+
+	for (i = 0; i < TEST_REPEAT_COUNT; i++)
+		ret += odp_packet_cmp_mem(pkt_tbl[i], 0, gbl_args->data_tbl[i],
+					  len) != 0;
+	return !ret;
+}
+
 static int bench_packet_copy_data(void)
 {
 	int i;
@@ -1254,6 +1424,20 @@ static int bench_packet_ref(void)
 	return i;
 }
 
+static int bench_packet_ref_multi(void)
+{
+	int i;
+	int refs = 0;
+	uint32_t offset = TEST_MIN_PKT_SIZE / 2;
+	odp_packet_t *pkt_tbl = gbl_args->pkt2_tbl;
+	odp_packet_t *ref_tbl = gbl_args->pkt_tbl;
+
+	for (i = 0; i < TEST_REPEAT_COUNT; i++)
+		refs += odp_packet_ref_multi(pkt_tbl[i], offset, &ref_tbl[refs],
+					     gbl_args->appl.burst_size);
+	return refs;
+}
+
 static int bench_packet_ref_pkt(void)
 {
 	int i;
@@ -1279,6 +1463,42 @@ static int bench_packet_has_ref(void)
 	return i;
 }
 
+static int bench_packet_parse(void)
+{
+	int i;
+	int ret = 0;
+	odp_packet_parse_param_t param;
+
+	param.proto = ODP_PROTO_ETH;
+	param.last_layer = ODP_PROTO_LAYER_ALL;
+
+	for (i = 0; i < TEST_REPEAT_COUNT; i++)
+		ret += odp_packet_parse(gbl_args->pkt_tbl[i], 0, &param);
+
+	return !ret;
+}
+
+static int bench_packet_parse_multi(void)
+{
+	int i;
+	int ret = 0;
+	int burst = gbl_args->appl.burst_size;
+	uint32_t offset[TEST_MAX_BURST] = {0};
+	odp_packet_parse_param_t param;
+
+	param.proto = ODP_PROTO_ETH;
+	param.last_layer = ODP_PROTO_LAYER_ALL;
+
+	for (i = 0; i < TEST_REPEAT_COUNT; i++) {
+		int pkt_idx = i * burst;
+
+		ret += odp_packet_parse_multi(&gbl_args->pkt_tbl[pkt_idx],
+					      offset, burst, &param);
+	}
+
+	return ret == TEST_REPEAT_COUNT * burst;
+}
+
 /**
  * Prinf usage information
  */
@@ -1461,6 +1681,21 @@ bench_info_t test_suite[] = {
 			   NULL),
 		BENCH_INFO(bench_packet_move_data, create_packets, free_packets,
 			   NULL),
+		BENCH_INFO(bench_packet_cmp_mem, create_cmp_packets,
+			   free_packets, NULL),
+		BENCH_INFO(bench_packet_copy, create_segmented_packets,
+			   free_packets_twice, "bench_packet_copy_seg"),
+		BENCH_INFO(bench_packet_copy_to_mem, create_segmented_packets,
+			   free_packets, "bench_packet_copy_to_mem_seg"),
+		BENCH_INFO(bench_packet_copy_from_mem, create_segmented_packets,
+			   free_packets, "bench_packet_copy_from_mem_seg"),
+		BENCH_INFO(bench_packet_copy_from_pkt,
+			   create_segmented_packets_twice, free_packets_twice,
+			   "bench_packet_copy_from_pkt_seg"),
+		BENCH_INFO(bench_packet_move_data, create_segmented_packets,
+			   free_packets, "bench_packet_move_data_seg"),
+		BENCH_INFO(bench_packet_cmp_mem, create_segmented_cmp_packets,
+			   free_packets, "bench_packet_cmp_mem_seg"),
 		BENCH_INFO(bench_packet_pool, create_packets, free_packets,
 			   NULL),
 		BENCH_INFO(bench_packet_input, create_packets, free_packets,
@@ -1504,10 +1739,20 @@ bench_info_t test_suite[] = {
 			   free_packets_twice, NULL),
 		BENCH_INFO(bench_packet_ref, create_packets,
 			   free_packets_twice, NULL),
+		BENCH_INFO(bench_packet_ref_multi, alloc_ref_multi_packets,
+			   free_ref_multi_packets, NULL),
 		BENCH_INFO(bench_packet_ref_pkt, alloc_packets_twice,
 			   free_packets_twice, NULL),
 		BENCH_INFO(bench_packet_has_ref, alloc_ref_packets,
 			   free_packets_twice, NULL),
+		BENCH_INFO(bench_packet_parse, create_ipv4_packets,
+			   free_packets, "bench_packet_parse_ipv4"),
+		BENCH_INFO(bench_packet_parse, create_ipv6_packets,
+			   free_packets, "bench_packet_parse_ipv6"),
+		BENCH_INFO(bench_packet_parse_multi, create_ipv4_packets_multi,
+			   free_packets_multi, "bench_packet_parse_multi_ipv4"),
+		BENCH_INFO(bench_packet_parse_multi, create_ipv6_packets_multi,
+			   free_packets_multi, "bench_packet_parse_multi_ipv6"),
 };
 
 /**
@@ -1579,10 +1824,11 @@ int main(int argc, char *argv[])
 		exit(EXIT_FAILURE);
 	}
 
-	/* At least 2 x TEST_REPEAT_COUNT packets required */
-	pkt_num = (gbl_args->appl.burst_size > 2) ?
-			gbl_args->appl.burst_size * TEST_REPEAT_COUNT :
-			2 * TEST_REPEAT_COUNT;
+	/* At least 2 x TEST_NUM_SEGS x TEST_REPEAT_COUNT packets required,
+	 * and (burst_size + 1) x TEST_REPEAT_COUNT for multi references */
+	pkt_num = (gbl_args->appl.burst_size + 1 > 2 * TEST_NUM_SEGS) ?
+			(gbl_args->appl.burst_size + 1) * TEST_REPEAT_COUNT :
+			2 * TEST_NUM_SEGS * TEST_REPEAT_COUNT;
 
 	if (capa.pkt.max_num && capa.pkt.max_num < pkt_num) {
 		LOG_ERR("Error: packet pool size not supported.\n");
@@ -0,0 +1,437 @@
+/* Copyright (c) 2017, Linaro Limited
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier:     BSD-3-Clause
+ */
+
+#include "config.h"
+
+/**
+ * @file
+ *
+ * @example odp_bench_time.c  Microbenchmarks for time functions
+ */
+
+#include <stdlib.h>
+#include <getopt.h>
+#include <inttypes.h>
+#include <signal.h>
+
+#include <test_debug.h>
+
+#include <odp_api.h>
+#include <odp/helper/threads.h>
+
+/** Number of calls per individual benchmark run */
+#define TEST_REPEAT_COUNT 1000
+
+/** Number of runs per benchmark */
+#define TEST_RUN_COUNT 100
+
+/** Maximum error of a nanosecond - time - nanosecond round trip */
+#define TEST_MAX_ERROR_NS 2
+
+/** Get rid of path in filename - only for unix-type paths using '/' */
+#define NO_PATH(file_name) (strrchr((file_name), '/') ? \
+			    strrchr((file_name), '/') + 1 : (file_name))
+
+#define BENCH_INFO(run, desc) {#run, run, desc}
+
+/**
+ * Run benchmark
+ *
+ * @retval >0 on success
+ */
+typedef int (*bench_run_fn_t)(void);
+
+/**
+ * Benchmark data
+ */
+typedef struct {
+	const char *name;
+	bench_run_fn_t run;
+	const char *desc;
+} bench_info_t;
+
+/**
+ * Grouping of all global data
+ */
+typedef struct {
+	/** Benchmark index to run indefinitely */
+	int bench_idx;
+	/** Benchmark functions */
+	bench_info_t *bench;
+	/** Number of benchmark functions */
+	int num_bench;
+	/** Array for storing test timestamps */
+	odp_time_t ts_tbl[TEST_REPEAT_COUNT];
+	/** Array for storing test nanosecond values */
+	uint64_t ns_tbl[TEST_REPEAT_COUNT];
+	/** Array for storing test outputs */
+	uint64_t output_tbl[TEST_REPEAT_COUNT];
+} args_t;
+
+/** Global pointer to args */
+static args_t *gbl_args;
+/** Break benchmark loop if set to 1 */
+static int exit_thread;
+
+static void sig_handler(int signo ODP_UNUSED)
+{
+	exit_thread = 1;
+}
+
+static void init_tables(void)
+{
+	int i;
+
+	for (i = 0; i < TEST_REPEAT_COUNT; i++) {
+		gbl_args->ts_tbl[i] = odp_time_local();
+		gbl_args->ns_tbl[i] = (uint64_t)i * 1234567;
+	}
+}
+
+static int bench_empty(void)
+{
+	int i;
+
+	for (i = 0; i < TEST_REPEAT_COUNT; i++)
+		gbl_args->output_tbl[i] = i;
+
+	return i;
+}
+
+static int bench_time_local(void)
+{
+	int i;
+
+	for (i = 0; i < TEST_REPEAT_COUNT; i++)
+		gbl_args->ts_tbl[i] = odp_time_local();
+
+	return i;
+}
+
+static int bench_time_global(void)
+{
+	int i;
+
+	for (i = 0; i < TEST_REPEAT_COUNT; i++)
+		gbl_args->ts_tbl[i] = odp_time_global();
+
+	return i;
+}
+
+static int bench_time_diff(void)
+{
+	int i;
+	odp_time_t *ts = gbl_args->ts_tbl;
+
+	for (i = 0; i < TEST_REPEAT_COUNT - 1; i++)
+		ts[i] = odp_time_diff(ts[i + 1], ts[i]);
+
+	return i;
+}
+
+static int bench_time_sum(void)
+{
+	int i;
+	odp_time_t *ts = gbl_args->ts_tbl;
+
+	for (i = 0; i < TEST_REPEAT_COUNT - 1; i++)
+		ts[i] = odp_time_sum(ts[i + 1], ts[i]);
+
+	return i;
+}
+
+static int bench_time_cmp(void)
+{
+	int i;
+	odp_time_t *ts = gbl_args->ts_tbl;
+
+	for (i = 0; i < TEST_REPEAT_COUNT - 1; i++)
+		gbl_args->output_tbl[i] = odp_time_cmp(ts[i + 1], ts[i]);
+
+	return i;
+}
+
+static int bench_time_to_ns(void)
+{
+	int i;
+	odp_time_t *ts = gbl_args->ts_tbl;
+
+	for (i = 0; i < TEST_REPEAT_COUNT; i++)
+		gbl_args->output_tbl[i] = odp_time_to_ns(ts[i]);
+
+	return i;
+}
+
+static int bench_time_local_from_ns(void)
+{
+	int i;
+	uint64_t *ns = gbl_args->ns_tbl;
+
+	for (i = 0; i < TEST_REPEAT_COUNT; i++)
+		gbl_args->ts_tbl[i] = odp_time_local_from_ns(ns[i]);
+
+	return i;
+}
+
+static int bench_time_local_res(void)
+{
+	int i;
+
+	for (i = 0; i < TEST_REPEAT_COUNT; i++)
+		gbl_args->output_tbl[i] = odp_time_local_res();
+
+	return i;
+}
+
+static int bench_time_local_ns(void)
+{
+	int i;
+
+	for (i = 0; i < TEST_REPEAT_COUNT; i++)
+		gbl_args->output_tbl[i] = odp_time_to_ns(odp_time_local());
+
+	return i;
+}
+
+/**
+ * Test functions
+ */
+bench_info_t test_suite[] = {
+	BENCH_INFO(bench_empty, NULL),
+	BENCH_INFO(bench_time_local, NULL),
+	BENCH_INFO(bench_time_global, NULL),
+	BENCH_INFO(bench_time_diff, NULL),
+	BENCH_INFO(bench_time_sum, NULL),
+	BENCH_INFO(bench_time_cmp, NULL),
+	BENCH_INFO(bench_time_to_ns, NULL),
+	BENCH_INFO(bench_time_local_from_ns, NULL),
+	BENCH_INFO(bench_time_local_res, NULL),
+	BENCH_INFO(bench_time_local_ns, "odp_time_to_ns(odp_time_local())"),
+};
+
+/**
+ * Check that time to nanosecond conversions round trip
+ */
+static int check_conversions(void)
+{
+	uint64_t ns, res_ns, max_err;
+	int i;
+
+	res_ns  = ODP_TIME_SEC_IN_NS / odp_time_local_res();
+	max_err = res_ns + TEST_MAX_ERROR_NS;
+
+	for (i = 0; i < 64; i++) {
+		uint64_t out, err;
+
+		ns  = UINT64_C(1) << i;
+		/* Keep within ten years */
+		if (ns > 10 * 365 * 24 * 3600 * ODP_TIME_SEC_IN_NS)
+			break;
+
+		out = odp_time_to_ns(odp_time_local_from_ns(ns));
+		err = out > ns ? out - ns : ns - out;
+
+		if (err > max_err + ns / 1000000000) {
+			LOG_ERR("Conversion error: %" PRIu64 " ns -> %" PRIu64
+				" ns\n", ns, out);
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * Run given benchmark indefinitely
+ */
+static void run_indef(args_t *args, int idx)
+{
+	const char *desc;
+
+	desc = args->bench[idx].desc != NULL ?
+			args->bench[idx].desc : args->bench[idx].name;
+
+	printf("Running %s() indefinitely\n", desc);
+
+	while (!exit_thread) {
+		if (!args->bench[idx].run())
+			LOG_ABORT("Benchmark %s failed\n", desc);
+	}
+}
+
+static int run_benchmarks(args_t *args)
+{
+	int i, j;
+
+	if (args->bench_idx) {
+		if (args->bench_idx > args->num_bench)
+			return -1;
+
+		run_indef(args, args->bench_idx - 1);
+		return 0;
+	}
+
+	printf("\nRunning benchmarks (cycles per call)\n"
+	       "------------------------------------\n");
+
+	for (i = 0; i < args->num_bench; i++) {
+		uint64_t c1, c2, tot_cycles = 0;
+		const char *desc;
+		double cycles;
+
+		desc = args->bench[i].desc != NULL ?
+				args->bench[i].desc : args->bench[i].name;
+
+		for (j = 0; j < TEST_RUN_COUNT; j++) {
+			init_tables();
+
+			c1 = odp_cpu_cycles();
+			if (!args->bench[i].run()) {
+				LOG_ERR("Benchmark %s failed\n", desc);
+				return -1;
+			}
+			c2 = odp_cpu_cycles();
+
+			tot_cycles += odp_cpu_cycles_diff(c2, c1);
+		}
+
+		cycles = (double)tot_cycles /
+			 (TEST_RUN_COUNT * TEST_REPEAT_COUNT);
+
+		printf("%-34s: %8.1f\n", desc, cycles);
+	}
+
+	printf("\n");
+	return 0;
+}
+
+/**
+ * Prinf usage information
+ */
+static void usage(char *progname)
+{
+	printf("\n"
+	       "OpenDataPlane Time function microbenchmark.\n"
+	       "\n"
+	       "Usage: %s OPTIONS\n"
+	       "  E.g. %s\n"
+	       "\n"
+	       "Optional OPTIONS:\n"
+	       "  -i, --index      Benchmark index to run indefinitely.\n"
+	       "  -h, --help       Display help and exit.\n\n"
+	       "\n", NO_PATH(progname), NO_PATH(progname));
+}
+
+/**
+ * Parse and store the command line arguments
+ */
+static void parse_args(int argc, char *argv[], args_t *args)
+{
+	int opt;
+	int long_index;
+	static const struct option longopts[] = {
+		{"help", no_argument, NULL, 'h'},
+		{"index", required_argument, NULL, 'i'},
+		{NULL, 0, NULL, 0}
+	};
+
+	static const char *shortopts =  "i:h";
+
+	/* Let helper collect its own arguments (e.g. --odph_proc) */
+	odph_parse_options(argc, argv, shortopts, longopts);
+
+	opterr = 0; /* Do not issue errors on helper options */
+
+	args->bench_idx = 0; /* Run all benchmarks */
+
+	while (1) {
+		opt = getopt_long(argc, argv, shortopts, longopts, &long_index);
+
+		if (opt == -1)
+			break;	/* No more options */
+
+		switch (opt) {
+		case 'h':
+			usage(argv[0]);
+			exit(EXIT_SUCCESS);
+			break;
+		case 'i':
+			args->bench_idx = atoi(optarg);
+			break;
+		default:
+			break;
+		}
+	}
+
+	optind = 1;		/* Reset 'extern optind' from the getopt lib */
+}
+
+/**
+ * ODP time microbenchmark application
+ */
+int main(int argc, char *argv[])
+{
+	odp_instance_t instance;
+	odp_shm_t shm;
+	int ret = 0;
+
+	signal(SIGINT, sig_handler);
+
+	if (odp_init_global(&instance, NULL, NULL)) {
+		LOG_ERR("Error: ODP global init failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	if (odp_init_local(instance, ODP_THREAD_CONTROL)) {
+		LOG_ERR("Error: ODP local init failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	shm = odp_shm_reserve("shm_args", sizeof(args_t),
+			      ODP_CACHE_LINE_SIZE, 0);
+	gbl_args = odp_shm_addr(shm);
+
+	if (gbl_args == NULL) {
+		LOG_ERR("Error: shared mem alloc failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	memset(gbl_args, 0, sizeof(args_t));
+
+	gbl_args->bench = test_suite;
+	gbl_args->num_bench = sizeof(test_suite) / sizeof(test_suite[0]);
+
+	parse_args(argc, argv, gbl_args);
+
+	odp_sys_info_print();
+
+	printf("Time resolution: %" PRIu64 " hz\n", odp_time_local_res());
+
+	if (check_conversions()) {
+		LOG_ERR("Error: time conversion check failed.\n");
+		ret = -1;
+	}
+
+	if (ret == 0 && run_benchmarks(gbl_args))
+		ret = -1;
+
+	if (odp_shm_free(shm)) {
+		LOG_ERR("Error: shm free failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	if (odp_term_local()) {
+		LOG_ERR("Error: term local failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	if (odp_term_global(instance)) {
+		LOG_ERR("Error: term global failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	return ret;
+}
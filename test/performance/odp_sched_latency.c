@@ -85,6 +85,9 @@ typedef struct {
 	} prio[NUM_PRIOS];
 	odp_bool_t sample_per_prio; /**< Allocate a separate sample event for
 					 each priority */
+	int idle_queues;		/**< Number of idle scheduled queues */
+	int rounds;			/**< Test rounds for each thread */
+	int sample_delay;		/**< Sample event forward delay in us */
 } test_args_t;
 
 /** Latency measurements statistics */
@@ -283,10 +286,13 @@ static void print_results(test_globals_t *globals)
 
 	printf("  HI_PRIO queues: %i\n", args->prio[HI_PRIO].queues);
 	if (args->prio[HI_PRIO].events_per_queue)
-		printf("  HI_PRIO event per queue: %i\n\n",
+		printf("  HI_PRIO event per queue: %i\n",
 		       args->prio[HI_PRIO].events);
 	else
-		printf("  HI_PRIO events: %i\n\n", args->prio[HI_PRIO].events);
+		printf("  HI_PRIO events: %i\n", args->prio[HI_PRIO].events);
+
+	printf("  Idle queues: %i\n", args->idle_queues);
+	printf("  Sample delay: %i us\n\n", args->sample_delay);
 
 	for (i = 0; i < NUM_PRIOS; i++) {
 		memset(&total, 0, sizeof(test_stat_t));
@@ -333,7 +339,7 @@ static void print_results(test_globals_t *globals)
 /**
  * Measure latency of scheduled ODP events
  *
- * Schedule and enqueue events until 'TEST_ROUNDS' events have been processed.
+ * Schedule and enqueue events until 'rounds' events have been processed.
  * Scheduling latency is measured only from type 'SAMPLE' events. Other events
  * are simply enqueued back to the scheduling queues.
  *
@@ -363,7 +369,7 @@ static int test_schedule(int thr, test_globals_t *globals)
 	globals->core_stat[thr].prio[HI_PRIO].min = UINT64_MAX;
 	globals->core_stat[thr].prio[LO_PRIO].min = UINT64_MAX;
 
-	for (i = 0; i < TEST_ROUNDS; i++) {
+	for (i = 0; i < (uint32_t)globals->args.rounds; i++) {
 		ev = odp_schedule(&src_queue, ODP_SCHED_WAIT);
 
 		buf = odp_buffer_from_event(ev);
@@ -399,8 +405,14 @@ static int test_schedule(int thr, test_globals_t *globals)
 		event->src_idx[event->prio] = dst_idx;
 		dst_queue = globals->queue[event->prio][dst_idx];
 
-		if (event->type == SAMPLE)
+		if (event->type == SAMPLE) {
+			/* Other threads may go idle meanwhile */
+			if (globals->args.sample_delay)
+				odp_time_wait_ns(globals->args.sample_delay *
+						 ODP_TIME_USEC_IN_NS);
+
 			event->ts = odp_time_to_ns(odp_time_global());
+		}
 
 		if (odp_queue_enq(dst_queue, ev)) {
 			LOG_ERR("[%i] Queue enqueue failed.\n", thr);
@@ -512,12 +524,19 @@ static void usage(void)
 	       "  -r  --sample-per-prio Allocate a separate sample event for each priority. By default\n"
 	       "			a single sample event is used and its priority is changed after\n"
 	       "			each processing round.\n"
+	       "  -i, --idle-queues <number> Number of additional scheduled queues which never receive\n"
+	       "			events. Set ODP_NUM_QUEUES environment variable to create more\n"
+	       "			queues than the default.\n"
+	       "  -e, --rounds <number> Number of events each thread processes (default %i)\n"
+	       "  -d, --sample-delay <us> Delay before forwarding a sample event. With few events,\n"
+	       "			other threads become idle and the latency includes their wake up\n"
+	       "			(see ODP_SCHED_IDLE environment variable).\n"
 	       "  -s, --sync  Scheduled queues' sync type\n"
 	       "               0: ODP_SCHED_SYNC_PARALLEL (default)\n"
 	       "               1: ODP_SCHED_SYNC_ATOMIC\n"
 	       "               2: ODP_SCHED_SYNC_ORDERED\n"
-	       "  -h, --help   Display help and exit.\n\n"
-	       );
+	       "  -h, --help   Display help and exit.\n\n",
+	       TEST_ROUNDS);
 }
 
 /**
@@ -542,12 +561,15 @@ static void parse_args(int argc, char *argv[], test_args_t *args)
 		{"lo-prio-events", required_argument, NULL, 'o'},
 		{"hi-prio-events", required_argument, NULL, 'p'},
 		{"sample-per-prio", no_argument, NULL, 'r'},
+		{"idle-queues", required_argument, NULL, 'i'},
+		{"rounds", required_argument, NULL, 'e'},
+		{"sample-delay", required_argument, NULL, 'd'},
 		{"sync", required_argument, NULL, 's'},
 		{"help", no_argument, NULL, 'h'},
 		{NULL, 0, NULL, 0}
 	};
 
-	static const char *shortopts = "+c:s:l:t:m:n:o:p:rh";
+	static const char *shortopts = "+c:s:l:t:m:n:o:p:ri:e:d:h";
 
 	/* Let helper collect its own arguments (e.g. --odph_proc) */
 	odph_parse_options(argc, argv, shortopts, longopts);
@@ -560,6 +582,7 @@ static void parse_args(int argc, char *argv[], test_args_t *args)
 	args->prio[HI_PRIO].events = HI_PRIO_EVENTS;
 	args->prio[LO_PRIO].events_per_queue = EVENTS_PER_LO_PRIO_QUEUE;
 	args->prio[HI_PRIO].events_per_queue = EVENTS_PER_HI_PRIO_QUEUE;
+	args->rounds = TEST_ROUNDS;
 
 	opterr = 0; /* Do not issue errors on helper options */
 	while (1) {
@@ -606,6 +629,15 @@ static void parse_args(int argc, char *argv[], test_args_t *args)
 		case 'r':
 			args->sample_per_prio = 1;
 			break;
+		case 'i':
+			args->idle_queues = atoi(optarg);
+			break;
+		case 'e':
+			args->rounds = atoi(optarg);
+			break;
+		case 'd':
+			args->sample_delay = atoi(optarg);
+			break;
 		case 'h':
 			usage();
 			exit(EXIT_SUCCESS);
@@ -623,6 +655,12 @@ static void parse_args(int argc, char *argv[], test_args_t *args)
 		args->prio[LO_PRIO].queues = MAX_QUEUES;
 	if (args->prio[HI_PRIO].queues > MAX_QUEUES)
 		args->prio[HI_PRIO].queues = MAX_QUEUES;
+	if (args->idle_queues < 0)
+		args->idle_queues = 0;
+	if (args->rounds <= 0)
+		args->rounds = TEST_ROUNDS;
+	if (args->sample_delay < 0)
+		args->sample_delay = 0;
 	if (!args->prio[HI_PRIO].queues && !args->prio[LO_PRIO].queues) {
 		printf("No queues configured\n");
 		usage();
@@ -644,6 +682,9 @@ int main(int argc, char *argv[])
 	odp_shm_t shm;
 	test_globals_t *globals;
 	test_args_t args;
+	odp_queue_capability_t capa;
+	odp_queue_t *idle_queue = NULL;
+	odp_time_t t1, t2;
 	char cpumaskstr[ODP_CPUMASK_STR_SIZE];
 	int i, j;
 	int ret = 0;
@@ -757,6 +798,58 @@ int main(int argc, char *argv[])
 		}
 	}
 
+	/*
+	 * Create idle queues. Those are never scheduled, but increase the
+	 * number of queues the scheduler maintains.
+	 */
+	if (args.idle_queues) {
+		odp_queue_param_t param;
+		int max_idle;
+
+		if (odp_queue_capability(&capa)) {
+			LOG_ERR("Queue capability failed.\n");
+			return -1;
+		}
+
+		max_idle = capa.sched.max_num - args.prio[HI_PRIO].queues -
+			   args.prio[LO_PRIO].queues;
+
+		if (args.idle_queues > max_idle) {
+			LOG_ERR("Too many idle queues: max %i. Try increasing "
+				"ODP_NUM_QUEUES.\n", max_idle);
+			return -1;
+		}
+
+		idle_queue = calloc(sizeof(odp_queue_t), args.idle_queues);
+		if (!idle_queue) {
+			LOG_ERR("no memory for idle queues\n");
+			return -1;
+		}
+
+		odp_queue_param_init(&param);
+		param.type        = ODP_QUEUE_TYPE_SCHED;
+		param.sched.prio  = ODP_SCHED_PRIO_DEFAULT;
+		param.sched.sync  = args.sync_type;
+		param.sched.group = ODP_SCHED_GROUP_ALL;
+
+		t1 = odp_time_local();
+
+		for (j = 0; j < args.idle_queues; j++) {
+			idle_queue[j] = odp_queue_create(NULL, &param);
+
+			if (idle_queue[j] == ODP_QUEUE_INVALID) {
+				LOG_ERR("Idle queue create failed.\n");
+				return -1;
+			}
+		}
+
+		t2 = odp_time_local();
+
+		printf("  Idle queues:    %i created in %" PRIu64 " us\n",
+		       args.idle_queues,
+		       odp_time_to_ns(odp_time_diff(t2, t1)) / 1000);
+	}
+
 	odp_barrier_init(&globals->barrier, num_workers);
 
 	/* Create and launch worker threads */
@@ -785,6 +878,11 @@ int main(int argc, char *argv[])
 		}
 	}
 
+	for (j = 0; j < args.idle_queues; j++)
+		ret += odp_queue_destroy(idle_queue[j]);
+
+	free(idle_queue);
+
 	ret += odp_shm_free(shm);
 	ret += odp_pool_destroy(pool);
 	ret += odp_term_local();
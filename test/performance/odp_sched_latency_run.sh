@@ -19,10 +19,33 @@ run()
 	$TEST_DIR/odp_sched_latency${EXEEXT} -c $1 || exit $?
 }
 
+run_idle_mode()
+{
+	echo odp_sched_latency_run starts with a single sample event and \
+	     ODP_SCHED_IDLE=$1
+	echo ===============================================
+
+	ODP_SCHED_IDLE=$1 $TEST_DIR/odp_sched_latency${EXEEXT} -l 1 -t 0 -o 0 \
+		-e 2000 -d 100 || exit $?
+}
+
+run_idle()
+{
+	echo odp_sched_latency_run starts with $2 idle queues out of $1 queues
+	echo ===============================================
+
+	ODP_NUM_QUEUES=$1 $TEST_DIR/odp_sched_latency${EXEEXT} -c 1 -i $2 ||
+		exit $?
+}
+
 run 1
 run 5
 run 8
 run 11
 run $ALL
+run_idle_mode 0
+run_idle_mode 100
+run_idle 65536 64000
+run_idle 1048576 1000000
 
 exit 0
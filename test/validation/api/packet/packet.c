@@ -1315,6 +1315,47 @@ void packet_test_copydata(void)
 	odp_packet_free(pkt);
 }
 
+void packet_test_cmp_mem(void)
+{
+	odp_packet_t pkt_tbl[2] = {test_packet, segmented_test_packet};
+	odp_packet_t pkt;
+	uint32_t pkt_len;
+	uint8_t *data_buf;
+	uint8_t byte;
+	int i, ret;
+
+	for (i = 0; i < 2; i++) {
+		pkt = pkt_tbl[i];
+		pkt_len = odp_packet_len(pkt);
+		CU_ASSERT_FATAL(pkt_len > 1);
+
+		data_buf = malloc(pkt_len);
+		CU_ASSERT_PTR_NOT_NULL_FATAL(data_buf);
+
+		CU_ASSERT(!odp_packet_copy_to_mem(pkt, 0, pkt_len, data_buf));
+
+		CU_ASSERT(odp_packet_cmp_mem(pkt, 0, data_buf, pkt_len) == 0);
+		CU_ASSERT(odp_packet_cmp_mem(pkt, 0, data_buf, 0) == 0);
+		CU_ASSERT(odp_packet_cmp_mem(pkt, pkt_len / 3,
+					     &data_buf[pkt_len / 3],
+					     pkt_len / 2) == 0);
+
+		/* Difference in the last byte */
+		data_buf[pkt_len - 1] ^= 0xff;
+		CU_ASSERT(odp_packet_cmp_mem(pkt, 0, data_buf,
+					     pkt_len - 1) == 0);
+
+		/* Result has the sign of memcmp() */
+		CU_ASSERT(!odp_packet_copy_to_mem(pkt, pkt_len - 1, 1, &byte));
+		ret = odp_packet_cmp_mem(pkt, 0, data_buf, pkt_len);
+		CU_ASSERT(ret != 0);
+		CU_ASSERT((ret < 0) == (byte < data_buf[pkt_len - 1]));
+		CU_ASSERT((ret > 0) == (byte > data_buf[pkt_len - 1]));
+
+		free(data_buf);
+	}
+}
+
 void packet_test_concatsplit(void)
 {
 	odp_packet_t pkt, pkt2;
@@ -2371,6 +2412,341 @@ void packet_test_ref(void)
 	odp_packet_free(ref_pkt[1]);
 }
 
+void packet_test_ref_multi(void)
+{
+	odp_packet_t pkt_tbl[2] = {test_packet, segmented_test_packet};
+	odp_packet_t pkt, ref[4];
+	uint32_t pkt_len, offset;
+	int i, j, num;
+
+	for (i = 0; i < 2; i++) {
+		pkt = odp_packet_copy(pkt_tbl[i], odp_packet_pool(pkt_tbl[i]));
+		CU_ASSERT_FATAL(pkt != ODP_PACKET_INVALID);
+
+		pkt_len = odp_packet_len(pkt);
+		offset  = pkt_len / 2;
+
+		CU_ASSERT(odp_packet_ref_multi(pkt, pkt_len, ref, 4) < 0);
+		CU_ASSERT(odp_packet_has_ref(pkt) == 0);
+
+		num = odp_packet_ref_multi(pkt, offset, ref, 4);
+		CU_ASSERT_FATAL(num > 0 && num <= 4);
+		CU_ASSERT(odp_packet_has_ref(pkt) == 1);
+
+		for (j = 0; j < num; j++) {
+			CU_ASSERT_FATAL(ref[j] != ODP_PACKET_INVALID);
+			CU_ASSERT(odp_packet_len(ref[j]) == pkt_len - offset);
+			CU_ASSERT(odp_packet_has_ref(ref[j]) == 1);
+			packet_compare_offset(ref[j], 0, pkt, offset,
+					      pkt_len - offset);
+		}
+
+		/* Metadata is not shared between references */
+		CU_ASSERT(odp_packet_l3_offset_set(ref[0], 1) == 0);
+		if (num > 1)
+			CU_ASSERT(odp_packet_l3_offset(ref[1]) != 1);
+
+		for (j = 0; j < num; j++)
+			odp_packet_free(ref[j]);
+
+		CU_ASSERT(odp_packet_has_ref(pkt) == 0);
+		odp_packet_free(pkt);
+	}
+}
+
+/* Ethernet + IPv4 + UDP headers, padded to minimum frame length */
+static const uint8_t parse_ipv4_udp[] = {
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x01,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x02,
+	0x08, 0x00,
+	0x45, 0x00, 0x00, 0x1c, 0x00, 0x00, 0x00, 0x00,
+	0x40, 0x11, 0x00, 0x00, 0x0a, 0x00, 0x00, 0x01,
+	0x0a, 0x00, 0x00, 0x02,
+	0x04, 0x00, 0x08, 0x00, 0x00, 0x08, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00
+};
+
+/* Ethernet + IPv6 + TCP headers */
+static const uint8_t parse_ipv6_tcp[] = {
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x01,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x02,
+	0x86, 0xdd,
+	0x60, 0x00, 0x00, 0x00, 0x00, 0x14, 0x06, 0x40,
+	0xfe, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01,
+	0xfe, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02,
+	0x04, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x01,
+	0x00, 0x00, 0x00, 0x00, 0x50, 0x02, 0x20, 0x00,
+	0x00, 0x00, 0x00, 0x00
+};
+
+/* Ethernet + VLAN + IPv4 + UDP headers, padded to minimum frame length */
+static const uint8_t parse_vlan_ipv4_udp[] = {
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x01,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x02,
+	0x81, 0x00, 0x00, 0x0a,
+	0x08, 0x00,
+	0x45, 0x00, 0x00, 0x1c, 0x00, 0x00, 0x00, 0x00,
+	0x40, 0x11, 0x00, 0x00, 0x0a, 0x00, 0x00, 0x01,
+	0x0a, 0x00, 0x00, 0x02,
+	0x04, 0x00, 0x08, 0x00, 0x00, 0x08, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00
+};
+
+/* Ethernet + IPv4 with options + UDP headers, padded to minimum frame
+ * length. IP options are not handled by the parser fast path. */
+static const uint8_t parse_ipv4_opt_udp[] = {
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x01,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x02,
+	0x08, 0x00,
+	0x46, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00, 0x00,
+	0x40, 0x11, 0x00, 0x00, 0x0a, 0x00, 0x00, 0x01,
+	0x0a, 0x00, 0x00, 0x02, 0x01, 0x01, 0x01, 0x00,
+	0x04, 0x00, 0x08, 0x00, 0x00, 0x08, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};
+
+static odp_packet_t parse_packet_alloc(const uint8_t *data, uint32_t len,
+				       uint32_t prefix)
+{
+	odp_packet_t pkt;
+
+	pkt = odp_packet_alloc(packet_pool, prefix + len);
+	CU_ASSERT_FATAL(pkt != ODP_PACKET_INVALID);
+	CU_ASSERT(odp_packet_copy_from_mem(pkt, prefix, len, data) == 0);
+
+	return pkt;
+}
+
+/* Parse a frame from Ethernet header to all layers and check results
+ * against parsing L2 only and parsing from L3 header. Frames which match the
+ * parser fast path are parsed with it only in the first case. */
+static void parse_frame_test(const uint8_t *data, uint32_t len,
+			     odp_proto_t l3_proto, uint32_t l3, uint32_t l4)
+{
+	const uint32_t prefix = 10;
+	odp_packet_t pkt, ref;
+	odp_packet_parse_param_t param;
+
+	pkt = parse_packet_alloc(data, len, prefix);
+	ref = parse_packet_alloc(data, len, prefix);
+
+	param.proto = ODP_PROTO_ETH;
+	param.last_layer = ODP_PROTO_LAYER_ALL;
+
+	CU_ASSERT(odp_packet_parse(pkt, prefix, &param) == 0);
+	CU_ASSERT(odp_packet_has_eth(pkt));
+	CU_ASSERT(odp_packet_has_l2(pkt));
+	CU_ASSERT(odp_packet_has_l3(pkt));
+	CU_ASSERT(odp_packet_has_l4(pkt));
+	CU_ASSERT(!odp_packet_has_error(pkt));
+	CU_ASSERT(odp_packet_l2_offset(pkt) == prefix);
+	CU_ASSERT(odp_packet_l3_offset(pkt) == prefix + l3);
+	CU_ASSERT(odp_packet_l4_offset(pkt) == prefix + l4);
+
+	/* L2 flags */
+	param.last_layer = ODP_PROTO_LAYER_L2;
+
+	CU_ASSERT(odp_packet_parse(ref, prefix, &param) == 0);
+	CU_ASSERT(odp_packet_l2_offset(ref) == prefix);
+	COMPARE_HAS_INFLAG(pkt, ref, eth);
+	COMPARE_HAS_INFLAG(pkt, ref, l2);
+	COMPARE_HAS_INFLAG(pkt, ref, eth_bcast);
+	COMPARE_HAS_INFLAG(pkt, ref, eth_mcast);
+	COMPARE_HAS_INFLAG(pkt, ref, jumbo);
+	COMPARE_HAS_INFLAG(pkt, ref, vlan);
+	COMPARE_HAS_INFLAG(pkt, ref, vlan_qinq);
+
+	/* L3 and L4 flags */
+	param.proto = l3_proto;
+	param.last_layer = ODP_PROTO_LAYER_ALL;
+
+	CU_ASSERT(odp_packet_parse(ref, prefix + l3, &param) == 0);
+	CU_ASSERT(odp_packet_l3_offset(ref) == odp_packet_l3_offset(pkt));
+	CU_ASSERT(odp_packet_l4_offset(ref) == odp_packet_l4_offset(pkt));
+	COMPARE_HAS_INFLAG(pkt, ref, l3);
+	COMPARE_HAS_INFLAG(pkt, ref, l4);
+	COMPARE_HAS_INFLAG(pkt, ref, ipv4);
+	COMPARE_HAS_INFLAG(pkt, ref, ipv6);
+	COMPARE_HAS_INFLAG(pkt, ref, ip_bcast);
+	COMPARE_HAS_INFLAG(pkt, ref, ip_mcast);
+	COMPARE_HAS_INFLAG(pkt, ref, ipfrag);
+	COMPARE_HAS_INFLAG(pkt, ref, ipopt);
+	COMPARE_HAS_INFLAG(pkt, ref, ipsec);
+	COMPARE_HAS_INFLAG(pkt, ref, udp);
+	COMPARE_HAS_INFLAG(pkt, ref, tcp);
+	COMPARE_HAS_INFLAG(pkt, ref, sctp);
+	COMPARE_HAS_INFLAG(pkt, ref, icmp);
+	COMPARE_HAS_INFLAG(pkt, ref, error);
+
+	odp_packet_free(ref);
+	odp_packet_free(pkt);
+}
+
+void packet_test_parse(void)
+{
+	const uint32_t l3 = 14;
+	const uint32_t l4 = 34;
+	const uint32_t prefix = 10;
+	odp_packet_t pkt[2];
+	uint32_t offset[2];
+	odp_packet_parse_param_t param;
+	int i;
+
+	for (i = 0; i < 2; i++) {
+		pkt[i] = parse_packet_alloc(parse_ipv4_udp,
+					    sizeof(parse_ipv4_udp), prefix);
+		offset[i] = prefix;
+	}
+
+	param.proto = ODP_PROTO_ETH;
+	param.last_layer = ODP_PROTO_LAYER_ALL;
+
+	CU_ASSERT(odp_packet_parse(pkt[0], prefix, &param) == 0);
+	CU_ASSERT(odp_packet_has_eth(pkt[0]));
+	CU_ASSERT(odp_packet_has_ipv4(pkt[0]));
+	CU_ASSERT(odp_packet_has_udp(pkt[0]));
+	CU_ASSERT(!odp_packet_has_vlan(pkt[0]));
+	CU_ASSERT(!odp_packet_has_ipopt(pkt[0]));
+	CU_ASSERT(!odp_packet_has_error(pkt[0]));
+	CU_ASSERT(odp_packet_l2_offset(pkt[0]) == prefix);
+	CU_ASSERT(odp_packet_l3_offset(pkt[0]) == prefix + l3);
+	CU_ASSERT(odp_packet_l4_offset(pkt[0]) == prefix + l4);
+
+	/* Parse up to L3 starting from the IPv4 header */
+	param.proto = ODP_PROTO_IPV4;
+	param.last_layer = ODP_PROTO_LAYER_L3;
+
+	CU_ASSERT(odp_packet_parse(pkt[0], prefix + l3, &param) == 0);
+	CU_ASSERT(odp_packet_has_ipv4(pkt[0]));
+	CU_ASSERT(!odp_packet_has_udp(pkt[0]));
+	CU_ASSERT(odp_packet_l3_offset(pkt[0]) == prefix + l3);
+	CU_ASSERT(odp_packet_l4_offset(pkt[0]) == ODP_PACKET_OFFSET_INVALID);
+
+	/* Offset beyond packet end */
+	CU_ASSERT(odp_packet_parse(pkt[0], odp_packet_len(pkt[0]),
+				   &param) < 0);
+
+	param.proto = ODP_PROTO_ETH;
+	param.last_layer = ODP_PROTO_LAYER_ALL;
+
+	CU_ASSERT(odp_packet_parse_multi(pkt, offset, 2, &param) == 2);
+
+	for (i = 0; i < 2; i++) {
+		CU_ASSERT(odp_packet_has_ipv4(pkt[i]));
+		CU_ASSERT(odp_packet_has_udp(pkt[i]));
+		CU_ASSERT(odp_packet_l3_offset(pkt[i]) == prefix + l3);
+		CU_ASSERT(odp_packet_l4_offset(pkt[i]) == prefix + l4);
+	}
+
+	odp_packet_free_multi(pkt, 2);
+
+	parse_frame_test(parse_ipv4_udp, sizeof(parse_ipv4_udp),
+			 ODP_PROTO_IPV4, 14, 34);
+	parse_frame_test(parse_ipv6_tcp, sizeof(parse_ipv6_tcp),
+			 ODP_PROTO_IPV6, 14, 54);
+	parse_frame_test(parse_vlan_ipv4_udp, sizeof(parse_vlan_ipv4_udp),
+			 ODP_PROTO_IPV4, 18, 38);
+	parse_frame_test(parse_ipv4_opt_udp, sizeof(parse_ipv4_opt_udp),
+			 ODP_PROTO_IPV4, 14, 38);
+
+	/* Header types of the frames */
+	pkt[0] = parse_packet_alloc(parse_ipv6_tcp, sizeof(parse_ipv6_tcp), 0);
+	CU_ASSERT(odp_packet_parse(pkt[0], 0, &param) == 0);
+	CU_ASSERT(odp_packet_has_ipv6(pkt[0]));
+	CU_ASSERT(odp_packet_has_tcp(pkt[0]));
+	odp_packet_free(pkt[0]);
+
+	pkt[0] = parse_packet_alloc(parse_vlan_ipv4_udp,
+				    sizeof(parse_vlan_ipv4_udp), 0);
+	CU_ASSERT(odp_packet_parse(pkt[0], 0, &param) == 0);
+	CU_ASSERT(odp_packet_has_vlan(pkt[0]));
+	CU_ASSERT(odp_packet_has_ipv4(pkt[0]));
+	CU_ASSERT(odp_packet_has_udp(pkt[0]));
+	odp_packet_free(pkt[0]);
+
+	pkt[0] = parse_packet_alloc(parse_ipv4_opt_udp,
+				    sizeof(parse_ipv4_opt_udp), 0);
+	CU_ASSERT(odp_packet_parse(pkt[0], 0, &param) == 0);
+	CU_ASSERT(odp_packet_has_ipv4(pkt[0]));
+	CU_ASSERT(odp_packet_has_ipopt(pkt[0]));
+	CU_ASSERT(odp_packet_has_udp(pkt[0]));
+	odp_packet_free(pkt[0]);
+}
+
+void packet_test_vector(void)
+{
+	odp_pool_capability_t capa;
+	odp_pool_param_t params;
+	odp_pool_t pool;
+	odp_packet_vector_t pktv;
+	odp_packet_t pkt[4];
+	odp_packet_t *tbl;
+	odp_event_t ev;
+	uint32_t max_size = 4;
+	int i;
+
+	CU_ASSERT_FATAL(odp_pool_capability(&capa) == 0);
+
+	if (capa.vector.max_pools == 0)
+		return;
+
+	if (capa.vector.max_size < max_size)
+		max_size = capa.vector.max_size;
+
+	odp_pool_param_init(&params);
+	params.type = ODP_POOL_VECTOR;
+	params.vector.num = 2;
+	params.vector.max_size = max_size;
+
+	pool = odp_pool_create("packet_vector_pool", &params);
+	CU_ASSERT_FATAL(pool != ODP_POOL_INVALID);
+
+	pktv = odp_packet_vector_alloc(pool);
+	CU_ASSERT_FATAL(pktv != ODP_PACKET_VECTOR_INVALID);
+	CU_ASSERT(odp_packet_vector_valid(pktv) == 1);
+	CU_ASSERT(odp_packet_vector_pool(pktv) == pool);
+	CU_ASSERT(odp_packet_vector_size(pktv) == 0);
+	CU_ASSERT(odp_packet_vector_tbl(pktv, &tbl) == 0);
+	CU_ASSERT_PTR_NOT_NULL_FATAL(tbl);
+
+	CU_ASSERT_FATAL(odp_packet_alloc_multi(packet_pool, packet_len, pkt,
+					       max_size) == (int)max_size);
+
+	for (i = 0; i < (int)max_size; i++)
+		tbl[i] = pkt[i];
+
+	odp_packet_vector_size_set(pktv, max_size);
+	CU_ASSERT(odp_packet_vector_size(pktv) == max_size);
+	CU_ASSERT(odp_packet_vector_tbl(pktv, &tbl) == max_size);
+
+	for (i = 0; i < (int)max_size; i++)
+		CU_ASSERT(tbl[i] == pkt[i]);
+
+	ev = odp_packet_vector_to_event(pktv);
+	CU_ASSERT_FATAL(ev != ODP_EVENT_INVALID);
+	CU_ASSERT(odp_event_type(ev) == ODP_EVENT_PACKET_VECTOR);
+	CU_ASSERT(odp_packet_vector_from_event(ev) == pktv);
+	CU_ASSERT(odp_packet_vector_to_u64(pktv) !=
+		  odp_packet_vector_to_u64(ODP_PACKET_VECTOR_INVALID));
+
+	/* Frees also the packets */
+	odp_event_free(ev);
+
+	pktv = odp_packet_vector_alloc(pool);
+	CU_ASSERT_FATAL(pktv != ODP_PACKET_VECTOR_INVALID);
+	CU_ASSERT(odp_packet_vector_size(pktv) == 0);
+	odp_packet_vector_free(pktv);
+
+	CU_ASSERT(odp_pool_destroy(pool) == 0);
+}
+
 odp_testinfo_t packet_suite[] = {
 	ODP_TEST_INFO(packet_test_alloc_free),
 	ODP_TEST_INFO(packet_test_alloc_free_multi),
@@ -2391,6 +2767,7 @@ odp_testinfo_t packet_suite[] = {
 	ODP_TEST_INFO(packet_test_add_rem_data),
 	ODP_TEST_INFO(packet_test_copy),
 	ODP_TEST_INFO(packet_test_copydata),
+	ODP_TEST_INFO(packet_test_cmp_mem),
 	ODP_TEST_INFO(packet_test_concatsplit),
 	ODP_TEST_INFO(packet_test_concat_small),
 	ODP_TEST_INFO(packet_test_concat_extend_trunc),
@@ -2401,6 +2778,9 @@ odp_testinfo_t packet_suite[] = {
 	ODP_TEST_INFO(packet_test_align),
 	ODP_TEST_INFO(packet_test_offset),
 	ODP_TEST_INFO(packet_test_ref),
+	ODP_TEST_INFO(packet_test_ref_multi),
+	ODP_TEST_INFO(packet_test_parse),
+	ODP_TEST_INFO(packet_test_vector),
 	ODP_TEST_INFO_NULL,
 };
 
@@ -29,6 +29,7 @@ void packet_test_error_flags(void);
 void packet_test_add_rem_data(void);
 void packet_test_copy(void);
 void packet_test_copydata(void);
+void packet_test_cmp_mem(void);
 void packet_test_concatsplit(void);
 void packet_test_concat_small(void);
 void packet_test_concat_extend_trunc(void);
@@ -39,6 +40,9 @@ void packet_test_extend_ref(void);
 void packet_test_align(void);
 void packet_test_offset(void);
 void packet_test_ref(void);
+void packet_test_ref_multi(void);
+void packet_test_parse(void);
+void packet_test_vector(void);
 
 /* test arrays: */
 extern odp_testinfo_t packet_suite[];
@@ -33,6 +33,10 @@
 #define PKTIN_TS_MAX_RES       10000000000
 #define PKTIN_TS_CMP_RES       1
 
+#define PKTIN_VECTOR_NUM       32
+#define PKTIN_VECTOR_MAX_SIZE  4
+#define PKTIN_VECTOR_PKTS      12
+
 #define PKTIO_SRC_MAC		{1, 2, 3, 4, 5, 6}
 #define PKTIO_DST_MAC		{6, 5, 4, 3, 2, 1}
 #undef DEBUG_STATS
@@ -2032,6 +2036,213 @@ void pktio_test_pktin_ts(void)
 	}
 }
 
+int pktio_check_pktin_vector(void)
+{
+	odp_pktio_t pktio;
+	odp_pktio_capability_t capa;
+	odp_pktio_param_t pktio_param;
+	odp_pool_capability_t pool_capa;
+	int ret;
+
+	if (odp_pool_capability(&pool_capa) < 0 ||
+	    pool_capa.vector.max_pools == 0 ||
+	    pool_capa.vector.max_size < PKTIN_VECTOR_MAX_SIZE)
+		return ODP_TEST_INACTIVE;
+
+	odp_pktio_param_init(&pktio_param);
+	pktio_param.in_mode = ODP_PKTIN_MODE_QUEUE;
+
+	pktio = odp_pktio_open(iface_name[0], pool[0], &pktio_param);
+	if (pktio == ODP_PKTIO_INVALID)
+		return ODP_TEST_INACTIVE;
+
+	ret = odp_pktio_capability(pktio, &capa);
+	(void)odp_pktio_close(pktio);
+
+	if (ret < 0 || !capa.vector.supported ||
+	    capa.vector.min_size > PKTIN_VECTOR_MAX_SIZE ||
+	    capa.vector.max_size < PKTIN_VECTOR_MAX_SIZE)
+		return ODP_TEST_INACTIVE;
+
+	return ODP_TEST_ACTIVE;
+}
+
+static odp_event_t pktin_vector_event(odp_pktin_mode_t in_mode,
+				      odp_queue_t queue)
+{
+	if (in_mode == ODP_PKTIN_MODE_QUEUE)
+		return odp_queue_deq(queue);
+
+	return odp_schedule(NULL, ODP_SCHED_NO_WAIT);
+}
+
+/* Send packets and receive those in vector or packet events. Packet order
+ * is checked over all events. Returns the number of packets received. */
+static int pktin_vector_txrx(odp_pktio_t pktio_tx, odp_pktio_t pktio_rx,
+			     odp_pktin_mode_t in_mode, odp_pool_t vector_pool,
+			     int *num_vectors, int *num_packets)
+{
+	odp_packet_t pkt_tbl[PKTIN_VECTOR_PKTS];
+	uint32_t pkt_seq[PKTIN_VECTOR_PKTS];
+	odp_pktout_queue_t pktout;
+	odp_queue_t queue = ODP_QUEUE_INVALID;
+	odp_packet_vector_t pktv;
+	odp_packet_t *tbl;
+	odp_packet_t pkt;
+	odp_event_t ev;
+	odp_time_t wait_time, end;
+	uint32_t size, i;
+	int num_rx = 0;
+	int ret;
+
+	*num_vectors = 0;
+	*num_packets = 0;
+
+	if (in_mode == ODP_PKTIN_MODE_QUEUE)
+		CU_ASSERT_FATAL(odp_pktin_event_queue(pktio_rx, &queue,
+						      1) == 1);
+
+	ret = create_packets(pkt_tbl, pkt_seq, PKTIN_VECTOR_PKTS, pktio_tx,
+			     pktio_rx);
+	CU_ASSERT_FATAL(ret == PKTIN_VECTOR_PKTS);
+
+	CU_ASSERT_FATAL(odp_pktout_queue(pktio_tx, &pktout, 1) == 1);
+	CU_ASSERT_FATAL(send_packets(pktout, pkt_tbl,
+				     PKTIN_VECTOR_PKTS) == 0);
+
+	wait_time = odp_time_local_from_ns(ODP_TIME_SEC_IN_NS);
+	end = odp_time_sum(odp_time_local(), wait_time);
+
+	do {
+		ev = pktin_vector_event(in_mode, queue);
+
+		if (ev == ODP_EVENT_INVALID)
+			continue;
+
+		if (odp_event_type(ev) == ODP_EVENT_PACKET) {
+			(*num_packets)++;
+			pkt = odp_packet_from_event(ev);
+
+			if (pktio_pkt_seq(pkt) == pkt_seq[num_rx])
+				num_rx++;
+
+			odp_packet_free(pkt);
+			continue;
+		}
+
+		if (odp_event_type(ev) != ODP_EVENT_PACKET_VECTOR) {
+			odp_event_free(ev);
+			continue;
+		}
+
+		(*num_vectors)++;
+		pktv = odp_packet_vector_from_event(ev);
+		size = odp_packet_vector_tbl(pktv, &tbl);
+
+		CU_ASSERT(odp_packet_vector_pool(pktv) == vector_pool);
+		CU_ASSERT(size > 0);
+		CU_ASSERT(size <= PKTIN_VECTOR_MAX_SIZE);
+
+		for (i = 0; i < size; i++) {
+			if (num_rx < PKTIN_VECTOR_PKTS &&
+			    pktio_pkt_seq(tbl[i]) == pkt_seq[num_rx])
+				num_rx++;
+		}
+
+		odp_event_free(ev);
+	} while (num_rx < PKTIN_VECTOR_PKTS &&
+		 odp_time_cmp(end, odp_time_local()) > 0);
+
+	return num_rx;
+}
+
+static void test_pktin_vector(odp_pktin_mode_t in_mode)
+{
+	odp_pktio_t pktio[MAX_NUM_IFACES];
+	odp_pktio_t pktio_tx, pktio_rx;
+	odp_pktin_queue_param_t pktin_param;
+	odp_pool_param_t pool_param;
+	odp_pool_t vector_pool;
+	odp_packet_vector_t pktv[PKTIN_VECTOR_NUM];
+	int num_vectors, num_packets;
+	int num_rx, num_alloc;
+	int i;
+
+	CU_ASSERT_FATAL(num_ifaces >= 1);
+
+	odp_pool_param_init(&pool_param);
+	pool_param.type = ODP_POOL_VECTOR;
+	pool_param.vector.num = PKTIN_VECTOR_NUM;
+	pool_param.vector.max_size = PKTIN_VECTOR_MAX_SIZE;
+
+	vector_pool = odp_pool_create("pktin_vector_pool", &pool_param);
+	CU_ASSERT_FATAL(vector_pool != ODP_POOL_INVALID);
+
+	/* Open and configure interfaces */
+	for (i = 0; i < num_ifaces; ++i) {
+		pktio[i] = create_pktio(i, in_mode, ODP_PKTOUT_MODE_DIRECT);
+		CU_ASSERT_FATAL(pktio[i] != ODP_PKTIO_INVALID);
+
+		odp_pktin_queue_param_init(&pktin_param);
+		pktin_param.queue_param.sched.sync = ODP_SCHED_SYNC_ATOMIC;
+		pktin_param.vector.enable = 1;
+		pktin_param.vector.pool = vector_pool;
+		pktin_param.vector.max_size = PKTIN_VECTOR_MAX_SIZE;
+
+		CU_ASSERT_FATAL(odp_pktin_queue_config(pktio[i],
+						       &pktin_param) == 0);
+		CU_ASSERT_FATAL(odp_pktio_start(pktio[i]) == 0);
+	}
+
+	for (i = 0; i < num_ifaces; i++)
+		_pktio_wait_linkup(pktio[i]);
+
+	pktio_tx = pktio[0];
+	pktio_rx = (num_ifaces > 1) ? pktio[1] : pktio_tx;
+
+	/* Packets in order and in vectors of at most max_size packets */
+	num_rx = pktin_vector_txrx(pktio_tx, pktio_rx, in_mode, vector_pool,
+				   &num_vectors, &num_packets);
+	CU_ASSERT(num_rx == PKTIN_VECTOR_PKTS);
+	CU_ASSERT(num_vectors >= PKTIN_VECTOR_PKTS / PKTIN_VECTOR_MAX_SIZE);
+	CU_ASSERT(num_packets == 0);
+
+	/* Packet events when vector pool is empty */
+	for (num_alloc = 0; num_alloc < PKTIN_VECTOR_NUM; num_alloc++) {
+		pktv[num_alloc] = odp_packet_vector_alloc(vector_pool);
+
+		if (pktv[num_alloc] == ODP_PACKET_VECTOR_INVALID)
+			break;
+	}
+
+	num_rx = pktin_vector_txrx(pktio_tx, pktio_rx, in_mode, vector_pool,
+				   &num_vectors, &num_packets);
+	CU_ASSERT(num_rx == PKTIN_VECTOR_PKTS);
+	CU_ASSERT(num_vectors == 0);
+	CU_ASSERT(num_packets >= PKTIN_VECTOR_PKTS);
+
+	for (i = 0; i < num_alloc; i++)
+		odp_packet_vector_free(pktv[i]);
+
+	for (i = 0; i < num_ifaces; i++) {
+		CU_ASSERT_FATAL(odp_pktio_stop(pktio[i]) == 0);
+		flush_input_queue(pktio[i], in_mode);
+		CU_ASSERT_FATAL(odp_pktio_close(pktio[i]) == 0);
+	}
+
+	CU_ASSERT(odp_pool_destroy(vector_pool) == 0);
+}
+
+void pktio_test_pktin_vector_queue(void)
+{
+	test_pktin_vector(ODP_PKTIN_MODE_QUEUE);
+}
+
+void pktio_test_pktin_vector_sched(void)
+{
+	test_pktin_vector(ODP_PKTIN_MODE_SCHED);
+}
+
 static int create_pool(const char *iface, int num)
 {
 	char pool_name[ODP_POOL_NAME_LEN];
@@ -2174,6 +2385,10 @@ odp_testinfo_t pktio_suite_unsegmented[] = {
 				  pktio_check_statistics_counters),
 	ODP_TEST_INFO_CONDITIONAL(pktio_test_pktin_ts,
 				  pktio_check_pktin_ts),
+	ODP_TEST_INFO_CONDITIONAL(pktio_test_pktin_vector_queue,
+				  pktio_check_pktin_vector),
+	ODP_TEST_INFO_CONDITIONAL(pktio_test_pktin_vector_sched,
+				  pktio_check_pktin_vector),
 	ODP_TEST_INFO_NULL
 };
 
@@ -46,6 +46,9 @@ int pktio_check_statistics_counters(void);
 void pktio_test_statistics_counters(void);
 int pktio_check_pktin_ts(void);
 void pktio_test_pktin_ts(void);
+int pktio_check_pktin_vector(void);
+void pktio_test_pktin_vector_queue(void);
+void pktio_test_pktin_vector_sched(void);
 
 /* test arrays: */
 extern odp_testinfo_t pktio_suite[];
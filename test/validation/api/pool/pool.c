@@ -69,6 +69,7 @@ void pool_test_lookup_info_print(void)
 	odp_pool_t pool;
 	const char pool_name[] = "pool_for_lookup_test";
 	odp_pool_info_t info;
+	uint32_t i, num;
 	odp_pool_param_t params = {
 			.buf = {
 				.size  = default_buffer_size,
@@ -90,17 +91,191 @@ void pool_test_lookup_info_print(void)
 	CU_ASSERT(params.buf.align <= info.params.buf.align);
 	CU_ASSERT(params.buf.num <= info.params.buf.num);
 	CU_ASSERT(params.type == info.params.type);
+	CU_ASSERT(info.num_node >= 1);
+	CU_ASSERT(info.num_node <= ODP_POOL_NUMA_NODES_MAX);
+
+	for (i = 0, num = 0; i < info.num_node && i < ODP_POOL_NUMA_NODES_MAX;
+	     i++) {
+		num += info.node_num[i];
+
+		/* Node ids are unique and in ascending order */
+		if (i > 0)
+			CU_ASSERT(info.node_id[i] > info.node_id[i - 1]);
+	}
+
+	CU_ASSERT(num == info.params.buf.num);
 
 	odp_pool_print(pool);
 
 	CU_ASSERT(odp_pool_destroy(pool) == 0);
 }
 
+#define SUBPARAM_NUM_PKT 64
+
+void pool_test_packet_subparam(void)
+{
+	odp_pool_capability_t capa;
+	odp_pool_param_t params;
+	odp_pool_info_t info;
+	odp_pool_t pool;
+	odp_packet_t pkt[3 * SUBPARAM_NUM_PKT];
+	uint32_t len[] = {64, 1500, 9000};
+	int i, num;
+
+	CU_ASSERT_FATAL(odp_pool_capability(&capa) == 0);
+
+	if (capa.pkt.max_num_subparam < 2)
+		return;
+
+	odp_pool_param_init(&params);
+	params.type             = ODP_POOL_PACKET;
+	params.pkt.num          = SUBPARAM_NUM_PKT;
+	params.pkt.len          = 256;
+	params.pkt.num_subparam = 2;
+	params.pkt.sub[0].num   = SUBPARAM_NUM_PKT;
+	params.pkt.sub[0].len   = 2048;
+	params.pkt.sub[1].num   = SUBPARAM_NUM_PKT;
+	params.pkt.sub[1].len   = 9000;
+
+	pool = odp_pool_create("pool_subparam", &params);
+	CU_ASSERT_FATAL(pool != ODP_POOL_INVALID);
+	CU_ASSERT(odp_pool_lookup("pool_subparam") == pool);
+
+	CU_ASSERT_FATAL(odp_pool_info(pool, &info) == 0);
+	CU_ASSERT(info.params.pkt.num_subparam == 2);
+	CU_ASSERT(info.params.pkt.sub[1].len == 9000);
+
+	for (i = 0; i < 3; i++) {
+		pkt[i] = odp_packet_alloc(pool, len[i]);
+		CU_ASSERT_FATAL(pkt[i] != ODP_PACKET_INVALID);
+		CU_ASSERT(odp_packet_len(pkt[i]) == len[i]);
+		CU_ASSERT(odp_packet_pool(pkt[i]) == pool);
+	}
+
+	/* Packets fitting into a class are not segmented */
+	CU_ASSERT(!odp_packet_is_segmented(pkt[0]));
+	CU_ASSERT(!odp_packet_is_segmented(pkt[1]));
+
+	odp_packet_free_multi(pkt, 3);
+
+	/* Small packets use larger classes when the smallest runs out */
+	num = 0;
+	while (num < 3 * SUBPARAM_NUM_PKT) {
+		pkt[num] = odp_packet_alloc(pool, len[0]);
+		if (pkt[num] == ODP_PACKET_INVALID)
+			break;
+
+		CU_ASSERT(odp_packet_pool(pkt[num]) == pool);
+		num++;
+	}
+
+	CU_ASSERT(num > SUBPARAM_NUM_PKT);
+	odp_packet_free_multi(pkt, num);
+
+	CU_ASSERT(odp_pool_destroy(pool) == 0);
+}
+
+/* Extend packets of the smallest buffer size class up to the maximum
+ * packet length. Packet data and segment count must remain valid. */
+void pool_test_packet_subparam_extend(void)
+{
+	odp_pool_capability_t capa;
+	odp_pool_param_t params;
+	odp_pool_t pool;
+	odp_packet_t pkt, src;
+	uint32_t max_len, len, ext_len, i;
+	uint8_t data;
+	int ret;
+
+	CU_ASSERT_FATAL(odp_pool_capability(&capa) == 0);
+
+	if (capa.pkt.max_num_subparam < 1)
+		return;
+
+	max_len = capa.pkt.max_len ? capa.pkt.max_len : 64 * 1024;
+	ext_len = 1000;
+
+	odp_pool_param_init(&params);
+	params.type             = ODP_POOL_PACKET;
+	params.pkt.num          = SUBPARAM_NUM_PKT;
+	params.pkt.len          = 64;
+	params.pkt.max_len      = max_len;
+	params.pkt.num_subparam = 1;
+	params.pkt.sub[0].num   = SUBPARAM_NUM_PKT;
+	params.pkt.sub[0].len   = 9000;
+
+	pool = odp_pool_create("pool_subparam_extend", &params);
+	CU_ASSERT_FATAL(pool != ODP_POOL_INVALID);
+
+	/* Extend tail */
+	pkt = odp_packet_alloc(pool, 64);
+	CU_ASSERT_FATAL(pkt != ODP_PACKET_INVALID);
+	CU_ASSERT(!odp_packet_is_segmented(pkt));
+
+	for (i = 0; i < 64; i++) {
+		data = i;
+		CU_ASSERT(odp_packet_copy_from_mem(pkt, i, 1, &data) == 0);
+	}
+
+	while ((len = odp_packet_len(pkt)) < max_len) {
+		if (len + ext_len > max_len)
+			ext_len = max_len - len;
+
+		ret = odp_packet_extend_tail(&pkt, ext_len, NULL, NULL);
+		CU_ASSERT_FATAL(ret >= 0);
+		CU_ASSERT(odp_packet_len(pkt) == len + ext_len);
+		CU_ASSERT(odp_packet_pool(pkt) == pool);
+		CU_ASSERT(odp_packet_num_segs(pkt) <=
+			  (int)capa.pkt.max_segs_per_pkt);
+	}
+
+	for (i = 0; i < 64; i++) {
+		CU_ASSERT(odp_packet_copy_to_mem(pkt, i, 1, &data) == 0);
+		CU_ASSERT(data == i);
+	}
+
+	odp_packet_free(pkt);
+
+	/* Extend head */
+	pkt = odp_packet_alloc(pool, 64);
+	CU_ASSERT_FATAL(pkt != ODP_PACKET_INVALID);
+
+	data = 0xab;
+	CU_ASSERT(odp_packet_copy_from_mem(pkt, 0, 1, &data) == 0);
+
+	ret = odp_packet_extend_head(&pkt, max_len - 64, NULL, NULL);
+	CU_ASSERT_FATAL(ret >= 0);
+	CU_ASSERT(odp_packet_len(pkt) == max_len);
+	CU_ASSERT(odp_packet_pool(pkt) == pool);
+	CU_ASSERT(odp_packet_num_segs(pkt) <= (int)capa.pkt.max_segs_per_pkt);
+	CU_ASSERT(odp_packet_copy_to_mem(pkt, max_len - 64, 1, &data) == 0);
+	CU_ASSERT(data == 0xab);
+
+	odp_packet_free(pkt);
+
+	/* Concatenate packets of different classes */
+	pkt = odp_packet_alloc(pool, 64);
+	CU_ASSERT_FATAL(pkt != ODP_PACKET_INVALID);
+	src = odp_packet_alloc(pool, max_len - 64);
+	CU_ASSERT_FATAL(src != ODP_PACKET_INVALID);
+
+	CU_ASSERT_FATAL(odp_packet_concat(&pkt, src) >= 0);
+	CU_ASSERT(odp_packet_len(pkt) == max_len);
+	CU_ASSERT(odp_packet_pool(pkt) == pool);
+	CU_ASSERT(odp_packet_num_segs(pkt) <= (int)capa.pkt.max_segs_per_pkt);
+
+	odp_packet_free(pkt);
+
+	CU_ASSERT(odp_pool_destroy(pool) == 0);
+}
+
 odp_testinfo_t pool_suite[] = {
 	ODP_TEST_INFO(pool_test_create_destroy_buffer),
 	ODP_TEST_INFO(pool_test_create_destroy_packet),
 	ODP_TEST_INFO(pool_test_create_destroy_timeout),
 	ODP_TEST_INFO(pool_test_lookup_info_print),
+	ODP_TEST_INFO(pool_test_packet_subparam),
+	ODP_TEST_INFO(pool_test_packet_subparam_extend),
 	ODP_TEST_INFO_NULL,
 };
 
@@ -15,6 +15,8 @@ void pool_test_create_destroy_packet(void);
 void pool_test_create_destroy_timeout(void);
 void pool_test_create_destroy_buffer_shm(void);
 void pool_test_lookup_info_print(void);
+void pool_test_packet_subparam(void);
+void pool_test_packet_subparam_extend(void);
 
 /* test arrays: */
 extern odp_testinfo_t pool_suite[];
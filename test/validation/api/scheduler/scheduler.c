@@ -42,6 +42,10 @@
 #define MAGIC1                  0xdeadbeef
 #define MAGIC2                  0xcafef00d
 
+#define MANY_QUEUES_MAX		4096
+#define PARAM_EVENTS		64
+#define PARAM_MAX_EVENTS	64
+
 #define CHAOS_NUM_QUEUES 6
 #define CHAOS_NUM_BUFS_PER_QUEUE 6
 #define CHAOS_NUM_ROUNDS 1000
@@ -268,6 +272,311 @@ void scheduler_test_queue_destroy(void)
 	CU_ASSERT_FATAL(odp_pool_destroy(p) == 0);
 }
 
+#define STATS_EVENTS 32
+
+static uint64_t stats_latency_sum(const odp_schedule_stats_t *stats)
+{
+	uint64_t sum = 0;
+	int i;
+
+	for (i = 0; i < ODP_SCHEDULE_LATENCY_BUCKETS; i++)
+		sum += stats->latency[i];
+
+	return sum;
+}
+
+/* Statistics are optional. When supported, counters of this thread must
+ * account for a known number of events run through a queue. */
+void scheduler_test_stats(void)
+{
+	odp_schedule_stats_t before, after, global;
+	odp_queue_param_t qp;
+	odp_queue_t queue, from;
+	odp_pool_t p;
+	odp_buffer_t buf;
+	odp_event_t ev;
+	uint64_t calls = 0;
+	int thr = odp_thread_id();
+	int i, num = 0;
+
+	odp_schedule_stats_print();
+
+	if (odp_schedule_stats(&global)) {
+		CU_ASSERT(odp_schedule_thr_stats(thr, &before) < 0);
+		printf("\n    Statistics not supported\n");
+		return;
+	}
+
+	p = odp_pool_lookup(MSG_POOL_NAME);
+	CU_ASSERT_FATAL(p != ODP_POOL_INVALID);
+
+	odp_queue_param_init(&qp);
+	qp.type        = ODP_QUEUE_TYPE_SCHED;
+	qp.sched.prio  = ODP_SCHED_PRIO_DEFAULT;
+	qp.sched.sync  = ODP_SCHED_SYNC_PARALLEL;
+	qp.sched.group = ODP_SCHED_GROUP_ALL;
+
+	queue = odp_queue_create("sched_stats_queue", &qp);
+	CU_ASSERT_FATAL(queue != ODP_QUEUE_INVALID);
+
+	CU_ASSERT_FATAL(odp_schedule_thr_stats(thr, &before) == 0);
+
+	for (i = 0; i < STATS_EVENTS; i++) {
+		buf = odp_buffer_alloc(p);
+		CU_ASSERT_FATAL(buf != ODP_BUFFER_INVALID);
+
+		ev = odp_buffer_to_event(buf);
+		if (!(CU_ASSERT(odp_queue_enq(queue, ev) == 0)))
+			odp_buffer_free(buf);
+	}
+
+	while (num < STATS_EVENTS) {
+		ev = odp_schedule(&from, ODP_SCHED_WAIT);
+		calls++;
+		CU_ASSERT_FATAL(ev != ODP_EVENT_INVALID);
+		CU_ASSERT(from == queue);
+
+		odp_event_free(ev);
+		num++;
+	}
+
+	CU_ASSERT(odp_schedule_thr_stats(thr, &after) == 0);
+
+	CU_ASSERT(after.events - before.events == STATS_EVENTS);
+	CU_ASSERT(after.calls - before.calls == calls);
+	CU_ASSERT(stats_latency_sum(&after) - stats_latency_sum(&before) ==
+		  STATS_EVENTS);
+
+	/* Empty queue, which must be counted as an empty poll */
+	ev = odp_schedule(NULL, ODP_SCHED_NO_WAIT);
+	CU_ASSERT(ev == ODP_EVENT_INVALID);
+
+	CU_ASSERT(odp_schedule_thr_stats(thr, &before) == 0);
+	CU_ASSERT(before.calls == after.calls + 1);
+	CU_ASSERT(before.events == after.events);
+	CU_ASSERT(before.empty_polls > after.empty_polls);
+
+	/* Global counters include this thread */
+	CU_ASSERT(odp_schedule_stats(&global) == 0);
+	CU_ASSERT(global.calls >= before.calls);
+	CU_ASSERT(global.events >= before.events);
+	CU_ASSERT(stats_latency_sum(&global) >= stats_latency_sum(&before));
+
+	CU_ASSERT(odp_schedule_thr_stats(-1, &global) < 0);
+
+	odp_schedule_stats_print();
+
+	CU_ASSERT(odp_queue_destroy(queue) == 0);
+}
+
+/* Run events through a queue created with scheduling parameters 'sp'. A
+ * schedule call must not output more than 'limit' events. */
+static void sched_param_run(const odp_schedule_param_t *sp, uint32_t limit)
+{
+	odp_event_t ev[PARAM_MAX_EVENTS];
+	odp_queue_param_t qp;
+	odp_queue_t queue, from;
+	odp_pool_t p;
+	odp_buffer_t buf;
+	uint32_t *u32;
+	uint32_t seq = 0;
+	int i, num;
+
+	p = odp_pool_lookup(MSG_POOL_NAME);
+	CU_ASSERT_FATAL(p != ODP_POOL_INVALID);
+
+	odp_queue_param_init(&qp);
+	qp.type  = ODP_QUEUE_TYPE_SCHED;
+	qp.sched = *sp;
+
+	queue = odp_queue_create("sched_param_queue", &qp);
+	CU_ASSERT_FATAL(queue != ODP_QUEUE_INVALID);
+
+	for (i = 0; i < PARAM_EVENTS; i++) {
+		buf = odp_buffer_alloc(p);
+		CU_ASSERT_FATAL(buf != ODP_BUFFER_INVALID);
+
+		u32 = odp_buffer_addr(buf);
+		u32[0] = i;
+
+		ev[0] = odp_buffer_to_event(buf);
+		if (!(CU_ASSERT(odp_queue_enq(queue, ev[0]) == 0)))
+			odp_buffer_free(buf);
+	}
+
+	while (seq < PARAM_EVENTS) {
+		num = odp_schedule_multi(&from, ODP_SCHED_WAIT, ev,
+					 PARAM_MAX_EVENTS);
+		CU_ASSERT_FATAL(num > 0);
+		CU_ASSERT((uint32_t)num <= limit);
+		CU_ASSERT(from == queue);
+
+		for (i = 0; i < num; i++) {
+			buf = odp_buffer_from_event(ev[i]);
+			u32 = odp_buffer_addr(buf);
+
+			/* Single thread sees events of an atomic queue in
+			 * order */
+			if (sp->sync == ODP_SCHED_SYNC_ATOMIC)
+				CU_ASSERT(u32[0] == seq);
+
+			seq++;
+			odp_buffer_free(buf);
+		}
+
+		/* Release the context in the middle, which must not lose
+		 * events */
+		if (sp->atomic_sticky && seq >= PARAM_EVENTS / 2 &&
+		    seq < PARAM_EVENTS / 2 + num)
+			odp_schedule_release_atomic();
+	}
+
+	CU_ASSERT(seq == PARAM_EVENTS);
+	release_context(sp->sync);
+	CU_ASSERT(exit_schedule_loop() == 0);
+	CU_ASSERT(odp_queue_destroy(queue) == 0);
+}
+
+/* Burst size limits the number of events per schedule call */
+void scheduler_test_param_burst(void)
+{
+	odp_queue_param_t qp;
+	odp_schedule_param_t *sp = &qp.sched;
+
+	odp_queue_param_init(&qp);
+	sp->burst_size = 4;
+
+	sched_param_run(sp, 4);
+
+	sp->sync = ODP_SCHED_SYNC_ATOMIC;
+	sched_param_run(sp, 4);
+
+	sp->burst_size = 1;
+	sched_param_run(sp, 1);
+}
+
+/* An atomic context holds at most atomic_max_events. Events of one schedule
+ * call are from the same context. */
+void scheduler_test_param_atomic_max(void)
+{
+	odp_queue_param_t qp;
+	odp_schedule_param_t *sp = &qp.sched;
+
+	odp_queue_param_init(&qp);
+	sp->sync = ODP_SCHED_SYNC_ATOMIC;
+	sp->atomic_max_events = 3;
+
+	sched_param_run(sp, 3);
+
+	/* Multiple bursts per context */
+	sp->burst_size = 2;
+	sp->atomic_max_events = 7;
+	sched_param_run(sp, 2);
+}
+
+/* Sticky atomic context does not lose or reorder events, also when
+ * released explicitly */
+void scheduler_test_param_atomic_sticky(void)
+{
+	odp_queue_param_t qp;
+	odp_schedule_param_t *sp = &qp.sched;
+
+	odp_queue_param_init(&qp);
+	sp->sync = ODP_SCHED_SYNC_ATOMIC;
+	sp->atomic_sticky = 1;
+	sp->atomic_max_events = 1;
+
+	sched_param_run(sp, PARAM_MAX_EVENTS);
+
+	sp->burst_size = 3;
+	sched_param_run(sp, 3);
+}
+
+/* Schedule one event from each of a large number of queues of the same
+ * priority. Implementation may place all of those into one internal priority
+ * queue. */
+void scheduler_test_many_queues(void)
+{
+	static odp_queue_t queue[MANY_QUEUES_MAX];
+	static uint8_t seen[MANY_QUEUES_MAX];
+	odp_queue_capability_t capa;
+	odp_queue_param_t qp;
+	odp_pool_t p;
+	odp_buffer_t buf;
+	odp_event_t ev;
+	odp_queue_t from;
+	uint32_t *u32;
+	uint32_t max, num, i;
+	int ret;
+
+	CU_ASSERT_FATAL(odp_queue_capability(&capa) == 0);
+
+	max = capa.sched.max_num;
+	if (max == 0 || max > capa.max_queues)
+		max = capa.max_queues;
+	if (max > MANY_QUEUES_MAX)
+		max = MANY_QUEUES_MAX;
+
+	p = odp_pool_lookup(MSG_POOL_NAME);
+	CU_ASSERT_FATAL(p != ODP_POOL_INVALID);
+
+	odp_queue_param_init(&qp);
+	qp.type        = ODP_QUEUE_TYPE_SCHED;
+	qp.sched.prio  = ODP_SCHED_PRIO_DEFAULT;
+	qp.sched.sync  = ODP_SCHED_SYNC_PARALLEL;
+	qp.sched.group = ODP_SCHED_GROUP_ALL;
+
+	/* Other tests' queues exist, create as many as possible */
+	for (num = 0; num < max; num++) {
+		queue[num] = odp_queue_create(NULL, &qp);
+		if (queue[num] == ODP_QUEUE_INVALID)
+			break;
+	}
+
+	CU_ASSERT(num > max / 4);
+
+	for (i = 0; i < num; i++) {
+		seen[i] = 0;
+		buf = odp_buffer_alloc(p);
+		CU_ASSERT_FATAL(buf != ODP_BUFFER_INVALID);
+
+		u32 = odp_buffer_addr(buf);
+		u32[0] = i;
+
+		ev = odp_buffer_to_event(buf);
+		ret = odp_queue_enq(queue[i], ev);
+		CU_ASSERT(ret == 0);
+
+		if (ret)
+			odp_buffer_free(buf);
+	}
+
+	for (i = 0; i < num; i++) {
+		ev = odp_schedule(&from, ODP_SCHED_WAIT);
+		CU_ASSERT_FATAL(ev != ODP_EVENT_INVALID);
+
+		buf = odp_buffer_from_event(ev);
+		u32 = odp_buffer_addr(buf);
+
+		CU_ASSERT_FATAL(u32[0] < num);
+		CU_ASSERT(from == queue[u32[0]]);
+		CU_ASSERT(seen[u32[0]] == 0);
+		seen[u32[0]] = 1;
+
+		odp_buffer_free(buf);
+	}
+
+	CU_ASSERT(exit_schedule_loop() == 0);
+
+	for (i = 0; i < num; i++)
+		CU_ASSERT(odp_queue_destroy(queue[i]) == 0);
+
+	/* Queues are still scheduled. Scheduler frees those when it finds
+	 * them destroyed, so that other tests can create queues again. */
+	ev = odp_schedule(NULL, ODP_SCHED_NO_WAIT);
+	CU_ASSERT(ev == ODP_EVENT_INVALID);
+}
+
 void scheduler_test_groups(void)
 {
 	odp_pool_t p;
@@ -1616,6 +1925,11 @@ odp_testinfo_t scheduler_suite[] = {
 	ODP_TEST_INFO(scheduler_test_wait_time),
 	ODP_TEST_INFO(scheduler_test_num_prio),
 	ODP_TEST_INFO(scheduler_test_queue_destroy),
+	ODP_TEST_INFO(scheduler_test_many_queues),
+	ODP_TEST_INFO(scheduler_test_stats),
+	ODP_TEST_INFO(scheduler_test_param_burst),
+	ODP_TEST_INFO(scheduler_test_param_atomic_max),
+	ODP_TEST_INFO(scheduler_test_param_atomic_sticky),
 	ODP_TEST_INFO(scheduler_test_groups),
 	ODP_TEST_INFO(scheduler_test_pause_resume),
 	ODP_TEST_INFO(scheduler_test_parallel),
@@ -13,6 +13,11 @@
 void scheduler_test_wait_time(void);
 void scheduler_test_num_prio(void);
 void scheduler_test_queue_destroy(void);
+void scheduler_test_many_queues(void);
+void scheduler_test_stats(void);
+void scheduler_test_param_burst(void);
+void scheduler_test_param_atomic_max(void);
+void scheduler_test_param_atomic_sticky(void);
 void scheduler_test_groups(void);
 void scheduler_test_chaos(void);
 void scheduler_test_parallel(void);